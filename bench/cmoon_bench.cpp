@@ -0,0 +1,883 @@
+/// @file
+///
+/// @brief cmoon_bench - throughput of cmoon_core computations.
+///
+/// @copyright 2019-2020 M.Mashimo and licensors. All Right Reserved.
+///
+/// This file is part of cMoon application.
+///
+/// cMoon is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// any later version.
+///
+/// cMoon is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with cMoon.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "AChebyshev.h"
+#include "AJplEphemeris.h"
+#include "ADateParser.h"
+#include "AKepler.h"
+#include "ALunarTheory.h"
+#include "AMoon.h"
+#include "APhaseTable.h"
+#include "APlanets.h"
+#include "ASun.h"
+#include "ASweep.h"
+#include "ATimeZone.h"
+#include "AVsop87.h"
+
+/// @brief Keeps results of benchmarked calls alive
+static volatile double s_sink;
+
+/// @brief Options of the micro-benchmarks
+using MicroOptions = struct structMicroOptions
+{
+	bool        json;         // JSON lines instead of a table
+	std::string filter;       // run benchmarks whose name contains this
+	double      minSeconds;   // warm: minimum time of a run
+	int         coldSamples;  // cold: calls timed one at a time
+	size_t      evictBytes;   // cold: buffer written before each call (larger than L2)
+	std::string jplPath;      // JPL ephemeris (DE binary or SPK) - none are shipped
+};
+
+static MicroOptions s_micro{false, "", 0.2, 200, 8 << 20, ""};
+
+/// @brief Eccentricities of planetDescrip (APlanets.cpp)
+static const std::vector<double> s_eccentricities
+{
+	0.2056324, 0.0067933, 0.0166967, 0.0934231, 0.0484646, 0.0531651, 0.0428959, 0.0102981, 0.2501272
+};
+
+/// @brief Newton loop formerly used by APlanets (reference for speed and accuracy)
+static double legacyTrueAnomaly(const double meanAnomaly, const double eccentricity, const double eps)
+{
+	double e = meanAnomaly;
+	double delta = .05;
+	double convergence = pow(10., -eps);
+	while(fabs(delta) >= convergence)
+	{
+		delta = e - (eccentricity * sin(e)) - meanAnomaly;
+		e = e - (delta / (1. - (eccentricity * cos(e))));
+	}
+
+	double ec = (1. + eccentricity) / (1. - eccentricity);
+	double v = 2 * atan(pow(ec, .5) * tan(.5 * e));
+	if (v < 0)
+	{
+		v += 2. * M_PI;
+	}
+	return v;
+}
+
+static double seconds(const std::chrono::steady_clock::time_point& start)
+{
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static void benchKepler()
+{
+	constexpr size_t count{1 << 16};
+	constexpr int rounds{8};
+
+	std::vector<double> m(count);
+	std::vector<double> v(count);
+	std::vector<double> ref(count);
+	for (size_t i = 0; i < count; i++)
+	{
+		m[i] = 2. * M_PI * (i + 0.5) / count;
+	}
+
+	const double solves = static_cast<double>(count) * rounds * s_eccentricities.size();
+	double sum = 0.;
+
+	auto start = std::chrono::steady_clock::now();
+	for (int k = 0; k < rounds; k++)
+	{
+		for (double e : s_eccentricities)
+		{
+			for (size_t i = 0; i < count; i++)
+			{
+				sum += legacyTrueAnomaly(m[i], e, 12);
+			}
+		}
+	}
+	double legacy = seconds(start);
+
+	start = std::chrono::steady_clock::now();
+	for (int k = 0; k < rounds; k++)
+	{
+		for (double e : s_eccentricities)
+		{
+			for (size_t i = 0; i < count; i++)
+			{
+				sum += AKepler::trueAnomaly(m[i], e);
+			}
+		}
+	}
+	double single = seconds(start);
+
+	start = std::chrono::steady_clock::now();
+	for (int k = 0; k < rounds; k++)
+	{
+		for (double e : s_eccentricities)
+		{
+			AKepler::trueAnomaly(m.data(), e, count, v.data());
+			sum += v[k];
+		}
+	}
+	double batch = seconds(start);
+
+	// Accuracy against the legacy loop
+	double maxError = 0.;
+	for (double e : s_eccentricities)
+	{
+		AKepler::trueAnomaly(m.data(), e, count, v.data());
+		for (size_t i = 0; i < count; i++)
+		{
+			double d = fabs(v[i] - legacyTrueAnomaly(m[i], e, 14));
+			d = fmin(d, fabs(d - (2. * M_PI)));
+			maxError = fmax(maxError, d);
+		}
+	}
+
+	printf("Kepler solver (%s, %d iterations), %zu solves per run\n", AKepler::simdName(), KeplerIterations, static_cast<size_t>(solves));
+	printf("  legacy loop   : %12.0f solves/sec\n", solves / legacy);
+	printf("  AKepler single: %12.0f solves/sec\n", solves / single);
+	printf("  AKepler batch : %12.0f solves/sec (%.1fx legacy)\n", solves / batch, legacy / batch);
+	printf("  max |v - legacy| = %.3g rad (checksum %.6g)\n", maxError, sum);
+}
+
+static void benchSweep()
+{
+	constexpr int days{366};
+	const double mjdStart{59215.};   // 2021-01-01
+
+	ALocation location;
+	AMoon moonObj;
+	ADateTime dateObj;
+	MoonRiseInfo info;
+	double sum = 0.;
+
+	auto start = std::chrono::steady_clock::now();
+	for (int d = 0; d < days; d++)
+	{
+		dateObj.setJulianDateTime(mjdStart + 2400000.5 + d);
+		moonObj.computeMoonRise(location, dateObj, info);
+		sum += info[0].utRise;
+	}
+	double daily = seconds(start);
+
+	ASweep sweep(location);
+	start = std::chrono::steady_clock::now();
+	int events = sweep.sweep(mjdStart, days, [&sum](const SweepEvent& event) { sum += event.mjd; });
+	double swept = seconds(start);
+
+	printf("Moon/Sun/twilight rise-set for %d days\n", days);
+	printf("  daily computeMoonRise: %10.3f ms\n", daily * 1e3);
+	printf("  ASweep               : %10.3f ms (%d events, %ld altitude samples, checksum %.6g)\n",
+		swept * 1e3, events, sweep.samples(), sum);
+
+	std::vector<AltitudeEvent> transits;
+	start = std::chrono::steady_clock::now();
+	sweep.culminations(SweepBody::Moon, mjdStart, days, transits);
+	double culminated = seconds(start);
+	printf("  Moon culminations    : %10.3f ms (%zu events, %ld altitude samples)\n",
+		culminated * 1e3, transits.size(), sweep.samples());
+
+	std::vector<RiseSetInfo> almanac;
+	ASweep almanacSweep(location, AlmanacSweepHorizons);
+	start = std::chrono::steady_clock::now();
+	almanacSweep.riseSetDays(mjdStart, days, almanac);
+	double annual = seconds(start);
+	printf("  Almanac (6 horizons) : %10.3f ms (%zu day-horizons, %ld altitude samples)\n",
+		annual * 1e3, almanac.size(), almanacSweep.samples());
+}
+
+static void benchPositions()
+{
+	constexpr size_t count{1 << 16};
+
+	std::vector<double> t(count);
+	std::vector<double> moonRa(count), moonDec(count), sunRa(count), sunDec(count);
+	for (size_t i = 0; i < count; i++)
+	{
+		t[i] = 0.2 + (i / (24. * 36525.));   // hourly from 2020
+	}
+
+	double sum = 0.;
+	auto start = std::chrono::steady_clock::now();
+	for (size_t i = 0; i < count; i++)
+	{
+		double ra, dec;
+		AMoon::moonEquatorial(t[i], ra, dec);
+		sum += ra;
+		AMoon::sunEquatorial(t[i], ra, dec);
+		sum += dec;
+	}
+	double single = seconds(start);
+
+	start = std::chrono::steady_clock::now();
+	AMoon::moonSunEquatorial(t.data(), count, moonRa.data(), moonDec.data(), sunRa.data(), sunDec.data());
+	double batch = seconds(start);
+	sum += moonRa[count / 2] + sunDec[count / 2];
+
+	printf("Low-precision Moon and Sun RA/DEC (%s), %zu times\n", AKepler::simdName(), count);
+	printf("  single : %12.0f times/sec\n", count / single);
+	printf("  batch  : %12.0f times/sec (%.1fx single, checksum %.6g)\n", count / batch, single / batch, sum);
+}
+
+static void benchPhases()
+{
+	const double jdStart{2305447.5};   // 1600-01-01
+	const double jdEnd{2597641.5};     // 2400-01-01
+
+	AMoon moonObj;
+	std::vector<PhaseEvent> events;
+
+	auto start = std::chrono::steady_clock::now();
+	int count = moonObj.computePhasesInRange(jdStart, jdEnd, events);
+	double elapsed = seconds(start);
+
+	printf("Moon phases 1600-2400: %d events in %.3f ms (%.0f events/sec)\n", count, elapsed * 1e3, count / elapsed);
+
+	// Same span from a mapped phase table
+	const std::string path{"cmoon_bench_phases.bin"};
+	APhaseTable table;
+
+	start = std::chrono::steady_clock::now();
+	bool generated = APhaseTable::generate(path, jdStart, jdEnd);
+	double generate = seconds(start);
+
+	start = std::chrono::steady_clock::now();
+	bool opened = generated && table.open(path);
+	double open = seconds(start);
+
+	if (!opened)
+	{
+		printf("  phase table: cannot write %s\n", path.c_str());
+		return;
+	}
+
+	constexpr int lookups{1000000};
+	double sum = 0.;
+	start = std::chrono::steady_clock::now();
+	for (int i = 0; i < lookups; i++)
+	{
+		sum += table.nextPhase(jdStart + (i * 0.29), 2).jde;
+	}
+	double lookup = seconds(start);
+
+	// Without the table - computed
+	table.close();
+	start = std::chrono::steady_clock::now();
+	for (int i = 0; i < 1000; i++)
+	{
+		sum += table.nextPhase(jdStart + (i * 290.), 2).jde;
+	}
+	double computed = seconds(start);
+
+	printf("  phase table: generate %.3f ms, open %.3f ms\n", generate * 1e3, open * 1e3);
+	printf("  nextPhase (table)   : %12.0f lookups/sec\n", lookups / lookup);
+	printf("  nextPhase (computed): %12.0f lookups/sec (checksum %.6g)\n", 1000 / computed, sum);
+	remove(path.c_str());
+}
+
+static void benchPhasePrecision()
+{
+	const double jdStart{2305447.5};   // 1600-01-01
+	const double jdEnd{2597641.5};     // 2400-01-01
+	const std::vector<double> precisions{0., 0.00001, 0.0001, 0.001};
+
+	AMoon moonObj;
+	std::vector<PhaseEvent> reference;
+	moonObj.computePhasesInRange(jdStart, jdEnd, reference);
+
+	printf("Moon phase corrections by precision (1600-2400)\n");
+	for (double precision : precisions)
+	{
+		std::vector<PhaseEvent> events;
+		moonObj.setPhasePrecision(precision);
+
+		auto start = std::chrono::steady_clock::now();
+		int count = moonObj.computePhasesInRange(jdStart, jdEnd, events);
+		double elapsed = seconds(start);
+
+		double maxError = 0.;
+		for (size_t i = 0; (i < events.size()) && (i < reference.size()); i++)
+		{
+			maxError = fmax(maxError, fabs(events[i].jde - reference[i].jde));
+		}
+
+		printf("  precision %8.5f days: %10.3f ms (%.0f events/sec), max error %6.1f sec\n",
+			precision, elapsed * 1e3, count / elapsed, maxError * 86400.);
+	}
+}
+
+static void benchParse()
+{
+	constexpr int records{200000};
+	const double jdStart{2451544.5};   // 2000-01-01
+
+	// Newline-separated records of each format (as read by --batch)
+	const char* names[]{"YYYY-MM-DD", "YYYY-MM-DD hh:mm:ss", "ISO-8601 with offset", "JD", "MJD", "Unix seconds"};
+	std::vector<std::string> inputs(6);
+	for (int i = 0; i < records; i++)
+	{
+		double jd = jdStart + (i * 0.0123456);
+		int year, month, day, hour, minute, second;
+		AlgBase::convertJulianToDate(floor(jd + 0.5), year, month, day);
+		double dayFraction = (jd + 0.5) - floor(jd + 0.5);
+		int daySeconds = static_cast<int>(dayFraction * 86400.);
+		hour = daySeconds / 3600;
+		minute = (daySeconds / 60) % 60;
+		second = daySeconds % 60;
+
+		char text[64];
+		snprintf(text, sizeof(text), "%04d-%02d-%02d\n", year, month, day);
+		inputs[0] += text;
+		snprintf(text, sizeof(text), "%04d-%02d-%02d %02d:%02d:%02d\n", year, month, day, hour, minute, second);
+		inputs[1] += text;
+		snprintf(text, sizeof(text), "%04d-%02d-%02dT%02d:%02d:%02d.250-05:00\n", year, month, day, hour, minute, second);
+		inputs[2] += text;
+		snprintf(text, sizeof(text), "%.6f\n", jd);
+		inputs[3] += text;
+		snprintf(text, sizeof(text), "MJD%.6f\n", jd - 2400000.5);
+		inputs[4] += text;
+		snprintf(text, sizeof(text), "@%.0f\n", (jd - 2440587.5) * 86400.);
+		inputs[5] += text;
+	}
+
+	printf("Date/time parsing (%d records)\n", records);
+	for (size_t f = 0; f < inputs.size(); f++)
+	{
+		const char* p = inputs[f].data();
+		const char* end = p + inputs[f].size();
+		int parsed = 0;
+		double sum = 0.;
+
+		auto start = std::chrono::steady_clock::now();
+		while (p < end)
+		{
+			const char* newline = static_cast<const char*>(memchr(p, '\n', end - p));
+			ParsedInstant instant;
+			if (ADateParser::parse(p, newline, instant))
+			{
+				sum += static_cast<double>(instant.ticks);
+				parsed++;
+			}
+			p = newline + 1;
+		}
+		double elapsed = seconds(start);
+		s_sink = sum;
+
+		printf("  ADateParser %-22s: %12.0f records/sec (%d parsed)\n", names[f], records / elapsed, parsed);
+	}
+
+	// Command line parsers of the same records (std::string per field)
+	ADateTime dateObj;
+	for (size_t f : {0, 1, 3})
+	{
+		const char* p = inputs[f].data();
+		const char* end = p + inputs[f].size();
+		double sum = 0.;
+
+		auto start = std::chrono::steady_clock::now();
+		while (p < end)
+		{
+			const char* newline = static_cast<const char*>(memchr(p, '\n', end - p));
+			const char* blank = static_cast<const char*>(memchr(p, ' ', newline - p));
+			if (f == 3)
+			{
+				dateObj.parseJulianTime(std::string(p, newline).c_str());
+			}
+			else
+			{
+				ParsedDate date;
+				dateObj.parseDate(std::string(p, (blank != nullptr) ? blank : newline).c_str(), date);
+				if (blank != nullptr)
+				{
+					dateObj.parseTime(std::string(blank + 1, newline).c_str());
+				}
+			}
+			sum += dateObj.julian();
+			p = newline + 1;
+		}
+		double elapsed = seconds(start);
+		s_sink = sum;
+
+		printf("  ADateTime   %-22s: %12.0f records/sec\n", names[f], records / elapsed);
+	}
+}
+
+/// @brief Evicts the benchmark's data and code from the caches (as far as the buffer reaches)
+static void evictCaches()
+{
+	static std::vector<char> buffer;
+	buffer.resize(s_micro.evictBytes);
+
+	static char value = 0;
+	value++;
+	memset(buffer.data(), value, buffer.size());
+	s_sink = s_sink + buffer[buffer.size() / 2];
+}
+
+/// @brief Times an operation with warm caches (repeated calls) and cold caches (one call after eviction).
+/// @param[in] name - reported name
+/// @param[in] opsPerCall - operations done by one call (e.g. batch size)
+/// @param[in] op - call to time; op(i) with i = 0, 1, 2... returns a value to keep
+template <typename Op>
+static void micro(const char* name, const size_t opsPerCall, Op op)
+{
+	if (!s_micro.filter.empty() && (std::string(name).find(s_micro.filter) == std::string::npos))
+	{
+		return;
+	}
+
+	// Warm - double the calls until a run takes long enough
+	double sum = 0.;
+	size_t calls = 1;
+	double elapsed = 0.;
+	for (;;)
+	{
+		auto start = std::chrono::steady_clock::now();
+		for (size_t i = 0; i < calls; i++)
+		{
+			sum += op(i);
+		}
+		elapsed = seconds(start);
+
+		if (elapsed >= s_micro.minSeconds)
+		{
+			break;
+		}
+		calls *= 2;
+	}
+	double warmNs = elapsed * 1e9 / (static_cast<double>(calls) * opsPerCall);
+
+	// Overhead of reading the clock
+	double overhead = 1e9;
+	for (int i = 0; i < 100; i++)
+	{
+		auto start = std::chrono::steady_clock::now();
+		overhead = std::min(overhead, seconds(start));
+	}
+
+	// Cold - each call after evicting the caches
+	double cold = 0.;
+	for (int i = 0; i < s_micro.coldSamples; i++)
+	{
+		evictCaches();
+		auto start = std::chrono::steady_clock::now();
+		sum += op(static_cast<size_t>(i));
+		cold += std::max(0., seconds(start) - overhead);
+	}
+	double coldNs = cold * 1e9 / (static_cast<double>(s_micro.coldSamples) * opsPerCall);
+
+	s_sink = s_sink + sum;
+
+	const char* cache[2]{"warm", "cold"};
+	const double ns[2]{warmNs, coldNs};
+	const size_t iterations[2]{calls * opsPerCall, static_cast<size_t>(s_micro.coldSamples) * opsPerCall};
+	for (int c = 0; c < 2; c++)
+	{
+		if (s_micro.json)
+		{
+			printf("{\"name\":\"%s\",\"cache\":\"%s\",\"simd\":\"%s\",\"ns_per_op\":%.3f,\"ops_per_sec\":%.0f,\"iterations\":%zu}\n",
+				name, cache[c], AKepler::simdName(), ns[c], 1e9 / ns[c], iterations[c]);
+		}
+		else
+		{
+			printf("  %-52s %s %12.1f ns/op %14.0f ops/sec\n", name, cache[c], ns[c], 1e9 / ns[c]);
+		}
+	}
+}
+
+static void benchMicro()
+{
+	constexpr size_t inputs{1024};
+
+	// Inputs cycle through a day-spread of times around 2021 (J2000 days, Julian centuries, MJD)
+	std::vector<double> j2000(inputs);
+	std::vector<double> t(inputs);
+	std::vector<double> mjd(inputs);
+	std::vector<double> meanAnomaly(inputs);
+	for (size_t i = 0; i < inputs; i++)
+	{
+		j2000[i] = 7671. + (i * 0.37);
+		t[i] = j2000[i] / 36525.;
+		mjd[i] = j2000[i] + 51544.5;
+		meanAnomaly[i] = 2. * M_PI * (i + 0.5) / inputs;
+	}
+
+	ALocation location;
+	APlanets planetsObj;
+	AMoon moonObj;
+	ASun sunObj(AContext{0, 0, 0, 0, -5., true, {}});
+	ASweep sweep(location);
+	ADateTime dateObj;
+	dateObj.setJulianDateTime(mjd[0] + 2400000.5);
+
+	const PlanetDescriptor& earth = APlanets::planetDescriptor(Earth);
+	const PlanetDescriptor& mars = APlanets::planetDescriptor(Mars);
+	const OrbitPos viewPos = planetsObj.computeViewPos(j2000[0]);
+
+	std::vector<PhaseEvent> events;
+	std::vector<double> ra(inputs), dec(inputs), ra2(inputs), dec2(inputs);
+
+	if (!s_micro.json)
+	{
+		printf("Micro-benchmarks (%s) - warm: repeated calls, cold: one call after writing %zu KB\n",
+			AKepler::simdName(), s_micro.evictBytes >> 10);
+	}
+
+	micro("AKepler::trueAnomaly (computeTrueAnomaly)", 1, [&](size_t i)
+	{
+		return AKepler::trueAnomaly(meanAnomaly[i % inputs], earth.eccentricity);
+	});
+
+	micro("AKepler::trueAnomaly batch", inputs, [&](size_t)
+	{
+		AKepler::trueAnomaly(meanAnomaly.data(), mars.eccentricity, inputs, ra.data());
+		return ra[0];
+	});
+
+	micro("APlanets::computeViewPos (Earth findPosition)", 1, [&](size_t i)
+	{
+		return planetsObj.computeViewPos(j2000[i % inputs]).m_X;
+	});
+
+	micro("APlanets::computePlanetPos (Mars findPosition)", 1, [&](size_t i)
+	{
+		PlanetPosition position;
+		planetsObj.computePlanetPos(mars, j2000[i % inputs], viewPos, position);
+		return position.ra;
+	});
+
+	micro("APlanets::computePlanetPos (Mars with Earth)", 1, [&](size_t i)
+	{
+		double r, d, dist;
+		planetsObj.computePlanetPos(mars, j2000[i % inputs], r, d, dist);
+		return r;
+	});
+
+	micro("AMoon::computePhasesInRange (fineTuneJdeForCycle)", 1, [&](size_t i)
+	{
+		events.clear();
+		moonObj.computePhasesInRange(mjd[i % inputs] + 2400000.5, mjd[i % inputs] + 2400000.5 + 7., events);
+		return events.empty() ? 0. : events[0].jde;
+	});
+
+	micro("AMoon::computeKForJulian (computeKForNextPhase)", 1, [&](size_t i)
+	{
+		return AMoon::computeKForJulian(static_cast<int>(i & 3), mjd[i % inputs] + 2400000.5);
+	});
+
+	micro("AMoon::moonEquatorial (moon)", 1, [&](size_t i)
+	{
+		double r, d;
+		AMoon::moonEquatorial(t[i % inputs], r, d);
+		return r + d;
+	});
+
+	micro("AMoon::sunEquatorial (sun)", 1, [&](size_t i)
+	{
+		double r, d;
+		AMoon::sunEquatorial(t[i % inputs], r, d);
+		return r + d;
+	});
+
+	micro("AMoon::moonSunEquatorial batch", inputs, [&](size_t)
+	{
+		AMoon::moonSunEquatorial(t.data(), inputs, ra.data(), dec.data(), ra2.data(), dec2.data());
+		return ra[0] + dec2[0];
+	});
+
+	micro("ASweep::sinAltitude (sinalt)", 1, [&](size_t i)
+	{
+		return sweep.sinAltitude(static_cast<SweepBody>(i & 1), mjd[i % inputs]);
+	});
+
+	// Moon of the lunar theory - t taken as TT
+	ALunarTheory lunarTheory;
+	micro("ALunarTheory::position (moon)", 1, [&](size_t i)
+	{
+		LunarPosition position;
+		lunarTheory.position(t[i % inputs], position);
+		return position.ra + position.dec;
+	});
+
+	micro("ALunarTheory::positions batch", inputs, [&](size_t)
+	{
+		lunarTheory.positions(t.data(), inputs, ra.data(), dec.data(), ra2.data());
+		return ra[0] + ra2[0];
+	});
+
+	ASweep lunarSweep(location);
+	lunarSweep.setLunarTheory(&lunarTheory);
+	micro("ASweep::sinAltitude (sinalt - lunar theory)", 1, [&](size_t i)
+	{
+		return lunarSweep.sinAltitude(static_cast<SweepBody>(i & 1), mjd[i % inputs]);
+	});
+
+	// Same samples from a Chebyshev ephemeris of the inputs
+	const std::string ephemerisPath{"cmoon_bench_ephemeris.bin"};
+	std::vector<ChebyshevSeries> report;
+	AChebyshev ephemeris;
+	ASweep fittedSweep(location);
+	if (AChebyshev::compile(ephemerisPath, mjd[0] + 2400000.5 - 1., mjd[inputs - 1] + 2400000.5 + 1., report)
+		&& ephemeris.open(ephemerisPath))
+	{
+		fittedSweep.setEphemeris(&ephemeris);
+
+		micro("AChebyshev::position (moon)", 1, [&](size_t i)
+		{
+			double r, d, dist;
+			ephemeris.position(ChebyshevBody::Moon, j2000[i % inputs], r, d, dist);
+			return r + d;
+		});
+
+		micro("AChebyshev::direction (moon)", 1, [&](size_t i)
+		{
+			double direction[3];
+			ephemeris.direction(ChebyshevBody::Moon, j2000[i % inputs], direction);
+			return direction[0] + direction[2];
+		});
+
+		micro("AChebyshev::position (Mars)", 1, [&](size_t i)
+		{
+			double r, d, dist;
+			ephemeris.position(ChebyshevBody::Mars, j2000[i % inputs], r, d, dist);
+			return r + dist;
+		});
+
+		micro("ASweep::sinAltitude (sinalt - Chebyshev)", 1, [&](size_t i)
+		{
+			return fittedSweep.sinAltitude(static_cast<SweepBody>(i & 1), mjd[i % inputs]);
+		});
+	}
+	ephemeris.close();
+	remove(ephemerisPath.c_str());
+
+	// JPL ephemeris of the user (planet positions in the span of the inputs)
+	AJplEphemeris jpl;
+	if (!s_micro.jplPath.empty() && jpl.open(s_micro.jplPath) && jpl.covers(j2000[0]) && jpl.covers(j2000[inputs - 1]))
+	{
+		APlanets jplPlanets;
+		jplPlanets.setEphemeris(&jpl);
+
+		micro("AJplEphemeris::barycentric (Earth)", 1, [&](size_t i)
+		{
+			double position[3];
+			jpl.barycentric(JplEarth, j2000[i % inputs] + 2451545., position);
+			return position[0];
+		});
+
+		micro("APlanets::computePlanetPos (Mars - JPL)", 1, [&](size_t i)
+		{
+			double r, d, dist;
+			jplPlanets.computePlanetPos(mars, j2000[i % inputs], r, d, dist);
+			return r + dist;
+		});
+	}
+
+	// VSOP87 of each truncation (radians/AU) - one planet, then all planets of blocks of evenly spaced days
+	PlanetBatch planetBatch;
+	for (double truncation : {0., 1e-7, 1e-6, 1e-5, 1e-4})
+	{
+		AVsop87 vsop87(truncation);
+		APlanets vsopPlanets;
+		vsopPlanets.setVsop87(&vsop87);
+
+		char name[80];
+		snprintf(name, sizeof(name), "APlanets::computePlanetPos (Mars - VSOP87 %g, %zu terms)", truncation, vsop87.terms());
+		micro(name, 1, [&](size_t i)
+		{
+			double r, d, dist;
+			vsopPlanets.computePlanetPos(mars, j2000[i % inputs], r, d, dist);
+			return r + dist;
+		});
+
+		snprintf(name, sizeof(name), "AVsop87::computeBatch (7 planets - VSOP87 %g)", truncation);
+		micro(name, inputs, [&](size_t)
+		{
+			vsop87.computeBatch(j2000.data(), inputs, VsopPlanetsMask, planetBatch);
+			return planetBatch.ra[Mars][0];
+		});
+	}
+
+	micro("AlgBase::quad", 1, [&](size_t i)
+	{
+		double xe, ye, z1, z2;
+		double y0 = meanAnomaly[i % inputs] - M_PI;
+		return AlgBase::quad(y0 - 0.1, y0, y0 + 0.05, xe, ye, z1, z2) + z1;
+	});
+
+	micro("AlgBase::localSiderialTime", 1, [&](size_t i)
+	{
+		return AlgBase::localSiderialTime(mjd[i % inputs], location);
+	});
+
+	micro("ADateTime::setJulianDateTime (getJulianDate)", 1, [&](size_t i)
+	{
+		dateObj.setJulianDateTime(mjd[i % inputs] + 2400000.5);
+		return dateObj.julian();
+	});
+
+	const char* isoInput{"2020-11-23T06:45:50.250-05:00"};
+	const char* isoEnd{isoInput + strlen(isoInput)};
+	micro("ADateParser::parse (ISO-8601 with offset)", 1, [&](size_t)
+	{
+		ParsedInstant instant;
+		ADateParser::parse(isoInput, isoEnd, instant);
+		return ADateParser::julian(instant);
+	});
+
+	micro("ADateTime::modifiedJuiianDate", 1, [&](size_t)
+	{
+		return dateObj.modifiedJuiianDate(true);
+	});
+
+	micro("ASun::computeSun (showSun)", 1, [&](size_t)
+	{
+		SunInfo info;
+		sunObj.computeSun(location, dateObj, info);
+		return info.Jset;
+	});
+
+	AInstant instant = dateObj.instant();
+	micro("ASun::computeSun (AInstant)", 1, [&](size_t)
+	{
+		SunInfo info;
+		sunObj.computeSun(location, instant, info);
+		return info.Jset;
+	});
+
+	std::vector<ALocation> locations(inputs);
+	for (size_t i = 0; i < inputs; i++)
+	{
+		locations[i].setLatitude(-60. + (120. * (i + 0.5) / inputs));
+		locations[i].setLongitude(-180. + (360. * ((i * 37) % inputs) / inputs));
+		locations[i].setElevation(static_cast<double>(i % 1000));
+	}
+	SunSites sites;
+	SunSiteTimes siteTimes;
+	ASun::prepareSites(locations, sites);
+
+	micro("ASun::computeSun (sites one by one)", inputs, [&](size_t)
+	{
+		SunInfo info;
+		double sum = 0.;
+		for (const ALocation& site : locations)
+		{
+			sunObj.computeSun(site, instant, info);
+			sum += info.Jset;
+		}
+		return sum;
+	});
+
+	micro("ASun::computeSunSites batch", inputs, [&](size_t)
+	{
+		ASun::computeSunSites(instant, sites, siteTimes);
+		return siteTimes.Jset[0];
+	});
+
+	micro("AInstant::fromJulian + localMidnight", 1, [&](size_t i)
+	{
+		return AInstant::fromJulian(mjd[i % inputs] + 2400000.5).localMidnight(-5.).modifiedJulian();
+	});
+
+	std::shared_ptr<const ATimeZone> zone = ATimeZone::find("America/New_York");
+	if (zone)
+	{
+		micro("ATimeZone::lookupJulian (showSun localtime)", 1, [&](size_t i)
+		{
+			return static_cast<double>(zone->lookupJulian(mjd[i % inputs] + 2400000.5).offset);
+		});
+	}
+}
+
+static void usage()
+{
+	printf("Use: cmoon_bench [--json] [--micro] [--filter NAME] [--min-time SECONDS] [--cold-samples N] [--evict-kb KB] [--jpl FILE]\n");
+	printf("  --json          micro-benchmark results as JSON lines (implies --micro)\n");
+	printf("  --micro         micro-benchmarks only\n");
+	printf("  --filter NAME   micro-benchmarks with NAME in their name\n");
+	printf("  --min-time      minimum seconds of a warm run (default 0.2)\n");
+	printf("  --cold-samples  calls timed with cold caches (default 200)\n");
+	printf("  --evict-kb      buffer written before each cold call (default 8192)\n");
+	printf("  --jpl FILE      also JPL ephemeris FILE (DE binary or .bsp covering 2021)\n");
+}
+
+int main(int argc, char** argv)
+{
+	bool microOnly = false;
+	for (int i = 1; i < argc; i++)
+	{
+		std::string arg = argv[i];
+		bool hasValue = (i + 1 < argc);
+
+		if (arg == "--json")
+		{
+			s_micro.json = true;
+			microOnly = true;
+		}
+		else if (arg == "--micro")
+		{
+			microOnly = true;
+		}
+		else if ((arg == "--filter") && hasValue)
+		{
+			s_micro.filter = argv[++i];
+		}
+		else if ((arg == "--min-time") && hasValue)
+		{
+			s_micro.minSeconds = atof(argv[++i]);
+		}
+		else if ((arg == "--cold-samples") && hasValue)
+		{
+			s_micro.coldSamples = std::max(1, atoi(argv[++i]));
+		}
+		else if ((arg == "--evict-kb") && hasValue)
+		{
+			s_micro.evictBytes = static_cast<size_t>(std::max(1, atoi(argv[++i]))) << 10;
+		}
+		else if ((arg == "--jpl") && hasValue)
+		{
+			s_micro.jplPath = argv[++i];
+		}
+		else
+		{
+			usage();
+			return 1;
+		}
+	}
+
+	if (microOnly)
+	{
+		benchMicro();
+		return 0;
+	}
+
+	benchKepler();
+	benchPositions();
+	benchSweep();
+	benchPhases();
+	benchPhasePrecision();
+	benchParse();
+	benchMicro();
+	return 0;
+}
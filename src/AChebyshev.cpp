@@ -0,0 +1,417 @@
+/// @file
+///
+/// @brief AChebyshev class implementation.
+///
+/// @copyright 2019-2020 M.Mashimo and licensors. All Right Reserved.
+///
+/// This file is part of cMoon application.
+///
+/// cMoon is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// any later version.
+///
+/// cMoon is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with cMoon.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "AChebyshev.h"
+#include "AMoon.h"
+
+static constexpr char ChebyshevMagic[8]{'c', 'M', 'o', 'o', 'n', 'C', 'E', '\0'};
+static constexpr uint32_t ChebyshevVersion{1};
+
+/// @brief Samples per coefficient checked against the source
+static constexpr int ChebyshevCheckSamples{4};
+
+/// @brief Arc seconds of a radian
+static constexpr double ArcSecondsPerRadian{180. * 3600. / M_PI};
+
+const std::vector<ChebyshevFit> DefaultChebyshevFits
+{
+	{ChebyshevBody::Sun,     32., 13},
+	{ChebyshevBody::Moon,     4., 15},
+	{ChebyshevBody::Mercury, 16., 13},
+	{ChebyshevBody::Venus,   32., 13},
+	{ChebyshevBody::Mars,    32., 13},
+	{ChebyshevBody::Jupiter, 64., 11},
+	{ChebyshevBody::Saturn,  64., 11},
+	{ChebyshevBody::Uranus,  64., 11},
+	{ChebyshevBody::Neptune, 64., 11},
+	{ChebyshevBody::Pluto,   64., 11}
+};
+
+static const char* s_bodyNames[NumberOfChebyshevBodies]
+{
+	"Sun", "Moon", "Mercury", "Venus", "Mars", "Jupiter", "Saturn", "Uranus", "Neptune", "Pluto"
+};
+
+/// @brief Planet of a body (PlanetType)
+static int bodyPlanet(const ChebyshevBody body)
+{
+	int index = static_cast<int>(body);
+	return index - ((index <= static_cast<int>(ChebyshevBody::Venus)) ? 2 : 1);
+}
+
+/// @brief Positions of a body computed by the source (AMoon or APlanets) - direction cosines and distance
+static void sourcePositions(const APlanets& planets, const ChebyshevBody body, const std::vector<double>& j2000,
+	std::vector<double>& x, std::vector<double>& y, std::vector<double>& z, std::vector<double>& dist)
+{
+	size_t count = j2000.size();
+	std::vector<double> ra(count);
+	std::vector<double> dec(count);
+	dist.assign(count, 0.);
+
+	if ((body == ChebyshevBody::Sun) || (body == ChebyshevBody::Moon))
+	{
+		std::vector<double> t(count);
+		for (size_t i = 0; i < count; i++)
+		{
+			t[i] = j2000[i] / 36525.;
+		}
+
+		if (body == ChebyshevBody::Sun)
+		{
+			AMoon::sunEquatorial(t.data(), count, ra.data(), dec.data());
+		}
+		else
+		{
+			AMoon::moonEquatorial(t.data(), count, ra.data(), dec.data());
+		}
+	}
+	else
+	{
+		int planet = bodyPlanet(body);
+		PlanetBatch batch;
+		planets.computePlanetBatch(j2000.data(), count, planetMask(planet), batch);
+		ra = batch.ra[planet];
+		dec = batch.dec[planet];
+		dist = batch.dist[planet];
+	}
+
+	x.resize(count);
+	y.resize(count);
+	z.resize(count);
+	for (size_t i = 0; i < count; i++)
+	{
+		double cosDec = AlgBase::cosDegrees(dec[i]);
+		x[i] = cosDec * AlgBase::cosDegrees(ra[i] * 15.);
+		y[i] = cosDec * AlgBase::sinDegrees(ra[i] * 15.);
+		z[i] = AlgBase::sinDegrees(dec[i]);
+	}
+}
+
+/// @brief Fits the segments of a body and checks them against the source
+static void fitBody(const APlanets& planets, const ChebyshevFit& fit, const double start, const uint64_t segments,
+	std::vector<double>& coefficients, ChebyshevSeries& series)
+{
+	const int count = fit.degree + 1;
+	const int components = series.components;
+
+	// Chebyshev nodes of a segment (-1 to 1) and samples between them
+	std::vector<double> nodes(count);
+	for (int j = 0; j < count; j++)
+	{
+		nodes[j] = cos(M_PI * (j + 0.5) / count);
+	}
+	const int checks = ChebyshevCheckSamples * count;
+
+	std::vector<double> j2000(count);
+	std::vector<double> checkJ2000(checks);
+	std::vector<double> values[4];
+	std::vector<double> check[4];
+
+	for (uint64_t s = 0; s < segments; s++)
+	{
+		double segmentStart = start + (s * fit.segmentDays);
+		double half = fit.segmentDays / 2.;
+		double middle = segmentStart + half;
+
+		for (int j = 0; j < count; j++)
+		{
+			j2000[j] = middle + (nodes[j] * half);
+		}
+		sourcePositions(planets, fit.body, j2000, values[0], values[1], values[2], values[3]);
+
+		// c[k] = 2/N sum f(x[j]) cos(k (j + 1/2) pi / N) - c[0] halved
+		size_t first = coefficients.size();
+		for (int c = 0; c < components; c++)
+		{
+			for (int k = 0; k < count; k++)
+			{
+				double sum = 0.;
+				for (int j = 0; j < count; j++)
+				{
+					sum += values[c][j] * cos(M_PI * k * (j + 0.5) / count);
+				}
+				coefficients.push_back(((k == 0) ? 1. : 2.) * sum / count);
+			}
+		}
+
+		// Errors between the nodes (and at the ends)
+		for (int i = 0; i < checks; i++)
+		{
+			checkJ2000[i] = segmentStart + ((fit.segmentDays * i) / (checks - 1));
+		}
+		sourcePositions(planets, fit.body, checkJ2000, check[0], check[1], check[2], check[3]);
+
+		for (int i = 0; i < checks; i++)
+		{
+			double x = (2. * i / (checks - 1)) - 1.;
+			double fitted[4];
+			for (int c = 0; c < components; c++)
+			{
+				fitted[c] = AChebyshev::evaluate(&coefficients[first + (c * count)], count, x);
+			}
+
+			// Angle between the directions (normalized)
+			double length = sqrt((fitted[0] * fitted[0]) + (fitted[1] * fitted[1]) + (fitted[2] * fitted[2]));
+			double dx = (fitted[0] / length) - check[0][i];
+			double dy = (fitted[1] / length) - check[1][i];
+			double dz = (fitted[2] / length) - check[2][i];
+			double chord = sqrt((dx * dx) + (dy * dy) + (dz * dz));
+			series.maxError = std::max(series.maxError, 2. * asin(std::min(1., chord / 2.)) * ArcSecondsPerRadian);
+
+			if (components > 3)
+			{
+				series.maxDistanceError = std::max(series.maxDistanceError, fabs(fitted[3] - check[3][i]));
+			}
+		}
+	}
+}
+
+
+AChebyshev::AChebyshev()
+	: m_header{}
+	, m_series{}
+	, m_coefficients(nullptr)
+{
+	// Intentionally left blank
+}
+
+AChebyshev::~AChebyshev()
+{
+	close();
+}
+
+const char* AChebyshev::bodyName(const ChebyshevBody body)
+{
+	int index = static_cast<int>(body);
+	return ((index >= 0) && (index < NumberOfChebyshevBodies)) ? s_bodyNames[index] : "?";
+}
+
+bool AChebyshev::compile(const std::string& path, const double jdStart, const double jdEnd,
+	std::vector<ChebyshevSeries>& report, const std::vector<ChebyshevFit>& fits)
+{
+	report.clear();
+	if ((jdEnd <= jdStart) || fits.empty())
+	{
+		return false;
+	}
+
+	APlanets planets;
+	std::vector<double> coefficients;
+	double start = jdStart - 2451545.;
+
+	for (auto& fit : fits)
+	{
+		int body = static_cast<int>(fit.body);
+		if ((body < 0) || (body >= NumberOfChebyshevBodies) || (fit.segmentDays <= 0.)
+			|| (fit.degree < 1) || (fit.degree > ChebyshevMaxDegree))
+		{
+			return false;
+		}
+
+		ChebyshevSeries series{};
+		series.body = body;
+		series.components = ((fit.body == ChebyshevBody::Sun) || (fit.body == ChebyshevBody::Moon)) ? 3 : 4;
+		series.degree = fit.degree;
+		series.start = start;
+		series.segmentDays = fit.segmentDays;
+		series.segments = static_cast<uint64_t>(ceil((jdEnd - jdStart) / fit.segmentDays));
+		series.offset = coefficients.size();
+
+		fitBody(planets, fit, start, series.segments, coefficients, series);
+		report.push_back(series);
+	}
+
+	ChebyshevHeader header{};
+	memcpy(header.magic, ChebyshevMagic, sizeof(header.magic));
+	header.version = ChebyshevVersion;
+	header.bodies = static_cast<uint32_t>(report.size());
+	header.jdStart = jdStart;
+	header.jdEnd = jdEnd;
+
+	// Readers never see a partial ephemeris
+	return AMappedFile::writeAtomic(path, [&](FILE* file)
+	{
+		return (fwrite(&header, sizeof(header), 1, file) == 1)
+			&& (fwrite(report.data(), sizeof(ChebyshevSeries), report.size(), file) == report.size())
+			&& (fwrite(coefficients.data(), sizeof(double), coefficients.size(), file) == coefficients.size());
+	});
+}
+
+bool AChebyshev::open(const std::string& path)
+{
+	close();
+
+	if (!m_file.open(path, sizeof(ChebyshevHeader)))
+	{
+		return false;
+	}
+
+	// Validate header, series and size
+	size_t size = m_file.size();
+	memcpy(&m_header, m_file.data(), sizeof(m_header));
+	size_t seriesEnd = sizeof(ChebyshevHeader) + (m_header.bodies * sizeof(ChebyshevSeries));
+	if ((memcmp(m_header.magic, ChebyshevMagic, sizeof(ChebyshevMagic)) != 0)
+		|| (m_header.version != ChebyshevVersion)
+		|| (m_header.bodies == 0) || (m_header.bodies > NumberOfChebyshevBodies)
+		|| (size < seriesEnd))
+	{
+		close();
+		return false;
+	}
+
+	const ChebyshevSeries* series = reinterpret_cast<const ChebyshevSeries*>(m_file.at(sizeof(ChebyshevHeader)));
+	size_t coefficients = (size - seriesEnd) / sizeof(double);
+	for (uint32_t i = 0; i < m_header.bodies; i++)
+	{
+		const ChebyshevSeries& entry = series[i];
+		if ((entry.body < 0) || (entry.body >= NumberOfChebyshevBodies) || (entry.components < 3) || (entry.components > 4)
+			|| (entry.degree < 1) || (entry.degree > ChebyshevMaxDegree) || (entry.segmentDays <= 0.))
+		{
+			close();
+			return false;
+		}
+
+		// Segments within the coefficients - divided, not multiplied (offset and segments of the file can be anything)
+		uint64_t segmentSize = static_cast<uint64_t>(entry.components) * static_cast<uint64_t>(entry.degree + 1);
+		if ((entry.offset > coefficients) || (entry.segments > ((coefficients - entry.offset) / segmentSize)))
+		{
+			close();
+			return false;
+		}
+		m_series[entry.body] = &entry;
+	}
+
+	m_coefficients = reinterpret_cast<const double*>(m_file.at(seriesEnd));
+	return true;
+}
+
+void AChebyshev::close()
+{
+	m_file.close();
+	m_coefficients = nullptr;
+	m_series.fill(nullptr);
+}
+
+const ChebyshevSeries* AChebyshev::series(const ChebyshevBody body) const
+{
+	int index = static_cast<int>(body);
+	return ((index >= 0) && (index < NumberOfChebyshevBodies)) ? m_series[index] : nullptr;
+}
+
+const double* AChebyshev::segment(const ChebyshevBody body, const double j2000, double& x) const
+{
+	const ChebyshevSeries* entry = series(body);
+	if (entry == nullptr)
+	{
+		return nullptr;
+	}
+
+	// Segment by index - no search
+	double offset = (j2000 - entry->start) / entry->segmentDays;
+	if ((offset < 0.) || (offset > static_cast<double>(entry->segments)))
+	{
+		return nullptr;
+	}
+
+	uint64_t index = std::min(static_cast<uint64_t>(offset), entry->segments - 1);
+	x = (2. * (offset - index)) - 1.;
+	return m_coefficients + entry->offset + (index * entry->components * (entry->degree + 1));
+}
+
+bool AChebyshev::covers(const ChebyshevBody body, const double j2000) const
+{
+	double x;
+	return segment(body, j2000, x) != nullptr;
+}
+
+void AChebyshev::evaluateDirection(const double* coefficients, const int count, const double x, double direction[3])
+{
+	// Clenshaw recurrences of the components together - independent chains overlap
+	const double* cx = coefficients;
+	const double* cy = coefficients + count;
+	const double* cz = coefficients + (2 * count);
+	double x2 = 2. * x;
+	double bx1 = 0., by1 = 0., bz1 = 0.;
+	double bx2 = 0., by2 = 0., bz2 = 0.;
+	for (int k = count - 1; k > 0; k--)
+	{
+		double bx0 = (x2 * bx1) - bx2 + cx[k];
+		double by0 = (x2 * by1) - by2 + cy[k];
+		double bz0 = (x2 * bz1) - bz2 + cz[k];
+		bx2 = bx1;
+		by2 = by1;
+		bz2 = bz1;
+		bx1 = bx0;
+		by1 = by0;
+		bz1 = bz0;
+	}
+
+	direction[0] = (x * bx1) - bx2 + cx[0];
+	direction[1] = (x * by1) - by2 + cy[0];
+	direction[2] = (x * bz1) - bz2 + cz[0];
+}
+
+bool AChebyshev::direction(const ChebyshevBody body, const double j2000, double direction[3]) const
+{
+	double x;
+	const double* coefficients = segment(body, j2000, x);
+	if (coefficients == nullptr)
+	{
+		return false;
+	}
+
+	evaluateDirection(coefficients, m_series[static_cast<int>(body)]->degree + 1, x, direction);
+	return true;
+}
+
+bool AChebyshev::position(const ChebyshevBody body, const double j2000, double& ra, double& dec, double& dist) const
+{
+	double x;
+	const double* coefficients = segment(body, j2000, x);
+	if (coefficients == nullptr)
+	{
+		return false;
+	}
+
+	const ChebyshevSeries* entry = m_series[static_cast<int>(body)];
+	int count = entry->degree + 1;
+
+	double direction[3];
+	evaluateDirection(coefficients, count, x, direction);
+	double u = direction[0];
+	double v = direction[1];
+	double w = direction[2];
+
+	ra = atan2(v, u) * (12. / M_PI);
+	if (ra < 0.)
+	{
+		ra += 24.;
+	}
+	dec = atan2(w, sqrt((u * u) + (v * v))) * (180. / M_PI);
+	dist = (entry->components > 3) ? evaluate(coefficients + (3 * count), count, x) : 0.;
+	return true;
+}
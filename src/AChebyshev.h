@@ -0,0 +1,196 @@
+/// @file
+///
+/// @brief AChebyshev class definitions.
+///
+/// AChebyshev evaluates geocentric positions of the Sun, the Moon and the
+/// planets from Chebyshev polynomial segments fitted to the computations of
+/// AMoon (Sun and Moon) and APlanets. Each body is fitted with segments of
+/// its own length and degree; a segment holds the equatorial direction cosines
+/// (x = cos(dec) cos(ra), y = cos(dec) sin(ra), z = sin(dec)) and, for the
+/// planets, the distance. compile() writes the segments to a binary file with
+/// the largest error of each body against the source; open() maps the file.
+/// A position is one segment lookup and a Clenshaw recurrence per component.
+///
+/// @copyright 2019-2020 M.Mashimo and licensors. All Right Reserved.
+///
+/// This file is part of cMoon application.
+///
+/// cMoon is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// any later version.
+///
+/// cMoon is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with cMoon.  If not, see <https://www.gnu.org/licenses/>.
+///
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "AMappedFile.h"
+#include "APlanets.h"
+
+/// @brief Bodies of a Chebyshev ephemeris - planets follow PlanetType (Earth is not a body)
+enum class ChebyshevBody : int
+{
+	Sun = 0,
+	Moon,
+	Mercury,
+	Venus,
+	Mars,
+	Jupiter,
+	Saturn,
+	Uranus,
+	Neptune,
+	Pluto
+};
+
+/// @brief Number of bodies (ChebyshevBody)
+constexpr int NumberOfChebyshevBodies{10};
+
+/// @brief Highest degree of a fit
+constexpr int ChebyshevMaxDegree{31};
+
+/// @brief Segment length and degree of a body
+using ChebyshevFit = struct structChebyshevFit
+{
+	ChebyshevBody body;
+	double        segmentDays;   // length of a segment
+	int           degree;        // degree of the polynomials (coefficients - 1)
+};
+
+/// @brief Fits of all bodies - sub-arc second against the source computations
+extern const std::vector<ChebyshevFit> DefaultChebyshevFits;
+
+/// @brief Header of the ephemeris file - followed by 'bodies' ChebyshevSeries and the coefficients (doubles, host byte order)
+using ChebyshevHeader = struct structChebyshevHeader
+{
+	char     magic[8];    // "cMoonCE"
+	uint32_t version;     // ChebyshevVersion
+	uint32_t bodies;      // number of series
+	double   jdStart;     // span of the ephemeris (Julian dates, UTC)
+	double   jdEnd;
+};
+
+/// @brief Segments of a body - coefficients of segment s, component c start at offset + ((s * components) + c) * (degree + 1)
+using ChebyshevSeries = struct structChebyshevSeries
+{
+	int32_t  body;         // ChebyshevBody
+	int32_t  components;   // 3 (direction) or 4 (direction and distance)
+	int32_t  degree;
+	uint32_t reserved;
+	double   start;        // J2000 day of the first segment
+	double   segmentDays;
+	uint64_t segments;
+	uint64_t offset;       // first coefficient (doubles after the series)
+	double   maxError;     // largest direction error against the source (arc seconds)
+	double   maxDistanceError;   // largest distance error against the source (AU)
+};
+
+class AChebyshev
+{
+public:
+	AChebyshev();
+
+	~AChebyshev();
+
+	AChebyshev(const AChebyshev&) = delete;
+	AChebyshev& operator=(const AChebyshev&) = delete;
+
+	/// @brief Fits bodies over a span of Julian dates and writes the ephemeris file.
+	/// @param[in] path - file to write (written to 'path.tmp' then renamed)
+	/// @param[in] jdStart - first Julian date (UTC)
+	/// @param[in] jdEnd - last Julian date (UTC - rounded up to whole segments)
+	/// @param[out] report - series written (segments and errors against the source)
+	/// @param[in] fits - bodies to fit
+	/// @return true if written
+	static bool compile(const std::string& path, const double jdStart, const double jdEnd,
+		std::vector<ChebyshevSeries>& report, const std::vector<ChebyshevFit>& fits = DefaultChebyshevFits);
+
+	/// @brief Maps an ephemeris file.
+	/// @return true if the file is a valid ephemeris
+	bool open(const std::string& path);
+
+	/// @brief Unmaps the ephemeris
+	void close();
+
+	bool isOpen() const { return m_coefficients != nullptr; }
+
+	/// @brief Span of the mapped ephemeris
+	double jdStart() const { return m_header.jdStart; }
+	double jdEnd() const { return m_header.jdEnd; }
+
+	/// @brief Series of a body (nullptr if not in the ephemeris)
+	const ChebyshevSeries* series(const ChebyshevBody body) const;
+
+	/// @brief True if the body is in the ephemeris at a J2000 day
+	bool covers(const ChebyshevBody body, const double j2000) const;
+
+	/// @brief Equatorial direction cosines of a body
+	/// @param[in] body
+	/// @param[in] j2000 - J2000 day (UTC)
+	/// @param[out] direction - x, y, z (unit vector within the fit error)
+	/// @return false if the body or the day is not in the ephemeris
+	bool direction(const ChebyshevBody body, const double j2000, double direction[3]) const;
+
+	/// @brief Geocentric RA, DEC and distance of a body
+	/// @param[in] body
+	/// @param[in] j2000 - J2000 day (UTC)
+	/// @param[out] ra - hours
+	/// @param[out] dec - degrees
+	/// @param[out] dist - AU (0 for the Sun and the Moon)
+	/// @return false if the body or the day is not in the ephemeris
+	bool position(const ChebyshevBody body, const double j2000, double& ra, double& dec, double& dist) const;
+
+	/// @brief Body of a planet (PlanetType - not Earth)
+	static ChebyshevBody planetBody(const int planet)
+	{
+		return static_cast<ChebyshevBody>(planet + ((planet < PlanetType::Earth) ? 2 : 1));
+	}
+
+	/// @brief Name of a body
+	static const char* bodyName(const ChebyshevBody body);
+
+	/// @brief Evaluates a Chebyshev series (Clenshaw recurrence)
+	/// @param[in] coefficients - degree + 1 coefficients (the first one halved)
+	/// @param[in] count - number of coefficients
+	/// @param[in] x - -1 to 1
+	static double evaluate(const double* coefficients, const int count, const double x)
+	{
+		double b1 = 0.;
+		double b2 = 0.;
+		double x2 = 2. * x;
+		for (int k = count - 1; k > 0; k--)
+		{
+			double b0 = (x2 * b1) - b2 + coefficients[k];
+			b2 = b1;
+			b1 = b0;
+		}
+		return (x * b1) - b2 + coefficients[0];
+	}
+
+private:
+	/// @brief Evaluates the direction cosines of a segment (three series at once)
+	static void evaluateDirection(const double* coefficients, const int count, const double x, double direction[3]);
+
+	/// @brief Coefficients of the segment of a J2000 day and the day in the segment (-1 to 1)
+	const double* segment(const ChebyshevBody body, const double j2000, double& x) const;
+
+	ChebyshevHeader m_header;
+
+	/// @brief Series of each body (nullptr if not in the ephemeris)
+	std::array<const ChebyshevSeries*, NumberOfChebyshevBodies> m_series;
+
+	/// @brief Mapped file and coefficients in it
+	AMappedFile   m_file;
+	const double* m_coefficients;
+};
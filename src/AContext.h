@@ -0,0 +1,47 @@
+/// @file
+///
+/// @brief AContext definitions.
+///
+/// AContext carries the per-request settings (verbose levels, time zone and DST)
+/// used by the computation engines instead of process-global (static) state.
+///
+/// @copyright 2019-2020 M.Mashimo and licensors. All Right Reserved.
+///
+/// This file is part of cMoon application.
+///
+/// cMoon is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// any later version.
+///
+/// cMoon is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with cMoon.  If not, see <https://www.gnu.org/licenses/>.
+///
+
+#pragma once
+
+/// @brief Constants used for debug levels (m_verboseLevel) - bit fields (except <0)
+constexpr int DebugFullDateTime{1};
+constexpr int DebugJulianDate{2};
+constexpr int DebugComputation{4};
+
+/// @brief Settings for one request - each engine (ADateTime, AMoon, ASun, APlanets)
+/// keeps its own copy so that engines on different threads share nothing.
+using AContext = struct structContext
+{
+	int    dateTimeVerbose;  // ADateTime verbose level (0 = quiet)
+	int    moonVerbose;      // AMoon verbose level
+	int    sunVerbose;       // ASun verbose level
+	int    planetsVerbose;   // APlanets verbose level
+	double timeZone;         // Time zone - hours from UTC (standard time)
+	bool   useDST;           // Location uses daylight savings time
+	char   timeZoneName[64]; // zoneinfo name or POSIX TZ rule (empty = timeZone/useDST) - see ATimeZone
+};
+
+/// @brief Default context - EST with DST, results and basic debug info
+constexpr AContext DefaultContext{1, 1, 1, 0, -5., true, {}};
@@ -0,0 +1,385 @@
+/// @file
+///
+/// @brief ADateParser class implementation.
+///
+/// @copyright 2019-2020 M.Mashimo and licensors. All Right Reserved.
+///
+/// This file is part of cMoon application.
+///
+/// cMoon is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// any later version.
+///
+/// cMoon is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with cMoon.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <cmath>
+#include <cstring>
+
+#include "ADateParser.h"
+#include "AlgBase.h"
+
+/// @brief Julian day number of J2000.0 (JD 2451545.0 is its noon)
+static constexpr int64_t JulianDayOfTickZero{2451545};
+
+/// @brief Ticks of Julian date 0 of other time scales (JD of their zero - J2000.0)
+static constexpr int64_t ModifiedJulianZero{-(51544 * TicksPerDay) - (TicksPerDay / 2)};   // JD 2400000.5
+static constexpr int64_t UnixEpochZero{-(10957 * TicksPerDay) - (TicksPerDay / 2)};        // JD 2440587.5
+
+/// @brief Plain numbers of this value or more are Unix seconds (JD below)
+static constexpr double UnixSecondsThreshold{1e8};
+
+/// @brief Largest inputs (integer part) - keeps the ticks of any input within int64
+static constexpr int64_t MaxInputDays{10000000};           // JD or MJD (about 27000 years)
+static constexpr int64_t MaxInputSeconds{1000000000000};   // Unix seconds (about 31700 years)
+
+/// @brief Most digits accumulated in an integer
+static constexpr int MaxDigits{18};
+
+static const double s_powersOfTen[]{1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9,
+	1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18};
+
+static inline bool isDigit(const char c)
+{
+	return (c >= '0') && (c <= '9');
+}
+
+/// @brief Parses exactly 'count' digits
+static inline bool parseDigits(const char*& p, const char* end, const int count, int& value)
+{
+	if ((end - p) < count)
+	{
+		return false;
+	}
+
+	value = 0;
+	for (int i = 0; i < count; i++, p++)
+	{
+		if (!isDigit(*p))
+		{
+			return false;
+		}
+		value = (value * 10) + (*p - '0');
+	}
+	return true;
+}
+
+/// @brief Parses [+-]digits[.digits] into sign, integer and fraction (whole range)
+static bool parseFixed(const char* p, const char* end, int& sign, int64_t& integer, double& fraction)
+{
+	sign = 1;
+	if ((p < end) && ((*p == '+') || (*p == '-')))
+	{
+		sign = (*p == '-') ? -1 : 1;
+		p++;
+	}
+
+	bool digits = false;
+	int count = 0;
+	integer = 0;
+	for (; (p < end) && isDigit(*p); p++, count++)
+	{
+		if (count == MaxDigits)
+		{
+			return false;
+		}
+		integer = (integer * 10) + (*p - '0');
+		digits = true;
+	}
+
+	fraction = 0.;
+	if ((p < end) && (*p == '.'))
+	{
+		p++;
+		int64_t value = 0;
+		int places = 0;
+		for (; (p < end) && isDigit(*p); p++)
+		{
+			// Digits beyond 1e-18 do not change a double
+			if (places < MaxDigits)
+			{
+				value = (value * 10) + (*p - '0');
+				places++;
+			}
+			digits = true;
+		}
+		fraction = static_cast<double>(value) / s_powersOfTen[places];
+	}
+
+	return digits && (p == end);
+}
+
+/// @brief Ticks of a number of units from a zero
+static inline int64_t scaledTicks(const int sign, const int64_t integer, const double fraction, const int64_t ticksPerUnit, const int64_t zero)
+{
+	int64_t ticks = (integer * ticksPerUnit) + llround(fraction * ticksPerUnit);
+	return (sign * ticks) + zero;
+}
+
+static inline bool matchPrefix(const char*& p, const char* end, const char* prefix)
+{
+	size_t length = strlen(prefix);
+	if (static_cast<size_t>(end - p) < length)
+	{
+		return false;
+	}
+	for (size_t i = 0; i < length; i++)
+	{
+		if ((p[i] | 0x20) != prefix[i])
+		{
+			return false;
+		}
+	}
+	p += length;
+	return true;
+}
+
+
+bool ADateParser::parse(const char* text, ParsedInstant& instant)
+{
+	return parse(text, text + strlen(text), instant);
+}
+
+bool ADateParser::parse(const char* begin, const char* end, ParsedInstant& instant)
+{
+	instant = ParsedInstant{0, 0, InputFormat::Invalid};
+
+	// Surrounding blanks
+	while ((begin < end) && ((*begin == ' ') || (*begin == '\t')))
+	{
+		begin++;
+	}
+	while ((end > begin) && ((end[-1] == ' ') || (end[-1] == '\t') || (end[-1] == '\r') || (end[-1] == '\n')))
+	{
+		end--;
+	}
+	if (begin == end)
+	{
+		return false;
+	}
+
+	// ISO-8601 - a '-' after the year
+	if (isDigit(*begin) && (memchr(begin + 1, '-', end - begin - 1) != nullptr))
+	{
+		return parseIso(begin, end, instant);
+	}
+
+	const char* p = begin;
+	InputFormat format = InputFormat::Invalid;
+	if (*p == '@')
+	{
+		p++;
+		format = InputFormat::UnixSeconds;
+	}
+	else if (matchPrefix(p, end, "mjd"))
+	{
+		format = InputFormat::ModifiedJulianDate;
+	}
+	else if (matchPrefix(p, end, "jd"))
+	{
+		format = InputFormat::JulianDate;
+	}
+
+	int sign;
+	int64_t integer;
+	double fraction;
+	if (!parseFixed(p, end, sign, integer, fraction))
+	{
+		return false;
+	}
+
+	if (format == InputFormat::Invalid)
+	{
+		format = ((integer + fraction) >= UnixSecondsThreshold) ? InputFormat::UnixSeconds : InputFormat::JulianDate;
+	}
+
+	if (integer > ((format == InputFormat::UnixSeconds) ? MaxInputSeconds : MaxInputDays))
+	{
+		return false;
+	}
+
+	switch (format)
+	{
+	case InputFormat::UnixSeconds:
+		instant.ticks = scaledTicks(sign, integer, fraction, TicksPerSecond, UnixEpochZero);
+		break;
+	case InputFormat::ModifiedJulianDate:
+		instant.ticks = scaledTicks(sign, integer, fraction, TicksPerDay, ModifiedJulianZero);
+		break;
+	default:
+		instant.ticks = scaledTicks(sign, integer, fraction, TicksPerDay, -JulianDayOfTickZero * TicksPerDay);
+		break;
+	}
+
+	instant.format = format;
+	return true;
+}
+
+bool ADateParser::parseTimeOfDay(const char* begin, const char* end, int64_t& ticks)
+{
+	const char* p = begin;
+	int hour, minute, second = 0;
+	if (!parseDigits(p, end, 2, hour) || (p == end) || (*p++ != ':') || !parseDigits(p, end, 2, minute))
+	{
+		return false;
+	}
+
+	int64_t micro = 0;
+	if ((p < end) && (*p == ':'))
+	{
+		p++;
+		if (!parseDigits(p, end, 2, second))
+		{
+			return false;
+		}
+
+		// Fraction of a second - microseconds (more digits are ignored)
+		if ((p < end) && ((*p == '.') || (*p == ',')))
+		{
+			p++;
+			int64_t scale = TicksPerSecond;
+			if ((p == end) || !isDigit(*p))
+			{
+				return false;
+			}
+			for (; (p < end) && isDigit(*p); p++)
+			{
+				scale /= 10;
+				micro += (*p - '0') * scale;
+			}
+		}
+	}
+
+	// 24:00:00 is the end of the day; second 60 is a leap second
+	if ((p != end) || (hour > 24) || (minute > 59) || (second > 60) || ((hour == 24) && ((minute != 0) || (second != 0) || (micro != 0))))
+	{
+		return false;
+	}
+
+	ticks = ((((hour * 60) + minute) * 60) + second) * TicksPerSecond + micro;
+	return true;
+}
+
+bool ADateParser::parseIso(const char* begin, const char* end, ParsedInstant& instant)
+{
+	instant = ParsedInstant{0, 0, InputFormat::Invalid};
+
+	const char* p = begin;
+	int year, month, day;
+	if (!parseDigits(p, end, 4, year) || (p == end) || (*p++ != '-') || !parseDigits(p, end, 2, month)
+		|| (p == end) || (*p++ != '-') || !parseDigits(p, end, 2, day))
+	{
+		return false;
+	}
+
+	if ((month < 1) || (month > 12) || (day < 1)
+		|| (day > (AlgBase::convertDateToJulianDay((month == 12) ? year + 1 : year, (month % 12) + 1, 1)
+			- AlgBase::convertDateToJulianDay(year, month, 1))))
+	{
+		return false;
+	}
+
+	// Midnight (UTC) of the date
+	int64_t ticks = ((AlgBase::convertDateToJulianDay(year, month, day) - JulianDayOfTickZero) * TicksPerDay) - (TicksPerDay / 2);
+	InputFormat format = InputFormat::Date;
+	int32_t offset = 0;
+
+	if (p < end)
+	{
+		if ((*p != 'T') && (*p != 't') && (*p != ' '))
+		{
+			return false;
+		}
+		p++;
+
+		// Time ends at the offset (Z, + or -)
+		const char* timeEnd = p;
+		while ((timeEnd < end) && (*timeEnd != 'Z') && (*timeEnd != 'z') && (*timeEnd != '+') && (*timeEnd != '-'))
+		{
+			timeEnd++;
+		}
+		// Blank before an offset: "2020-11-23 06:30 +01:00"
+		const char* timeLast = timeEnd;
+		while ((timeLast > p) && (timeLast[-1] == ' '))
+		{
+			timeLast--;
+		}
+
+		int64_t timeOfDay;
+		if (!parseTimeOfDay(p, timeLast, timeOfDay))
+		{
+			return false;
+		}
+		ticks += timeOfDay;
+		format = InputFormat::DateTime;
+
+		p = timeEnd;
+		if (p < end)
+		{
+			if ((*p == 'Z') || (*p == 'z'))
+			{
+				p++;
+			}
+			else
+			{
+				int sign = (*p++ == '-') ? -1 : 1;
+				int hours, minutes = 0;
+				if (!parseDigits(p, end, 2, hours))
+				{
+					return false;
+				}
+				if ((p < end) && (*p == ':'))
+				{
+					p++;
+				}
+				if ((p < end) && !parseDigits(p, end, 2, minutes))
+				{
+					return false;
+				}
+				if ((hours > 23) || (minutes > 59))
+				{
+					return false;
+				}
+				offset = sign * ((hours * 3600) + (minutes * 60));
+			}
+
+			if (p != end)
+			{
+				return false;
+			}
+		}
+	}
+
+	// Local time to UTC
+	instant.ticks = ticks - (offset * TicksPerSecond);
+	instant.offset = offset;
+	instant.format = format;
+	return true;
+}
+
+bool ADateParser::parseDecimal(const char* begin, const char* end, double& value)
+{
+	int sign;
+	int64_t integer;
+	double fraction;
+	if (!parseFixed(begin, end, sign, integer, fraction))
+	{
+		return false;
+	}
+
+	value = sign * (static_cast<double>(integer) + fraction);
+	return true;
+}
+
+int64_t ADateParser::ticksFromJulian(const double jd)
+{
+	// Whole days first - keeps the precision of the fraction
+	double days = floor(jd);
+	return ((static_cast<int64_t>(days) - JulianDayOfTickZero) * TicksPerDay) + llround((jd - days) * TicksPerDay);
+}
@@ -0,0 +1,93 @@
+/// @file
+///
+/// @brief ADateParser class definitions.
+///
+/// ADateParser parses date/time inputs from character ranges (not terminated,
+/// nothing copied or allocated) into an instant: microseconds since J2000.0
+/// (JD 2451545.0, UTC). Accepted formats:
+///  - ISO-8601: YYYY-MM-DD[(T| )hh:mm[:ss[.ffffff]]][Z|+hh[:mm]|-hh[:mm]]
+///  - Julian date: 2459177.25 or JD2459177.25
+///  - Modified Julian date: MJD59176.75
+///  - Unix epoch seconds: @1606132800 (or any plain number of 1e8 or more)
+///
+/// @copyright 2019-2020 M.Mashimo and licensors. All Right Reserved.
+///
+/// This file is part of cMoon application.
+///
+/// cMoon is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// any later version.
+///
+/// cMoon is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with cMoon.  If not, see <https://www.gnu.org/licenses/>.
+///
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/// @brief Instant resolution - microseconds
+constexpr int64_t TicksPerSecond{1000000};
+constexpr int64_t TicksPerDay{86400 * TicksPerSecond};
+
+/// @brief Julian date of tick 0 (J2000.0)
+constexpr double JulianDateOfTickZero{2451545.0};
+
+/// @brief Format of a parsed input
+enum class InputFormat : int
+{
+	Invalid = 0,
+	Date,           // YYYY-MM-DD (00:00 UTC)
+	DateTime,       // YYYY-MM-DD hh:mm[:ss] (with or without offset)
+	JulianDate,
+	ModifiedJulianDate,
+	UnixSeconds
+};
+
+/// @brief Parsed instant
+using ParsedInstant = struct structParsedInstant
+{
+	int64_t     ticks;    // microseconds since J2000.0 (UTC)
+	int32_t     offset;   // UTC offset of the input (seconds east - ISO-8601 only)
+	InputFormat format;
+};
+
+class ADateParser
+{
+public:
+	/// @brief Parses a date/time input (format detected)
+	/// @param[in] begin - first character
+	/// @param[in] end - one past the last character
+	/// @param[out] instant - parsed instant
+	/// @return true if the whole range is parsed
+	static bool parse(const char* begin, const char* end, ParsedInstant& instant);
+
+	/// @brief Parses a terminated string
+	static bool parse(const char* text, ParsedInstant& instant);
+
+	/// @brief Parses ISO-8601 date and time: YYYY-MM-DD[(T| )hh:mm[:ss[.ffffff]]][Z|(+|-)hh[[:]mm]]
+	static bool parseIso(const char* begin, const char* end, ParsedInstant& instant);
+
+	/// @brief Parses time of day "hh:mm[:ss[.ffffff]]" (no offset)
+	/// @param[out] ticks - microseconds since midnight
+	static bool parseTimeOfDay(const char* begin, const char* end, int64_t& ticks);
+
+	/// @brief Parses a decimal number (no exponent) - digits are accumulated as integers
+	static bool parseDecimal(const char* begin, const char* end, double& value);
+
+	/// @brief Julian date of an instant
+	static double julian(const ParsedInstant& instant)
+	{
+		return JulianDateOfTickZero + (static_cast<double>(instant.ticks) / TicksPerDay);
+	}
+
+	/// @brief Instant of a Julian date (rounded to the tick)
+	static int64_t ticksFromJulian(const double jd);
+};
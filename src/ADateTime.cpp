@@ -31,15 +31,6 @@
 
 using namespace std;
 
-// Static class var:
-int ADateTime::m_verboseLevel = 1;
-
-// double ADateTime::m_timeZone = -4;   // EDT
-double ADateTime::m_defaultTimeZone = -5;   // EST
-bool ADateTime::m_useDST = true;
-
-bool ADateTime::m_autoComputeTimeZone = true;
-
 constexpr std::array<int, 12> s_MonthDays{ 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
 
 // To use strftime(), refer to:
@@ -47,8 +38,51 @@ constexpr std::array<int, 12> s_MonthDays{ 31, 28, 31, 30, 31, 30, 31, 31, 30, 3
 static const char* DateTimeFormat24h = "%a %F %T";  // Generic Date-Time format: 'Wkd YYYY-MM-YY HH:MM:SS' 24-hour
 static const char* DateTimeFormat12h = "%a %F %r";  // Generic Date-Time format: 'Wkd YYYY-MM-YY HH:MM:SS a/pm' 12-hour
 
-ADateTime::ADateTime()
+/// @brief Julian day number of 1970-01-01 (Unix epoch)
+static constexpr long JulianDayOfEpoch = 2440588;
+
+/// @brief Integer division rounded down (negative values step back)
+static inline long floorDivide(const long value, const long divisor)
+{
+    long quotient = value / divisor;
+    return ((value % divisor) < 0) ? quotient - 1 : quotient;
+}
+
+/// @brief Sets date and time fields of struct tm from Julian day number and seconds of the day
+static void setTimeStruct(const long julianDay, const long seconds, struct tm& timeStruct)
+{
+    int y, m, d;
+    AlgBase::convertJulianToDate(static_cast<double>(julianDay), y, m, d);
+
+    timeStruct.tm_year = y - 1900;
+    timeStruct.tm_mon = m - 1;
+    timeStruct.tm_mday = d;
+    timeStruct.tm_hour = static_cast<int>(seconds / 3600);
+    timeStruct.tm_min = static_cast<int>((seconds % 3600) / 60);
+    timeStruct.tm_sec = static_cast<int>(seconds % 60);
+
+    // Julian day 0 is a Monday
+    timeStruct.tm_wday = static_cast<int>((julianDay + 1) % 7);
+    timeStruct.tm_yday = static_cast<int>(julianDay - AlgBase::convertDateToJulianDay(y, 1, 1));
+}
+
+/// @brief Normalizes struct tm (like mktime() - without time zone) - fields out of range carry over,
+/// day of week and year are set
+static void normalizeTimeStruct(struct tm& timeStruct)
 {
+    long year = timeStruct.tm_year + 1900L + floorDivide(timeStruct.tm_mon, 12);
+    long month = timeStruct.tm_mon - (12 * floorDivide(timeStruct.tm_mon, 12));
+
+    long seconds = (timeStruct.tm_hour * 3600L) + (timeStruct.tm_min * 60L) + timeStruct.tm_sec;
+    long days = AlgBase::convertDateToJulianDay(static_cast<int>(year), static_cast<int>(month + 1), 1)
+        + (timeStruct.tm_mday - 1) + floorDivide(seconds, 86400);
+
+    setTimeStruct(days, seconds - (86400 * floorDivide(seconds, 86400)), timeStruct);
+}
+
+ADateTime::ADateTime(const AContext& context)
+{
+    setContext(context);
     todaysDate(false);
 }
 
@@ -72,11 +106,14 @@ void ADateTime::copyHelper(const ADateTime& ref)
 	m_parsedCorrectly     = ref.m_parsedCorrectly;
 	m_julian              = ref.m_julian;
     m_timeZone            = ref.m_timeZone;
+    m_useDST              = ref.m_useDST;
+    m_zone                = ref.m_zone;
+    m_verboseLevel        = ref.m_verboseLevel;
 	m_parsedDate          = ref.m_parsedDate;
 	m_parsedTime          = ref.m_parsedTime;
 	m_timeStruct          = ref.m_timeStruct;
     m_localTimeStruct     = ref.m_localTimeStruct;
-	m_rawTime             = m_rawTime;
+	m_rawTime             = ref.m_rawTime;
 }
 
 void ADateTime::printASCII() const
@@ -142,9 +179,9 @@ int ADateTime::day() const
 
 void ADateTime::addDays(const int days)
 {
-    time_t baseTime = mktime(&m_timeStruct);
-    baseTime += (days * 86400);
-    m_timeStruct = *gmtime(&baseTime);
+    m_timeStruct.tm_mday += days;
+    m_julian += days;
+    normalizeTimeStruct(m_timeStruct);
     constructDateTimeArray(m_timeStruct, true);
 }
 
@@ -164,15 +201,30 @@ void ADateTime::setVerboseMode(const int level)
     m_verboseLevel = level;
 }
 
+void ADateTime::setContext(const AContext& context)
+{
+    m_verboseLevel = context.dateTimeVerbose;
+    m_timeZone     = context.timeZone;
+    m_useDST       = context.useDST;
+    m_zone         = ATimeZone::fromContext(context);
+}
+
 void ADateTime::todaysDate(const bool bUTC)
 {
     // current date/time based on current system
     m_rawTime = time(nullptr);
 
-    m_timeStruct = *gmtime(&m_rawTime);
+    // UTC from seconds since epoch
+    long seconds = static_cast<long>(m_rawTime);
+    setTimeStruct(JulianDayOfEpoch + floorDivide(seconds, 86400), seconds - (86400 * floorDivide(seconds, 86400)), m_timeStruct);
+    m_timeStruct.tm_isdst = 0;
 
-    setTimeZone();
-    m_localTimeStruct = *localtime(&m_rawTime);
+    // Local time of the system (re-entrant)
+#ifdef WIN32
+    localtime_s(&m_localTimeStruct, &m_rawTime);
+#else
+    localtime_r(&m_rawTime, &m_localTimeStruct);
+#endif
 
     if (bUTC)
     {
@@ -189,20 +241,6 @@ void ADateTime::todaysDate(const bool bUTC)
 	m_parsedCorrectly = true;
 }
 
-void ADateTime::setTimeZone()
-{
-    // Check local time and see if we need to set the DST bit
-    if (m_autoComputeTimeZone)
-    {
-        m_timeZone = m_defaultTimeZone;
-    }
-    else
-    {
-        m_timeZone = m_defaultTimeZone;
-    }
-
-}
-
 bool ADateTime::parseDateTime(const char* ar)
 {
     bool bGoodDate = false;
@@ -247,39 +285,32 @@ bool ADateTime::parseDateTime(const char* ar)
 }
 
 
-bool ADateTime::parseDate(const DateString& arg, ParsedDate& parsedDate)
+bool ADateTime::parseDate(const char* arg, ParsedDate& parsedDate)
 {
     bool isOK{ false };
 
-    char stmp[1024];
-    size_t len = arg.size();
-    strcpy(stmp, arg.c_str());
+    // Fields are read in place - atoi() stops at the delimiter
+    size_t len = strlen(arg);
 
     // Check if we have a YY-MM-DD (dash delimiter) or decimal point (Julian)
-    char* ptr = strchr(stmp, '-');
+    const char* ptr = strchr(arg, '-');
     if (ptr != nullptr)
     {
-        int idx = 0;
-        bool bContainsDelim = false;
         int dateIdx = 0;
-        ptr = stmp;
-        char* startPtr = stmp;
+        const char* startPtr = arg;
 
         // Check if we have a YY-MM-DD (dash delimiter) or decimal point (Julian)
-        for (size_t istr = 0; istr < len; istr++, ptr++)
+        for (size_t istr = 0; istr < len; istr++)
         {
-            if (stmp[istr] == '-')
+            if (arg[istr] == '-')
             {
-                bContainsDelim = true;
-
-                *ptr = '\0';
                 m_parsedDate[dateIdx] = atoi(startPtr);
                 dateIdx++;
 
                 if ((istr + 1) < len)
                 {
                     // If at end, this could throw exception using it
-                    startPtr = ptr + 1;
+                    startPtr = arg + istr + 1;
                     if (dateIdx == 2)
                     {
                         m_parsedDate[dateIdx] = atoi(startPtr);
@@ -298,9 +329,9 @@ bool ADateTime::parseDate(const DateString& arg, ParsedDate& parsedDate)
     }
     else
     {
-        double jd = atof(stmp);
+        double jd = atof(arg);
         setFromJulian(jd);
-        std::cout << "Date (" << stmp << "): " << asString("%c").c_str() << " UTC" << std::endl;
+        std::cout << "Date (" << arg << "): " << asString("%c").c_str() << " UTC" << std::endl;
         isOK = true;
     }
 
@@ -309,21 +340,19 @@ bool ADateTime::parseDate(const DateString& arg, ParsedDate& parsedDate)
     return isOK;
 }
 
-bool ADateTime::parseTime(const std::string& arg)
+bool ADateTime::parseTime(const char* arg)
 {
 	bool isOK{ true };
-	char stmp[1024];
-	size_t len = arg.size();
-	strcpy(stmp, arg.c_str());
 
-	char *p = stmp;
-	char* ptr = strchr(stmp, ':');
+	// Fields are read in place - atoi() stops at ':'
+	const char *p = arg;
+	const char* ptr = strchr(arg, ':');
 
 	if (ptr == nullptr)
 	{
         // Time string has no ":"
 		// Treat the string as number of seconds from midnight
-		uint32_t secs = atoi(stmp);
+		uint32_t secs = atoi(arg);
 		// NOTE use of integer math - floors
 		m_parsedTime.m_Time[2] = secs / 3600;
 		uint32_t tmp = secs % 3600;
@@ -336,7 +365,6 @@ bool ADateTime::parseTime(const std::string& arg)
 	else
 	{
 		// String needs parsing
-		*ptr = '\0';
 		m_parsedTime.m_Time[2] = atoi(p);
 		p = ptr + 1;
 		ptr = strchr(p, ':');
@@ -376,9 +404,9 @@ bool ADateTime::parseTime(const std::string& arg)
 	return true;
 }
 
-bool ADateTime::parseJulianTime(const std::string& arg)
+bool ADateTime::parseJulianTime(const char* arg)
 {
-    double jd = atof(arg.c_str());
+    double jd = atof(arg);
 
     // Set Julian date-time and update this struct
     setJulianDateTime(jd);
@@ -386,6 +414,41 @@ bool ADateTime::parseJulianTime(const std::string& arg)
     return jd != 0;
 }
 
+bool ADateTime::parseInstant(const char* begin, const char* end)
+{
+    ParsedInstant instant;
+    if (!ADateParser::parse(begin, end, instant))
+    {
+        return false;
+    }
+
+    setInstant(instant);
+    return true;
+}
+
+void ADateTime::setInstant(const ParsedInstant& instant)
+{
+    double jd = ADateParser::julian(instant);
+    if (instant.format == InputFormat::Date)
+    {
+        // Same as parseDate() - date only (time is kept)
+        AlgBase::convertJulianToDate(floor(jd + 0.5), m_parsedDate[0], m_parsedDate[1], m_parsedDate[2]);
+        convertDateFromArray(m_parsedDate, m_parsedTime);
+        m_julian = julianDay(true);
+    }
+    else
+    {
+        setJulianDateTime(jd);
+    }
+
+    m_parsedCorrectly = true;
+}
+
+AInstant ADateTime::instant() const
+{
+    return AInstant::fromJulian(m_julian);
+}
+
 bool ADateTime::isParsedDateOk(const ParsedDate& parsed) const
 {
     bool bOk = true;
@@ -438,9 +501,6 @@ bool ADateTime::isParsedDateOk(const ParsedDate& parsed) const
 
 int ADateTime::dayOfYear() const
 {
-#ifdef RECOMPILE_TM
-    mktime(&m_timeStruct);
-#endif
     return m_timeStruct.tm_yday;
 }
 
@@ -496,8 +556,6 @@ void ADateTime::convertDateFromArray(const ParsedDate& parsedDate, const ParsedT
     if (toUtc)
     {
         // Converting local time to UTC
-        mktime(&m_timeStruct);
-
         if (parsedTime.m_24hr)
         {
             m_timeStruct.tm_hour = parsedTime.m_Time[0];
@@ -516,15 +574,12 @@ void ADateTime::convertDateFromArray(const ParsedDate& parsedDate, const ParsedT
 
         m_timeStruct.tm_isdst = 0;
     }
-    else
-    {
-        // Convert to local time
-        mktime(&m_timeStruct);
-    }
+
+    normalizeTimeStruct(m_timeStruct);
 }
 
 
-void ADateTime::convertJulianToTime(const double jd, struct tm& timeOnly)
+void ADateTime::convertJulianToTime(const double jd, struct tm& timeOnly) const
 {
     // Get time while at it
     double dayDecimal = jd - floor(jd);
@@ -675,18 +730,9 @@ double ADateTime::modifiedJuiianDate(const bool addTimeZone) const
 
     double utTime = a + b + static_cast<int>(30.6001 * (m + 1)) + d;
 
-    if (m_verboseLevel & DebugJulianDate)
-    {
-        std::cout << "Modified JD: UTC (midnite) = " << utTime << " using [" << y << "-" << m << "-" << d << "]" << std::endl;
-    }
-
     if (addTimeZone)
     {
         utTime = utTime - (timeZoneAsFractionOfDay());
-        if (m_verboseLevel & DebugJulianDate)
-        {
-            std::cout << "Modified JD (uses local zone) = " << utTime << " using TZ=" << m_timeZone << std::endl;
-        }
     }
 
     return utTime;
@@ -26,6 +26,11 @@
 #include <string>
 #include <array>
 #include <ctime>
+#include <memory>
+
+#include "AContext.h"
+#include "AInstant.h"
+#include "ATimeZone.h"
 
 using ParsedDate = std::array<int, 3>;
 using DateString = std::string;
@@ -52,17 +57,13 @@ using ParsedTime = struct _parsedTime
 
 #endif
 
-/// @brief Constants used for debug levels (m_verboseLevel) - bit fields (except <0)
-constexpr int DebugFullDateTime{1};
-constexpr int DebugJulianDate{2};
-constexpr int DebugComputation{4};
-
 class ADateTime
 {
 public:
 
     /// @brief Constructor to get current date/time
-    ADateTime();
+    /// @param[in] context - time zone, DST and verbose level
+    ADateTime(const AContext& context = DefaultContext);
 
     /// @brief Copy Contructor
     ADateTime(const ADateTime& ref);
@@ -86,16 +87,32 @@ public:
     /// @param[out] parsedDate - Date in an array (YYYY-MM-DD)
     ///
     /// @return bool - true if parsing was good (list is populated)
-    bool parseDate(const DateString& arg, ParsedDate& parsedDate);
+    bool parseDate(const char* arg, ParsedDate& parsedDate);
 
 	/// @brief Parses short time format: HH:MM:SS[a,p]
 	///
 	/// @param[in] arg = time string
 	///
 	/// @return true if time can be converted, false string format is bad
-	bool parseTime(const std::string& arg);
+	bool parseTime(const char* arg);
+
+    bool parseJulianTime(const char* arg);
+
+    /// @brief Parses a date/time range (ISO-8601 with offset, JD, MJD or Unix seconds) with
+    /// ADateParser - nothing is copied. A date without time is set as parseDate() does.
+    ///
+    /// @param[in] begin - first character
+    /// @param[in] end - one past the last character
+    ///
+    /// @return true if the whole range is parsed
+    bool parseInstant(const char* begin, const char* end);
+
+    /// @brief Sets this date-time object to a parsed instant (see parseInstant())
+    /// @param[in] instant - instant from ADateParser
+    void setInstant(const ParsedInstant& instant);
 
-    bool parseJulianTime(const std::string& arg);
+    /// @brief Instant of the Julian date/time of this object - what the computations take
+    AInstant instant() const;
 
     /// @brief Checks if Date and Time are parsed correctly.
     /// @return true if this instance of ParsedDate and ParsedTime are set correctly
@@ -113,7 +130,7 @@ public:
     void todaysDate(const bool bUTC = false);
 
     /// @brief Converts Julian decimal into time struct
-    void convertJulianToTime(const double jd, struct tm& timeOnly);
+    void convertJulianToTime(const double jd, struct tm& timeOnly) const;
 
     /// @brief Sets Date struct from Julian calendar
     void setFromJulian(const double& jd);
@@ -137,6 +154,10 @@ public:
     /// @param[in] level - 0=quiet(results only) non-zero(prints debug info)
     void setVerboseMode(const int level);
 
+    /// @brief Sets time zone, DST and verbose level from context
+    /// @param[in] context - settings of the request
+    void setContext(const AContext& context);
+
     //--------------------------------------------------------------------------
     // Accessors
     //--------------------------------------------------------------------------
@@ -163,6 +184,9 @@ public:
 
     double timeZoneAsFractionOfDay() const;
 
+    /// @brief Time zone of the context (name, or offset and DST) - e.g. zone()->localMidnight()
+    const std::shared_ptr<const ATimeZone>& zone() const { return m_zone; }
+
 
     /// @brief Set this date-time object to Julian date/time.
     /// @param[in] jd - Julian date to convert this object
@@ -193,28 +217,10 @@ public:
 
     double j2000Noon() const;
 
-	/// @brief Verbose level of 0 - is quiet mode
-	static int    m_verboseLevel;
-
-    /// @brief Default time zone if time-zone is not computed directly.
-    /// NOTE: this should be in ALocation, but that's for later
-    static double m_defaultTimeZone;
-
-    /// @brief Location uses DST - onset/offset month, week number, weekday.
-    /// NOTE: this should be in ALocation, but that's for later
-    static bool   m_useDST;
-
-	//--- Date Members ---
-    /// @brief default use of time-zone computation
-    static bool m_autoComputeTimeZone;
-
 private:
     /// @brief Copies internals for copy constructor and assignment operator
     void copyHelper(const ADateTime& ref);
 
-    /// @brief Computes DST and time zone from longitude (if automatic)
-    void setTimeZone();
-
     /// @brief Sets Year, Month, Day - returns remaining Time as double.
     /// @param[in] jd - Julian Date
     /// @param[out] parsedDate - converted from Julian date
@@ -257,8 +263,19 @@ private:
 	/// @brief Parsed correctly and needs to nodification
 	bool       m_parsedCorrectly;
 
-    /// @brief Computed, if not automatically, from longitude and struct tm
+    /// @brief Time zone - hours from UTC (standard time)
+    /// NOTE: this should be in ALocation, but that's for later
     double     m_timeZone;
 
+    /// @brief Location uses DST - onset/offset month, week number, weekday.
+    /// NOTE: this should be in ALocation, but that's for later
+    bool       m_useDST;
+
+    /// @brief Time zone of the context (shared, read only) - local days
+    std::shared_ptr<const ATimeZone> m_zone;
+
+	/// @brief Verbose level of 0 - is quiet mode
+	int        m_verboseLevel;
+
 };
 
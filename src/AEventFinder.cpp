@@ -0,0 +1,426 @@
+/// @file
+///
+/// @brief AEventFinder class implementation.
+///
+/// @copyright 2019-2020 M.Mashimo and licensors. All Right Reserved.
+///
+/// This file is part of cMoon application.
+///
+/// cMoon is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// any later version.
+///
+/// cMoon is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with cMoon.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <algorithm>
+#include <limits>
+
+#include "AEventFinder.h"
+
+/// @brief Iterations of the refinements - not reached (Brent's method halves the bracket at worst)
+static constexpr int MaxIterations{100};
+
+/// @brief Step past the crossing predicted from the current rate (fraction of the time to it)
+static constexpr double PredictedStep{1.2};
+
+/// @brief Golden section of Brent's minimization
+static constexpr double GoldenSection{0.3819660};
+
+AEventFinder::AEventFinder(const AltitudeFunction& altitude, const double maxRate)
+	: m_altitude(altitude)
+	, m_maxRate(maxRate)
+	, m_tolerance(5e-6)
+	, m_minStep(1. / 32.)
+	, m_maxStep(1. / 4.)
+	, m_resolution(1. / 1440.)
+	, m_horizons(nullptr)
+	, m_culminations(false)
+	, m_startValue(0.)
+	, m_evaluations(0)
+	, m_points(0)
+	, m_pointMjd{0., 0.}
+	, m_pointValue{0., 0.}
+	, m_callback(nullptr)
+	, m_found(0)
+{
+	// Nothing here
+}
+
+void AEventFinder::setTolerance(const double days)
+{
+	m_tolerance = days;
+}
+
+void AEventFinder::setSteps(const double minStep, const double maxStep, const double resolution)
+{
+	m_minStep = minStep;
+	m_maxStep = maxStep;
+	m_resolution = resolution;
+}
+
+double AEventFinder::maxRate(const double latitude, const double hourAngleRate, const double decRate)
+{
+	// d(sin h)/dt = -cos(lat) cos(dec) sin(H) dH/dt + (sin(lat) cos(dec) - cos(lat) sin(dec) cos(H)) d(dec)/dt
+	return (cos(latitude * (M_PI / 180.)) * hourAngleRate) + decRate;
+}
+
+double AEventFinder::evaluate(const double mjd)
+{
+	m_evaluations++;
+	return m_altitude(mjd);
+}
+
+int AEventFinder::find(const double mjdStart, const double mjdEnd, const std::vector<double>& sinHorizons,
+	const bool culminations, const AltitudeEventCallback& callback)
+{
+	m_horizons = &sinHorizons;
+	m_culminations = culminations;
+	m_callback = &callback;
+	m_evaluations = 0;
+	m_points = 0;
+	m_found = 0;
+	m_pending.clear();
+
+	double a = mjdStart;
+	double fa = evaluate(a);
+	m_startValue = fa;
+	addPoint(a, fa);
+
+	while (a < mjdEnd)
+	{
+		// No horizon can be reached before distance / rate
+		double distance = std::numeric_limits<double>::max();
+		for (double horizon : sinHorizons)
+		{
+			distance = std::min(distance, fabs(fa - horizon));
+		}
+
+		double step = std::max(m_minStep, distance / m_maxRate);
+
+		// A little past the nearest crossing at the current rate - tight brackets (checked by scan())
+		if (m_points >= 2)
+		{
+			double rate = (fa - m_pointValue[0]) / (a - m_pointMjd[0]);
+			double nearest = m_maxStep;
+			for (double horizon : sinHorizons)
+			{
+				double time = (horizon - fa) / rate;
+				if (time > 0.)
+				{
+					nearest = std::min(nearest, time);
+				}
+			}
+			step = std::max(step, PredictedStep * nearest);
+		}
+		step = std::min(m_maxStep, step);
+		double b = std::min(a + step, mjdEnd);
+		double fb = evaluate(b);
+
+		scan(a, fa, b, fb);
+
+		a = b;
+		fa = fb;
+	}
+
+	flush(std::numeric_limits<double>::max());
+	m_callback = nullptr;
+
+	return m_found;
+}
+
+void AEventFinder::scan(const double a, const double fa, const double b, const double fb)
+{
+	const std::vector<double>& horizons = *m_horizons;
+
+	// Both ends on one side: crossing and returning needs at least (|fa - h| + |fb - h|) / rate
+	if ((b - a) > m_resolution)
+	{
+		for (double horizon : horizons)
+		{
+			double ga = fa - horizon;
+			double gb = fb - horizon;
+			if (((ga > 0.) == (gb > 0.)) && ((fabs(ga) + fabs(gb)) <= (m_maxRate * (b - a))))
+			{
+				double m = 0.5 * (a + b);
+				double fm = evaluate(m);
+				scan(a, fa, m, fm);
+				scan(m, fm, b, fb);
+				return;
+			}
+		}
+	}
+
+	for (size_t i = 0; i < horizons.size(); i++)
+	{
+		double ga = fa - horizons[i];
+		double gb = fb - horizons[i];
+		if ((ga > 0.) != (gb > 0.))
+		{
+			AltitudeEvent event{(gb > 0.) ? AltitudeEventType::Rise : AltitudeEventType::Set, static_cast<int>(i), 0., horizons[i]};
+			event.mjd = findRoot(a, fa, b, fb, horizons[i]);
+			m_pending.push_back(event);
+		}
+	}
+
+	addPoint(b, fb);
+}
+
+void AEventFinder::addPoint(const double mjd, const double value)
+{
+	if (m_culminations && (m_points >= 2))
+	{
+		// Middle point higher (lower) than both neighbors - extremum between them
+		const double* x = m_pointMjd;
+		const double* y = m_pointValue;
+		double sign = 0.;
+		if ((y[1] > y[0]) && (y[1] >= value))
+		{
+			sign = 1.;
+		}
+		else if ((y[1] < y[0]) && (y[1] <= value))
+		{
+			sign = -1.;
+		}
+
+		if (sign != 0.)
+		{
+			AltitudeEvent event{(sign > 0.) ? AltitudeEventType::Transit : AltitudeEventType::LowerTransit, -1, 0., 0.};
+			event.mjd = findExtremum(x[0], x[1], mjd, y[1], sign, event.sinAltitude);
+			m_pending.push_back(event);
+		}
+	}
+
+	m_pointMjd[0] = m_pointMjd[1];
+	m_pointValue[0] = m_pointValue[1];
+	m_pointMjd[1] = mjd;
+	m_pointValue[1] = value;
+	m_points++;
+
+	// Events found later are after the older point
+	flush((m_points >= 2) ? m_pointMjd[0] : mjd);
+}
+
+double AEventFinder::findRoot(const double a, const double fa, const double b, const double fb, const double horizon)
+{
+	// Offsets from a - precision of the times is not lost to the date
+	double xa = 0.;
+	double xb = b - a;
+	double xc = xb;
+	double ya = fa - horizon;
+	double yb = fb - horizon;
+	double yc = yb;
+	double d = xb;
+	double e = d;
+	const double tol = 0.5 * m_tolerance;
+
+	for (int iteration = 0; iteration < MaxIterations; iteration++)
+	{
+		if (((yb > 0.) && (yc > 0.)) || ((yb < 0.) && (yc < 0.)))
+		{
+			// Bracket is b and a
+			xc = xa;
+			yc = ya;
+			d = xb - xa;
+			e = d;
+		}
+		if (fabs(yc) < fabs(yb))
+		{
+			// b is the best estimate
+			xa = xb;
+			xb = xc;
+			xc = xa;
+			ya = yb;
+			yb = yc;
+			yc = ya;
+		}
+
+		double xm = 0.5 * (xc - xb);
+		if ((fabs(xm) <= tol) || (yb == 0.))
+		{
+			break;
+		}
+
+		if ((fabs(e) >= tol) && (fabs(ya) > fabs(yb)))
+		{
+			// Inverse quadratic interpolation (secant if only two points)
+			double p, q;
+			double s = yb / ya;
+			if (xa == xc)
+			{
+				p = 2. * xm * s;
+				q = 1. - s;
+			}
+			else
+			{
+				double qa = ya / yc;
+				double r = yb / yc;
+				p = s * ((2. * xm * qa * (qa - r)) - ((xb - xa) * (r - 1.)));
+				q = (qa - 1.) * (r - 1.) * (s - 1.);
+			}
+			if (p > 0.)
+			{
+				q = -q;
+			}
+			p = fabs(p);
+
+			if ((2. * p) < std::min((3. * xm * q) - fabs(tol * q), fabs(e * q)))
+			{
+				e = d;
+				d = p / q;
+			}
+			else
+			{
+				// Interpolation too slow - bisection
+				d = xm;
+				e = d;
+			}
+		}
+		else
+		{
+			d = xm;
+			e = d;
+		}
+
+		xa = xb;
+		ya = yb;
+		xb += (fabs(d) > tol) ? d : ((xm > 0.) ? tol : -tol);
+		yb = evaluate(a + xb) - horizon;
+	}
+
+	return a + xb;
+}
+
+double AEventFinder::findExtremum(const double a, const double b, const double c, const double fb, const double sign, double& value)
+{
+	// Minimum of -sign * altitude - offsets from a
+	double lo = 0.;
+	double hi = c - a;
+	double x = b - a;
+	double w = x;
+	double v = x;
+	double fx = -sign * fb;
+	double fw = fx;
+	double fv = fx;
+	double d = 0.;
+	double e = 0.;
+	const double tol = 0.5 * m_tolerance;
+
+	for (int iteration = 0; iteration < MaxIterations; iteration++)
+	{
+		double xm = 0.5 * (lo + hi);
+		if (fabs(x - xm) <= ((2. * tol) - (0.5 * (hi - lo))))
+		{
+			break;
+		}
+
+		if (fabs(e) > tol)
+		{
+			// Parabola through x, w and v
+			double r = (x - w) * (fx - fv);
+			double q = (x - v) * (fx - fw);
+			double p = ((x - v) * q) - ((x - w) * r);
+			q = 2. * (q - r);
+			if (q > 0.)
+			{
+				p = -p;
+			}
+			q = fabs(q);
+			double previous = e;
+			e = d;
+
+			if ((fabs(p) >= fabs(0.5 * q * previous)) || (p <= (q * (lo - x))) || (p >= (q * (hi - x))))
+			{
+				e = (x >= xm) ? (lo - x) : (hi - x);
+				d = GoldenSection * e;
+			}
+			else
+			{
+				d = p / q;
+				double u = x + d;
+				if (((u - lo) < (2. * tol)) || ((hi - u) < (2. * tol)))
+				{
+					d = copysign(tol, xm - x);
+				}
+			}
+		}
+		else
+		{
+			e = (x >= xm) ? (lo - x) : (hi - x);
+			d = GoldenSection * e;
+		}
+
+		double u = (fabs(d) >= tol) ? (x + d) : (x + copysign(tol, d));
+		double fu = -sign * evaluate(a + u);
+
+		if (fu <= fx)
+		{
+			if (u >= x)
+			{
+				lo = x;
+			}
+			else
+			{
+				hi = x;
+			}
+			v = w;
+			w = x;
+			x = u;
+			fv = fw;
+			fw = fx;
+			fx = fu;
+		}
+		else
+		{
+			if (u < x)
+			{
+				lo = u;
+			}
+			else
+			{
+				hi = u;
+			}
+			if ((fu <= fw) || (w == x))
+			{
+				v = w;
+				w = u;
+				fv = fw;
+				fw = fu;
+			}
+			else if ((fu <= fv) || (v == x) || (v == w))
+			{
+				v = u;
+				fv = fu;
+			}
+		}
+	}
+
+	value = -sign * fx;
+	return a + x;
+}
+
+void AEventFinder::flush(const double mjd)
+{
+	if (m_pending.empty())
+	{
+		return;
+	}
+
+	std::sort(m_pending.begin(), m_pending.end(),
+		[](const AltitudeEvent& a, const AltitudeEvent& b) { return a.mjd < b.mjd; });
+
+	size_t count = 0;
+	while ((count < m_pending.size()) && (m_pending[count].mjd < mjd))
+	{
+		(*m_callback)(m_pending[count]);
+		m_found++;
+		count++;
+	}
+	m_pending.erase(m_pending.begin(), m_pending.begin() + count);
+}
@@ -0,0 +1,144 @@
+/// @file
+///
+/// @brief AEventFinder class definitions.
+///
+/// AEventFinder finds horizon crossings (rise/set) and culminations (transits)
+/// of any altitude function of time. Crossings are bracketed with a bound on the
+/// rate of the sine of the altitude: a body at distance d from the nearest
+/// horizon cannot reach it in less than d / rate, so steps are long far from the
+/// horizons and no crossing is missed - an interval whose ends are both on one
+/// side is searched further only if the bound allows a crossing and a return
+/// within it. Brackets are refined with Brent's method (bisection safeguarded
+/// inverse quadratic interpolation), culminations with Brent's minimization.
+///
+/// @copyright 2019-2020 M.Mashimo and licensors. All Right Reserved.
+///
+/// This file is part of cMoon application.
+///
+/// cMoon is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// any later version.
+///
+/// cMoon is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with cMoon.  If not, see <https://www.gnu.org/licenses/>.
+///
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+/// @brief Rotation of the Earth relative to the equinox (radians per day)
+constexpr double SiderealRate{2. * M_PI * 1.00273790935};
+
+/// @brief Type of an event found by AEventFinder
+enum class AltitudeEventType : int
+{
+	Rise = 0,       // crosses a horizon upward
+	Set,            // crosses a horizon downward
+	Transit,        // upper culmination - highest altitude
+	LowerTransit    // lower culmination - lowest altitude
+};
+
+/// @brief Event found by AEventFinder
+using AltitudeEvent = struct structAltitudeEvent
+{
+	AltitudeEventType type;
+	int               horizon;       // index of the horizon crossed (-1 - culmination)
+	double            mjd;           // modified Julian date (UTC) of the event
+	double            sinAltitude;   // sine of the altitude at the event
+};
+
+/// @brief Sine of the altitude of a body at a modified Julian date (UTC)
+using AltitudeFunction = std::function<double(const double mjd)>;
+
+/// @brief Receives events in time order
+using AltitudeEventCallback = std::function<void(const AltitudeEvent&)>;
+
+
+class AEventFinder
+{
+public:
+	/// @brief Constructor
+	/// @param[in] altitude - sine of the altitude of the body
+	/// @param[in] maxRate - bound of the rate of the sine of the altitude (per day - see maxRate())
+	AEventFinder(const AltitudeFunction& altitude, const double maxRate);
+
+	/// @brief Sets the precision of the events (days - default 5e-6, about 0.4 seconds)
+	void setTolerance(const double days);
+
+	/// @brief Sets the steps of the bracketing (days)
+	/// @param[in] minStep - shortest step near a horizon (default 1/32)
+	/// @param[in] maxStep - longest step far from the horizons (default 1/4 - culminations need 4 steps a day)
+	/// @param[in] resolution - shortest interval searched for a crossing and a return (default 1/1440)
+	void setSteps(const double minStep, const double maxStep, const double resolution);
+
+	/// @brief Finds the events of a time span
+	/// @param[in] mjdStart - modified Julian date (UTC) to start
+	/// @param[in] mjdEnd - modified Julian date (UTC) to end
+	/// @param[in] sinHorizons - sines of the altitudes of the horizons to find crossings for
+	/// @param[in] culminations - also finds transits and lower transits
+	/// @param[in] callback - called for each event (in time order)
+	/// @return number of events found
+	int find(const double mjdStart, const double mjdEnd, const std::vector<double>& sinHorizons,
+		const bool culminations, const AltitudeEventCallback& callback);
+
+	/// @brief Sine of the altitude at the start of the last find()
+	double sinAltitudeAtStart() const { return m_startValue; }
+
+	/// @brief Number of evaluations of the altitude function by the last find()
+	long evaluations() const { return m_evaluations; }
+
+	/// @brief Bound of the rate of the sine of the altitude of a body (per day)
+	/// @param[in] latitude - of the observer (degrees)
+	/// @param[in] hourAngleRate - largest rate of the hour angle of the body (radians per day - e.g. SiderealRate)
+	/// @param[in] decRate - largest rate of the declination of the body (radians per day)
+	static double maxRate(const double latitude, const double hourAngleRate, const double decRate);
+
+private:
+	/// @brief Altitude function at a time (counts evaluations)
+	double evaluate(const double mjd);
+
+	/// @brief Searches an interval (values at both ends known) - sub-divides where the bound allows hidden crossings
+	void scan(const double a, const double fa, const double b, const double fb);
+
+	/// @brief Takes the next point in time order - culminations of the last three points
+	void addPoint(const double mjd, const double value);
+
+	/// @brief Time of a crossing of a horizon bracketed by a and b (Brent's method)
+	double findRoot(const double a, const double fa, const double b, const double fb, const double horizon);
+
+	/// @brief Time of an extremum bracketed by a < b < c (Brent's minimization) - sign 1 maximum, -1 minimum
+	double findExtremum(const double a, const double b, const double c, const double fb, const double sign, double& value);
+
+	/// @brief Passes events before a time to the callback (in time order)
+	void flush(const double mjd);
+
+	AltitudeFunction m_altitude;
+	double m_maxRate;
+
+	double m_tolerance;
+	double m_minStep;
+	double m_maxStep;
+	double m_resolution;
+
+	// State of find()
+	const std::vector<double>* m_horizons;
+	bool   m_culminations;
+	double m_startValue;
+	long   m_evaluations;
+	int    m_points;
+	double m_pointMjd[2];
+	double m_pointValue[2];
+	std::vector<AltitudeEvent> m_pending;
+	const AltitudeEventCallback* m_callback;
+	int    m_found;
+};
@@ -0,0 +1,73 @@
+/// @file
+///
+/// @brief AInstant class implementation.
+///
+/// @copyright 2019-2020 M.Mashimo and licensors. All Right Reserved.
+///
+/// This file is part of cMoon application.
+///
+/// cMoon is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// any later version.
+///
+/// cMoon is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with cMoon.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <cmath>
+
+#include "AInstant.h"
+#include "AlgBase.h"
+
+/// @brief Days of a Julian year
+static constexpr double DaysPerYear{365.25};
+
+AInstant AInstant::fromDate(const int year, const int month, const int day, const int64_t timeOfDay)
+{
+	long jdn = AlgBase::convertDateToJulianDay(year, month, day);
+	return AInstant(((jdn - static_cast<long>(JulianDateOfTickZero)) * TicksPerDay) - (TicksPerDay / 2) + timeOfDay);
+}
+
+AInstant AInstant::fromJulianTT(const double jde)
+{
+	// deltaT changes by less than a second a year - one step is enough
+	AInstant instant = fromJulian(jde);
+	return instant.plusSeconds(-instant.deltaT());
+}
+
+double AInstant::deltaT() const
+{
+	return AlgBase::deltaT(2000. + (j2000() / DaysPerYear));
+}
+
+AInstant AInstant::localMidnight(const double timeZone) const
+{
+	return AInstant(midnight().m_ticks - llround(timeZone * 3600. * TicksPerSecond));
+}
+
+void AInstant::date(int& year, int& month, int& day) const
+{
+	AlgBase::convertJulianToDate(static_cast<double>(julianDayNumber()), year, month, day);
+}
+
+int AInstant::year() const
+{
+	int year, month, day;
+	date(year, month, day);
+	return year;
+}
+
+AInstant AInstant::plusDays(const double days) const
+{
+	return AInstant(m_ticks + llround(days * TicksPerDay));
+}
+
+AInstant AInstant::plusSeconds(const double seconds) const
+{
+	return AInstant(m_ticks + llround(seconds * TicksPerSecond));
+}
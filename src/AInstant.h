@@ -0,0 +1,184 @@
+/// @file
+///
+/// @brief AInstant class definitions.
+///
+/// AInstant is the instant (UTC) the computations take: microseconds since
+/// J2000.0 (JD 2451545.0) in one int64 - 8 bytes, trivially copyable, passed
+/// by value. ADateTime remains the parsing and formatting front end
+/// (ADateTime::instant()); ADateParser produces the same ticks.
+///
+/// @copyright 2019-2020 M.Mashimo and licensors. All Right Reserved.
+///
+/// This file is part of cMoon application.
+///
+/// cMoon is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// any later version.
+///
+/// cMoon is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with cMoon.  If not, see <https://www.gnu.org/licenses/>.
+///
+
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+#include "ADateParser.h"
+
+/// @brief Julian date of modified Julian date 0 (1858-11-17 00:00 UTC)
+constexpr double ModifiedJulianOffset{2400000.5};
+
+class AInstant
+{
+public:
+	/// @brief J2000.0 (2000-01-01 12:00 UTC)
+	AInstant() = default;
+
+	/// @brief Instant of ticks since J2000.0 (see ADateParser)
+	constexpr explicit AInstant(const int64_t ticks) : m_ticks(ticks) {}
+
+	/// @brief Instant of a Julian date (UTC) - rounded to the tick
+	static AInstant fromJulian(const double jd)
+	{
+		return AInstant(ADateParser::ticksFromJulian(jd));
+	}
+
+	/// @brief Instant of a modified Julian date (UTC)
+	static AInstant fromModifiedJulian(const double mjd)
+	{
+		return fromJulian(mjd + ModifiedJulianOffset);
+	}
+
+	/// @brief Instant of a parsed input
+	static AInstant fromParsed(const ParsedInstant& parsed)
+	{
+		return AInstant(parsed.ticks);
+	}
+
+	/// @brief Instant of a date (UTC) and time of day
+	/// @param[in] year, month, day - Gregorian date
+	/// @param[in] timeOfDay - ticks since midnight
+	static AInstant fromDate(const int year, const int month, const int day, const int64_t timeOfDay = 0);
+
+	/// @brief Instant (UT) of a Julian ephemeris date (TT) - see deltaT()
+	static AInstant fromJulianTT(const double jde);
+
+	//--------------------------------------------------------------------------
+	// Time scales
+	//--------------------------------------------------------------------------
+
+	int64_t ticks() const
+	{
+		return m_ticks;
+	}
+
+	/// @brief Julian date (UTC)
+	double julian() const
+	{
+		return JulianDateOfTickZero + (static_cast<double>(m_ticks) / TicksPerDay);
+	}
+
+	/// @brief Modified Julian date (UTC)
+	double modifiedJulian() const
+	{
+		return (JulianDateOfTickZero - ModifiedJulianOffset) + (static_cast<double>(m_ticks) / TicksPerDay);
+	}
+
+	/// @brief Days since J2000.0 (UTC)
+	double j2000() const
+	{
+		return static_cast<double>(m_ticks) / TicksPerDay;
+	}
+
+	/// @brief Julian ephemeris date (TT = UT + deltaT)
+	double julianTT() const
+	{
+		return julian() + (deltaT() / 86400.);
+	}
+
+	/// @brief TT - UT in seconds (AlgBase::deltaT of the decimal year)
+	double deltaT() const;
+
+	//--------------------------------------------------------------------------
+	// Calendar (UTC)
+	//--------------------------------------------------------------------------
+
+	/// @brief Julian day number of the date
+	long julianDayNumber() const
+	{
+		return static_cast<long>(floorDays(m_ticks + (TicksPerDay / 2))) + static_cast<long>(JulianDateOfTickZero);
+	}
+
+	/// @brief Midnight (00:00 UTC) of the date
+	AInstant midnight() const
+	{
+		return AInstant((floorDays(m_ticks + (TicksPerDay / 2)) * TicksPerDay) - (TicksPerDay / 2));
+	}
+
+	/// @brief Local midnight of the date (UTC date) in a time zone - see ADateTime::modifiedJuiianDate(true)
+	/// @param[in] timeZone - hours from UTC
+	AInstant localMidnight(const double timeZone) const;
+
+	/// @brief Ticks since midnight (UTC)
+	int64_t timeOfDay() const
+	{
+		return m_ticks - midnight().m_ticks;
+	}
+
+	/// @brief Gregorian date
+	void date(int& year, int& month, int& day) const;
+
+	int year() const;
+
+	//--------------------------------------------------------------------------
+	// Arithmetic
+	//--------------------------------------------------------------------------
+
+	AInstant plusDays(const double days) const;
+
+	AInstant plusSeconds(const double seconds) const;
+
+	AInstant& operator+=(const int64_t ticks)
+	{
+		m_ticks += ticks;
+		return *this;
+	}
+
+	AInstant& operator-=(const int64_t ticks)
+	{
+		m_ticks -= ticks;
+		return *this;
+	}
+
+	friend AInstant operator+(const AInstant instant, const int64_t ticks) { return AInstant(instant.m_ticks + ticks); }
+	friend AInstant operator-(const AInstant instant, const int64_t ticks) { return AInstant(instant.m_ticks - ticks); }
+
+	/// @brief Ticks between instants
+	friend int64_t operator-(const AInstant a, const AInstant b) { return a.m_ticks - b.m_ticks; }
+
+	friend bool operator==(const AInstant a, const AInstant b) { return a.m_ticks == b.m_ticks; }
+	friend bool operator!=(const AInstant a, const AInstant b) { return a.m_ticks != b.m_ticks; }
+	friend bool operator<(const AInstant a, const AInstant b)  { return a.m_ticks < b.m_ticks; }
+	friend bool operator<=(const AInstant a, const AInstant b) { return a.m_ticks <= b.m_ticks; }
+	friend bool operator>(const AInstant a, const AInstant b)  { return a.m_ticks > b.m_ticks; }
+	friend bool operator>=(const AInstant a, const AInstant b) { return a.m_ticks >= b.m_ticks; }
+
+private:
+	/// @brief Whole days of ticks (rounded down)
+	static int64_t floorDays(const int64_t ticks)
+	{
+		return (ticks >= 0) ? (ticks / TicksPerDay) : -((-ticks + TicksPerDay - 1) / TicksPerDay);
+	}
+
+	int64_t m_ticks{0};
+};
+
+static_assert(sizeof(AInstant) == 8, "AInstant is one int64");
+static_assert(std::is_trivially_copyable<AInstant>::value, "AInstant is copied by value");
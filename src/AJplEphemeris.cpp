@@ -0,0 +1,554 @@
+/// @file
+///
+/// @brief AJplEphemeris class implementation.
+///
+/// @copyright 2019-2020 M.Mashimo and licensors. All Right Reserved.
+///
+/// This file is part of cMoon application.
+///
+/// cMoon is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// any later version.
+///
+/// cMoon is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with cMoon.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+
+#include "AChebyshev.h"
+#include "AInstant.h"
+#include "AJplEphemeris.h"
+
+/// @brief Julian date of J2000.0 - time argument 0 of SPK kernels
+static constexpr double J2000Epoch{2451545.};
+
+/// @brief Astronomical unit of SPK kernels (km - IAU 2012)
+static constexpr double SpkAstronomicalUnit{149597870.7};
+
+/// @brief Speed of light (km per day)
+static constexpr double LightKmPerDay{299792.458 * 86400.};
+
+/// @brief Obliquity of the ecliptic at J2000.0 (IAU 1976 - 84381.448")
+static constexpr double J2000Obliquity{84381.448 / 3600. * M_PI / 180.};
+
+//------------------------------------------------------------------------------
+// JPL binary file - record 1 (header) as written by asc2eph
+//------------------------------------------------------------------------------
+static constexpr size_t BinarySpan{2652};            // SS - start, end and length of records (JD)
+static constexpr size_t BinaryConstantCount{2676};   // NCON
+static constexpr size_t BinaryAu{2680};
+static constexpr size_t BinaryEmrat{2688};
+static constexpr size_t BinaryPointers{2696};        // IPT - offset, coefficients and sub-intervals of 12 items
+static constexpr size_t BinaryNumber{2840};          // NUMDE
+static constexpr size_t BinaryLibrations{2844};      // IPT of the librations
+static constexpr size_t BinaryHeaderSize{2856};
+
+/// @brief Bodies of the JPL binary series (Mercury to Sun) - NAIF id and center
+static const int s_binaryTargets[11][2]
+{
+	{1, SolarSystemBarycenter}, {2, SolarSystemBarycenter}, {EarthMoonBarycenter, SolarSystemBarycenter},
+	{4, SolarSystemBarycenter}, {5, SolarSystemBarycenter}, {6, SolarSystemBarycenter},
+	{7, SolarSystemBarycenter}, {8, SolarSystemBarycenter}, {9, SolarSystemBarycenter},
+	{JplMoon, JplEarth}, {JplSun, SolarSystemBarycenter}
+};
+
+//------------------------------------------------------------------------------
+// SPK kernel - DAF file record and summaries
+//------------------------------------------------------------------------------
+static constexpr size_t DafRecordSize{1024};
+static constexpr size_t DafSummaryCount{8};      // ND
+static constexpr size_t DafIntegerCount{12};     // NI
+static constexpr size_t DafForward{76};          // FWARD - first summary record
+static constexpr size_t DafFormat{88};           // LOCFMT
+
+/// @brief Reference frame of planetary ephemerides (J2000 - ICRF)
+static constexpr int32_t SpkFrameJ2000{1};
+
+/// @brief Most summary records read (a broken chain of records ends the file)
+static constexpr int MaxSummaryRecords{10000};
+
+static bool hostIsLittleEndian()
+{
+	const uint16_t probe{1};
+	return *reinterpret_cast<const uint8_t*>(&probe) == 1;
+}
+
+static int32_t swap32(const int32_t value)
+{
+	uint32_t u = static_cast<uint32_t>(value);
+	u = ((u & 0xFF) << 24) | ((u & 0xFF00) << 8) | ((u >> 8) & 0xFF00) | (u >> 24);
+	return static_cast<int32_t>(u);
+}
+
+static double swap64(const double value)
+{
+	uint8_t bytes[8];
+	memcpy(bytes, &value, sizeof(bytes));
+	std::reverse(bytes, bytes + 8);
+	double swapped;
+	memcpy(&swapped, bytes, sizeof(swapped));
+	return swapped;
+}
+
+static int32_t readInt(const void* map, const size_t offset, const bool swapped)
+{
+	int32_t value;
+	memcpy(&value, static_cast<const char*>(map) + offset, sizeof(value));
+	return swapped ? swap32(value) : value;
+}
+
+static double readDouble(const void* map, const size_t offset, const bool swapped)
+{
+	double value;
+	memcpy(&value, static_cast<const char*>(map) + offset, sizeof(value));
+	return swapped ? swap64(value) : value;
+}
+
+
+AJplEphemeris::AJplEphemeris()
+	: m_swapped(false)
+	, m_number(0)
+	, m_jdStart(0.)
+	, m_jdEnd(0.)
+	, m_au(SpkAstronomicalUnit)
+	, m_emrat(0.)
+{
+	// Intentionally left blank
+}
+
+AJplEphemeris::~AJplEphemeris()
+{
+	close();
+}
+
+bool AJplEphemeris::open(const std::string& path)
+{
+	close();
+
+	if (!m_file.open(path, DafRecordSize))
+	{
+		return false;
+	}
+
+	// SPK kernels start with their DAF id - anything else has to be a JPL binary file
+	bool valid = ((memcmp(m_file.data(), "DAF/SPK", 7) == 0) || (memcmp(m_file.data(), "NAIF/DAF", 8) == 0)) ? openSpk() : openBinary();
+
+	// The Earth, the Moon and the Sun are needed of any planet position
+	double position[3];
+	double middle = (m_jdStart + m_jdEnd) / 2.;
+	valid = valid && (m_jdStart < m_jdEnd) && barycentric(JplEarth, middle, position) && barycentric(JplSun, middle, position)
+		&& barycentric(JplMoon, middle, position);
+
+	if (!valid)
+	{
+		close();
+	}
+	return valid;
+}
+
+void AJplEphemeris::close()
+{
+	m_file.close();
+	m_swapped = false;
+	m_number = 0;
+	m_jdStart = 0.;
+	m_jdEnd = 0.;
+	m_au = SpkAstronomicalUnit;
+	m_emrat = 0.;
+	m_series.clear();
+}
+
+bool AJplEphemeris::openBinary()
+{
+	if (m_file.size() < BinaryHeaderSize)
+	{
+		return false;
+	}
+
+	// Byte order of the file - ephemeris number is small either way
+	int32_t number = readInt(m_file.data(), BinaryNumber, false);
+	m_swapped = (number <= 0) || (number > 9999);
+	number = readInt(m_file.data(), BinaryNumber, m_swapped);
+	if ((number <= 0) || (number > 9999))
+	{
+		return false;
+	}
+
+	double start = readDouble(m_file.data(), BinarySpan, m_swapped);
+	double end = readDouble(m_file.data(), BinarySpan + sizeof(double), m_swapped);
+	double span = readDouble(m_file.data(), BinarySpan + (2 * sizeof(double)), m_swapped);
+	int32_t constants = readInt(m_file.data(), BinaryConstantCount, m_swapped);
+	m_au = readDouble(m_file.data(), BinaryAu, m_swapped);
+	m_emrat = readDouble(m_file.data(), BinaryEmrat, m_swapped);
+	if ((span <= 0.) || (end <= start) || (constants < 0) || (m_au <= 0.) || (m_emrat <= 0.))
+	{
+		return false;
+	}
+
+	// Pointers of the 11 bodies, nutations (2 components) and librations
+	int32_t pointers[13][3];
+	for (int item = 0; item < 13; item++)
+	{
+		size_t offset = (item < 12) ? (BinaryPointers + (item * 3 * sizeof(int32_t))) : BinaryLibrations;
+		for (int k = 0; k < 3; k++)
+		{
+			pointers[item][k] = readInt(m_file.data(), offset + (k * sizeof(int32_t)), m_swapped);
+		}
+	}
+
+	// Doubles of a record - end of the last item (items past the librations follow the names of
+	// constants beyond 400 and do not end records of planetary ephemerides)
+	int64_t recordSize = 0;
+	for (int item = 0; item < 13; item++)
+	{
+		int64_t components = (item == 11) ? 2 : 3;
+		if ((pointers[item][1] < 0) || (pointers[item][2] < 0))
+		{
+			return false;
+		}
+		recordSize = std::max(recordSize, pointers[item][0] - 1 + (components * pointers[item][1] * pointers[item][2]));
+	}
+	if (constants > 400)
+	{
+		size_t extra = BinaryHeaderSize + ((constants - 400) * 6);
+		for (int item = 0; (item < 2) && ((extra + (3 * sizeof(int32_t))) <= m_file.size()); item++, extra += 3 * sizeof(int32_t))
+		{
+			int64_t offset = readInt(m_file.data(), extra, m_swapped);
+			int64_t count = readInt(m_file.data(), extra + sizeof(int32_t), m_swapped);
+			int64_t intervals = readInt(m_file.data(), extra + (2 * sizeof(int32_t)), m_swapped);
+			int64_t components = (item == 0) ? 1 : 3;  // TT-TDB, then Moon mantle angular velocity
+			if ((offset > 0) && (count > 0) && (intervals > 0))
+			{
+				recordSize = std::max(recordSize, offset - 1 + (components * count * intervals));
+			}
+		}
+	}
+	if (recordSize <= 2)
+	{
+		return false;
+	}
+
+	// Records (after the header and constants) - first record has to start the ephemeris
+	uint64_t records = (m_file.size() / (recordSize * sizeof(double)));
+	records = (records > 2) ? std::min<uint64_t>(records - 2, static_cast<uint64_t>(llround((end - start) / span))) : 0;
+	if ((records == 0) || (readDouble(m_file.data(), 2 * recordSize * sizeof(double), m_swapped) != start))
+	{
+		return false;
+	}
+
+	for (int item = 0; item < 11; item++)
+	{
+		const int32_t* pointer = pointers[item];
+		if ((pointer[1] == 0) || (pointer[2] == 0))
+		{
+			continue;
+		}
+		if ((pointer[0] < 3) || (pointer[1] > JplMaxCoefficients))
+		{
+			return false;
+		}
+
+		JplSeries series{};
+		series.target = s_binaryTargets[item][0];
+		series.center = s_binaryTargets[item][1];
+		series.epoch = 0.;
+		series.unitsPerDay = 1.;
+		series.start = start;
+		series.interval = span / pointer[2];
+		series.intervals = records * pointer[2];
+		series.end = start + (records * span);
+		series.subintervals = static_cast<uint32_t>(pointer[2]);
+		series.coefficients = pointer[1];
+		series.offset = (2 * recordSize) + pointer[0] - 1;
+		series.recordSize = static_cast<uint64_t>(recordSize);
+		series.midRadius = false;
+		m_series.push_back(series);
+	}
+
+	m_number = number;
+	m_jdStart = start;
+	m_jdEnd = start + (records * span);
+	return true;
+}
+
+bool AJplEphemeris::openSpk()
+{
+	// Byte order of the file (older kernels have no format - ND is 2 either way)
+	bool little = (memcmp(m_file.at(DafFormat), "LTL-IEEE", 8) == 0);
+	bool big = (memcmp(m_file.at(DafFormat), "BIG-IEEE", 8) == 0);
+	m_swapped = (little || big) ? (little != hostIsLittleEndian()) : (readInt(m_file.data(), DafSummaryCount, false) != 2);
+
+	int32_t nd = readInt(m_file.data(), DafSummaryCount, m_swapped);
+	int32_t ni = readInt(m_file.data(), DafIntegerCount, m_swapped);
+	int32_t record = readInt(m_file.data(), DafForward, m_swapped);
+	if ((nd != 2) || (ni != 6))
+	{
+		return false;
+	}
+
+	// Doubles of a summary - start and end (seconds past J2000 TDB), then target, center, frame,
+	// type, first and last address (doubles, 1 based) packed as integers
+	size_t summarySize = nd + ((ni + 1) / 2);
+	uint64_t doubles = m_file.size() / sizeof(double);
+
+	// Span of every body (intersection is the span of the ephemeris)
+	std::map<int32_t, std::pair<double, double>> spans;
+
+	for (int count = 0; (record > 0) && (count < MaxSummaryRecords); count++)
+	{
+		size_t base = (record - 1) * DafRecordSize;
+		if ((base + DafRecordSize) > m_file.size())
+		{
+			return false;
+		}
+
+		record = static_cast<int32_t>(readDouble(m_file.data(), base, m_swapped));
+		int summaries = static_cast<int>(readDouble(m_file.data(), base + (2 * sizeof(double)), m_swapped));
+		if ((summaries < 0) || ((3 + (summaries * summarySize)) * sizeof(double) > DafRecordSize))
+		{
+			return false;
+		}
+
+		for (int s = 0; s < summaries; s++)
+		{
+			size_t summary = base + ((3 + (s * summarySize)) * sizeof(double));
+			double first = readDouble(m_file.data(), summary, m_swapped);
+			double last = readDouble(m_file.data(), summary + sizeof(double), m_swapped);
+			int32_t ic[6];
+			for (int k = 0; k < 6; k++)
+			{
+				ic[k] = readInt(m_file.data(), summary + (nd * sizeof(double)) + (k * sizeof(int32_t)), m_swapped);
+			}
+
+			// Chebyshev positions (type 2) or positions and velocities (type 3) of the J2000 frame only
+			if ((ic[2] != SpkFrameJ2000) || ((ic[3] != 2) && (ic[3] != 3)) || (ic[4] < 1) || (ic[5] < ic[4] + 4)
+				|| (static_cast<uint64_t>(ic[5]) > doubles))
+			{
+				continue;
+			}
+
+			// Directory at the end of the segment - start, length and size of records, number of records
+			double init = value(ic[5] - 4);
+			double length = value(ic[5] - 3);
+			int64_t size = llround(value(ic[5] - 2));
+			int64_t records = llround(value(ic[5] - 1));
+			int64_t components = (ic[3] == 2) ? 3 : 6;
+			int64_t coefficients = (size - 2) / components;
+			if ((length <= 0.) || (records <= 0) || (coefficients < 1) || (coefficients > JplMaxCoefficients)
+				|| ((ic[4] - 1 + (records * size)) > (ic[5] - 4)))
+			{
+				return false;
+			}
+
+			JplSeries series{};
+			series.target = ic[0];
+			series.center = ic[1];
+			series.epoch = J2000Epoch;
+			series.unitsPerDay = 86400.;
+			series.start = init;    // interval i starts at init + (i * length)
+			series.end = std::min(last, init + (records * length));
+			series.interval = length;
+			series.intervals = static_cast<uint64_t>(records);
+			series.subintervals = 1;
+			series.coefficients = static_cast<int32_t>(coefficients);
+			series.offset = ic[4] - 1 + 2;
+			series.recordSize = static_cast<uint64_t>(size);
+			series.midRadius = true;
+			m_series.push_back(series);
+
+			double jdFirst = J2000Epoch + (std::max(first, init) / 86400.);
+			double jdLast = J2000Epoch + (series.end / 86400.);
+			auto it = spans.find(ic[0]);
+			if (it == spans.end())
+			{
+				spans[ic[0]] = std::make_pair(jdFirst, jdLast);
+			}
+			else
+			{
+				it->second.first = std::min(it->second.first, jdFirst);
+				it->second.second = std::max(it->second.second, jdLast);
+			}
+		}
+	}
+
+	if (spans.empty())
+	{
+		return false;
+	}
+
+	m_jdStart = spans.begin()->second.first;
+	m_jdEnd = spans.begin()->second.second;
+	for (auto& span : spans)
+	{
+		m_jdStart = std::max(m_jdStart, span.second.first);
+		m_jdEnd = std::min(m_jdEnd, span.second.second);
+	}
+	m_au = SpkAstronomicalUnit;
+	m_emrat = 0.;
+	return true;
+}
+
+double AJplEphemeris::value(const uint64_t index) const
+{
+	return readDouble(m_file.data(), index * sizeof(double), m_swapped);
+}
+
+const JplSeries* AJplEphemeris::find(const int target, const double jd) const
+{
+	for (auto& series : m_series)
+	{
+		if (series.target == target)
+		{
+			double t = (jd - series.epoch) * series.unitsPerDay;
+			if ((t >= series.start) && (t <= series.end))
+			{
+				return &series;
+			}
+		}
+	}
+	return nullptr;
+}
+
+void AJplEphemeris::evaluate(const JplSeries& series, const double jd, double position[3]) const
+{
+	// Interval of the date - computed (the end of the last interval is in the last one)
+	double t = (jd - series.epoch) * series.unitsPerDay;
+	double index = floor((t - series.start) / series.interval);
+	uint64_t interval = (index <= 0.) ? 0 : std::min(static_cast<uint64_t>(index), series.intervals - 1);
+
+	uint64_t record = interval / series.subintervals;
+	uint64_t sub = interval % series.subintervals;
+	uint64_t base = series.offset + (record * series.recordSize) + (sub * 3 * series.coefficients);
+
+	double x;
+	if (series.midRadius)
+	{
+		x = (t - value(base - 2)) / value(base - 1);
+	}
+	else
+	{
+		x = (2. * (t - (series.start + (interval * series.interval))) / series.interval) - 1.;
+	}
+
+	double coefficients[JplMaxCoefficients];
+	for (int c = 0; c < 3; c++)
+	{
+		for (int k = 0; k < series.coefficients; k++)
+		{
+			coefficients[k] = value(base + (c * series.coefficients) + k);
+		}
+		position[c] = AChebyshev::evaluate(coefficients, series.coefficients, x);
+	}
+}
+
+bool AJplEphemeris::barycentric(const int target, const double jd, double position[3]) const
+{
+	position[0] = 0.;
+	position[1] = 0.;
+	position[2] = 0.;
+
+	// Add positions of the body relative to its center up to the barycenter (few levels)
+	int body = target;
+	for (int level = 0; (body != SolarSystemBarycenter) && (level < 8); level++)
+	{
+		double relative[3];
+		const JplSeries* series = find(body, jd);
+		if (series != nullptr)
+		{
+			evaluate(*series, jd, relative);
+			body = series->center;
+		}
+		else if ((body == JplEarth) && (m_emrat > 0.) && ((series = find(JplMoon, jd)) != nullptr) && (series->center == JplEarth))
+		{
+			// Earth of a JPL binary file - opposite of the geocentric Moon by the mass ratio
+			evaluate(*series, jd, relative);
+			for (int c = 0; c < 3; c++)
+			{
+				relative[c] /= -(1. + m_emrat);
+			}
+			body = EarthMoonBarycenter;
+		}
+		else
+		{
+			return false;
+		}
+
+		for (int c = 0; c < 3; c++)
+		{
+			position[c] += relative[c];
+		}
+	}
+
+	return body == SolarSystemBarycenter;
+}
+
+bool AJplEphemeris::covers(const double j2000) const
+{
+	// Light time of the outer planets is less than a day
+	double jd = AInstant::fromJulian(j2000 + J2000Epoch).julianTT();
+	return isOpen() && (jd >= (m_jdStart + 1.)) && (jd <= m_jdEnd);
+}
+
+bool AJplEphemeris::planetPosition(const int planet, const double j2000, PlanetPosition& position) const
+{
+	// TDB is TT within 2 milliseconds
+	double jd = AInstant::fromJulian(j2000 + J2000Epoch).julianTT();
+	if ((planet < PlanetType::Mercury) || (planet >= NumberOfPlanets) || (planet == PlanetType::Earth)
+		|| (jd < (m_jdStart + 1.)) || (jd > m_jdEnd))
+	{
+		return false;
+	}
+
+	double earth[3];
+	double body[3];
+	if (!barycentric(JplEarth, jd, earth) || !barycentric(planetTarget(planet), jd, body))
+	{
+		return false;
+	}
+
+	// Planet when the light left it (converges in two iterations)
+	double geocentric[3];
+	double distance = 0.;
+	for (int iteration = 0; iteration < 3; iteration++)
+	{
+		if ((iteration > 0) && !barycentric(planetTarget(planet), jd - (distance / LightKmPerDay), body))
+		{
+			return false;
+		}
+		for (int c = 0; c < 3; c++)
+		{
+			geocentric[c] = body[c] - earth[c];
+		}
+		distance = sqrt((geocentric[0] * geocentric[0]) + (geocentric[1] * geocentric[1]) + (geocentric[2] * geocentric[2]));
+	}
+
+	double sun[3];
+	if (!barycentric(JplSun, jd - (distance / LightKmPerDay), sun))
+	{
+		return false;
+	}
+
+	// Heliocentric - rotated from equatorial to ecliptic coords
+	double xh = (body[0] - sun[0]) / m_au;
+	double yh = (body[1] - sun[1]) / m_au;
+	double zh = (body[2] - sun[2]) / m_au;
+	position.x = xh;
+	position.y = (yh * cos(J2000Obliquity)) + (zh * sin(J2000Obliquity));
+	position.z = (zh * cos(J2000Obliquity)) - (yh * sin(J2000Obliquity));
+
+	double ra = atan2(geocentric[1], geocentric[0]) * (12. / M_PI);
+	position.ra = (ra < 0.) ? (ra + 24.) : ra;
+	position.dec = atan2(geocentric[2], sqrt((geocentric[0] * geocentric[0]) + (geocentric[1] * geocentric[1]))) * (180. / M_PI);
+	position.dist = distance / m_au;
+	return true;
+}
@@ -0,0 +1,159 @@
+/// @file
+///
+/// @brief AJplEphemeris class definitions.
+///
+/// AJplEphemeris maps a JPL planetary ephemeris (DE4xx) and evaluates its
+/// Chebyshev records in place. Both distributions of the ephemerides are
+/// read: the binary files of the JPL Fortran/C readers (linux_p1550p2650.440
+/// and such - converted by asc2eph) and the SPICE kernels (de440s.bsp and
+/// such - SPK segments of type 2 or 3). Records of equal length follow each
+/// other, so the record of a date is computed from the start of the series
+/// and the length of a record - no search. Positions are barycentric (ICRF,
+/// km); planet positions are astrometric (light-time corrected) geocentric
+/// J2000 coordinates as of APlanets::computePlanetPos(). Files are supplied
+/// by the user (https://ssd.jpl.nasa.gov/ftp/eph/planets/).
+///
+/// @copyright 2019-2020 M.Mashimo and licensors. All Right Reserved.
+///
+/// This file is part of cMoon application.
+///
+/// cMoon is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// any later version.
+///
+/// cMoon is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with cMoon.  If not, see <https://www.gnu.org/licenses/>.
+///
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "AMappedFile.h"
+#include "APlanets.h"
+
+/// @brief Bodies (NAIF ids) of the ephemeris - planets 1 to 9 are barycenters of their systems
+enum JplTarget : int
+{
+	SolarSystemBarycenter = 0,
+	EarthMoonBarycenter   = 3,
+	JplSun                = 10,
+	JplMoon               = 301,
+	JplEarth              = 399
+};
+
+/// @brief Most coefficients of a component in an interval
+constexpr int JplMaxCoefficients{32};
+
+/// @brief Chebyshev records of a body relative to its center
+///
+/// The time argument of a Julian date (TDB) is (jd - epoch) * unitsPerDay. Interval i of the
+/// series starts at start + (i * interval); its coefficients (x, y then z - 'coefficients' each)
+/// start at offset + ((i / subintervals) * recordSize) + ((i % subintervals) * 3 * coefficients)
+/// doubles from the start of the file.
+using JplSeries = struct structJplSeries
+{
+	int32_t  target;        // NAIF id
+	int32_t  center;        // NAIF id
+	double   epoch;         // Julian date of time argument 0
+	double   unitsPerDay;   // 1 (days) or 86400 (seconds)
+	double   start;         // first interval (time argument)
+	double   end;           // end of the last interval (time argument)
+	double   interval;      // length of an interval (time argument)
+	uint64_t intervals;
+	uint32_t subintervals;  // intervals of a record
+	int32_t  coefficients;  // coefficients of a component
+	uint64_t offset;        // first coefficient of the series (doubles)
+	uint64_t recordSize;    // doubles of a record
+	bool     midRadius;     // intervals start with their midpoint and half length (SPK)
+};
+
+class AJplEphemeris
+{
+public:
+	AJplEphemeris();
+
+	~AJplEphemeris();
+
+	AJplEphemeris(const AJplEphemeris&) = delete;
+	AJplEphemeris& operator=(const AJplEphemeris&) = delete;
+
+	/// @brief Maps an ephemeris file (JPL binary or SPK kernel - either byte order).
+	/// @return true if the file is an ephemeris with the Sun, the Earth and the Moon
+	bool open(const std::string& path);
+
+	/// @brief Unmaps the ephemeris
+	void close();
+
+	bool isOpen() const { return m_file.isOpen(); }
+
+	/// @brief Ephemeris number of a JPL binary file (0 for SPK kernels)
+	int number() const { return m_number; }
+
+	/// @brief Span of the ephemeris (Julian dates, TDB)
+	double jdStart() const { return m_jdStart; }
+	double jdEnd() const { return m_jdEnd; }
+
+	/// @brief Series of the mapped file
+	const std::vector<JplSeries>& series() const { return m_series; }
+
+	/// @brief True if planet positions are in the ephemeris at a J2000 day (UTC)
+	bool covers(const double j2000) const;
+
+	/// @brief Position of a body relative to the solar system barycenter
+	/// @param[in] target - NAIF id (JplTarget or 1 to 9)
+	/// @param[in] jd - Julian date (TDB)
+	/// @param[out] position - x, y, z (ICRF, km)
+	/// @return false if the body or the date is not in the ephemeris
+	bool barycentric(const int target, const double jd, double position[3]) const;
+
+	/// @brief Astrometric geocentric position of a planet (same as APlanets::computePlanetPos())
+	/// @param[in] planet - PlanetType (not Earth)
+	/// @param[in] j2000 - J2000 day (UTC)
+	/// @param[out] position - heliocentric x, y, z (ecliptic J2000, AU), RA (hours), DEC (degrees) and distance (AU)
+	/// @return false if the planet or the day is not in the ephemeris
+	bool planetPosition(const int planet, const double j2000, PlanetPosition& position) const;
+
+	/// @brief NAIF id of a planet (PlanetType)
+	static int planetTarget(const int planet)
+	{
+		return (planet == PlanetType::Earth) ? JplEarth : (planet + 1);
+	}
+
+private:
+	/// @brief Reads the header and series of a JPL binary file
+	bool openBinary();
+
+	/// @brief Reads the segments of an SPK kernel
+	bool openSpk();
+
+	/// @brief Series of a body at a Julian date (nullptr if not in the ephemeris)
+	const JplSeries* find(const int target, const double jd) const;
+
+	/// @brief Position of a body relative to the center of its series
+	void evaluate(const JplSeries& series, const double jd, double position[3]) const;
+
+	/// @brief Double of the file (swapped to host order)
+	double value(const uint64_t index) const;
+
+	/// @brief Mapped file
+	AMappedFile m_file;
+
+	bool   m_swapped;
+
+	int    m_number;
+	double m_jdStart;
+	double m_jdEnd;
+	double m_au;      // km
+	double m_emrat;   // Earth/Moon mass ratio (0 if the Earth has a series of its own)
+
+	std::vector<JplSeries> m_series;
+};
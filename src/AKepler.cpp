@@ -0,0 +1,169 @@
+/// @file
+///
+/// @brief AKepler class implementation.
+///
+/// @copyright 2019-2020 M.Mashimo and licensors. All Right Reserved.
+///
+/// This file is part of cMoon application.
+///
+/// cMoon is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// any later version.
+///
+/// cMoon is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with cMoon.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <cmath>
+
+#include "AKepler.h"
+#include "ASimd.h"
+
+int AKepler::iterations(const double eccentricity)
+{
+	// Worst case over all mean anomalies using the starting guess below
+	if (eccentricity <= KeplerMaxEccentricity)
+	{
+		return KeplerIterations;
+	}
+	else if (eccentricity <= 0.5)
+	{
+		return 4;
+	}
+	else if (eccentricity <= 0.7)
+	{
+		return 5;
+	}
+	else if (eccentricity <= 0.8)
+	{
+		return 6;
+	}
+	else if (eccentricity <= 0.9)
+	{
+		return 7;
+	}
+	return 10;
+}
+
+/// @brief Solves Kepler's equation for packed mean anomalies
+///
+/// Each Newton step needs sin/cos of E. The last step's sin/cos are moved to
+/// the final E with a second-order expansion (step is < 1e-10) instead of another sincos.
+static inline void solve(const VDouble m, const VDouble e, const VDouble sq, const int iterations, VDouble& v, VDouble& r)
+{
+	VDouble s, c;
+
+	// Starting guess - third order in e
+	vsincos(m, s, c);
+	VDouble ea = vmadd(e * s, vmadd(e, c, vset(1.)), m);
+
+	VDouble step = vset(0.);
+	for (int i = 0; i < iterations; i++)
+	{
+		vsincos(ea, s, c);
+		step = (ea - (e * s) - m) / (vset(1.) - (e * c));
+		ea = ea - step;
+	}
+
+	// sin/cos at E (E moved by -step)
+	VDouble h = vset(0.5) * step * step;
+	VDouble sn = s - (step * c) - (h * s);
+	VDouble cs = c + (step * s) - (h * c);
+
+	// tan(v/2) = sqrt((1+e)/(1-e)) tan(E/2), as an angle of (cos E - e, sqrt(1 - e^2) sin E)
+	v = vatan2pos(sq * sn, cs - e);
+	r = vset(1.) - (e * cs);
+}
+
+void AKepler::trueAnomaly(const double* meanAnomaly, const double eccentricity, const size_t count,
+	double* trueAnomaly, double* radius)
+{
+	const int iter = iterations(eccentricity);
+	const VDouble e = vset(eccentricity);
+	const VDouble sq = vset(sqrt(1. - (eccentricity * eccentricity)));
+
+	VDouble v, r;
+	size_t i = 0;
+	for (; i + VDoubleWidth <= count; i += VDoubleWidth)
+	{
+		solve(vload(meanAnomaly + i), e, sq, iter, v, r);
+		vstore(trueAnomaly + i, v);
+		if (radius != nullptr)
+		{
+			vstore(radius + i, r);
+		}
+	}
+
+	// Remaining mean anomalies - padded to a full vector
+	if (i < count)
+	{
+		double m[VDoubleWidth] = {0.};
+		double vt[VDoubleWidth];
+		double rt[VDoubleWidth];
+		for (size_t k = i; k < count; k++)
+		{
+			m[k - i] = meanAnomaly[k];
+		}
+
+		solve(vload(m), e, sq, iter, v, r);
+		vstore(vt, v);
+		vstore(rt, r);
+
+		for (size_t k = i; k < count; k++)
+		{
+			trueAnomaly[k] = vt[k - i];
+			if (radius != nullptr)
+			{
+				radius[k] = rt[k - i];
+			}
+		}
+	}
+}
+
+double AKepler::trueAnomaly(const double meanAnomaly, const double eccentricity, double* radius)
+{
+	// Same steps as solve() with scalar sin/cos - a padded vector costs more than one solve.
+	// A step below 1e-9 leaves an error below e (1e-9)^2 - the remaining steps are skipped.
+	const int iter = iterations(eccentricity);
+	const double e = eccentricity;
+
+	double ea = meanAnomaly + (e * sin(meanAnomaly) * (1. + (e * cos(meanAnomaly))));
+
+	double s = 0.;
+	double c = 1.;
+	double step = 0.;
+	for (int i = 0; i < iter; i++)
+	{
+		s = sin(ea);
+		c = cos(ea);
+		step = (ea - (e * s) - meanAnomaly) / (1. - (e * c));
+		ea = ea - step;
+		if (fabs(step) < 1e-9)
+		{
+			break;
+		}
+	}
+
+	// sin/cos at E (E moved by -step)
+	double h = 0.5 * step * step;
+	double sn = s - (step * c) - (h * s);
+	double cs = c + (step * s) - (h * c);
+
+	if (radius != nullptr)
+	{
+		*radius = 1. - (e * cs);
+	}
+
+	double v = atan2(sqrt(1. - (e * e)) * sn, cs - e);
+	return (v < 0.) ? v + (2. * M_PI) : v;
+}
+
+const char* AKepler::simdName()
+{
+	return SimdName;
+}
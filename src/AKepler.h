@@ -0,0 +1,67 @@
+/// @file
+///
+/// @brief AKepler class definitions.
+///
+/// AKepler solves Kepler's equation (E - e sin E = M) for arrays of mean anomalies
+/// with packed (SIMD) doubles - see ASimd.h.
+///
+/// @copyright 2019-2020 M.Mashimo and licensors. All Right Reserved.
+///
+/// This file is part of cMoon application.
+///
+/// cMoon is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// any later version.
+///
+/// cMoon is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with cMoon.  If not, see <https://www.gnu.org/licenses/>.
+///
+
+#pragma once
+
+#include <cstddef>
+
+/// @brief Largest eccentricity solved with KeplerIterations (Pluto is 0.2501)
+constexpr double KeplerMaxEccentricity{0.26};
+
+/// @brief Newton iterations used for eccentricities up to KeplerMaxEccentricity
+///
+/// Starting guess E0 = M + e sin M (1 + e cos M) is within 0.0087 rad of E for
+/// e <= 0.26 (error is O(e^3)). Each Newton step squares the error times
+/// e / (2 (1 - e)) <= 0.18, so errors are 1.3e-5, 3e-11 and < 1e-21 after
+/// one, two and three steps - three steps reach double precision.
+constexpr int KeplerIterations{3};
+
+class AKepler
+{
+public:
+	/// @brief Number of Newton iterations needed for an eccentricity
+	/// @param[in] eccentricity - eccentricity of the orbit (0 <= e < 0.97)
+	/// @return number of iterations (KeplerIterations for planetary orbits)
+	static int iterations(const double eccentricity);
+
+	/// @brief Computes true anomaly for one mean anomaly (scalar - stops once a step is below 1e-9)
+	/// @param[in] meanAnomaly - mean anomaly in radians
+	/// @param[in] eccentricity - eccentricity of the orbit
+	/// @param[out] radius - radius in units of semi-major axis, 1 - e cos E (optional)
+	/// @return true anomaly in radians (0 to two pi)
+	static double trueAnomaly(const double meanAnomaly, const double eccentricity, double* radius = nullptr);
+
+	/// @brief Computes true anomaly for an array of mean anomalies (same orbit)
+	/// @param[in] meanAnomaly - mean anomalies in radians
+	/// @param[in] eccentricity - eccentricity of the orbit
+	/// @param[in] count - number of mean anomalies
+	/// @param[out] trueAnomaly - true anomalies in radians (0 to two pi)
+	/// @param[out] radius - radius in units of semi-major axis, 1 - e cos E (optional)
+	static void trueAnomaly(const double* meanAnomaly, const double eccentricity, const size_t count,
+		double* trueAnomaly, double* radius = nullptr);
+
+	/// @brief Name of the instruction set used by the solver (AVX2, SSE2 or scalar)
+	static const char* simdName();
+};
@@ -0,0 +1,350 @@
+/// @file
+///
+/// @brief ALunarTheory class implementation.
+///
+/// @copyright 2019-2020 M.Mashimo and licensors. All Right Reserved.
+///
+/// This file is part of cMoon application.
+///
+/// cMoon is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// any later version.
+///
+/// cMoon is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with cMoon.  If not, see <https://www.gnu.org/licenses/>.
+///
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "AInstant.h"
+#include "ALunarTheory.h"
+
+static constexpr double rads = M_PI / 180.;
+static constexpr double degs = 180. / M_PI;
+
+/// @brief Astronomical unit (km)
+static constexpr double AstronomicalUnit{149597870.7};
+
+/// @brief Mean distance of the Moon (km) - constant of the distance series
+static constexpr double MeanDistance{385000.56};
+
+/// @brief Number of times computed together by compute()
+static constexpr size_t LunarBlock{64};
+
+/// @brief Periodic term of a table: multiples of D, M, M', F and the coefficients
+using LunarTerm = struct structLunarTerm
+{
+	int    multiple[SeriesArguments];
+	double sine;     // longitude (1e-6 degrees) or latitude (1e-6 degrees)
+	double cosine;   // distance (1e-3 km)
+};
+
+/// @brief Longitude and distance (Meeus table 47.A)
+static const std::vector<LunarTerm> s_longitudeDistanceTable
+{
+	{{0,  0,  1,  0}, 6288774., -20905355.},
+	{{2,  0, -1,  0}, 1274027.,  -3699111.},
+	{{2,  0,  0,  0},  658314.,  -2955968.},
+	{{0,  0,  2,  0},  213618.,   -569925.},
+	{{0,  1,  0,  0}, -185116.,     48888.},
+	{{0,  0,  0,  2}, -114332.,     -3149.},
+	{{2,  0, -2,  0},   58793.,    246158.},
+	{{2, -1, -1,  0},   57066.,   -152138.},
+	{{2,  0,  1,  0},   53322.,   -170733.},
+	{{2, -1,  0,  0},   45758.,   -204586.},
+	{{0,  1, -1,  0},  -40923.,   -129620.},
+	{{1,  0,  0,  0},  -34720.,    108743.},
+	{{0,  1,  1,  0},  -30383.,    104755.},
+	{{2,  0,  0, -2},   15327.,     10321.},
+	{{0,  0,  1,  2},  -12528.,         0.},
+	{{0,  0,  1, -2},   10980.,     79661.},
+	{{4,  0, -1,  0},   10675.,    -34782.},
+	{{0,  0,  3,  0},   10034.,    -23210.},
+	{{4,  0, -2,  0},    8548.,    -21636.},
+	{{2,  1, -1,  0},   -7888.,     24208.},
+	{{2,  1,  0,  0},   -6766.,     30824.},
+	{{1,  0, -1,  0},   -5163.,     -8379.},
+	{{1,  1,  0,  0},    4987.,    -16675.},
+	{{2, -1,  1,  0},    4036.,    -12831.},
+	{{2,  0,  2,  0},    3994.,    -10445.},
+	{{4,  0,  0,  0},    3861.,    -11650.},
+	{{2,  0, -3,  0},    3665.,     14403.},
+	{{0,  1, -2,  0},   -2689.,     -7003.},
+	{{2,  0, -1,  2},   -2602.,         0.},
+	{{2, -1, -2,  0},    2390.,     10056.},
+	{{1,  0,  1,  0},   -2348.,      6322.},
+	{{2, -2,  0,  0},    2236.,     -9884.},
+	{{0,  1,  2,  0},   -2120.,      5751.},
+	{{0,  2,  0,  0},   -2069.,         0.},
+	{{2, -2, -1,  0},    2048.,     -4950.},
+	{{2,  0,  1, -2},   -1773.,      4130.},
+	{{2,  0,  0,  2},   -1595.,         0.},
+	{{4, -1, -1,  0},    1215.,     -3958.},
+	{{0,  0,  2,  2},   -1110.,         0.},
+	{{3,  0, -1,  0},    -892.,      3258.},
+	{{2,  1,  1,  0},    -810.,      2616.},
+	{{4, -1, -2,  0},     759.,     -1897.},
+	{{0,  2, -1,  0},    -713.,     -2117.},
+	{{2,  2, -1,  0},    -700.,      2354.},
+	{{2,  1, -2,  0},     691.,         0.},
+	{{2, -1,  0, -2},     596.,         0.},
+	{{4,  0,  1,  0},     549.,     -1423.},
+	{{0,  0,  4,  0},     537.,     -1117.},
+	{{4, -1,  0,  0},     520.,     -1571.},
+	{{1,  0, -2,  0},    -487.,     -1739.},
+	{{2,  1,  0, -2},    -399.,         0.},
+	{{0,  0,  2, -2},    -381.,     -4421.},
+	{{1,  1,  1,  0},     351.,         0.},
+	{{3,  0, -2,  0},    -340.,         0.},
+	{{4,  0, -3,  0},     330.,         0.},
+	{{2, -1,  2,  0},     327.,         0.},
+	{{0,  2,  1,  0},    -323.,      1165.},
+	{{1,  1, -1,  0},     299.,         0.},
+	{{2,  0,  3,  0},     294.,         0.},
+	{{2,  0, -1, -2},       0.,      8752.}
+};
+
+/// @brief Latitude (Meeus table 47.B)
+static const std::vector<LunarTerm> s_latitudeTable
+{
+	{{0,  0,  0,  1}, 5128122., 0.},
+	{{0,  0,  1,  1},  280602., 0.},
+	{{0,  0,  1, -1},  277693., 0.},
+	{{2,  0,  0, -1},  173237., 0.},
+	{{2,  0, -1,  1},   55413., 0.},
+	{{2,  0, -1, -1},   46271., 0.},
+	{{2,  0,  0,  1},   32573., 0.},
+	{{0,  0,  2,  1},   17198., 0.},
+	{{2,  0,  1, -1},    9266., 0.},
+	{{0,  0,  2, -1},    8822., 0.},
+	{{2, -1,  0, -1},    8216., 0.},
+	{{2,  0, -2, -1},    4324., 0.},
+	{{2,  0,  1,  1},    4200., 0.},
+	{{2,  1,  0, -1},   -3359., 0.},
+	{{2, -1, -1,  1},    2463., 0.},
+	{{2, -1,  0,  1},    2211., 0.},
+	{{2, -1, -1, -1},    2065., 0.},
+	{{0,  1, -1, -1},   -1870., 0.},
+	{{4,  0, -1, -1},    1828., 0.},
+	{{0,  1,  0,  1},   -1794., 0.},
+	{{0,  0,  0,  3},   -1749., 0.},
+	{{0,  1, -1,  1},   -1565., 0.},
+	{{1,  0,  0,  1},   -1491., 0.},
+	{{0,  1,  1,  1},   -1475., 0.},
+	{{0,  1,  1, -1},   -1410., 0.},
+	{{0,  1,  0, -1},   -1344., 0.},
+	{{1,  0,  0, -1},   -1335., 0.},
+	{{0,  0,  3,  1},    1107., 0.},
+	{{4,  0,  0, -1},    1021., 0.},
+	{{4,  0, -1,  1},     833., 0.},
+	{{0,  0,  1, -3},     777., 0.},
+	{{4,  0, -2,  1},     671., 0.},
+	{{2,  0,  0, -3},     607., 0.},
+	{{2,  0,  2, -1},     596., 0.},
+	{{2, -1,  1, -1},     491., 0.},
+	{{2,  0, -2,  1},    -451., 0.},
+	{{0,  0,  3, -1},     439., 0.},
+	{{2,  0,  2,  1},     422., 0.},
+	{{2,  0, -3, -1},     421., 0.},
+	{{2,  1, -1,  1},    -366., 0.},
+	{{2,  1,  0,  1},    -351., 0.},
+	{{4,  0,  0,  1},     331., 0.},
+	{{2, -1,  1,  1},     315., 0.},
+	{{2, -2,  0, -1},     302., 0.},
+	{{0,  0,  1,  3},    -283., 0.},
+	{{2,  1,  1, -1},    -229., 0.},
+	{{1,  1,  0, -1},     223., 0.},
+	{{1,  1,  0,  1},     223., 0.},
+	{{0,  1, -2, -1},    -220., 0.},
+	{{2,  1, -1, -1},    -220., 0.},
+	{{1,  0,  1,  1},    -185., 0.},
+	{{2, -1, -2, -1},     181., 0.},
+	{{0,  1,  2,  1},    -177., 0.},
+	{{4,  0, -2, -1},     176., 0.},
+	{{4, -1, -1, -1},     166., 0.},
+	{{1,  0,  1, -1},    -164., 0.},
+	{{4,  0,  1, -1},     132., 0.},
+	{{1,  0, -1, -1},    -119., 0.},
+	{{4, -1,  0, -1},     115., 0.},
+	{{2, -2,  0,  1},     107., 0.}
+};
+
+/// @brief Series terms of a table - E^|multiple of M| for the eccentricity of the Earth's orbit
+/// @param[in] table
+/// @param[in] cosine - cosine coefficients (else sine)
+/// @param[in] scale - of the coefficients
+static std::vector<SeriesTerm> seriesTerms(const std::vector<LunarTerm>& table, const bool cosine, const double scale)
+{
+	std::vector<SeriesTerm> terms;
+	for (const auto& term : table)
+	{
+		double coefficient = cosine ? term.cosine : term.sine;
+		if (coefficient != 0.)
+		{
+			terms.push_back(SeriesTerm{coefficient * scale, std::abs(term.multiple[1]),
+				{term.multiple[0], term.multiple[1], term.multiple[2], term.multiple[3]}});
+		}
+	}
+	return terms;
+}
+
+/// @brief Degrees in range 0 to 360
+static double degreesInRange(const double x)
+{
+	double a = fmod(x, 360.);
+	return (a < 0.) ? (a + 360.) : a;
+}
+
+ALunarTheory::ALunarTheory()
+	: m_longitude(seriesTerms(s_longitudeDistanceTable, false, 1e-6))
+	, m_latitude(seriesTerms(s_latitudeTable, false, 1e-6))
+	, m_distance(seriesTerms(s_longitudeDistanceTable, true, 1e-3), true)
+{
+	// Nothing here
+}
+
+double ALunarTheory::julianCenturies(const double jd)
+{
+	return (AInstant::fromJulian(jd).julianTT() - 2451545.) / 36525.;
+}
+
+double ALunarTheory::parallax(const double distance)
+{
+	return asin(EarthRadiusKm / distance) * degs;
+}
+
+double ALunarTheory::riseSetAltitude(const double distance)
+{
+	return (0.7275 * parallax(distance)) - (34. / 60.);
+}
+
+void ALunarTheory::position(const double t, LunarPosition& position) const
+{
+	compute(&t, 1, &position.longitude, &position.latitude, &position.distance,
+		&position.ra, &position.dec, &position.elongation, &position.illuminated);
+	position.parallax = parallax(position.distance);
+}
+
+void ALunarTheory::positions(const double* t, const size_t count, double* ra, double* dec, double* distance,
+	double* elongation) const
+{
+	compute(t, count, nullptr, nullptr, distance, ra, dec, elongation, nullptr);
+}
+
+void ALunarTheory::compute(const double* t, const size_t count, double* longitude, double* latitude, double* distance,
+	double* ra, double* dec, double* elongation, double* illuminated) const
+{
+	const ASeries* series[3]{&m_longitude, &m_latitude, &m_distance};
+
+	for (size_t first = 0; first < count; first += LunarBlock)
+	{
+		size_t n = std::min(LunarBlock, count - first);
+		const double* tb = t + first;
+
+		// Fundamental arguments (D, M, M', F - radians) and E - once per time for all series
+		double args[SeriesArguments][LunarBlock];
+		double E[LunarBlock];
+		double meanLongitude[LunarBlock];
+		for (size_t i = 0; i < n; i++)
+		{
+			double T = tb[i];
+			double T2 = T * T;
+			double T3 = T2 * T;
+			double T4 = T3 * T;
+			meanLongitude[i] = degreesInRange(218.3164477 + (481267.88123421 * T) - (0.0015786 * T2) + (T3 / 538841.) - (T4 / 65194000.));
+			args[0][i] = degreesInRange(297.8501921 + (445267.1114034 * T) - (0.0018819 * T2) + (T3 / 545868.) - (T4 / 113065000.)) * rads;
+			args[1][i] = degreesInRange(357.5291092 + (35999.0502909 * T) - (0.0001536 * T2) + (T3 / 24490000.)) * rads;
+			args[2][i] = degreesInRange(134.9633964 + (477198.8675055 * T) + (0.0087414 * T2) + (T3 / 69699.) - (T4 / 14712000.)) * rads;
+			args[3][i] = degreesInRange(93.2720950 + (483202.0175233 * T) - (0.0036539 * T2) - (T3 / 3526000.) + (T4 / 863310000.)) * rads;
+			E[i] = 1. - (0.002516 * T) - (0.0000074 * T2);
+		}
+		const double* arguments[SeriesArguments]{args[0], args[1], args[2], args[3]};
+
+		double sumL[LunarBlock];
+		double sumB[LunarBlock];
+		double sumR[LunarBlock];
+		double* results[3]{sumL, sumB, sumR};
+		ASeries::evaluate(series, 3, arguments, E, n, results);
+
+		for (size_t i = 0; i < n; i++)
+		{
+			double T = tb[i];
+			double Lp = meanLongitude[i] * rads;
+			double Mp = args[2][i];
+			double F = args[3][i];
+
+			// Venus (A1), Jupiter (A2) and the flattening of the Earth (A3)
+			double A1 = (119.75 + (131.849 * T)) * rads;
+			double A2 = (53.09 + (479264.290 * T)) * rads;
+			double A3 = (313.45 + (481266.484 * T)) * rads;
+			double dL = sumL[i] + (0.003958 * sin(A1)) + (0.001962 * sin(Lp - F)) + (0.000318 * sin(A2));
+			double b = sumB[i] - (0.002235 * sin(Lp)) + (0.000382 * sin(A3)) + (0.000175 * sin(A1 - F))
+				+ (0.000175 * sin(A1 + F)) + (0.000127 * sin(Lp - Mp)) - (0.000115 * sin(Lp + Mp));
+			double r = MeanDistance + sumR[i];
+
+			// Nutation (Meeus 22 - 0.5" in longitude, 0.1" in obliquity) and true obliquity
+			double omega = (125.04452 - (1934.136261 * T) + (0.0020708 * T * T) + (T * T * T / 450000.)) * rads;
+			double Ls = (280.4665 + (36000.7698 * T)) * rads;
+			double dpsi = ((-17.20 * sin(omega)) - (1.32 * sin(2. * Ls)) - (0.23 * sin(2. * Lp)) + (0.21 * sin(2. * omega))) / 3600.;
+			double deps = ((9.20 * cos(omega)) + (0.57 * cos(2. * Ls)) + (0.10 * cos(2. * Lp)) - (0.09 * cos(2. * omega))) / 3600.;
+			double eps = (23.4392911 - (((46.8150 * T) + (0.00059 * T * T) - (0.001813 * T * T * T)) / 3600.) + deps) * rads;
+
+			double l = degreesInRange(meanLongitude[i] + dL + dpsi);
+			if (longitude != nullptr)
+			{
+				longitude[first + i] = l;
+				latitude[first + i] = b;
+			}
+			if (distance != nullptr)
+			{
+				distance[first + i] = r;
+			}
+
+			double sinL = sin(l * rads);
+			double cosL = cos(l * rads);
+			double sinB = sin(b * rads);
+			double cosB = cos(b * rads);
+			if (ra != nullptr)
+			{
+				double a = atan2((sinL * cos(eps) * cosB) - (sinB * sin(eps)), cosL * cosB) * (12. / M_PI);
+				ra[first + i] = (a < 0.) ? (a + 24.) : a;
+				dec[first + i] = asin((sinB * cos(eps)) + (cosB * sin(eps) * sinL)) * degs;
+			}
+
+			if ((elongation == nullptr) && (illuminated == nullptr))
+			{
+				continue;
+			}
+
+			// Apparent longitude (degrees) and distance (km) of the Sun - Meeus 25
+			double M = args[1][i];
+			double C = ((1.914602 - (0.004817 * T) - (0.000014 * T * T)) * sin(M)) + ((0.019993 - (0.000101 * T)) * sin(2. * M))
+				+ (0.000289 * sin(3. * M));
+			double sunLongitude = (280.46646 + (36000.76983 * T) + (0.0003032 * T * T)) + C - 0.00569 - (0.00478 * sin(omega));
+			double e = 0.016708634 - (0.000042037 * T) - (0.0000001267 * T * T);
+			double R = AstronomicalUnit * 1.000001018 * (1. - (e * e)) / (1. + (e * cos(M + (C * rads))));
+
+			double elong = degreesInRange(l - sunLongitude);
+			if (elongation != nullptr)
+			{
+				elongation[first + i] = elong;
+			}
+			if (illuminated != nullptr)
+			{
+				// Phase angle of the geocentric elongation (Meeus 48.2, 48.3)
+				double cosPsi = cosB * cos(elong * rads);
+				double sinPsi = sqrt(std::max(0., 1. - (cosPsi * cosPsi)));
+				double phaseAngle = atan2(R * sinPsi, r - (R * cosPsi));
+				illuminated[first + i] = (1. + cos(phaseAngle)) / 2.;
+			}
+		}
+	}
+}
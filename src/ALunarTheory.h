@@ -0,0 +1,101 @@
+/// @file
+///
+/// @brief ALunarTheory class definitions.
+///
+/// ALunarTheory computes geocentric positions of the Moon from the truncated
+/// ELP-2000/82 theory of J. Meeus (Astronomical Algorithms, chapter 47) -
+/// about 10" in longitude and 4" in latitude. Longitude, latitude and distance
+/// are series of the fundamental arguments (D, M, M', F) held in coefficient
+/// tables (ASeries); the arguments and their multiples are computed once per
+/// time for the three series. Positions are apparent (nutation in longitude,
+/// true obliquity of date), with the horizontal parallax of the distance.
+/// The Sun's longitude (Meeus chapter 25 - from the same M) gives the
+/// elongation and the illuminated fraction of the Moon.
+///
+/// @copyright 2019-2020 M.Mashimo and licensors. All Right Reserved.
+///
+/// This file is part of cMoon application.
+///
+/// cMoon is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// any later version.
+///
+/// cMoon is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with cMoon.  If not, see <https://www.gnu.org/licenses/>.
+///
+
+#pragma once
+
+#include <cstddef>
+
+#include "ASeries.h"
+
+/// @brief Geocentric position of the Moon (ALunarTheory::position)
+using LunarPosition = struct structLunarPosition
+{
+	// Apparent ecliptic coordinates (equinox of date)
+	double longitude;     // degrees (0 to 360)
+	double latitude;      // degrees
+	double distance;      // km - center of the Earth to center of the Moon
+
+	// Apparent equatorial coordinates (true equator and equinox of date)
+	double ra;            // hours
+	double dec;           // degrees
+
+	double parallax;      // equatorial horizontal parallax (degrees)
+	double elongation;    // longitude of the Moon - longitude of the Sun (degrees, 0 to 360 - 0 = new Moon)
+	double illuminated;   // illuminated fraction of the disk (0 to 1)
+};
+
+/// @brief Equatorial radius of the Earth (km)
+constexpr double EarthRadiusKm{6378.14};
+
+class ALunarTheory
+{
+public:
+	/// @brief Constructor - builds the series of the coefficient tables
+	ALunarTheory();
+
+	ALunarTheory(const ALunarTheory&) = delete;
+	ALunarTheory& operator=(const ALunarTheory&) = delete;
+
+	/// @brief Position of the Moon
+	/// @param[in] t - Julian centuries (TT) from J2000.0 - see julianCenturies()
+	/// @param[out] position
+	void position(const double t, LunarPosition& position) const;
+
+	/// @brief Positions of the Moon for an array of times (any output may be nullptr)
+	/// @param[in] t - Julian centuries (TT) from J2000.0
+	/// @param[in] count - number of times
+	/// @param[out] ra - apparent RA (hours)
+	/// @param[out] dec - apparent DEC (degrees)
+	/// @param[out] distance - km
+	/// @param[out] elongation - degrees (0 to 360)
+	void positions(const double* t, const size_t count, double* ra, double* dec, double* distance,
+		double* elongation = nullptr) const;
+
+	/// @brief Julian centuries (TT) from J2000.0 of a Julian date (UT)
+	static double julianCenturies(const double jd);
+
+	/// @brief Equatorial horizontal parallax (degrees) of a distance (km)
+	static double parallax(const double distance);
+
+	/// @brief Altitude of the center of the Moon at rising and setting (degrees - Meeus 15: 0.7275 parallax - 0°34')
+	static double riseSetAltitude(const double distance);
+
+private:
+	/// @brief Computes a block of times - outputs as of position() (nullptr - not computed)
+	void compute(const double* t, const size_t count, double* longitude, double* latitude, double* distance,
+		double* ra, double* dec, double* elongation, double* illuminated) const;
+
+	/// @brief Series of the periodic terms - sines of longitude and latitude (degrees), cosines of distance (km)
+	ASeries m_longitude;
+	ASeries m_latitude;
+	ASeries m_distance;
+};
@@ -0,0 +1,141 @@
+/// @file
+///
+/// @brief AMappedFile class implementation.
+///
+/// @copyright 2019-2020 M.Mashimo and licensors. All Right Reserved.
+///
+/// This file is part of cMoon application.
+///
+/// cMoon is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// any later version.
+///
+/// cMoon is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with cMoon.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <cstdlib>
+
+#ifdef WIN32
+#include <fstream>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "AMappedFile.h"
+
+AMappedFile::AMappedFile()
+	: m_map(nullptr)
+	, m_size(0)
+{
+	// Nothing here
+}
+
+AMappedFile::~AMappedFile()
+{
+	close();
+}
+
+bool AMappedFile::open(const std::string& path, const size_t minSize)
+{
+	close();
+
+#ifdef WIN32
+	std::ifstream file(path, std::ios::binary | std::ios::ate);
+	if (!file)
+	{
+		return false;
+	}
+
+	size_t size = static_cast<size_t>(file.tellg());
+	if ((size == 0) || (size < minSize))
+	{
+		return false;
+	}
+
+	void* map = malloc(size);
+	file.seekg(0);
+	if ((map == nullptr) || !file.read(static_cast<char*>(map), size))
+	{
+		free(map);
+		return false;
+	}
+#else
+	int fd = ::open(path.c_str(), O_RDONLY);
+	if (fd < 0)
+	{
+		return false;
+	}
+
+	struct stat st;
+	if ((fstat(fd, &st) != 0) || (st.st_size == 0) || (static_cast<size_t>(st.st_size) < minSize))
+	{
+		::close(fd);
+		return false;
+	}
+
+	size_t size = static_cast<size_t>(st.st_size);
+	void* map = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+	::close(fd);
+	if (map == MAP_FAILED)
+	{
+		return false;
+	}
+#endif
+
+	m_map = map;
+	m_size = size;
+	return true;
+}
+
+void AMappedFile::close()
+{
+	if (m_map != nullptr)
+	{
+#ifdef WIN32
+		free(m_map);
+#else
+		munmap(m_map, m_size);
+#endif
+	}
+
+	m_map = nullptr;
+	m_size = 0;
+}
+
+bool AMappedFile::writeAtomic(const std::string& path, const std::function<bool(FILE*)>& write)
+{
+	std::string tmpPath = path + ".tmp";
+	FILE* file = fopen(tmpPath.c_str(), "wb");
+	if (file == nullptr)
+	{
+		return false;
+	}
+
+	bool written = write(file);
+	written = (fclose(file) == 0) && written;
+
+#ifdef WIN32
+	// rename() does not replace an existing file on Windows
+	if (written)
+	{
+		remove(path.c_str());
+	}
+#endif
+
+	if (!written || (rename(tmpPath.c_str(), path.c_str()) != 0))
+	{
+		remove(tmpPath.c_str());
+		return false;
+	}
+
+	return true;
+}
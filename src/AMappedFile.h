@@ -0,0 +1,74 @@
+/// @file
+///
+/// @brief AMappedFile class definitions.
+///
+/// AMappedFile maps a read-only binary file (read into memory on Windows) and
+/// writes binary files atomically (temporary file renamed over the file). Used by
+/// the ephemerides, the phase table and the result cache.
+///
+/// @copyright 2019-2020 M.Mashimo and licensors. All Right Reserved.
+///
+/// This file is part of cMoon application.
+///
+/// cMoon is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// any later version.
+///
+/// cMoon is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with cMoon.  If not, see <https://www.gnu.org/licenses/>.
+///
+
+#pragma once
+
+#include <cstddef>
+#include <cstdio>
+#include <functional>
+#include <string>
+
+class AMappedFile
+{
+public:
+	AMappedFile();
+
+	~AMappedFile();
+
+	AMappedFile(const AMappedFile&) = delete;
+	AMappedFile& operator=(const AMappedFile&) = delete;
+
+	/// @brief Maps a file (read-only).
+	/// @param[in] path - file to map
+	/// @param[in] minSize - smallest valid size of the file (e.g. its header)
+	/// @return true if mapped
+	bool open(const std::string& path, const size_t minSize = 1);
+
+	/// @brief Unmaps the file
+	void close();
+
+	/// @brief True if a file is mapped
+	bool isOpen() const { return m_map != nullptr; }
+
+	/// @brief Mapped bytes (nullptr if not mapped)
+	const void* data() const { return m_map; }
+
+	/// @brief Mapped bytes at an offset
+	const char* at(const size_t offset) const { return static_cast<const char*>(m_map) + offset; }
+
+	/// @brief Size of the mapped file
+	size_t size() const { return m_size; }
+
+	/// @brief Writes a file to 'path.tmp' then renames it - readers never see a partial file.
+	/// @param[in] path - file to write
+	/// @param[in] write - writes the content, returns false on error
+	/// @return true if written and renamed
+	static bool writeAtomic(const std::string& path, const std::function<bool(FILE*)>& write);
+
+private:
+	void*  m_map;
+	size_t m_size;
+};
@@ -25,9 +25,14 @@
 #include <cstdio>
 #include <iomanip>
 #include <stdlib.h>
+#include <algorithm>
 #include <array>
 
 #include "AMoon.h"
+#include "APhaseTable.h"
+#include "ASweep.h"
+#include "ASeries.h"
+#include "ASimd.h"
 #include "ALocation.h"
 
 #include "AObject.h"
@@ -48,11 +53,140 @@ constexpr double MilleniumJD{ 2451544.5 };
 constexpr double MoonsPerYear = 12.3685;
 constexpr double MoonCycleDivisor = 1236.85;
 
-std::array<const char*, 4> s_phaseName{"New Moon", "Waxing Quarter", "Full Moon", "Waning Quarter"};
+/// @brief Mean New Moon of K=0 (2000-01-06) and mean synodic month (days)
+constexpr double JdeOfFirstNewMoon = 2451550.09765;
+constexpr double SynodicMonth = 29.530588853;
 
-int AMoon::m_verboseLevel = 1;
+/// @brief Phase correction terms (days) - arguments are M, M' (MS), F and Omega
+static const std::vector<SeriesTerm> s_newMoonTerms
+{
+	{-0.4072,   0, { 0, 1,  0, 0}},
+	{ 0.17241,  1, { 1, 0,  0, 0}},
+	{ 0.01608,  0, { 0, 2,  0, 0}},
+	{ 0.01039,  0, { 0, 0,  2, 0}},
+	{ 0.00739,  1, {-1, 1,  0, 0}},
+	{-0.00514,  1, { 1, 1,  0, 0}},
+	{ 0.00208,  2, { 2, 0,  0, 0}},
+	{-0.00111,  0, { 0, 1, -2, 0}},
+	{-0.00057,  0, { 0, 1,  2, 0}},
+	{ 0.00056,  1, { 1, 2,  0, 0}},
+	{-0.00042,  0, { 0, 3,  0, 0}},
+	{ 0.00042,  1, { 1, 0,  2, 0}},
+	{ 0.00038,  1, { 1, 0, -2, 0}},
+	{-0.00024,  1, {-1, 2,  0, 0}},
+	{-0.00017,  0, { 0, 0,  0, 1}},
+	{-0.00007,  0, { 2, 1,  0, 0}},
+	{ 0.00004,  0, { 0, 2, -2, 0}},
+	{ 0.00004,  0, { 3, 0,  0, 0}},
+	{ 0.00003,  0, { 1, 1, -2, 0}},
+	{ 0.00003,  0, { 0, 2,  2, 0}},
+	{-0.00003,  0, { 1, 1,  2, 0}},
+	{ 0.00003,  0, {-1, 1,  2, 0}},
+	{-0.00002,  0, {-1, 1, -2, 0}},
+	{-0.00002,  0, { 1, 3,  0, 0}},
+	{ 0.00002,  0, { 0, 4,  0, 0}}
+};
+
+static const std::vector<SeriesTerm> s_fullMoonTerms
+{
+	{-0.40614,  0, { 0, 1,  0, 0}},
+	{ 0.17302,  1, { 1, 0,  0, 0}},
+	{ 0.01614,  0, { 0, 2,  0, 0}},
+	{ 0.01043,  0, { 0, 0,  2, 0}},
+	{ 0.00734,  1, {-1, 1,  0, 0}},
+	{-0.00515,  1, { 1, 1,  0, 0}},
+	{ 0.00209,  2, { 2, 0,  0, 0}},
+	{-0.00111,  0, { 0, 1, -2, 0}},
+	{-0.00057,  0, { 0, 1,  2, 0}},
+	{ 0.00056,  1, { 1, 2,  0, 0}},
+	{-0.00042,  0, { 0, 3,  0, 0}},
+	{ 0.00042,  1, { 1, 0,  2, 0}},
+	{ 0.00038,  1, { 1, 0, -2, 0}},
+	{-0.00024,  1, {-1, 2,  0, 0}},
+	{-0.00017,  0, { 0, 0,  0, 1}},
+	{-0.00007,  0, { 2, 1,  0, 0}},
+	{ 0.00004,  0, { 0, 2, -2, 0}},
+	{ 0.00004,  0, { 3, 0,  0, 0}},
+	{ 0.00003,  0, { 1, 1, -2, 0}},
+	{ 0.00003,  0, { 0, 2,  2, 0}},
+	{-0.00003,  0, { 1, 1,  2, 0}},
+	{ 0.00003,  0, {-1, 1,  2, 0}},
+	{-0.00002,  0, {-1, 1, -2, 0}},
+	{-0.00002,  0, { 1, 3,  0, 0}},
+	{ 0.00002,  0, { 0, 4,  0, 0}}
+};
+
+static const std::vector<SeriesTerm> s_quarterTerms
+{
+	{-0.62801,  0, { 0, 1,  0, 0}},
+	{ 0.17172,  1, { 1, 0,  0, 0}},
+	{-0.01183,  1, { 1, 1,  0, 0}},
+	{ 0.00862,  0, { 0, 2,  0, 0}},
+	{ 0.00804,  0, { 0, 0,  2, 0}},
+	{ 0.00454,  1, {-1, 1,  0, 0}},
+	{ 0.00204,  2, { 2, 0,  0, 0}},
+	{-0.0018,   0, { 0, 1, -2, 0}},
+	{-0.0007,   0, { 0, 1,  2, 0}},
+	{-0.0004,   0, { 0, 3,  0, 0}},
+	{-0.00034,  1, {-1, 2,  0, 0}},
+	{ 0.00032,  1, { 1, 0,  2, 0}},
+	{ 0.00032,  1, { 1, 0, -2, 0}},
+	{-0.00028,  2, { 2, 1,  0, 0}},
+	{ 0.00027,  1, { 1, 2,  0, 0}},
+	{-0.00017,  0, { 0, 0,  0, 1}},
+	{-0.00005,  0, {-1, 1, -2, 0}},
+	{ 0.00004,  0, { 0, 2,  2, 0}},
+	{-0.00004,  0, { 1, 1,  2, 0}},
+	{ 0.00004,  0, {-2, 1,  0, 0}},
+	{ 0.00003,  0, { 1, 1, -2, 0}},
+	{ 0.00003,  0, { 3, 0,  0, 0}},
+	{ 0.00002,  0, { 0, 2, -2, 0}},
+	{ 0.00002,  0, {-1, 1,  2, 0}},
+	{-0.00002,  0, { 1, 3,  0, 0}}
+};
 
-AMoon::AMoon()
+/// @brief Quarter phase W (cosine) terms - added for waxing, subtracted for waning quarter
+static const std::vector<SeriesTerm> s_quarterWTerms
+{
+	{ 0.00306,  0, { 0, 0,  0, 0}},
+	{-0.00038,  1, { 1, 0,  0, 0}},
+	{ 0.00026,  0, { 0, 1,  0, 0}},
+	{-0.00002,  0, {-1, 1,  0, 0}},
+	{ 0.00002,  0, { 1, 1,  0, 0}},
+	{ 0.00002,  0, { 0, 0,  2, 0}}
+};
+
+/// @brief Planetary arguments A1..A14 (PK) - degrees as a function of K
+static const std::vector<LinearSineTerm> s_planetaryArguments
+{
+	{0.000325, 299.77, 0.107408, -0.009173 / (MoonCycleDivisor * MoonCycleDivisor)},
+	{0.000165, 251.88, 0.016321,  0.},
+	{0.000164, 251.83, 26.651886, 0.},
+	{0.000126, 349.42, 36.412478, 0.},
+	{0.00011,  84.66,  18.206239, 0.},
+	{0.000062, 141.74, 53.303771, 0.},
+	{0.00006,  207.14, 2.453732,  0.},
+	{0.000056, 154.84, 7.30686,   0.},
+	{0.000047, 34.52,  27.261239, 0.},
+	{0.000042, 207.19, 0.121824,  0.},
+	{0.00004,  291.34, 1.844379,  0.},
+	{0.000037, 161.72, 24.198154, 0.},
+	{0.000035, 239.56, 25.513099, 0.},
+	{0.000023, 331.55, 3.592518,  0.}
+};
+
+static const ASeries s_newMoonSeries(s_newMoonTerms);
+static const ASeries s_fullMoonSeries(s_fullMoonTerms);
+static const ASeries s_quarterSeries(s_quarterTerms);
+static const ASeries s_quarterWSeries(s_quarterWTerms, true);
+
+static const std::array<const char*, 4> s_phaseName{"New Moon", "Waxing Quarter", "Full Moon", "Waning Quarter"};
+
+AMoon::AMoon(const AContext& context)
+	: m_verboseLevel(context.moonVerbose)
+	, m_phasePrecision(0.)
+	, m_lunarTheory(nullptr)
+	, m_phaseTable(nullptr)
 {
 	resestNextPhase();
 }
@@ -84,6 +218,7 @@ void AMoon::resestNextPhase()
 
 void AMoon::copyHelper(const AMoon& ref)
 {
+	m_verboseLevel   = ref.m_verboseLevel;
 	m_phase          = ref.m_phase;
 
 	// Next Phase computation
@@ -91,19 +226,22 @@ void AMoon::copyHelper(const AMoon& ref)
 	m_numberOfPhases = ref.m_numberOfPhases;
 	m_nextMoonCycle  = ref.m_nextMoonCycle;
 	m_lockMoonPhase  = ref.m_lockMoonPhase;
+
+	m_phasePrecision = ref.m_phasePrecision;
+	m_lunarTheory    = ref.m_lunarTheory;
+	m_phaseTable     = ref.m_phaseTable;
 }
 
-void AMoon::parseNextPhase(std::string arg)
+void AMoon::parseNextPhase(const char* arg)
 {
 	bool breakLoop = false;
 	int cycleIndex = 0;
 
 	// Need to resolve 32 characters, only
-	char args[32];
-	strncpy(args, arg.c_str(), 32);
-	char *options = args;
+	const char* options = arg;
+	const char* last = arg + strnlen(arg, 32);
 
-	while(!breakLoop && (*options != '\0'))
+	while(!breakLoop && (options < last))
 	{
 		if (isdigit(*options))
 		{
@@ -176,28 +314,51 @@ void AMoon::setVerboseMode(const int level)
     m_verboseLevel = level;
 }
 
+void AMoon::setContext(const AContext& context)
+{
+    m_verboseLevel = context.moonVerbose;
+}
+
 
 int AMoon::moonPhase(const ADateTime& dateTime)
 {
-	ADateTime newTime = dateTime;
 	PhaseInfo phase;
 
-	processPhase(dateTime, phase);
+	computeMoonPhase(dateTime, phase);
+
+	m_phase = phase;
 
 	return printPhase(phase);
 }
 
-int AMoon::processPhase(const ADateTime& dateTime, PhaseInfo& phase)
+int AMoon::computeMoonPhase(const ADateTime& dateTime, PhaseInfo& phase) const
 {
-	int nextPhase = 0;	// start with "new"
 	// Example of Julian Days is: 2017-3-1 should be 2457813.5
 	// https://www.subsystems.us/uploads/9/8/9/4/98948044/moonphase.pdf
-	double jd = dateTime.julianDay(true);
+	return computeMoonPhase(dateTime.instant().midnight(), phase);
+}
+
+int AMoon::computeMoonPhase(const AInstant instant, PhaseInfo& phase) const
+{
+	return computeMoonPhase(instant.julian(), phase);
+}
+
+int AMoon::computeMoonPhase(const double jd, PhaseInfo& phase) const
+{
+	int nextPhase = 0;	// start with "new"
 	phase.julian = jd;
 	phase.daysSince = static_cast<int>(jd - 2451549.5);
-	phase.newMoons = phase.daysSince / MoonDays;
+	// Fraction of the day too - same as whole days at midnight (dates), moves within a day for --range steps
+	phase.newMoons = (jd - 2451549.5) / MoonDays;
 
-	if (jd > 2451549.5)
+	if (m_lunarTheory != nullptr)
+	{
+		// Age of the Moon from the elongation of the true positions
+		LunarPosition position;
+		m_lunarTheory->position(ALunarTheory::julianCenturies(jd), position);
+		phase.daysFromNew = (position.elongation / 360.) * MoonDays;
+	}
+	else if (jd > 2451549.5)
 	{
 		phase.daysFromNew = (phase.newMoons - int(phase.newMoons)) * MoonDays;
 	}
@@ -222,8 +383,6 @@ int AMoon::processPhase(const ADateTime& dateTime, PhaseInfo& phase)
 	}
 	// Otherwise, new Moon
 
-	m_phase = phase;
-
 	return nextPhase;
 }
 
@@ -331,46 +490,45 @@ int AMoon::printPhase(const PhaseInfo& phase) const
 static double computeJdeFromK(const double& K)
 {
 	double T = K / MoonCycleDivisor;
-	double JDE = 2451550.09765 + (29.530588853 * K) + (0.0001337 * pow(T, 2.)) - (0.00000015 * pow(T, 3.)) + (0.00000000073 * pow(T, 4.));
+	double JDE = JdeOfFirstNewMoon + (SynodicMonth * K) + (0.0001337 * pow(T, 2.)) - (0.00000015 * pow(T, 3.)) + (0.00000000073 * pow(T, 4.));
 	// TODO: Add debug message for travelling through cycles
 	return JDE;
 }
 
-/// @brief Computes Moon Cycle for the phase - given year and day-of-year (from dateTime).
+/// @brief Computes Moon Cycle for the next phase from an instant.
 /// @param[in] phase - [0=new, 1=waxing quarter, 2=full, 3=waning quarter]
-/// @param[in] dateTime - date and time with JDE already computed
-/// @param[out] Y - year of conversion
-/// @param[out] K - number of moon of phases since J2000
+/// @param[in] instant - date and time
 /// @return Moon Cycle since J2000 (K)
-double AMoon::computeKForNextPhase(const int phase, const ADateTime& dateTime)
+double AMoon::computeKForNextPhase(const int phase, const AInstant instant) const
 {
-	// Computes from the year and the year-day
-	double Y = static_cast<double>(dateTime.year()) + (static_cast<double>(dateTime.dayOfYear()) / 365.25);
+	return computeKForJulian(phase, instant.julian());
+}
 
-	// K1 is number of moons since J2000.
-	double K1 = (Y - 2000.) * MoonsPerYear;
+double AMoon::meanJdeForK(const double K)
+{
+	return computeJdeFromK(K);
+}
 
-	double K = floor(K1) + (phase * 0.25);    // Phase is full (2)*0.25
+double AMoon::lunation(const double jd)
+{
+	// Inverse of computeJdeFromK() without the (small) T^2 terms
+	return (jd - JdeOfFirstNewMoon) / SynodicMonth;
+}
 
-	double JDE = computeJdeFromK(K);
+double AMoon::computeKForJulian(const int phase, const double jd)
+{
+	double shift = phase * 0.25;
 
-	if (AMoon::m_verboseLevel & DebugComputation)
-	{
-		std::cout << "--> Converting " << dateTime.year() << "-" << dateTime.month() << "-" << dateTime.day()
-			<< " and [" << dateTime.dayOfYear() << " days]=" << dateTime.julian() << " as " << Y << " years" << std::endl;
-		std::cout << "--> Last JDE for " << s_phaseName[phase] << " = " << JDE << " Number of Moons (since 2000) = " << K1 << std::endl;
-	}
-	
-	// Find next Julian Date/Time compared to the current one
-	while (JDE < dateTime.julian())
+	// Lunation index is within one cycle of the estimate - correct once either way
+	double K = ceil(lunation(jd) - shift) + shift;
+
+	if (computeJdeFromK(K) < jd)
 	{
 		K += 1.;
-		JDE = computeJdeFromK(K);
 	}
-
-	if (AMoon::m_verboseLevel & DebugComputation)
+	else if (computeJdeFromK(K - 1.) >= jd)
 	{
-		std::cout << "--> Date Conversion Y = " << Y << "; K phase = " << K << "; JDE = " << JDE << std::endl;
+		K -= 1.;
 	}
 
 	return K;
@@ -382,213 +540,265 @@ double AMoon::computeKForNextPhase(const int phase, const ADateTime& dateTime)
 /// @param[in] T - Tau - the percent of cycle within 100 year epoch
 /// @param[in] year - current year - used to compute seconds offset per each year since 0AD
 /// @return adjusted (fine-tuned) JDE down to the second
-double AMoon::fineTuneJdeForCycle(const int phase, const double& K, const int year)
+double AMoon::fineTuneJdeForCycle(const int phase, const double& K, const int year) const
 {
-	double JDE = computeJdeFromK(K);
+	double jde;
+	fineTuneJdeForCycles(phase, &K, &year, 1, &jde);
+	return jde;
+}
 
-	double T = K / MoonCycleDivisor;
+void AMoon::fineTuneJdeForCycles(const int phase, const double* K, const int* year, const size_t count, double* jde) const
+{
+	// Fundamental arguments (M, M', F, Omega) and E for each K
+	std::vector<double> args(SeriesArguments * count);
+	std::vector<double> E(count);
+	double* M = &args[0];
+	double* MS = &args[count];
+	double* F = &args[2 * count];
+	double* Omega = &args[3 * count];
+
+	for (size_t i = 0; i < count; i++)
+	{
+		double k = K[i];
+		double T = k / MoonCycleDivisor;
+
+		double T2 = T * T;
+		double T3 = T2 * T;
+		double T4 = T3 * T;
+
+		E[i] = 1. - (0.002516 * T) - (0.0000074 * T2);
+		M[i] = AlgBase::radianConvert(2.5534 + (29.10535669 * k) - (0.0000218 * T2) - (0.00000011 * T3));
+		MS[i] = AlgBase::radianConvert(201.5643 + (385.81693528 * k) + (0.0107438 * T2) + (0.00001239 * T3) - (0.000000058 * T4));
+		F[i] = AlgBase::radianConvert(160.7108 + (390.67050274 * k) - (0.0016341 * T2) - (0.00000227 * T3) + (0.000000011 * T4));
+		Omega[i] = AlgBase::radianConvert(124.7746 - (1.5637558 * k) + (0.0020691 * T2) + (0.00000215 * T3));
+	}
 
-	double T2 = T * T;
-	double T3 = T2 * T;
-	double T4 = T3 * T;
-
-	double E = 1. - (0.002516 * T) - (0.0000074 * T2);
-	double M = 2.5534 + (29.10535669 * K) - (0.0000218 * T2) - (0.00000011 * T3);
-	double MS = 201.5643 + (385.81693528 * K) + (0.0107438 * T2) + (0.00001239 * T3) - (0.000000058 * T4);
-	double F = 160.7108 + (390.67050274 * K) - (0.0016341 * T2) - (0.00000227 * T3) + (0.000000011 * T4);
-	double Omega = 124.7746 - (1.5637558 * K) + (0.0020691 * T2) + (0.00000215 * T3);
-
-	M = AlgBase::radianConvert(M);
-	MS = AlgBase::radianConvert(MS);
-	F = AlgBase::radianConvert(F);
-	Omega = AlgBase::radianConvert(Omega);
-
-	// Argumente der Planeten
-	double A1 = AlgBase::radianConvert(299.77 + (0.107408 * K) - (0.009173 * T2));
-	double A2 = AlgBase::radianConvert(251.88 + (0.016321 * K));
-	double A3 = AlgBase::radianConvert(251.83 + (26.651886 * K));
-	double A4 = AlgBase::radianConvert(349.42 + (36.412478 * K));
-	double A5 = AlgBase::radianConvert(84.66 + (18.206239 * K));
-	double A6 = AlgBase::radianConvert(141.74 + (53.303771 * K));
-	double A7 = AlgBase::radianConvert(207.14 + (2.453732 * K));
-	double A8 = AlgBase::radianConvert(154.84 + (7.30686 * K));
-	double A9 = AlgBase::radianConvert(34.52 + (27.261239 * K));
-	double A10 = AlgBase::radianConvert(207.19 + (0.121824 * K));
-	double A11 = AlgBase::radianConvert(291.34 + (1.844379 * K));
-	double A12 = AlgBase::radianConvert(161.72 + (24.198154 * K));
-	double A13 = AlgBase::radianConvert(239.56 + (25.513099 * K));
-	double A14 = AlgBase::radianConvert(331.55 + (3.592518 * K));
-
-	double PK = (0.000325 * sin(A1)) + (0.000165 * sin(A2)) + (0.000164 * sin(A3))
-		+ (0.000126 * sin(A4)) + (0.00011 * sin(A5)) + (0.000062 * sin(A6))
-		+ (0.00006 * sin(A7)) + (0.000056 * sin(A8)) + (0.000047 * sin(A9))
-		+ (0.000042 * sin(A10)) + (0.00004 * sin(A11)) + (0.000037 * sin(A12))
-		+ (0.000035 * sin(A13)) + (0.000023 * sin(A14));
-
-	double PT, W{ 0 };
+	const double* arguments[SeriesArguments]{M, MS, F, Omega};
+
+	// Planetary arguments (PK) in jde, phase corrections (PT) then W
+	std::vector<double> PT(count);
+	ASeries::evaluateLinear(s_planetaryArguments, K, count, jde, m_phasePrecision);
 
 	switch (phase)
 	{
 	default:
 	case 0: // New Moon
-		PT = (-0.4072 * sin(MS))
-			+ (0.17241 * E * sin(M))
-			+ (0.01608 * sin(2 * MS))
-			+ (0.01039 * sin(2 * F))
-			+ (0.00739 * E * sin(MS - M))
-			- (0.00514 * E * sin(MS + M))
-			+ (0.00208 * pow(E, 2.) * sin(2 * M))
-			- (0.00111 * sin(MS - (2 * F)))
-			- (0.00057 * sin(MS + 2 * F))
-			+ (0.00056 * E * sin(2 * MS + M))
-			- (0.00042 * sin(3 * MS))
-			+ (0.00042 * E * sin(M + 2 * F))
-			+ (0.00038 * E * sin(M - 2 * F))
-			- (0.00024 * E * sin(2 * MS - M))
-			- (0.00017 * sin(Omega))
-			- (0.00007 * sin(MS + 2 * M))
-			+ (0.00004 * sin(2 * MS - 2 * F))
-			+ (0.00004 * sin(3 * M))
-			+ (0.00003 * sin(MS + M - 2 * F))
-			+ (0.00003 * sin(2 * MS + 2 * F))
-			- (0.00003 * sin(MS + M + 2 * F))
-			+ (0.00003 * sin(MS - M + 2 * F))
-			- (0.00002 * sin(MS - M - 2 * F))
-			- (0.00002 * sin(3 * MS + M))
-			+ (0.00002 * sin(4 * MS));
-
+		s_newMoonSeries.evaluate(arguments, E.data(), count, PT.data(), m_phasePrecision);
 		break;
 
 	case 2: // Full Moon
-		PT = (-0.40614 * sin(MS))
-			+ (0.17302 * E * sin(M))
-			+ (0.01614 * sin(2 * MS))
-			+ (0.01043 * sin(2 * F))
-			+ (0.00734 * E * sin(MS - M))
-			- (0.00515 * E * sin(MS + M))
-			+ (0.00209 * pow(E, 2.) * sin(2 * M))
-			- (0.00111 * sin(MS - 2 * F))
-			- (0.00057 * sin(MS + 2 * F))
-			+ (0.00056 * E * sin(2 * MS + M))
-			- (0.00042 * sin(3 * MS))
-			+ (0.00042 * E * sin(M + 2 * F))
-			+ (0.00038 * E * sin(M - 2 * F))
-			- (0.00024 * E * sin(2 * MS - M))
-			- (0.00017 * sin(Omega))
-			- (0.00007 * sin(MS + 2 * M))
-			+ (0.00004 * sin(2 * MS - 2 * F))
-			+ (0.00004 * sin(3 * M))
-			+ (0.00003 * sin(MS + M - 2 * F))
-			+ (0.00003 * sin(2 * MS + 2 * F))
-			- (0.00003 * sin(MS + M + 2 * F))
-			+ (0.00003 * sin(MS - M + 2 * F))
-			- (0.00002 * sin(MS - M - 2 * F))
-			- (0.00002 * sin(3 * MS + M))
-			+ (0.00002 * sin(4 * MS));
-
+		s_fullMoonSeries.evaluate(arguments, E.data(), count, PT.data(), m_phasePrecision);
 		break;
 
 	case 1:
 	case 3: // Quarter Phase
-		PT = (-0.62801 * sin(MS))
-			+ (0.17172 * E * sin(M))
-			- (0.01183 * E * sin(MS + M))
-			+ (0.00862 * sin(2 * MS))
-			+ (0.00804 * sin(2 * F))
-			+ (0.00454 * E * sin(MS - M))
-			+ (0.00204 * pow(E, 2.) * sin(2 * M))
-			- (0.0018 * sin(MS - 2 * F))
-			- (0.0007 * sin(MS + 2 * F))
-			- (0.0004 * sin(3 * MS))
-			- (0.00034 * E * sin(2 * MS - M))
-			+ (0.00032 * E * sin(M + 2 * F))
-			+ (0.00032 * E * sin(M - 2 * F))
-			- (0.00028 * pow(E, 2.) * sin(MS + 2 * M))
-			+ (0.00027 * E * sin(2 * MS + M))
-			- (0.00017 * sin(Omega))
-			- (0.00005 * sin(MS - M - 2 * F))
-			+ (0.00004 * sin(2 * MS + 2 * F))
-			- (0.00004 * sin(MS + M + 2 * F))
-			+ (0.00004 * sin(MS - 2 * M))
-			+ (0.00003 * sin(MS + M - 2 * F))
-			+ (0.00003 * sin(3 * M))
-			+ (0.00002 * sin(2 * MS - 2 * F))
-			+ (0.00002 * sin(MS - M + 2 * F))
-			- (0.00002 * sin(3 * MS + M));
-
-		W = 0.00306 - (0.00038 * E * cos(M)) + (0.00026 * cos(MS))
-			- (0.00002 * cos(MS - M)) + (0.00002 * cos(MS + M)) + (0.00002 * cos(2 * F));
-
-		if (phase == 3)
+	{
+		std::vector<double> W(count);
+		s_quarterSeries.evaluate(arguments, E.data(), count, PT.data(), m_phasePrecision);
+		s_quarterWSeries.evaluate(arguments, E.data(), count, W.data(), m_phasePrecision);
+
+		double sign = (phase == 3) ? -1. : 1.;
+		for (size_t i = 0; i < count; i++)
 		{
-			W = -W;
+			PT[i] += sign * W[i];
 		}
-
 		break;
+	}
 	}  // End switch
 
-	// Compute number of seconds/year offset
-	double delta = AlgBase::deltaT(year) / 86400;
-
-	double total = JDE + PK + PT + W - delta;
-
-	if (AMoon::m_verboseLevel & DebugComputation)
+	for (size_t i = 0; i < count; i++)
 	{
-		std::cout << "PK = " << PK << "; PT = " << PT << "; W = " << W << "; delta = " << delta << std::endl;
-		std::cout << " Offset from JDE = " << JDE << " to " << total << std::endl;
+		// Compute number of seconds/year offset
+		double delta = AlgBase::deltaT(year[i]) / 86400;
+
+		jde[i] = computeJdeFromK(K[i]) + jde[i] + PT[i] - delta;
 	}
+}
 
-	return total;
+void AMoon::setPhasePrecision(const double days)
+{
+	m_phasePrecision = days;
 }
 
 
-void AMoon::displayMoonPhaseForK(const int phase, const double K, ADateTime& dateTime)
+PhaseEvent AMoon::computePhaseForK(const int phase, const double K, const int year) const
 {
-	double total = fineTuneJdeForCycle(phase, K, static_cast<double>(dateTime.year()));
+	PhaseEvent event;
 
-	// Update Julian date-time with new Julian date
-	dateTime.setJulianDateTime(total);
+	event.phase   = phase;
+	event.K       = K;
+	event.meanJde = computeJdeFromK(K);
+	event.jde     = fineTuneJdeForCycle(phase, K, year);
 
-	std::cout << "Next " << s_phaseName[phase] << ": " << dateTime.asString("%F %T [UTC]") << std::endl;
+	return event;
 }
 
+PhaseEvent AMoon::phaseForK(const int phase, const double K, const int year) const
+{
+	PhaseEvent event;
 
-int AMoon::nextMoonPhase(const ADateTime& dateTime, const int startPhase, const bool lockPhase, const int numOfPhases, const int numOfCycles)
+	// The table is computed with all terms and the delta-T of the year of each mean JDE
+	if ((m_phaseTable != nullptr) && (m_phasePrecision == 0.) && m_phaseTable->phaseForK(K, event))
+	{
+		int tableYear, month, day;
+		AlgBase::convertJulianToDate(event.meanJde + 0.5, tableYear, month, day);
+		if (tableYear != year)
+		{
+			event.jde += (AlgBase::deltaT(tableYear) - AlgBase::deltaT(year)) / 86400;
+		}
+		return event;
+	}
+
+	return computePhaseForK(phase, K, year);
+}
+
+
+int AMoon::computeNextPhases(const ADateTime& dateTime, const int startPhase, const bool lockPhase,
+	const int numOfPhases, const int numOfCycles, std::vector<PhaseEvent>& events) const
+{
+	return computeNextPhases(dateTime.instant(), startPhase, lockPhase, numOfPhases, numOfCycles, events);
+}
+
+int AMoon::computeNextPhases(const AInstant instant, const int startPhase, const bool lockPhase,
+	const int numOfPhases, const int numOfCycles, std::vector<PhaseEvent>& events) const
 {
-	ADateTime newDate = dateTime;
 	int phase = startPhase;
 
 	if (startPhase == -1)
 	{
-		phase = processPhase(dateTime, m_phase);
+		PhaseInfo current;
+		phase = computeMoonPhase(instant.midnight(), current);
 	}
 
-	// Show first phase, at least
-	std::cout << "---------------------------------------" << std::endl;
-	double K = computeKForNextPhase(phase, newDate);
+	double K = computeKForNextPhase(phase, instant);
 
 	// Add or subtract number of moon cycle from the date proposed
 	K += static_cast<double>(numOfCycles);
 
-	// Show the first phase computation
-	displayMoonPhaseForK(phase, K, newDate);
+	// The first phase uses the year of the date given - the following phases
+	// use the year of the phase before it
+	int year = instant.year();
+	events.push_back(phaseForK(phase, K, year));
 
 	// Cycle through number of phases
 	for (int i = 1; i < numOfPhases; i++)
 	{
-		std::cout << "---------------------------------------" << std::endl;
+		int month, day;
+		AlgBase::convertJulianToDate(events.back().jde + 0.5, year, month, day);
+
 		if (lockPhase)
 		{
-			// Advance date/time one day to get next phase
+			// Advance one cycle to get next phase
 			K += 1.;
-			displayMoonPhaseForK(phase, K, newDate);
 		}
 		else
 		{
-			phase = (++phase) % 4;
+			phase = (phase + 1) % 4;
 			K += 0.25;
-			displayMoonPhaseForK(phase, K, newDate);
 		}
+		events.push_back(phaseForK(phase, K, year));
+	}
+
+	return phase;
+}
+
+
+int AMoon::computePhasesInRange(const double jdStart, const double jdEnd, std::vector<PhaseEvent>& events) const
+{
+	if (jdEnd <= jdStart)
+	{
+		return 0;
+	}
+
+	size_t first = events.size();
+	events.reserve(first + static_cast<size_t>((jdEnd - jdStart) / SynodicMonth * 4.) + 4);
+
+	// Corrections move a phase less than a day from its mean JDE - start a quarter cycle
+	// before the day before jdStart (any phase)
+	double K = (floor(lunation(jdStart - 1.) * 4.) - 1.) * 0.25;
+	double jdeLimit = jdEnd + 1.;
+
+	int firstPhase = static_cast<int>(K * 4. - (4. * floor(K)));
+
+	// Cycles of each phase - evaluated together
+	int phase = firstPhase;
+	size_t total = 0;
+	std::array<std::vector<double>, 4> cycles;
+	std::array<std::vector<int>, 4> years;
+	for (double meanJde = computeJdeFromK(K); meanJde < jdeLimit; meanJde = computeJdeFromK(K))
+	{
+		int year, month, day;
+		AlgBase::convertJulianToDate(meanJde + 0.5, year, month, day);
+
+		cycles[phase].push_back(K);
+		years[phase].push_back(year);
+		phase = (phase + 1) % 4;
+		total++;
+		K += 0.25;
+	}
+
+	std::array<std::vector<double>, 4> jde;
+	for (phase = 0; phase < 4; phase++)
+	{
+		jde[phase].resize(cycles[phase].size());
+		fineTuneJdeForCycles(phase, cycles[phase].data(), years[phase].data(), cycles[phase].size(), jde[phase].data());
+	}
+
+	// Back in time order - the i-th phase is entry i/4 of its phase
+	for (size_t i = 0; i < total; i++)
+	{
+		phase = static_cast<int>((firstPhase + i) % 4);
+		size_t index = i / 4;
+
+		PhaseEvent event{phase, cycles[phase][index], computeJdeFromK(cycles[phase][index]), jde[phase][index]};
+		if ((event.jde >= jdStart) && (event.jde < jdEnd))
+		{
+			events.push_back(event);
+		}
+	}
+
+	return static_cast<int>(events.size() - first);
+}
+
+
+void AMoon::printPhaseEvent(const PhaseEvent& event) const
+{
+	ADateTime dateTime;
+
+	if (m_verboseLevel & DebugComputation)
+	{
+		std::cout << "--> " << s_phaseName[event.phase] << " K phase = " << event.K
+			<< "; Offset from JDE = " << event.meanJde << " to " << event.jde << std::endl;
+	}
+
+	// Update Julian date-time with new Julian date
+	dateTime.setJulianDateTime(event.jde);
+
+	std::cout << "Next " << s_phaseName[event.phase] << ": " << dateTime.asString("%F %T [UTC]") << std::endl;
+}
+
+
+int AMoon::nextMoonPhase(const ADateTime& dateTime, const int startPhase, const bool lockPhase, const int numOfPhases, const int numOfCycles)
+{
+	std::vector<PhaseEvent> events;
+
+	if (startPhase == -1)
+	{
+		computeMoonPhase(dateTime, m_phase);
+	}
+
+	int phase = computeNextPhases(dateTime, startPhase, lockPhase, numOfPhases, numOfCycles, events);
+
+	if (m_verboseLevel & DebugComputation)
+	{
+		std::cout << "--> Converting " << dateTime.year() << "-" << dateTime.month() << "-" << dateTime.day()
+			<< " and [" << dateTime.dayOfYear() << " days]=" << dateTime.julian() << std::endl;
+	}
+
+	for (auto& event : events)
+	{
+		std::cout << "---------------------------------------" << std::endl;
+		printPhaseEvent(event);
 	}
 
 	std::cout << "---------------------------------------" << std::endl;
@@ -597,6 +807,16 @@ int AMoon::nextMoonPhase(const ADateTime& dateTime, const int startPhase, const
 }
 
 
+int AMoon::computeNextPhases(const ADateTime& dateTime, std::vector<PhaseEvent>& events) const
+{
+	return computeNextPhases(dateTime.instant(), events);
+}
+
+int AMoon::computeNextPhases(const AInstant instant, std::vector<PhaseEvent>& events) const
+{
+	return computeNextPhases(instant, m_nextPhase, m_lockMoonPhase, m_numberOfPhases, m_nextMoonCycle, events);
+}
+
 int AMoon::nextMoonPhase(const ADateTime& dateTime)
 {
 	return nextMoonPhase(dateTime, m_nextPhase, m_lockMoonPhase, m_numberOfPhases, m_nextMoonCycle);
@@ -613,203 +833,305 @@ static constexpr double ARC = 206264.8062;
 static constexpr double COSEPS = 0.91748;
 static constexpr double SINEPS = 0.39778;
 
-// returns ra and dec of Moon to 5 arc min (ra) and 1 arc min (dec)
-// for a few centuries either side of J2000.0
+// Fundamental arguments (radians) of the low-precision theory: L, LS, d, F
+//   L  - mean anomaly of Moon
+//   LS - mean anomaly of Sun (shared by the Moon and Sun terms)
+//   d  - diff longitude sun and moon
+//   F  - mean arg latitude
+
+/// @brief Moon longitude correction terms (arc seconds)
+static const std::vector<SeriesTerm> s_moonLongitudeTerms
+{
+	{22640., 0, { 1,  0,  0, 0}},
+	{-4586., 0, { 1,  0, -2, 0}},
+	{ 2370., 0, { 0,  0,  2, 0}},
+	{  769., 0, { 2,  0,  0, 0}},
+	{ -668., 0, { 0,  1,  0, 0}},
+	{ -412., 0, { 0,  0,  0, 2}},
+	{ -212., 0, { 2,  0, -2, 0}},
+	{ -206., 0, { 1,  1, -2, 0}},
+	{  192., 0, { 1,  0,  2, 0}},
+	{ -165., 0, { 0,  1, -2, 0}},
+	{ -125., 0, { 0,  0,  1, 0}},
+	{ -110., 0, { 1,  1,  0, 0}},
+	{  148., 0, { 1, -1,  0, 0}},
+	{  -55., 0, { 0,  0, -2, 2}}
+};
+
+/// @brief Added to the longitude correction for the latitude argument S (arc seconds)
+static const std::vector<SeriesTerm> s_moonLatitudeArgumentTerms
+{
+	{  412., 0, { 0,  0,  0, 2}},
+	{  541., 0, { 0,  1,  0, 0}}
+};
+
+/// @brief Moon latitude correction terms (arc seconds) - h = F - 2d
+static const std::vector<SeriesTerm> s_moonLatitudeTerms
+{
+	{ -526., 0, { 0,  0, -2, 1}},
+	{   44., 0, { 1,  0, -2, 1}},
+	{  -31., 0, {-1,  0, -2, 1}},
+	{  -23., 0, { 0,  1, -2, 1}},
+	{   11., 0, { 0, -1, -2, 1}},
+	{  -25., 0, {-2,  0,  0, 1}},
+	{   21., 0, {-1,  0,  0, 1}}
+};
+
+/// @brief Sun equation of centre (arc seconds)
+static const std::vector<SeriesTerm> s_sunCentreTerms
+{
+	{ 6893., 0, { 0,  1,  0, 0}},
+	{   72., 0, { 0,  2,  0, 0}}
+};
+
+static const ASeries s_moonLongitudeSeries(s_moonLongitudeTerms);
+static const ASeries s_moonLatitudeArgumentSeries(s_moonLatitudeArgumentTerms);
+static const ASeries s_moonLatitudeSeries(s_moonLatitudeTerms);
+static const ASeries s_sunCentreSeries(s_sunCentreTerms);
+
+/// @brief Number of times computed together by lowPrecisionPositions()
+static constexpr size_t LowPrecisionBlock{64};
+
+/// @brief RA (hours) and DEC (degrees) of packed ecliptic longitudes and latitudes (radians) - fixed ecliptic
+static inline void eclipticToEquatorial(const VDouble lon, const VDouble lat, VDouble& ra, VDouble& dec)
+{
+	VDouble sinLon, cosLon, sinLat, cosLat;
+	vsincos(lon, sinLon, cosLon);
+	vsincos(lat, sinLat, cosLat);
+
+	VDouble x = cosLat * cosLon;
+	VDouble V = cosLat * sinLon;
+	VDouble y = (vset(COSEPS) * V) - (vset(SINEPS) * sinLat);
+	VDouble Z = (vset(SINEPS) * V) + (vset(COSEPS) * sinLat);
+	VDouble rho = vsqrt(vset(1.) - (Z * Z));
+
+	dec = vset(360. / Pi2) * vatan(Z / rho);
+
+	// Angle of (x, y) - the half angle form atan(y / (x + rho)) is 0/0 at 12 hours
+	ra = vset(24. / Pi2) * vatan2pos(y, x);
+}
+
+/// @brief Fractional part of packed doubles (same as AlgBase::fpart() for positive values)
+static inline VDouble vfpart(const VDouble x)
+{
+	return x - vfloor(x);
+}
+
+// From http://www.stargazing.net/kepler/ - coefficients in the tables above
+// Moon: RA to 5 arc min and DEC to 1 arc min for a few centuries either side of J2000.0
 // Predicts rise and set times to within minutes for about 500 years
 // in past - TDT and UT time diference may become significant for long
 // times
-void moon(double t, double &ra, double &dec)
+// Sun: RA and DEC to roughly 1 arcmin for few hundred years either side of J2000.0
+// Either body may be skipped (nullptr)
+static void lowPrecisionPositions(const double* t, const size_t count, double* moonRa, double* moonDec,
+	double* sunRa, double* sunDec)
 {
+	const bool useMoon = (moonRa != nullptr);
+	const bool useSun = (sunRa != nullptr);
+
+	for (size_t first = 0; first < count; first += LowPrecisionBlock)
+	{
+		size_t n = std::min(LowPrecisionBlock, count - first);
+		size_t padded = ((n + VDoubleWidth - 1) / VDoubleWidth) * VDoubleWidth;
+
+		// Remaining times padded with the last time
+		double tb[LowPrecisionBlock];
+		for (size_t i = 0; i < padded; i++)
+		{
+			tb[i] = t[first + std::min(i, n - 1)];
+		}
+
+		double args[SeriesArguments][LowPrecisionBlock];
+		for (size_t i = 0; i < padded; i += VDoubleWidth)
+		{
+			VDouble tv = vload(tb + i);
+			vstore(args[0] + i, vset(Pi2) * vfpart(vmadd(vset(1325.55241), tv, vset(.374897))));
+			vstore(args[1] + i, vset(Pi2) * vfpart(vmadd(vset(99.997361), tv, vset(.993133))));
+			vstore(args[2] + i, vset(Pi2) * vfpart(vmadd(vset(1236.853086), tv, vset(.827361))));
+			vstore(args[3] + i, vset(Pi2) * vfpart(vmadd(vset(1342.227825), tv, vset(.259086))));
+		}
+		const double* arguments[SeriesArguments]{args[0], args[1], args[2], args[3]};
+
+		// All series from the same sines/cosines of the arguments
+		double dL[LowPrecisionBlock];
+		double dS[LowPrecisionBlock];
+		double N[LowPrecisionBlock];
+		double sunDL[LowPrecisionBlock];
+
+		const ASeries* series[4];
+		double* results[4];
+		size_t seriesCount = 0;
+		if (useMoon)
+		{
+			series[seriesCount] = &s_moonLongitudeSeries;
+			results[seriesCount++] = dL;
+			series[seriesCount] = &s_moonLatitudeArgumentSeries;
+			results[seriesCount++] = dS;
+			series[seriesCount] = &s_moonLatitudeSeries;
+			results[seriesCount++] = N;
+		}
+		if (useSun)
+		{
+			series[seriesCount] = &s_sunCentreSeries;
+			results[seriesCount++] = sunDL;
+		}
+		ASeries::evaluate(series, seriesCount, arguments, nullptr, padded, results);
 
-	double L0 = AlgBase::fpart(.606433 + 1336.855225 * t);     // mean long Moon in revs
-	double L = Pi2 * AlgBase::fpart(.374897 + 1325.55241 * t);  // mean anomaly of Moon
-	double LS = Pi2 * AlgBase::fpart(.993133 + 99.997361 * t);  // mean anomaly of Sun
-	double d = Pi2 * AlgBase::fpart(.827361 + 1236.853086 * t); // diff longitude sun and moon
-	double F = Pi2 * AlgBase::fpart(.259086 + 1342.227825 * t); // mean arg latitude
+		double ra[LowPrecisionBlock];
+		double dec[LowPrecisionBlock];
+		if (useMoon)
+		{
+			for (size_t i = 0; i < padded; i += VDoubleWidth)
+			{
+				VDouble tv = vload(tb + i);
+				VDouble dLv = vload(dL + i);
 
-	// longitude correction terms
-	double dL = 22640 * sin(L) - 4586 * sin(L - 2 * d);
-	dL = dL + 2370 * sin(2 * d) + 769 * sin(2 * L);
-	dL = dL - 668 * sin(LS) - 412 * sin(2 * F);
-	dL = dL - 212 * sin(2 * L - 2 * d) - 206 * sin(L + LS - 2 * d);
-	dL = dL + 192 * sin(L + 2 * d) - 165 * sin(LS - 2 * d);
-	dL = dL - 125 * sin(d) - 110 * sin(L + LS);
-	dL = dL + 148 * sin(L - LS) - 55 * sin(2 * F - 2 * d);
+				VDouble L0 = vfpart(vmadd(vset(1336.855225), tv, vset(.606433)));    // mean long Moon in revs
+				VDouble S = vload(args[3] + i) + ((dLv + vload(dS + i)) / vset(ARC));  // latitude argument
 
-	// latitude arguments
-	double S = F + (dL + 412 * sin(2 * F) + 541 * sin(LS)) / ARC;
-	double h = F - 2 * d;
+				VDouble sinS, cosS;
+				vsincos(S, sinS, cosS);
 
-	// latitude correction terms
-	double N = -526 * sin(h) + 44 * sin(L + h) - 31 * sin(h - L) - 23 * sin(LS + h);
-	N = N + 11 * sin(h - LS) - 25 * sin(F - 2 * L) + 21 * sin(F - L);
+				VDouble lmoon = vset(Pi2) * vfpart(L0 + (dLv / vset(1296000.)));
+				VDouble bmoon = vmadd(vset(18520.), sinS, vload(N + i)) / vset(ARC);
 
-	double lmoon = Pi2 * AlgBase::fpart(L0 + dL / 1296000.);  // Lat in rads
-	double bmoon = (18520. * sin(S) + N) / ARC;     // long in rads
+				VDouble rav, decv;
+				eclipticToEquatorial(lmoon, bmoon, rav, decv);
+				vstore(ra + i, rav);
+				vstore(dec + i, decv);
+			}
 
-	// convert to equatorial coords using a fixed ecliptic
-	double CB = cos(bmoon);
-	double x = CB * cos(lmoon);
+			std::copy(ra, ra + n, moonRa + first);
+			std::copy(dec, dec + n, moonDec + first);
+		}
 
-	double V = CB * sin(lmoon);
-	double W = sin(bmoon);
-	double y = COSEPS * V - SINEPS * W;
-	double Z = SINEPS * V + COSEPS * W;
-	double rho = sqrt(1. - Z * Z);
+		if (useSun)
+		{
+			for (size_t i = 0; i < padded; i += VDoubleWidth)
+			{
+				VDouble tv = vload(tb + i);
+				VDouble m = vload(args[1] + i);   // Mean anomaly
 
-	dec = (360. / Pi2) * atan(Z / rho);
-	ra = (48. / Pi2) * atan(y / (x + rho));
+				// ecliptic latitude of Sun taken as zero
+				VDouble L = vset(Pi2) * vfpart(vset(0.7859453) + (m / vset(Pi2))
+					+ (vmadd(vset(6191.2), tv, vload(sunDL + i)) / vset(1296000.)));
 
-	if (ra < 0)
-	{
-		ra = ra + 24.;
+				VDouble rav, decv;
+				eclipticToEquatorial(L, vset(0.), rav, decv);
+				vstore(ra + i, rav);
+				vstore(dec + i, decv);
+			}
+
+			std::copy(ra, ra + n, sunRa + first);
+			std::copy(dec, dec + n, sunDec + first);
+		}
 	}
 }
 
-// Returns RA and DEC of Sun to roughly 1 arcmin for few hundred
-// years either side of J2000.0
-void sun(double t, double &ra, double &dec)
+void AMoon::moonEquatorial(const double t, double& ra, double& dec)
 {
-	double m = Pi2 * AlgBase::fpart(0.993133 + 99.997361 * t);        // Mean anomaly
-	double dL = 6893. * sin(m) + 72. * sin(2 * m);          // Eq centre
-
-	double L = Pi2 * AlgBase::fpart(0.7859453 + m / Pi2 + (6191.2 * t + dL) / 1296000.);
+	lowPrecisionPositions(&t, 1, &ra, &dec, nullptr, nullptr);
+}
 
-	// convert to RA and DEC - ecliptic latitude of Sun taken as zero
-	double sl = sin(L);
-	double x = cos(L);
-	double y = COSEPS * sl;
-	double Z = SINEPS * sl;
-	double rho = sqrt(1. - Z * Z);
+void AMoon::sunEquatorial(const double t, double& ra, double& dec)
+{
+	lowPrecisionPositions(&t, 1, nullptr, nullptr, &ra, &dec);
+}
 
-	dec = (360. / Pi2) * atan(Z / rho);
-	ra = (48. / Pi2) * atan(y / (x + rho));
-	if (ra < 0)
-	{
-		ra = ra + 24.;
-	}
+void AMoon::moonEquatorial(const double* t, const size_t count, double* ra, double* dec)
+{
+	lowPrecisionPositions(t, count, ra, dec, nullptr, nullptr);
 }
 
+void AMoon::sunEquatorial(const double* t, const size_t count, double* ra, double* dec)
+{
+	lowPrecisionPositions(t, count, nullptr, nullptr, ra, dec);
+}
 
-static double sinalt(const ALocation& location, int iobj, double mjd0, double hour)
+void AMoon::moonSunEquatorial(const double* t, const size_t count, double* moonRa, double* moonDec,
+	double* sunRa, double* sunDec)
 {
+	lowPrecisionPositions(t, count, moonRa, moonDec, sunRa, sunDec);
+}
 
-	// ' returns sine of the altitude of either the sun or the moon given the
-	// ' modified julian day number at midnight UT and the hour of the UT day,
-	// ' the longitude of the observer, and the sine and cosine of the latitude
-	// ' of the observer
-	double ra = 0;
-	double dec = 0;
+// Crossings bracketed by the rate of the altitude and refined by Brent's method (see ASweep, AEventFinder)
+void AMoon::computeMoonRise(const ALocation& location, const ADateTime& procTime, MoonRiseInfo& info) const
+{
+	// Midnight local time in the zone of the date (name, or offset and DST)
+	computeMoonRise(location, procTime.zone()->localMidnight(procTime.instant()), info);
+}
 
-	double instant = mjd0 + hour / 24.;
-	double t = (instant - 51544.5) / 36525.;
+void AMoon::computeMoonRise(const ALocation& location, const AInstant dayStart, MoonRiseInfo& info) const
+{
+	// Moon, Sun and Nautical twilight (DefaultSweepHorizons) - Sun is searched once for both horizons
+	ASweep sweep(location);
+	sweep.setLunarTheory(m_lunarTheory);
 
-	double altitude = -1;
+	double date = dayStart.modifiedJulian();
 
-	if (ADateTime::m_verboseLevel & DebugJulianDate)
+	for (auto& riseSet : info)
 	{
-		std::cout << "Converting Julian " << instant << " to local " << static_cast<int>(hour) << " hour sidereal: " << t << std::endl;
+		riseSet = RiseSetInfo{0., 0., false, false, false};
 	}
- 
-	if (iobj == 0)
+
+	// First rise and first set of the day
+	sweep.sweep(date, 1, [&info, date](const SweepEvent& event)
 	{
-		moon(t, ra, dec);
-		altitude = AlgBase::localAltitude(location, instant, ra, dec);
-		if (AMoon::m_verboseLevel & DebugComputation)
+		RiseSetInfo& riseSet = info[event.horizon];
+		double hour = (event.mjd - date) * 24.;
+		if (event.rise && !riseSet.rise)
 		{
-			std::cout << "Moon (" << hour << "hr): RA = " << ra << " Decl = " << dec << " Alt = " << altitude << std::endl;
+			riseSet.utRise = hour;
+			riseSet.rise = true;
 		}
-	}
-	else
-	{
-		sun(t, ra, dec);
-		altitude = AlgBase::localAltitude(location, instant, ra, dec);
-		if (AMoon::m_verboseLevel & DebugComputation)
+		else if (!event.rise && !riseSet.sett)
 		{
-			std::cout << "Sun (" << hour << "hr): RA = " << ra << " Decl = " << dec << " Alt = " << altitude << std::endl;
+			riseSet.utSet = hour;
+			riseSet.sett = true;
 		}
-	}
+	});
 
-	return altitude;
+	// Check if object already above the horizon
+	for (int iobj = 0; iobj < NumberOfRiseSetObjects; iobj++)
+	{
+		info[iobj].above = sweep.aboveAtStart(iobj);
+	}
 }
 
 
-static AObject objects[3]
+void AMoon::moonRise(const ALocation& location, const ADateTime& procTime)
 {
-	{"Moon", AltitudeType::MoonObject, true},
-	{"Sun",  AltitudeType::ActualSun, false},
-	{"Nautical twilight", AltitudeType::NauticalSun, false}
-};
+	AObject objects[NumberOfRiseSetObjects]
+	{
+		{"Moon", AltitudeType::MoonObject, true},
+		{"Sun",  AltitudeType::ActualSun, false},
+		{"Nautical twilight", AltitudeType::NauticalSun, false}
+	};
 
+	MoonRiseInfo info;
 
-// Approximation Method
-void AMoon::moonRise(const ALocation& location, const ADateTime& procTime)
-{
-	ADateTime dateTime = procTime;
 	std::cout << std::endl << "-------------Moon-Sun-Rise/Set-------------------" << std::endl;
 
-	// UTC with time-zone adjusted - midnight local time
-	double date = dateTime.modifiedJuiianDate(true);
-
 	if (m_verboseLevel & DebugJulianDate)
 	{
-		std::cout << "Modified Julian (for moonRise): " << date << std::endl;
+		std::cout << "Modified Julian (for moonRise): " << procTime.modifiedJuiianDate(true)
+			<< " using TZ=" << procTime.timeZoneAsFractionOfDay() * 24. << std::endl;
 	}
 
-	// define the altitudes for each object
-	// treat twilight as a separate object 3, so sinalt routine
-	// falls through to finding Sun altitude again
+	computeMoonRise(location, procTime, info);
 
-	for (int iobj = 0; iobj < 3; iobj++)
+	for (int iobj = 0; iobj < NumberOfRiseSetObjects; iobj++)
 	{
-		AObject& obj = objects[iobj];
-
-		obj.resetSettings();
-
-		double hour = 1.;
-		double sinho = obj.m_sinHorizontal;
-
-		double yPrior = sinalt(location, iobj, date, hour - 1) - sinho;
-
-		double yCurr = 0.;
-		double yNext = 0.;
-
-		// Check if object already above the horizon
-		obj.m_above  = (yPrior > 0);
-
-		// used later to classify non-risings
-		do {
-			yCurr = sinalt(location, iobj, date, hour) - sinho;
-			yNext = sinalt(location, iobj, date, hour + 1) - sinho;
-
-			// Approximate for zero and compute for next
-			obj.adjustForNext(yPrior, yCurr, yNext, hour);
-
-			yPrior = yNext;     // 'reuse the ordinate in the next interval
-
-			hour = hour + 2;    // Skip to get next block
-
-			if (m_verboseLevel & DebugComputation)
-			{
-				std::cout << "------ solution: prev = " << yPrior << " curr = " << yCurr << " next = " << yNext << std::endl;
-			}
-		} while ((hour < 25) && (!(obj.m_rise && obj.m_sett)));
-
-		if (m_verboseLevel & DebugComputation)
-		{
-			std::cout << "-Final solution: prev = " << yPrior << " curr = " << yCurr << " next = " << yNext << std::endl;
-		}
-
 		if (iobj != 0)
 		{
 			std::cout << std::endl;
 		}
 
 		// Just note, utrise and utset times are actually local time UTC time
-		obj.printRiseSetTimes();
-
-	}   // End for objects
+		objects[iobj].setRiseSetInfo(info[iobj]);
+		objects[iobj].printRiseSetTimes();
+	}
 
 	std::cout << "-------------------------------------------------" << std::endl << std::endl;
 }
-
@@ -26,10 +26,16 @@
 
 #include <cstring>
 #include <cmath>
+#include <array>
+#include <vector>
 
 #include "AlgBase.h"
 
 #include "ADateTime.h"
+#include "AObject.h"
+#include "ALunarTheory.h"
+
+class APhaseTable;
 
 using DateString = std::string;
 
@@ -57,10 +63,27 @@ using PhaseInfo = struct _moonPhase
 
 #endif
 
+/// @brief A principal Moon phase event computed by computeNextPhases()
+using PhaseEvent = struct _phaseEvent
+{
+	int    phase;    // 0=new, 1=waxing quarter, 2=full, 3=waning quarter
+	double K;        // Moon cycles since J2000 (plus phase fraction)
+	double meanJde;  // JDE of mean phase (before corrections)
+	double jde;      // Julian date of the phase (corrections applied)
+};
+
+/// @brief Number of objects computed for rise/set - Moon, Sun and Nautical twilight
+constexpr int NumberOfRiseSetObjects{3};
+
+/// @brief Rise/set results for the Moon[0], Sun[1] and Nautical twilight[2]
+using MoonRiseInfo = std::array<RiseSetInfo, NumberOfRiseSetObjects>;
+
 class AMoon : public AlgBase
 {
 public:
-	AMoon();
+	/// @brief Constructor
+	/// @param[in] context - verbose level of the request
+	AMoon(const AContext& context = DefaultContext);
 
 	AMoon(const AMoon& ref);
 
@@ -70,21 +93,163 @@ public:
 
 	void resestNextPhase();
 
-	void parseNextPhase(std::string arg);
+	void parseNextPhase(const char* arg);
+
+	//--------------------------------------------------------------------------
+	// Computation (no console output)
+	//--------------------------------------------------------------------------
+
+	/// @brief Computes the current Moon Phase.
+	/// @param[in] dateTime - date (midnight UTC)
+	/// @param[out] phase - phase information
+	/// @return "Next Phase" value
+	int computeMoonPhase(const ADateTime& dateTime, PhaseInfo& phase) const;
+
+	/// @brief Computes the Moon Phase at an instant.
+	/// @param[in] instant
+	/// @param[out] phase - phase information
+	/// @return "Next Phase" value
+	int computeMoonPhase(const AInstant instant, PhaseInfo& phase) const;
+
+	/// @brief Computes the Moon Phase at a Julian date (and time).
+	/// @param[in] jd - Julian date
+	/// @param[out] phase - phase information
+	/// @return "Next Phase" value
+	int computeMoonPhase(const double jd, PhaseInfo& phase) const;
+
+	/// @brief Computes Moon, Sun and Nautical twilight rise/set times for the day.
+	/// @param[in] location
+	/// @param[in] procTime - of the day
+	/// @param[out] info - rise/set results for each object
+	void computeMoonRise(const ALocation& location, const ADateTime& procTime, MoonRiseInfo& info) const;
+
+	/// @brief Computes Moon, Sun and Nautical twilight rise/set times for one day from an instant.
+	/// @param[in] location
+	/// @param[in] dayStart - start of the day (e.g. AInstant::localMidnight())
+	/// @param[out] info - rise/set results for each object (hours from dayStart)
+	void computeMoonRise(const ALocation& location, const AInstant dayStart, MoonRiseInfo& info) const;
+
+	/// @brief Computes Next Moon Phases from give dateTime.
+	/// @param[in] dateTime - Set date and time
+	/// @param[in] startPhase - next phase from dateTime (-1 uses the current phase)
+	/// @param[in] lockPhase - Compute only the phase in startPhase
+	/// @param[in] numOfPhases - number of phases to compute
+	/// @param[in] numOfCycles - Moon cycles added to (or subtracted from) the first phase
+	/// @param[out] events - phases computed (in order)
+	/// @return last phase computed
+	int computeNextPhases(const ADateTime& dateTime, const int startPhase, const bool lockPhase,
+		const int numOfPhases, const int numOfCycles, std::vector<PhaseEvent>& events) const;
+
+	/// @brief Computes Next Moon Phases from an instant (see above).
+	int computeNextPhases(const AInstant instant, const int startPhase, const bool lockPhase,
+		const int numOfPhases, const int numOfCycles, std::vector<PhaseEvent>& events) const;
+
+	/// @brief Computes Next Moon Phases from give dateTime using the settings of parseNextPhase().
+	/// @param[in] dateTime - Set date and time
+	/// @param[out] events - phases computed (in order)
+	/// @return last phase computed
+	int computeNextPhases(const ADateTime& dateTime, std::vector<PhaseEvent>& events) const;
 
-	/// @brief Compute the current Moon Phase.
+	/// @brief Computes Next Moon Phases from an instant using the settings of parseNextPhase().
+	int computeNextPhases(const AInstant instant, std::vector<PhaseEvent>& events) const;
+
+	/// @brief Computes all principal phases (new, quarters, full) within a range of Julian dates.
+	/// @param[in] jdStart - first Julian date (inclusive)
+	/// @param[in] jdEnd - last Julian date (exclusive)
+	/// @param[out] events - phases are appended in time order
+	/// @return number of phases appended
+	int computePhasesInRange(const double jdStart, const double jdEnd, std::vector<PhaseEvent>& events) const;
+
+	/// @brief Sets precision of phase corrections - correction terms smaller than this are skipped.
+	/// @param[in] days - largest skipped term (0 = all terms, 0.0001 = about 10 seconds)
+	void setPhasePrecision(const double days);
+
+	/// @brief Precision of phase corrections (days)
+	double getPhasePrecision() const { return m_phasePrecision; }
+
+	/// @brief Sets the lunar theory for phases and rise/set (nullptr - mean synodic month and low precision positions)
+	/// @param[in] theory - not owned
+	void setLunarTheory(const ALunarTheory* theory) { m_lunarTheory = theory; }
+
+	/// @brief Lunar theory (nullptr - not used)
+	const ALunarTheory* lunarTheory() const { return m_lunarTheory; }
+
+	/// @brief Sets the phase table of computeNextPhases() (nullptr - phases are computed)
+	/// @param[in] table - not owned (used while the phase precision is 0 - all terms)
+	void setPhaseTable(const APhaseTable* table) { m_phaseTable = table; }
+
+	/// @brief Phase table (nullptr - not used)
+	const APhaseTable* phaseTable() const { return m_phaseTable; }
+
+	/// @brief Mean phase JDE (before corrections) of a Moon cycle.
+	/// @param[in] K - Moon cycles since J2000 (plus phase fraction)
+	/// @return JDE of the mean phase
+	static double meanJdeForK(const double K);
+
+	/// @brief Mean lunation number (Moon cycles since the New Moon of 2000-01-06) of a Julian date.
+	/// @param[in] jd - Julian date
+	/// @return lunation number with fraction (0.5 is about full Moon)
+	static double lunation(const double jd);
+
+	/// @brief Computes Moon Cycle (K) of the first mean phase at or after a Julian date - in constant time.
+	/// @param[in] phase - [0=new, 1=waxing quarter, 2=full, 3=waning quarter]
+	/// @param[in] jd - Julian date
+	/// @return Moon Cycle since J2000 (K) plus phase fraction
+	static double computeKForJulian(const int phase, const double jd);
+
+	/// @brief Low-precision RA and DEC of the Moon - 5 arc min (ra), 1 arc min (dec)
+	/// @param[in] t - Julian centuries since J2000
+	/// @param[out] ra - hours
+	/// @param[out] dec - degrees
+	static void moonEquatorial(const double t, double& ra, double& dec);
+
+	/// @brief Low-precision RA and DEC of the Sun - 1 arc min
+	/// @param[in] t - Julian centuries since J2000
+	/// @param[out] ra - hours
+	/// @param[out] dec - degrees
+	static void sunEquatorial(const double t, double& ra, double& dec);
+
+	/// @brief Low-precision RA and DEC of the Moon for an array of times
+	/// @param[in] t - Julian centuries since J2000
+	/// @param[in] count - number of times
+	/// @param[out] ra - hours
+	/// @param[out] dec - degrees
+	static void moonEquatorial(const double* t, const size_t count, double* ra, double* dec);
+
+	/// @brief Low-precision RA and DEC of the Sun for an array of times
+	/// @param[in] t - Julian centuries since J2000
+	/// @param[in] count - number of times
+	/// @param[out] ra - hours
+	/// @param[out] dec - degrees
+	static void sunEquatorial(const double* t, const size_t count, double* ra, double* dec);
+
+	/// @brief Low-precision RA and DEC of the Moon and the Sun for an array of times - shared arguments computed once
+	/// @param[in] t - Julian centuries since J2000
+	/// @param[in] count - number of times
+	/// @param[out] moonRa - hours
+	/// @param[out] moonDec - degrees
+	/// @param[out] sunRa - hours
+	/// @param[out] sunDec - degrees
+	static void moonSunEquatorial(const double* t, const size_t count, double* moonRa, double* moonDec,
+		double* sunRa, double* sunDec);
+
+	//--------------------------------------------------------------------------
+	// Display
+	//--------------------------------------------------------------------------
+
+	/// @brief Compute and display the current Moon Phase.
 	/// @param[in] dateTime
 	/// @return "Next Phase" value
 	int moonPhase(const ADateTime& dateTime);
 
-	/// @brief Computes Moon rise/set times
+	/// @brief Computes and displays Moon rise/set times
 	/// @param[in] location
 	/// @param[in] procTime - of the day
 	void moonRise(const ALocation& location, const ADateTime& procTime);
 
 	int nextMoonPhase(const ADateTime& dateTime);
 
-	/// @brief Computes Next Moon Phase from give dateTime.
+	/// @brief Computes and displays Next Moon Phase from give dateTime.
 	/// @param[in] dateTime - Set date and time
 	/// @param[in] startPhase - next phase from dateTime
 	/// @param[in] lockPhase - Show only the phase in startPhase
@@ -94,29 +259,48 @@ public:
     /// @param[in] level - 0=quiet(results only) non-zero(prints debug info)
     void setVerboseMode(const int level);
 
-	static int m_verboseLevel;
+    /// @brief Sets verbose level from context
+    /// @param[in] context - settings of the request
+    void setContext(const AContext& context);
+
+	int  m_verboseLevel;
 
 	int  m_nextPhase;
 	int  m_numberOfPhases;
 	int  m_nextMoonCycle;
 	bool m_lockMoonPhase;
 
+	/// @brief Phase correction terms smaller than this (days) are skipped
+	double m_phasePrecision;
+
+	/// @brief Lunar theory of the Moon's position (not owned - nullptr if not used)
+	const ALunarTheory* m_lunarTheory;
+
+	/// @brief Precomputed phases of computeNextPhases() (not owned - nullptr if not used)
+	const APhaseTable* m_phaseTable;
+
 
 private:
 
 	void copyHelper(const AMoon& ref);
 
-	int processPhase(const ADateTime& jd, PhaseInfo& phase);
-
 	int printPhase(const PhaseInfo& phase) const;
 
-	/// @brief Computes Moon Cycle for the phase - given year and day-of-year (from dateTime).
+	/// @brief Prints a phase event computed by computeNextPhases()
+	void printPhaseEvent(const PhaseEvent& event) const;
+
+	/// @brief Phase of a Moon cycle - from the phase table if it holds the cycle, otherwise computed.
 	/// @param[in] phase - [0=new, 1=waxing quarter, 2=full, 3=waning quarter]
-	/// @param[in] dateTime - date and time with JDE already computed
-	/// @param[out] Y - year of conversion
-	/// @param[out] K - number of moon of phases since J2000
+	/// @param[in] K - Moon cycle since J2000 (plus phase fraction)
+	/// @param[in] year - year used for delta-T
+	/// @return phase event
+	PhaseEvent phaseForK(const int phase, const double K, const int year) const;
+
+	/// @brief Computes Moon Cycle for the next phase from an instant (see computeKForJulian).
+	/// @param[in] phase - [0=new, 1=waxing quarter, 2=full, 3=waning quarter]
+	/// @param[in] instant - date and time
 	/// @return Moon Cycle since J2000 (K)
-	double computeKForNextPhase(const int phase, const ADateTime& dateTime);
+	double computeKForNextPhase(const int phase, const AInstant instant) const;
 
 	/// @brief Computes offset of the given phase for the cycle and the 100-year epoch.
 	/// @param[in] phase - (0= new)
@@ -124,12 +308,22 @@ private:
 	/// @param[in] T - Tau - the percent of cycle within 100 year epoch
 	/// @param[in] year - current year - used to compute seconds offset per each year since 0AD
 	/// @return adjusted (fine-tuned) JDE down to the second
-	double fineTuneJdeForCycle(const int phase, const double& K, const int year);
+	double fineTuneJdeForCycle(const int phase, const double& K, const int year) const;
 
-	/// @brief Shows precise Moon phase date/time for a given since J2000 (K) - adjusts DateTime by Julian date.
+	/// @brief Computes adjusted (fine-tuned) JDEs of one phase for arrays of cycles.
+	/// @param[in] phase - (0= new)
+	/// @param[in] K - array of Moon cycles plus shifted phase since J2000
+	/// @param[in] year - array of years used for delta-T
+	/// @param[in] count - number of cycles
+	/// @param[out] jde - adjusted JDEs
+	void fineTuneJdeForCycles(const int phase, const double* K, const int* year, const size_t count, double* jde) const;
+
+	/// @brief Computes precise Moon phase date/time for a given cycle since J2000 (K).
+	/// @param[in] phase - phase of the cycle
 	/// @param[in] K - Moon cycles since J2000
-	/// @param[in,out] dateTime - DateTime to modify
-	void displayMoonPhaseForK(const int phase, const double K, ADateTime& dateTime);
+	/// @param[in] year - year used for delta-T
+	/// @return phase event
+	PhaseEvent computePhaseForK(const int phase, const double K, const int year) const;
 
 	PhaseInfo m_phase;
 
@@ -27,8 +27,16 @@
 #include "AlgBase.h"
 #include "ADateTime.h"
 
-// static
-std::array<double, NumberOfAltTypes> AObject::m_sinho;
+// static - Set the object refraction deviations (initialized before main, never modified)
+const std::array<double, NumberOfAltTypes> AObject::m_sinho
+{
+	0.,
+	AlgBase::sinDegrees(8. / 60.),   // moonrise - average diameter used
+	AlgBase::sinDegrees(-50. / 60.), // sunrise - classic value for refraction
+	AlgBase::sinDegrees(-6.),        // snrise/set - civil (6degrees) twilight
+	AlgBase::sinDegrees(-12.),       // nautical twilight
+	AlgBase::sinDegrees(-18.)        // astronomical twilight
+};
 
 
 AObject::AObject(const char* name, const AltitudeType altType, bool brightObject)
@@ -69,20 +77,23 @@ void AObject::resetSettings()
 }
 
 
+RiseSetInfo AObject::riseSetInfo() const
+{
+	return RiseSetInfo{m_utRise, m_utSet, m_rise, m_sett, m_above};
+}
+
+void AObject::setRiseSetInfo(const RiseSetInfo& info)
+{
+	m_utRise = info.utRise;
+	m_utSet  = info.utSet;
+	m_rise   = info.rise;
+	m_sett   = info.sett;
+	m_above  = info.above;
+}
+
+
 void AObject::setAltitudeType(const AltitudeType type)
 {
-	// Set the object refraction deviations
-	static bool bFirst = true;
-	if (bFirst)
-	{
-		m_sinho[0] = 0;
-		m_sinho[1] = AlgBase::sinDegrees(8. / 60.);   // moonrise - average diameter used
-		m_sinho[2] = AlgBase::sinDegrees(-50. / 60.); // sunrise - classic value for refraction
-		m_sinho[3] = AlgBase::sinDegrees(-6.);        // snrise/set - civil (6degrees) twilight
-		m_sinho[4] = AlgBase::sinDegrees(-12.);       // nautical twilight
-		m_sinho[5] = AlgBase::sinDegrees(-18.);       // astronomical twilight
-		bFirst = false;
-	}
 	m_sinHorizontal = m_sinho[static_cast<int>(type)];
 }
 
@@ -46,6 +46,18 @@ enum class AltitudeType : int
 constexpr int NumberOfAltTypes{6};
 
 
+/// @brief Rise/set result of an object for one day.
+/// NOTE: Rise/set hours are from midnight of the local date expressed in UTC
+using RiseSetInfo = struct _riseSetInfo
+{
+	double utRise;   // hour of rise
+	double utSet;    // hour of set
+	bool   rise;     // true if the object rises within the day
+	bool   sett;     // true if the object sets within the day
+	bool   above;    // true if the object was above the horizon at start of day
+};
+
+
 // Base object for all objects
 class AObject
 {
@@ -66,6 +78,13 @@ public:
 	/// @brief Adjusts time hourly to check ends and resolved current
 	void adjustForNext(double yPrior, double yCurr, double yNext, double hour);
 
+	/// @brief Returns rise/set results computed in this object
+	RiseSetInfo riseSetInfo() const;
+
+	/// @brief Sets rise/set results (used to print results computed elsewhere)
+	/// @param[in] info - rise/set results
+	void setRiseSetInfo(const RiseSetInfo& info);
+
 	const char* m_Name;
 	const char* m_strAbove;
 	const char* m_strBelow;
@@ -83,8 +102,8 @@ private:
 
 	void setAltitudeType(const AltitudeType type);
 
-	// NOTE: Use of non-const since it may need to be re-computed.
-	static std::array<double, NumberOfAltTypes> m_sinho;
+	/// @brief Sine of the horizon altitude for each AltitudeType (read-only)
+	static const std::array<double, NumberOfAltTypes> m_sinho;
 };
 
 
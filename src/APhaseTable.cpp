@@ -0,0 +1,285 @@
+/// @file
+///
+/// @brief APhaseTable class implementation.
+///
+/// @copyright 2019-2020 M.Mashimo and licensors. All Right Reserved.
+///
+/// This file is part of cMoon application.
+///
+/// cMoon is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// any later version.
+///
+/// cMoon is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with cMoon.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "APhaseTable.h"
+
+static constexpr char PhaseTableMagic[8]{'c', 'M', 'o', 'o', 'n', 'P', 'T', '\0'};
+static constexpr uint32_t PhaseTableVersion{1};
+
+/// @brief Days searched past jd for a phase computed outside of the table (a cycle plus corrections)
+static constexpr double PhaseSearchDays{31.};
+
+APhaseTable::APhaseTable()
+	: m_moon(AContext{0, 0, 0, 0, 0., false, {}})
+	, m_header{}
+	, m_jde(nullptr)
+	, m_count(0)
+{
+	// Nothing here
+}
+
+APhaseTable::~APhaseTable()
+{
+	close();
+}
+
+bool APhaseTable::generate(const std::string& path, const double jdStart, const double jdEnd)
+{
+	AMoon moonObj(AContext{0, 0, 0, 0, 0., false, {}});
+	std::vector<PhaseEvent> events;
+
+	moonObj.computePhasesInRange(jdStart, jdEnd, events);
+	if (events.empty())
+	{
+		return false;
+	}
+
+	PhaseTableHeader header{};
+	memcpy(header.magic, PhaseTableMagic, sizeof(header.magic));
+	header.version = PhaseTableVersion;
+	header.firstPhase = static_cast<uint32_t>(events.front().phase);
+	header.count = events.size();
+	header.firstK = events.front().K;
+	header.jdStart = jdStart;
+	header.jdEnd = jdEnd;
+
+	std::vector<double> jde;
+	jde.reserve(events.size());
+	for (auto& event : events)
+	{
+		jde.push_back(event.jde);
+	}
+
+	// Readers never see a partial table
+	return AMappedFile::writeAtomic(path, [&](FILE* file)
+	{
+		return (fwrite(&header, sizeof(header), 1, file) == 1)
+			&& (fwrite(jde.data(), sizeof(double), jde.size(), file) == jde.size());
+	});
+}
+
+bool APhaseTable::open(const std::string& path)
+{
+	close();
+
+	if (!m_file.open(path, sizeof(PhaseTableHeader)))
+	{
+		return false;
+	}
+
+	// Validate header and size
+	size_t size = m_file.size();
+	memcpy(&m_header, m_file.data(), sizeof(m_header));
+	if ((memcmp(m_header.magic, PhaseTableMagic, sizeof(PhaseTableMagic)) != 0)
+		|| (m_header.version != PhaseTableVersion)
+		|| (m_header.firstPhase > 3)
+		|| (m_header.count == 0)
+		|| (size != sizeof(PhaseTableHeader) + (m_header.count * sizeof(double))))
+	{
+		close();
+		return false;
+	}
+
+	m_jde = reinterpret_cast<const double*>(m_file.at(sizeof(PhaseTableHeader)));
+	m_count = static_cast<size_t>(m_header.count);
+
+	return true;
+}
+
+bool APhaseTable::openOrGenerate(const std::string& path, const double jdStart, const double jdEnd)
+{
+	if (open(path) && (m_header.jdStart == jdStart) && (m_header.jdEnd == jdEnd))
+	{
+		return true;
+	}
+
+	return generate(path, jdStart, jdEnd) && open(path);
+}
+
+void APhaseTable::close()
+{
+	m_file.close();
+	m_jde = nullptr;
+	m_count = 0;
+	m_header = PhaseTableHeader{};
+}
+
+PhaseEvent APhaseTable::eventAt(const size_t index) const
+{
+	PhaseEvent event;
+
+	event.phase   = static_cast<int>((m_header.firstPhase + index) % 4);
+	event.K       = m_header.firstK + (0.25 * index);
+	event.meanJde = AMoon::meanJdeForK(event.K);
+	event.jde     = m_jde[index];
+
+	return event;
+}
+
+PhaseEvent APhaseTable::invalidPhase(const int phase)
+{
+	return PhaseEvent{phase, NAN, NAN, NAN};
+}
+
+bool APhaseTable::phaseForK(const double K, PhaseEvent& event) const
+{
+	if (!isOpen())
+	{
+		return false;
+	}
+
+	double quarters = (K - m_header.firstK) * 4.;
+	double index = floor(quarters + 0.5);
+	if ((index < 0.) || (index >= static_cast<double>(m_count)) || (fabs(quarters - index) > 1e-6))
+	{
+		return false;
+	}
+
+	event = eventAt(static_cast<size_t>(index));
+	return true;
+}
+
+size_t APhaseTable::lowerBound(const double jd) const
+{
+	return static_cast<size_t>(std::lower_bound(m_jde, m_jde + m_count, jd) - m_jde);
+}
+
+PhaseEvent APhaseTable::nextPhase(const double jd, const int phase) const
+{
+	if ((phase != AnyPhase) && ((phase < 0) || (phase > 3)))
+	{
+		return invalidPhase(phase);
+	}
+
+	if (isOpen() && (jd >= m_header.jdStart))
+	{
+		size_t index = lowerBound(jd);
+		while ((index < m_count) && (phase != AnyPhase) && (static_cast<int>((m_header.firstPhase + index) % 4) != phase))
+		{
+			index++;
+		}
+
+		if (index < m_count)
+		{
+			return eventAt(index);
+		}
+	}
+
+	// Outside of the table - compute
+	std::vector<PhaseEvent> events;
+	for (double start = jd; ; start += PhaseSearchDays)
+	{
+		events.clear();
+		m_moon.computePhasesInRange(start, start + PhaseSearchDays, events);
+		for (auto& event : events)
+		{
+			if ((phase == AnyPhase) || (event.phase == phase))
+			{
+				return event;
+			}
+		}
+	}
+}
+
+PhaseEvent APhaseTable::previousPhase(const double jd, const int phase) const
+{
+	if ((phase != AnyPhase) && ((phase < 0) || (phase > 3)))
+	{
+		return invalidPhase(phase);
+	}
+
+	if (isOpen() && (jd <= m_header.jdEnd))
+	{
+		size_t index = lowerBound(jd);
+		while ((index > 0) && (phase != AnyPhase) && (static_cast<int>((m_header.firstPhase + index - 1) % 4) != phase))
+		{
+			index--;
+		}
+
+		if (index > 0)
+		{
+			return eventAt(index - 1);
+		}
+	}
+
+	// Outside of the table - compute
+	std::vector<PhaseEvent> events;
+	for (double end = jd; ; end -= PhaseSearchDays)
+	{
+		events.clear();
+		m_moon.computePhasesInRange(end - PhaseSearchDays, end, events);
+		for (auto itr = events.rbegin(); itr != events.rend(); itr++)
+		{
+			if ((phase == AnyPhase) || (itr->phase == phase))
+			{
+				return *itr;
+			}
+		}
+	}
+}
+
+int APhaseTable::phasesInRange(const double jdStart, const double jdEnd, std::vector<PhaseEvent>& events) const
+{
+	if (jdEnd <= jdStart)
+	{
+		return 0;
+	}
+
+	if (!isOpen())
+	{
+		return m_moon.computePhasesInRange(jdStart, jdEnd, events);
+	}
+
+	int count = 0;
+
+	// Before the table
+	if (jdStart < m_header.jdStart)
+	{
+		count += m_moon.computePhasesInRange(jdStart, std::min(jdEnd, m_header.jdStart), events);
+	}
+
+	// From the table
+	double first = std::max(jdStart, m_header.jdStart);
+	double last = std::min(jdEnd, m_header.jdEnd);
+	if (first < last)
+	{
+		size_t end = lowerBound(last);
+		for (size_t index = lowerBound(first); index < end; index++)
+		{
+			events.push_back(eventAt(index));
+			count++;
+		}
+	}
+
+	// After the table
+	if (jdEnd > m_header.jdEnd)
+	{
+		count += m_moon.computePhasesInRange(std::max(jdStart, m_header.jdEnd), jdEnd, events);
+	}
+
+	return count;
+}
@@ -0,0 +1,141 @@
+/// @file
+///
+/// @brief APhaseTable class definitions.
+///
+/// APhaseTable answers Moon phase queries from a precomputed binary file of
+/// phase JDEs (memory-mapped). Queries outside the span of the file are
+/// computed (AMoon::computePhasesInRange).
+///
+/// @copyright 2019-2020 M.Mashimo and licensors. All Right Reserved.
+///
+/// This file is part of cMoon application.
+///
+/// cMoon is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// any later version.
+///
+/// cMoon is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with cMoon.  If not, see <https://www.gnu.org/licenses/>.
+///
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "AMappedFile.h"
+#include "AMoon.h"
+
+/// @brief Default span of a phase table - 1600-01-01 to 2400-01-01
+constexpr double PhaseTableStart{2305447.5};
+constexpr double PhaseTableEnd{2597641.5};
+
+/// @brief Any phase - for APhaseTable::nextPhase()
+constexpr int AnyPhase{-1};
+
+/// @brief Header of the phase table file - followed by 'count' JDEs (doubles, host byte order)
+using PhaseTableHeader = struct structPhaseTableHeader
+{
+	char     magic[8];    // "cMoonPT"
+	uint32_t version;     // PhaseTableVersion
+	uint32_t firstPhase;  // phase of the first JDE (following JDEs cycle through phases)
+	uint64_t count;       // number of JDEs
+	double   firstK;      // Moon cycle (K) of the first JDE - increments by 0.25
+	double   jdStart;     // span of the table - all phases with jdStart <= JDE < jdEnd
+	double   jdEnd;
+};
+
+class APhaseTable
+{
+public:
+	APhaseTable();
+
+	~APhaseTable();
+
+	APhaseTable(const APhaseTable&) = delete;
+	APhaseTable& operator=(const APhaseTable&) = delete;
+
+	/// @brief Writes phase table file for a span of Julian dates.
+	/// @param[in] path - file to write (written to 'path.tmp' then renamed)
+	/// @param[in] jdStart - first Julian date
+	/// @param[in] jdEnd - last Julian date (exclusive)
+	/// @return true if written
+	static bool generate(const std::string& path, const double jdStart = PhaseTableStart, const double jdEnd = PhaseTableEnd);
+
+	/// @brief Maps the phase table file.
+	/// @param[in] path - phase table file
+	/// @return true if the file is a valid phase table
+	bool open(const std::string& path);
+
+	/// @brief Maps the phase table file - generates it first if missing, invalid or of another span (first run).
+	/// @param[in] path - phase table file
+	/// @param[in] jdStart - first Julian date of the table
+	/// @param[in] jdEnd - last Julian date of the table (exclusive)
+	/// @return true if the table is mapped
+	bool openOrGenerate(const std::string& path, const double jdStart = PhaseTableStart, const double jdEnd = PhaseTableEnd);
+
+	/// @brief Unmaps the table (queries are computed)
+	void close();
+
+	/// @brief True if a table is mapped
+	bool isOpen() const { return m_jde != nullptr; }
+
+	/// @brief Span of the mapped table
+	double jdStart() const { return m_header.jdStart; }
+	double jdEnd() const { return m_header.jdEnd; }
+
+	/// @brief Number of phases in the mapped table
+	size_t count() const { return m_count; }
+
+	/// @brief Finds the phase of a Moon cycle in the mapped table.
+	/// @param[in] K - Moon cycle since J2000 (quarters for phases)
+	/// @param[out] event - phase event (delta-T of the year of its mean JDE)
+	/// @return true if K is within the table
+	bool phaseForK(const double K, PhaseEvent& event) const;
+
+	/// @brief Finds the first phase at or after a Julian date.
+	/// @param[in] jd - Julian date
+	/// @param[in] phase - [0=new, 1=waxing quarter, 2=full, 3=waning quarter] or AnyPhase
+	/// @return phase event (jde is NaN if phase is not valid)
+	PhaseEvent nextPhase(const double jd, const int phase = AnyPhase) const;
+
+	/// @brief Finds the last phase before a Julian date.
+	/// @param[in] jd - Julian date
+	/// @param[in] phase - [0=new, 1=waxing quarter, 2=full, 3=waning quarter] or AnyPhase
+	/// @return phase event (jde is NaN if phase is not valid)
+	PhaseEvent previousPhase(const double jd, const int phase = AnyPhase) const;
+
+	/// @brief Finds all phases within a range of Julian dates.
+	/// @param[in] jdStart - first Julian date (inclusive)
+	/// @param[in] jdEnd - last Julian date (exclusive)
+	/// @param[out] events - phases are appended in time order
+	/// @return number of phases appended
+	int phasesInRange(const double jdStart, const double jdEnd, std::vector<PhaseEvent>& events) const;
+
+private:
+	/// @brief Phase event of table entry
+	PhaseEvent eventAt(const size_t index) const;
+
+	/// @brief Event returned for a phase that is neither AnyPhase nor 0..3
+	static PhaseEvent invalidPhase(const int phase);
+
+	/// @brief Index of first JDE >= jd
+	size_t lowerBound(const double jd) const;
+
+	/// @brief Computes phases (outside of table)
+	AMoon m_moon;
+
+	PhaseTableHeader m_header;
+
+	/// @brief Mapped file and JDEs in it
+	AMappedFile   m_file;
+	const double* m_jde;
+	size_t        m_count;
+};
@@ -22,10 +22,14 @@
 
 #include <iostream>
 
+#include <algorithm>
 #include <cmath>
 #include <vector>
 
 #include "APlanets.h"
+#include "AJplEphemeris.h"
+#include "AKepler.h"
+#include "AVsop87.h"
 
 // static constexpr double pi{3.14159265358979323846};
 
@@ -37,7 +41,7 @@ static constexpr double elementsDate{2450680.5};  // date of elements
 static constexpr double eclipticDate{2451545.};   // date of mean ecliptic and equinox of
 
 /// @brief Coefficients for computing Planet orbits
-static std::vector<PlanetDescriptor> planetDescrip
+static const std::vector<PlanetDescriptor> planetDescrip
 {
 	{"Mercury", 0, 7.00507 * rads, 48.3339 * rads, 77.45399999999999*rads, 0.3870978, 4.092353*rads, 0.2056324, 314.42369 * rads},
 	{"Venus"  , 1, 3.39472 * rads, 76.6889 * rads,  131.761 * rads,  0.7233238, 1.602158 * rads,   0.0067933, 236.94045 * rads},
@@ -50,13 +54,14 @@ static std::vector<PlanetDescriptor> planetDescrip
 	{"Pluto"  , 8, 17.12137 * rads,110.3833 * rads, 224.8025 * rads, 39.5804,   0.003958072 * rads,0.2501272, 235.7656 * rads }
 };
 
-int APlanets::m_verboseLevel = 0;
-
 /// @brief Constructor - Start with Earth as the center of view
-APlanets::APlanets(const int planetType)
+APlanets::APlanets(const int planetType, const AContext& context)
 	: AlgBase()
-	, m_viewPos{planetDescrip[Earth],0,0,0}
+	, m_verboseLevel(context.planetsVerbose)
+	, m_timeZone(context.timeZone)
 	, m_planetType(planetType)
+	, m_ephemeris(nullptr)
+	, m_vsop87(nullptr)
 {
 	// Nothing here
 }
@@ -67,6 +72,12 @@ APlanets::~APlanets()
 	// Nothing here
 }
 
+void APlanets::setContext(const AContext& context)
+{
+	m_verboseLevel = context.planetsVerbose;
+	m_timeZone = context.timeZone;
+}
+
 void APlanets::parseArgs(std::string options)
 {
 	if (isdigit(options[0]))
@@ -129,54 +140,6 @@ void APlanets::parseArgs(std::string options)
 }
 
 
-/// @brief Computes True Anomaly
-///
-/// @param[in] meanAnomaly - the mean anomaly in radians
-/// @param[in] eccentricity - the eccentricity of the orbit
-/// @param[in] eps - the convergence paramter (8 or 9 is usually fine, 12 or 14 for very accurate work)
-///
-/// @return double True Anomaly
-static double computeTrueAnomaly(const double meanAnomaly, const double eccentricity, const double eps)
-{
-
-//   returns the true anomaly given
-//   m - the mean anomaly in radians
-//   ecc - the eccentricity of the orbit
-//   eps - the convergence paramter (8 or 9 is usually fine
-//   12 or 14 for very accurate work)
-
-	double e = meanAnomaly;
-	double delta = .05;
-	double convergence = pow(10., -eps);
-	while(fabs(delta) >= convergence)
-	{
-		// DO WHILE ABS(delta) >= 10 ^ -eps
-		// delta = e - ecc * SIN(e) - m
-		// e = e - delta / (1 - ecc * COS(e))
-		// LOOP
-		delta = e - (eccentricity * sin(e)) - meanAnomaly;
-		e = e - (delta / (1. - (eccentricity * cos(e))));
-	}
-
-	// v = 2 * ATN(((1 + ecc) / (1 - ecc)) ^ .5 * TAN(.5 * e))
-	double ec = (1. + eccentricity) / (1. - eccentricity);
-	double v = 2 * atan(pow(ec, .5) * tan(.5 * e));
-
-	// IF v < 0 THEN v = v + tpi
-	if (v < 0)
-	{
-		v += twoPi;
-	}
-
-	if (APlanets::m_verboseLevel & DebugComputation)
-	{
-		std::cout << "Compute True Anomaly=" << v << " from: mean anomaly=" << meanAnomaly << " eccentricity=" << eccentricity << " eps=" << eps << std::endl;
-	}
-
-	return v;
-
-}
-
 static double angleInRange(const double x)
 {
 	double b = x / twoPi;
@@ -203,10 +166,10 @@ static void computeViewPosition(OrbitPos& orbit, const double d)
 	double ap = planet.semiMajorAxis;
 	double ip = planet.inclination;
 
-	double vp = computeTrueAnomaly(mp, ep, 12);
-
+	double rf;
+	double vp = AKepler::trueAnomaly(mp, ep, &rf);
 
-	double rp = ap * (1 - (ep * ep)) / (1 + (ep * cos(vp)));
+	double rp = ap * rf;
 	double vep = vp + pp;
 
 	// Heliocentric coords of earth
@@ -214,13 +177,6 @@ static void computeViewPosition(OrbitPos& orbit, const double d)
 	orbit.m_X = rp * cos(vep);
 	orbit.m_Y = rp * sin(vep);
 	orbit.m_Z = 0.;
-
-	std::cout << "Coord of " << planet.planetName << " : X=" << orbit.m_X << " Y=" << orbit.m_Y << std::endl;
-
-	if (APlanets::m_verboseLevel & DebugComputation)
-	{
-		std::cout << planet.planetName <<" mean anomaly= " << mp << " true anomaly=" << vp << " radius pos=" << rp << " radian vector=" << vep << std::endl;
-	}
 }
 
 static void findPosition(OrbitPos& orbit, const double d)
@@ -238,10 +194,10 @@ static void findPosition(OrbitPos& orbit, const double d)
 	double ap = planet.semiMajorAxis;
 	double ip = planet.inclination;
 
-	double vp = computeTrueAnomaly(mp, ep, 12);
+	double rf;
+	double vp = AKepler::trueAnomaly(mp, ep, &rf);
 
-
-	double rp = ap * (1 - (ep * ep)) / (1 + (ep * cos(vp)));
+	double rp = ap * rf;
 	double vep = vp + pp;
 
 	// heliocentric rectangular coordinates of planet
@@ -250,13 +206,25 @@ static void findPosition(OrbitPos& orbit, const double d)
 	orbit.m_X = rp * (cos(op) * cos(vep) - sin(op) * sin(vep) * cos(ip));
 	orbit.m_Y = rp * (sin(op) * cos(vep) + cos(op) * sin(vep) * cos(ip));
 	orbit.m_Z = rp * (sin(vep) * sin(ip));
+}
 
-	std::cout << "Coord of " << planet.planetName << ": X=" << orbit.m_X << " Y=" << orbit.m_Y << " Z=" << orbit.m_Z << std::endl;
+/// @brief Computes true anomaly and radius (AU) of a planet in its orbit for an array of days
+static void computeOrbitBatch(const PlanetDescriptor& planet, const double* d, const size_t count, double* v, double* r)
+{
+	const double eldate = elementsDate - eclipticDate;
+	const double pp = planet.perihelion;
 
-	if (APlanets::m_verboseLevel & DebugComputation)
+	// mean anomaly (in v) then true anomaly
+	for (size_t i = 0; i < count; i++)
 	{
-		std::cout << planet.planetName << " mean anomaly= " << mp << " true anomaly=" << vp << " radius pos=" << rp << " radian vector=" << vep << std::endl;
-		std::cout << planet.planetName << " inclination= " << ip << " ascending node=" << ip << " perihelion=" << pp << " semi-Major axis=" << ap << std::endl;
+		v[i] = angleInRange((planet.dailyMotion * (d[i] - eldate)) + planet.meanLongitude - pp);
+	}
+
+	AKepler::trueAnomaly(v, planet.eccentricity, count, v, r);
+
+	for (size_t i = 0; i < count; i++)
+	{
+		r[i] *= planet.semiMajorAxis;
 	}
 }
 
@@ -281,17 +249,57 @@ static void printDegrees(char* str, const double deg)
 	}
 }
 
+const PlanetDescriptor& APlanets::planetDescriptor(const int planet)
+{
+	return planetDescrip[planet];
+}
+
+OrbitPos APlanets::computeViewPos(const double j2000) const
+{
+	OrbitPos viewPos{planetDescrip[Earth], 0,0,0};
+	computeViewPosition(viewPos, j2000);
+	return viewPos;
+}
+
 // RA, DEC are in degrees
-void APlanets::computePlanetPos(const PlanetDescriptor& planet, const double j2000, double& ra, double& dec, double& dist)
+void APlanets::computePlanetPos(const PlanetDescriptor& planet, const double j2000, double& ra, double& dec, double& dist) const
+{
+	OrbitPos viewPos{planetDescrip[Earth], 0,0,0};
+	PlanetPosition position;
+
+	// View position is not needed of the ephemeris and VSOP87
+	if (((m_ephemeris == nullptr) || !m_ephemeris->planetPosition(planet.planetIndex, j2000, position))
+		&& ((m_vsop87 == nullptr) || !m_vsop87->planetPosition(planet.planetIndex, j2000, position)))
+	{
+		computeViewPosition(viewPos, j2000);
+		computePlanetPos(planet, j2000, viewPos, position);
+	}
+
+	ra = position.ra;
+	dec = position.dec;
+	dist = position.dist;
+}
+
+void APlanets::computePlanetPos(const PlanetDescriptor& planet, const double j2000, const OrbitPos& viewPos, PlanetPosition& position) const
 {
+	// JPL ephemeris within its span, then VSOP87 (Mercury to Neptune)
+	if (((m_ephemeris != nullptr) && m_ephemeris->planetPosition(planet.planetIndex, j2000, position))
+		|| ((m_vsop87 != nullptr) && m_vsop87->planetPosition(planet.planetIndex, j2000, position)))
+	{
+		position.planetName = planet.planetName;
+		position.planetIndex = planet.planetIndex;
+		position.alt = 0.;
+		return;
+	}
+
 	OrbitPos orbit{planet, 0,0,0};
 
 	// Planet's position - use internal variables
 	findPosition(orbit, j2000);
 
 	// convert to geocentric rectangular coordinates
-	double xg = orbit.m_X - m_viewPos.m_X;
-	double yg = orbit.m_Y - m_viewPos.m_Y;
+	double xg = orbit.m_X - viewPos.m_X;
+	double yg = orbit.m_Y - viewPos.m_Y;
 	double zg = orbit.m_Z;
 
 
@@ -302,120 +310,282 @@ void APlanets::computePlanetPos(const PlanetDescriptor& planet, const double j20
 	double yeq = (yg * cos(ecl)) - (zg * sin(ecl));
 	double zeq = (yg * sin(ecl)) + (zg * cos(ecl));
 
+	position.planetName = planet.planetName;
+	position.planetIndex = planet.planetIndex;
+	position.x = orbit.m_X;
+	position.y = orbit.m_Y;
+	position.z = orbit.m_Z;
+
 	// find the RA and DEC from the rectangular equatorial coords
-	ra = AlgBase::fnatn2(yeq, xeq);
-	dec = atan(zeq / sqrt((xeq * xeq) + (yeq * yeq)));
-	dist = sqrt((xeq * xeq) + (yeq * yeq) + (zeq * zeq));
+	double ra = AlgBase::fnatn2(yeq, xeq);
+	double dec = atan(zeq / sqrt((xeq * xeq) + (yeq * yeq)));
+	position.dist = sqrt((xeq * xeq) + (yeq * yeq) + (zeq * zeq));
 
 	// Return in degrees
-	ra = ra * degs / 15;
-	dec = dec * degs;
+	position.ra = ra * degs / 15;
+	position.dec = dec * degs;
+	position.alt = 0.;
 }
 
-static void showPositions(const PlanetDescriptor& planet, const double& ra, const double& dec, const double& dist)
+void APlanets::computePlanetBatch(const double* j2000, const size_t count, const unsigned mask, PlanetBatch& batch) const
 {
-	char raStr[100];
-	char dclStr[100];
-	printDegrees(raStr, ra);
-	printDegrees(dclStr, dec);
+	batch.count = count;
+	batch.mask = mask & AllPlanetsMask;
 
-	std::cout << "Equatorial coordinates of planet " << planet.planetName << std::endl;
-	std::cout << "   RA = " << raStr << std::endl;
-	std::cout << "  DEC = " << dclStr << std::endl;
-	std::cout << " Dist = " << dist << std::endl;
+	// JPL ephemeris if all days are within its span
+	if ((m_ephemeris != nullptr) && std::all_of(j2000, j2000 + count, [this](const double d) { return m_ephemeris->covers(d); }))
+	{
+		ephemerisBatch(j2000, count, batch);
+		return;
+	}
 
-}
+	// VSOP87 of Mercury to Neptune - elements of the others (Pluto)
+	unsigned elementsMask = batch.mask;
+	if (m_vsop87 != nullptr)
+	{
+		m_vsop87->computeBatch(j2000, count, batch.mask, batch);
+		batch.mask = mask & AllPlanetsMask;
+		elementsMask &= ~VsopPlanetsMask;
+		if (elementsMask == 0)
+		{
+			return;
+		}
+	}
 
-void APlanets::computeAPlanet(const PlanetDescriptor& planet, const ALocation& location, const double j2000, const double md)
-{
-	double ra;
-	double dec;
-	double rvec;
+	// Scratch - true anomaly and radius, then Earth's (view) coordinates
+	std::vector<double> v(count);
+	std::vector<double> r(count);
+	std::vector<double> ex(count);
+	std::vector<double> ey(count);
 
-	computePlanetPos(planet, j2000, ra, dec, rvec);
+	// Earth's position needs to be computed first (once per timestamp)
+	const PlanetDescriptor& earth = planetDescrip[Earth];
+	computeOrbitBatch(earth, j2000, count, v.data(), r.data());
+	for (size_t i = 0; i < count; i++)
+	{
+		double vep = v[i] + earth.perihelion;
+		ex[i] = r[i] * cos(vep);
+		ey[i] = r[i] * sin(vep);
+	}
 
-	showPositions(planet, ra, dec, rvec);
+	// rotation from ecliptic to equatorial coords (J2000.0 frame)
+	const double ecl = 23.429292 * rads;
+	const double cecl = cos(ecl);
+	const double secl = sin(ecl);
 
-	// Crude method to see if it is above the horizon
-	double alt = AlgBase::localAltitude(location, md, ra, dec);
-	std::cout << "  Alt = " << alt << std::endl;
+	for (const auto& planet : planetDescrip)
+	{
+		int index = planet.planetIndex;
+		if ((elementsMask & planetMask(index)) == 0)
+		{
+			if ((batch.mask & planetMask(index)) == 0)
+			{
+				batch.ra[index].clear();
+				batch.dec[index].clear();
+				batch.dist[index].clear();
+			}
+			continue;
+		}
+
+		batch.ra[index].resize(count);
+		batch.dec[index].resize(count);
+		batch.dist[index].resize(count);
+		double* ra = batch.ra[index].data();
+		double* dec = batch.dec[index].data();
+		double* dist = batch.dist[index].data();
+
+		computeOrbitBatch(planet, j2000, count, v.data(), r.data());
+
+		const double pp = planet.perihelion;
+		const double op = planet.ascendingNode;
+		const double cop = cos(op);
+		const double sop = sin(op);
+		const double cip = cos(planet.inclination);
+		const double sip = sin(planet.inclination);
+
+		for (size_t i = 0; i < count; i++)
+		{
+			// heliocentric rectangular coordinates of planet
+			double vep = v[i] + pp - op;
+			double cv = cos(vep);
+			double sv = sin(vep);
+
+			// geocentric rectangular coordinates
+			double xg = r[i] * (cop * cv - sop * sv * cip) - ex[i];
+			double yg = r[i] * (sop * cv + cop * sv * cip) - ey[i];
+			double zg = r[i] * (sv * sip);
+
+			// equatorial coordinates
+			double xeq = xg;
+			double yeq = (yg * cecl) - (zg * secl);
+			double zeq = (yg * secl) + (zg * cecl);
+
+			// same as AlgBase::fnatn2() - range 0 to two pi
+			double a = atan(yeq / xeq);
+			a += (xeq < 0) ? __pi : 0.;
+			a += ((yeq < 0) && (xeq > 0)) ? twoPi : 0.;
+
+			double rxy = (xeq * xeq) + (yeq * yeq);
+			ra[i] = a * degs / 15;
+			dec[i] = atan(zeq / sqrt(rxy)) * degs;
+			dist[i] = sqrt(rxy + (zeq * zeq));
+		}
+	}
 }
 
-void APlanets::printAll(const ALocation& location, const ADateTime& dateTime)
+void APlanets::computePlanetBatch(const std::vector<double>& j2000, const unsigned mask, PlanetBatch& batch) const
 {
-	std::cout << "....................................." << std::endl;
-	auto itr = planetDescrip.begin();
-	for (; itr != planetDescrip.end(); itr++)
+	computePlanetBatch(j2000.data(), j2000.size(), mask, batch);
+}
+
+void APlanets::ephemerisBatch(const double* j2000, const size_t count, PlanetBatch& batch) const
+{
+	PlanetPosition position;
+	for (int index = 0; index < NumberOfPlanets; index++)
 	{
-		if (itr->planetIndex != PlanetType::Earth)
+		if ((batch.mask & planetMask(index)) == 0)
 		{
-			computeAPlanet(*itr, location, dateTime.j2000Day(), dateTime.modifiedJuiianDate(true));
+			batch.ra[index].clear();
+			batch.dec[index].clear();
+			batch.dist[index].clear();
+			continue;
+		}
 
-			std::cout << "....................................." << std::endl;
+		batch.ra[index].resize(count);
+		batch.dec[index].resize(count);
+		batch.dist[index].resize(count);
+		for (size_t i = 0; i < count; i++)
+		{
+			m_ephemeris->planetPosition(index, j2000[i], position);
+			batch.ra[index][i] = position.ra;
+			batch.dec[index][i] = position.dec;
+			batch.dist[index][i] = position.dist;
 		}
 	}
 }
 
-void APlanets::computePlanets(const ALocation& location, const ADateTime& procTime, int type)
+void APlanets::setEphemeris(const AJplEphemeris* ephemeris)
+{
+	m_ephemeris = ((ephemeris != nullptr) && ephemeris->isOpen()) ? ephemeris : nullptr;
+}
+
+void APlanets::setVsop87(const AVsop87* vsop87)
+{
+	m_vsop87 = vsop87;
+}
+
+static void showPositions(const PlanetPosition& position)
+{
+	char raStr[100];
+	char dclStr[100];
+	printDegrees(raStr, position.ra);
+	printDegrees(dclStr, position.dec);
+
+	std::cout << "Coord of " << position.planetName << ": X=" << position.x << " Y=" << position.y << " Z=" << position.z << std::endl;
+	std::cout << "Equatorial coordinates of planet " << position.planetName << std::endl;
+	std::cout << "   RA = " << raStr << std::endl;
+	std::cout << "  DEC = " << dclStr << std::endl;
+	std::cout << " Dist = " << position.dist << std::endl;
+	std::cout << "  Alt = " << position.alt << std::endl;
+}
+
+void APlanets::computeAPlanet(const PlanetDescriptor& planet, const ALocation& location, const double j2000, const double md,
+	const OrbitPos& viewPos, PlanetPosition& position) const
 {
-	ADateTime dateTime(procTime);
+	computePlanetPos(planet, j2000, viewPos, position);
 
-	// Get Earth info
-	double d = dateTime.j2000Day();
+	// Crude method to see if it is above the horizon
+	position.alt = AlgBase::localAltitude(location, md, position.ra, position.dec);
+}
+
+void APlanets::computePlanetPositions(const ALocation& location, const AInstant instant, const AInstant localMidnight, int type,
+	std::vector<PlanetPosition>& positions) const
+{
+	// Get Earth info - midnight (UTC) of the date
+	double d = instant.midnight().j2000();
 	// Use with example (see QBasicCode.txt)
 	// 0h 21 June 1997
 	// double d = -924.50;
 
-	if (m_verboseLevel & DebugJulianDate)
-	{
-		dateTime.printASCII();
-		std::cout << "J2000 date: " << d << std::endl;
-	}
-
-	double md = dateTime.modifiedJuiianDate(true);
-
-	std::cout << "....................................." << std::endl;
+	double md = localMidnight.modifiedJulian();
 
 	// Earth's position needs to be computed first to figure out the vectors
-	computeViewPosition(m_viewPos, d);
+	OrbitPos viewPos{planetDescrip[Earth], 0,0,0};
+	computeViewPosition(viewPos, d);
 
-	// Compute all the planets except Earth
-	std::vector<int>list{0,1,3,4,5,6,7,8};
+	PlanetPosition position;
 
-	// After search, if not found, print all
-	if ((type < 0) || (type == PlanetType::Earth))
+	// Compute all the planets except Earth (unless specific planet is found)
+	bool found = false;
+	if ((type >= 0) && (type != PlanetType::Earth))
 	{
-		printAll(location, dateTime);
-	}
-	else
-	{
-		// Find specific Planet
-		bool found = false;
-		auto itr = planetDescrip.begin();
-		for (; itr != planetDescrip.end(); itr++)
+		for (auto itr = planetDescrip.begin(); itr != planetDescrip.end(); itr++)
 		{
 			if (itr->planetIndex == type)
 			{
+				computeAPlanet(*itr, location, d, md, viewPos, position);
+				positions.push_back(position);
 				found = true;
 				break;
 			}
 		}
+	}
 
-		if (found)
-		{
-			std::cout << "....................................." << std::endl;
-			computeAPlanet(*itr, location, d, md);
-			std::cout << "....................................." << std::endl;
-			return;
-		}
-		else
+	if (!found)
+	{
+		for (auto itr = planetDescrip.begin(); itr != planetDescrip.end(); itr++)
 		{
-			printAll(location, dateTime);
+			if (itr->planetIndex != PlanetType::Earth)
+			{
+				computeAPlanet(*itr, location, d, md, viewPos, position);
+				positions.push_back(position);
+			}
 		}
 	}
 }
 
+unsigned APlanets::selectedPlanets() const
+{
+	// Same as computePlanetPositions() - all planets unless one (not Earth) is selected
+	if ((m_planetType >= 0) && (m_planetType < NumberOfPlanets) && (m_planetType != PlanetType::Earth))
+	{
+		return planetMask(m_planetType);
+	}
+	return AllPlanetsMask;
+}
+
+void APlanets::computePlanetPositions(const ALocation& location, const ADateTime& procTime, std::vector<PlanetPosition>& positions) const
+{
+	AInstant instant = procTime.instant();
+	computePlanetPositions(location, instant, instant.localMidnight(procTime.timeZoneAsFractionOfDay() * 24.), m_planetType, positions);
+}
+
+void APlanets::computePlanetPositions(const ALocation& location, const AInstant instant, std::vector<PlanetPosition>& positions) const
+{
+	computePlanetPositions(location, instant, instant.localMidnight(m_timeZone), m_planetType, positions);
+}
+
 void APlanets::computePlanets(const ALocation& location, const ADateTime& procTime)
 {
-	computePlanets(location, procTime, m_planetType);
-}
\ No newline at end of file
+	std::vector<PlanetPosition> positions;
+
+	if (m_verboseLevel & DebugJulianDate)
+	{
+		procTime.printASCII();
+		std::cout << "J2000 date: " << procTime.j2000Day() << std::endl;
+	}
+
+	computePlanetPositions(location, procTime, positions);
+
+	OrbitPos viewPos = computeViewPos(procTime.j2000Day());
+
+	std::cout << "....................................." << std::endl;
+	std::cout << "Coord of " << viewPos.description.planetName << " : X=" << viewPos.m_X << " Y=" << viewPos.m_Y << std::endl;
+	std::cout << "....................................." << std::endl;
+
+	for (auto& position : positions)
+	{
+		showPositions(position);
+		std::cout << "....................................." << std::endl;
+	}
+}
@@ -23,6 +23,9 @@
 ///
 #pragma once
 
+#include <array>
+#include <vector>
+
 #include "AlgBase.h"
 #include "ADateTime.h"
 #include "ALocation.h"
@@ -41,6 +44,19 @@ enum PlanetType : int
 	Pluto
 };
 
+/// @brief Number of planets in the planet descriptor table (including Earth)
+constexpr int NumberOfPlanets{9};
+
+/// @brief Bit of a planet in a planet mask (see APlanets::computePlanetBatch)
+/// @param[in] planet - PlanetType (not All)
+constexpr unsigned planetMask(const int planet)
+{
+	return 1u << planet;
+}
+
+/// @brief Planet mask of all planets except Earth (the view position)
+constexpr unsigned AllPlanetsMask{((1u << NumberOfPlanets) - 1) & ~(1u << PlanetType::Earth)};
+
 /// @brief Elements (coefficients and such) for computing Planetary positions
 using PlanetDescriptor = struct structPlanet
 {
@@ -67,11 +83,53 @@ using OrbitPos = struct structOrbit
 	double m_Z;
 };
 
+/// @brief Computed position of a planet (results of APlanets::computePlanetPositions)
+using PlanetPosition = struct structPlanetPos
+{
+	const char* planetName;
+	int         planetIndex;
+
+	// Heliocentric rectangular coordinates (AU)
+	double      x;
+	double      y;
+	double      z;
+
+	// Geocentric equatorial coordinates
+	double      ra;    // hours
+	double      dec;   // degrees
+	double      dist;  // AU
+
+	// Sine of the altitude at the location
+	double      alt;
+};
+
+
+/// @brief Structure-of-arrays results of APlanets::computePlanetBatch
+///
+/// Arrays are indexed by planet index, then by timestamp. Arrays of planets
+/// not in the mask are left empty.
+using PlanetBatch = struct structPlanetBatch
+{
+	size_t   count;  // number of timestamps
+	unsigned mask;   // planets computed
+
+	// Geocentric equatorial coordinates
+	std::array<std::vector<double>, NumberOfPlanets> ra;    // hours
+	std::array<std::vector<double>, NumberOfPlanets> dec;   // degrees
+	std::array<std::vector<double>, NumberOfPlanets> dist;  // AU
+};
+
+
+class AJplEphemeris;
+class AVsop87;
 
 class APlanets : public AlgBase
 {
 public:
-	APlanets(const int planetType = PlanetType::All);
+	/// @brief Constructor
+	/// @param[in] planetType - planet(s) to compute
+	/// @param[in] context - verbose level of the request
+	APlanets(const int planetType = PlanetType::All, const AContext& context = DefaultContext);
 
 	// APlanets(const DateString& dateString);
 
@@ -84,30 +142,104 @@ public:
 	/// @brief Compute and displays planet positions from settings in this object
 	void computePlanets(const ALocation& location, const ADateTime& procTime);
 
-	void computePlanetPos(const PlanetDescriptor& planet, const double j2000, double& ra, double& dec, double& dist);
+	/// @brief Computes planet positions from settings in this object (no console output)
+	/// @param[in] location
+	/// @param[in] procTime - date/time of computation
+	/// @param[out] positions - positions of planet(s) selected
+	void computePlanetPositions(const ALocation& location, const ADateTime& procTime, std::vector<PlanetPosition>& positions) const;
+
+	/// @brief Computes planet positions of the date of an instant (no console output)
+	/// @param[in] location
+	/// @param[in] instant - date of computation (altitudes at local midnight in the time zone of the context)
+	/// @param[out] positions - positions of planet(s) selected
+	void computePlanetPositions(const ALocation& location, const AInstant instant, std::vector<PlanetPosition>& positions) const;
+
+	/// @brief Elements of a planet
+	/// @param[in] planet - PlanetType (not All)
+	static const PlanetDescriptor& planetDescriptor(const int planet);
+
+	/// @brief Computes Heliocentric Rectangular Coordinates of Earth (x = 0 is at vernal equinox)
+	/// @param[in] j2000 - J2000 day
+	/// @return position of Earth (the view position)
+	OrbitPos computeViewPos(const double j2000) const;
+
+	/// @brief Computes geocentric RA (hours), DEC (degrees) and distance (AU) of a planet.
+	void computePlanetPos(const PlanetDescriptor& planet, const double j2000, double& ra, double& dec, double& dist) const;
+
+	/// @brief Computes geocentric and heliocentric position of a planet.
+	/// @param[in] planet - planet elements
+	/// @param[in] j2000 - J2000 day
+	/// @param[in] viewPos - position of Earth for the same day (see computeViewPos)
+	/// @param[out] position - computed position
+	void computePlanetPos(const PlanetDescriptor& planet, const double j2000, const OrbitPos& viewPos, PlanetPosition& position) const;
+
+	/// @brief Computes geocentric RA/DEC/distance of planets for an array of J2000 days.
+	///
+	/// Earth (view) position is computed once per timestamp and shared by all planets.
+	/// Results are the same as computePlanetPos() for each planet and day.
+	///
+	/// @param[in] j2000 - J2000 days
+	/// @param[in] count - number of J2000 days
+	/// @param[in] mask - planets to compute (see planetMask(), AllPlanetsMask)
+	/// @param[out] batch - computed positions (arrays are re-sized - capacity is reused)
+	void computePlanetBatch(const double* j2000, const size_t count, const unsigned mask, PlanetBatch& batch) const;
+
+	/// @brief Computes geocentric RA/DEC/distance of planets for a vector of J2000 days.
+	void computePlanetBatch(const std::vector<double>& j2000, const unsigned mask, PlanetBatch& batch) const;
 
 	void parseArgs(std::string args);
 
-	static int m_verboseLevel;
+	/// @brief Planet mask of the planets computed by computePlanetPositions() (see parseArgs)
+	unsigned selectedPlanets() const;
+
+	/// @brief Computes positions from a JPL ephemeris (within its span) instead of the elements
+	/// @param[in] ephemeris - open ephemeris (nullptr = elements only) - not owned
+	void setEphemeris(const AJplEphemeris* ephemeris);
+
+	const AJplEphemeris* ephemeris() const
+	{
+		return m_ephemeris;
+	}
+
+	/// @brief Computes positions of Mercury to Neptune from VSOP87 instead of the elements (outside the JPL ephemeris)
+	/// @param[in] vsop87 - theory of the truncation to use (nullptr = elements) - not owned
+	void setVsop87(const AVsop87* vsop87);
+
+	const AVsop87* vsop87() const
+	{
+		return m_vsop87;
+	}
+
+    /// @brief Sets verbose level and time zone from context
+    /// @param[in] context - settings of the request
+    void setContext(const AContext& context);
+
+	int m_verboseLevel;
+
+	/// @brief Time zone of the context (hours from UTC)
+	double m_timeZone;
 
 private:
-	/// @brief Computes a planet's RA/DEC/Alt
-	void computeAPlanet(const PlanetDescriptor& planet, const ALocation& location, const double j2000, const double md);
+	/// @brief Computes positions of the batch from the ephemeris (all days within its span)
+	void ephemerisBatch(const double* j2000, const size_t count, PlanetBatch& batch) const;
 
-	/// @brief Displays planets of type
-	void computePlanets(const ALocation& location, const ADateTime& procTime, int type);
+	/// @brief Computes a planet's RA/DEC/Alt
+	void computeAPlanet(const PlanetDescriptor& planet, const ALocation& location, const double j2000, const double md,
+		const OrbitPos& viewPos, PlanetPosition& position) const;
 
-	/// @brief Prints all Planet information
-	void printAll(const ALocation& location, const ADateTime& dateTime);
+	/// @brief Computes planets of type
+	/// @param[in] instant - date of computation
+	/// @param[in] localMidnight - instant of altitudes
+	void computePlanetPositions(const ALocation& location, const AInstant instant, const AInstant localMidnight, int type,
+		std::vector<PlanetPosition>& positions) const;
 
-	/// @brief Heliocentric Rectangular Coordinates of Earth (x = 0 is at vernal equinox)
-	OrbitPos m_viewPos;
-#if 0
-	double m_xEarth;
-	double m_yEarth;
-	double m_zEarth;
-#endif
 	/// @brief Compute for the planet type
 	int m_planetType;
+
+	/// @brief JPL ephemeris of positions (nullptr = elements)
+	const AJplEphemeris* m_ephemeris;
+
+	/// @brief VSOP87 theory of positions (nullptr = elements)
+	const AVsop87* m_vsop87;
 };
 
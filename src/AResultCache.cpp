@@ -0,0 +1,231 @@
+/// @file
+///
+/// @brief AResultCache class implementation.
+///
+/// @copyright 2019-2020 M.Mashimo and licensors. All Right Reserved.
+///
+/// This file is part of cMoon application.
+///
+/// cMoon is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// any later version.
+///
+/// cMoon is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with cMoon.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "AMappedFile.h"
+#include "AResultCache.h"
+
+static const char s_cacheMagic[8]{'c', 'M', 'o', 'o', 'n', 'R', 'C', '\0'};
+
+/// @brief Most Moon cycles of next phase settings in a key (more are computed every time)
+static constexpr int MaxKeyCycles{127};
+
+static ResultCacheHeader cacheHeader(const double precision)
+{
+	ResultCacheHeader header{};
+	memcpy(header.magic, s_cacheMagic, sizeof(header.magic));
+	header.version = ResultCacheVersion;
+	header.events = static_cast<uint32_t>(CacheEvent::Count);
+	header.precision = precision;
+	header.sizes[0] = sizeof(MoonRiseInfo);
+	header.sizes[1] = sizeof(SunInfo);
+	header.sizes[2] = sizeof(CachedPhase);
+	header.sizes[3] = sizeof(CachedPhases);
+	return header;
+}
+
+/// @brief Engine of the Moon as key variant bits - results of the lunar theory are not those of the series
+static uint32_t engineVariant(const AMoon& moon)
+{
+	return (moon.lunarTheory() != nullptr) ? CacheVariantLunarTheory : 0;
+}
+
+/// @brief Next phase settings of a Moon as a key variant
+/// @return false if the settings are not cached (too many phases or cycles, phase precision set)
+static bool nextPhaseVariant(const AMoon& moon, uint32_t& variant)
+{
+	if ((moon.m_numberOfPhases < 1) || (moon.m_numberOfPhases > ResultCacheMaxPhases) || (abs(moon.m_nextMoonCycle) > MaxKeyCycles)
+		|| (moon.m_nextPhase < -1) || (moon.m_nextPhase > 3) || (moon.m_phasePrecision != 0.))
+	{
+		return false;
+	}
+
+	variant = static_cast<uint32_t>(moon.m_nextPhase + 1)
+		| (static_cast<uint32_t>(moon.m_lockMoonPhase ? 1 : 0) << 3)
+		| (static_cast<uint32_t>(moon.m_numberOfPhases) << 4)
+		| (static_cast<uint32_t>(moon.m_nextMoonCycle + MaxKeyCycles) << 12)
+		| engineVariant(moon);
+	return true;
+}
+
+
+AResultCache::AResultCache(const size_t capacity, const double precision)
+	: m_precision(std::max(precision, ResultCacheMinPrecision))
+	, m_moonRise(capacity)
+	, m_sun(capacity)
+	, m_phase(capacity)
+	, m_nextPhases(capacity)
+{
+	// Intentionally left blank
+}
+
+CacheKey AResultCache::siteKey(const AInstant instant, const ALocation& location, ALocation& rounded) const
+{
+	CacheKey key{instant.ticks(),
+		static_cast<int32_t>(lround(location.latitude() / m_precision)),
+		static_cast<int32_t>(lround(location.longitude() / m_precision)),
+		static_cast<int32_t>(lround(location.elevation())),
+		0};
+
+	rounded = location;
+	rounded.setLatitude(key.latitude * m_precision);
+	rounded.setLongitude(key.longitude * m_precision);
+	rounded.setElevation(static_cast<double>(key.elevation));
+	return key;
+}
+
+void AResultCache::computeMoonRise(const AMoon& moon, const ALocation& location, const AInstant dayStart, MoonRiseInfo& info)
+{
+	ALocation rounded;
+	CacheKey key = siteKey(dayStart, location, rounded);
+	key.variant = engineVariant(moon);
+	if (!m_moonRise.find(key, info))
+	{
+		moon.computeMoonRise(rounded, dayStart, info);
+		m_moonRise.insert(key, info);
+	}
+}
+
+void AResultCache::computeSun(const ASun& sun, const ALocation& location, const AInstant instant, SunInfo& info)
+{
+	// Sunrise/sunset is of the Julian day (noon to noon UTC) of the instant
+	AInstant day = AInstant::fromJulian(floor(instant.julian()));
+
+	ALocation rounded;
+	CacheKey key = siteKey(day, location, rounded);
+	if (!m_sun.find(key, info))
+	{
+		sun.computeSun(rounded, day, info);
+		m_sun.insert(key, info);
+	}
+}
+
+int AResultCache::computeMoonPhase(const AMoon& moon, const AInstant instant, PhaseInfo& info)
+{
+	CacheKey key{instant.ticks(), 0, 0, 0, engineVariant(moon)};
+	CachedPhase phase;
+	if (!m_phase.find(key, phase))
+	{
+		phase.nextPhase = moon.computeMoonPhase(instant, phase.info);
+		m_phase.insert(key, phase);
+	}
+
+	info = phase.info;
+	return phase.nextPhase;
+}
+
+int AResultCache::computeNextPhases(const AMoon& moon, const AInstant instant, std::vector<PhaseEvent>& events)
+{
+	CacheKey key{instant.ticks(), 0, 0, 0, 0};
+	if (!nextPhaseVariant(moon, key.variant))
+	{
+		return moon.computeNextPhases(instant, events);
+	}
+
+	CachedPhases phases;
+	if (!m_nextPhases.find(key, phases))
+	{
+		std::vector<PhaseEvent> computed;
+		phases.nextPhase = moon.computeNextPhases(instant, computed);
+		phases.count = static_cast<int>(std::min(computed.size(), phases.events.size()));
+		std::copy(computed.begin(), computed.begin() + phases.count, phases.events.begin());
+		m_nextPhases.insert(key, phases);
+	}
+
+	events.insert(events.end(), phases.events.begin(), phases.events.begin() + phases.count);
+	return phases.nextPhase;
+}
+
+CacheCounters AResultCache::counters(const CacheEvent event) const
+{
+	switch (event)
+	{
+	case CacheEvent::MoonRise:
+		return m_moonRise.counters();
+	case CacheEvent::Sun:
+		return m_sun.counters();
+	case CacheEvent::MoonPhase:
+		return m_phase.counters();
+	case CacheEvent::NextPhases:
+		return m_nextPhases.counters();
+	default:
+		return CacheCounters{0, 0, 0};
+	}
+}
+
+CacheCounters AResultCache::counters() const
+{
+	CacheCounters total{0, 0, 0};
+	for (uint32_t event = 0; event < static_cast<uint32_t>(CacheEvent::Count); event++)
+	{
+		CacheCounters counter = counters(static_cast<CacheEvent>(event));
+		total.hits += counter.hits;
+		total.misses += counter.misses;
+		total.entries += counter.entries;
+	}
+	return total;
+}
+
+void AResultCache::clear()
+{
+	m_moonRise.clear();
+	m_sun.clear();
+	m_phase.clear();
+	m_nextPhases.clear();
+}
+
+bool AResultCache::save(const std::string& path) const
+{
+	ResultCacheHeader header = cacheHeader(m_precision);
+
+	// Readers never see a partial cache
+	return AMappedFile::writeAtomic(path, [&](FILE* file)
+	{
+		return (fwrite(&header, sizeof(header), 1, file) == 1)
+			&& m_moonRise.write(file) && m_sun.write(file) && m_phase.write(file) && m_nextPhases.write(file);
+	});
+}
+
+bool AResultCache::load(const std::string& path)
+{
+	FILE* file = fopen(path.c_str(), "rb");
+	if (file == nullptr)
+	{
+		return false;
+	}
+
+	// Same version, precision and layout of values only
+	ResultCacheHeader expected = cacheHeader(m_precision);
+	ResultCacheHeader header;
+	bool valid = (fread(&header, sizeof(header), 1, file) == 1) && (memcmp(&header, &expected, sizeof(header)) == 0);
+
+	valid = valid && m_moonRise.read(file) && m_sun.read(file) && m_phase.read(file) && m_nextPhases.read(file);
+	fclose(file);
+
+	if (!valid)
+	{
+		clear();
+	}
+	return valid;
+}
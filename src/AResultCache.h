@@ -0,0 +1,334 @@
+/// @file
+///
+/// @brief AResultCache class definitions.
+///
+/// AResultCache answers repeated rise/set, sunrise/sunset, phase and next
+/// phase queries from memory. A result of a site (latitude/longitude rounded
+/// to the precision of the cache, elevation rounded) and a day (or instant)
+/// never changes, so each computation keeps its least recently used results
+/// up to the capacity of the cache. Results are computed for the rounded
+/// site - the same answer whichever query computed it first. The cache is
+/// thread-safe and can be saved to (and loaded from) a file between runs.
+///
+/// @copyright 2019-2020 M.Mashimo and licensors. All Right Reserved.
+///
+/// This file is part of cMoon application.
+///
+/// cMoon is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// any later version.
+///
+/// cMoon is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with cMoon.  If not, see <https://www.gnu.org/licenses/>.
+///
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <iterator>
+#include <list>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "AInstant.h"
+#include "ALocation.h"
+#include "AMoon.h"
+#include "ASun.h"
+
+/// @brief Default results kept of each computation
+constexpr size_t ResultCacheCapacity{65536};
+
+/// @brief Default precision of latitude and longitude (degrees - about 100m)
+constexpr double ResultCachePrecision{0.001};
+
+/// @brief Finest precision (latitude and longitude keys are 32 bits)
+constexpr double ResultCacheMinPrecision{1e-6};
+
+/// @brief Most next phase events cached of a query (more are computed every time)
+constexpr int ResultCacheMaxPhases{16};
+
+/// @brief Version of the cache file - files of other versions are ignored
+constexpr uint32_t ResultCacheVersion{2};
+
+/// @brief Key variant bit of results of the lunar theory (AMoon::setLunarTheory())
+constexpr uint32_t CacheVariantLunarTheory{1u << 24};
+
+/// @brief Computations cached
+enum class CacheEvent : uint32_t
+{
+	MoonRise = 0,   // AMoon::computeMoonRise() - of the day
+	Sun,            // ASun::computeSun() - of the day
+	MoonPhase,      // AMoon::computeMoonPhase() - at the instant
+	NextPhases,     // AMoon::computeNextPhases() - from the instant (with the next phase settings)
+	Count
+};
+
+/// @brief Key of a cached result
+using CacheKey = struct structCacheKey
+{
+	int64_t  instant;    // day start or instant (ticks - see AInstant)
+	int32_t  latitude;   // latitude / precision (0 if not used)
+	int32_t  longitude;  // longitude / precision (0 if not used)
+	int32_t  elevation;  // elevation rounded (0 if not used)
+	uint32_t variant;    // settings of the computation (next phases) and engine (CacheVariantLunarTheory)
+};
+
+inline bool operator==(const CacheKey& a, const CacheKey& b)
+{
+	return (a.instant == b.instant) && (a.latitude == b.latitude) && (a.longitude == b.longitude)
+		&& (a.elevation == b.elevation) && (a.variant == b.variant);
+}
+
+/// @brief Hash of a key (splitmix64 of the fields)
+struct CacheKeyHash
+{
+	size_t operator()(const CacheKey& key) const
+	{
+		uint64_t h = static_cast<uint64_t>(key.instant);
+		h ^= (static_cast<uint64_t>(static_cast<uint32_t>(key.latitude)) << 32) | static_cast<uint32_t>(key.longitude);
+		h += 0x9E3779B97F4A7C15ULL * (1 + ((static_cast<uint64_t>(static_cast<uint32_t>(key.elevation)) << 32) | key.variant));
+		h = (h ^ (h >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		h = (h ^ (h >> 27)) * 0x94D049BB133111EBULL;
+		return static_cast<size_t>(h ^ (h >> 31));
+	}
+};
+
+/// @brief Phase (and next phase) of AMoon::computeMoonPhase()
+using CachedPhase = struct structCachedPhase
+{
+	PhaseInfo info;
+	int       nextPhase;
+};
+
+/// @brief Events of AMoon::computeNextPhases()
+using CachedPhases = struct structCachedPhases
+{
+	int        count;
+	int        nextPhase;   // return value
+	std::array<PhaseEvent, ResultCacheMaxPhases> events;
+};
+
+/// @brief Hits and misses of a computation
+using CacheCounters = struct structCacheCounters
+{
+	uint64_t hits;
+	uint64_t misses;
+	size_t   entries;
+};
+
+/// @brief Least recently used results of one computation (thread-safe)
+template <typename Value>
+class ALruCache
+{
+	static_assert(std::is_trivially_copyable<Value>::value, "cached values are saved as they are");
+
+public:
+	explicit ALruCache(const size_t capacity) : m_capacity(capacity), m_hits(0), m_misses(0)
+	{
+		m_index.reserve(capacity);
+	}
+
+	/// @brief Finds the result of a key (most recently used from now on)
+	/// @return true if found (hit)
+	bool find(const CacheKey& key, Value& value)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		auto it = m_index.find(key);
+		if (it == m_index.end())
+		{
+			m_misses++;
+			return false;
+		}
+
+		m_entries.splice(m_entries.begin(), m_entries, it->second);
+		value = it->second->second;
+		m_hits++;
+		return true;
+	}
+
+	/// @brief Adds (or replaces) the result of a key - drops the least recently used beyond the capacity
+	void insert(const CacheKey& key, const Value& value)
+	{
+		if (m_capacity == 0)
+		{
+			return;
+		}
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		auto it = m_index.find(key);
+		if (it != m_index.end())
+		{
+			it->second->second = value;
+			m_entries.splice(m_entries.begin(), m_entries, it->second);
+			return;
+		}
+
+		if (m_entries.size() >= m_capacity)
+		{
+			// Reuse the node of the least recently used
+			auto last = std::prev(m_entries.end());
+			m_index.erase(last->first);
+			last->first = key;
+			last->second = value;
+			m_entries.splice(m_entries.begin(), m_entries, last);
+		}
+		else
+		{
+			m_entries.emplace_front(key, value);
+		}
+		m_index.emplace(key, m_entries.begin());
+	}
+
+	void clear()
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_entries.clear();
+		m_index.clear();
+		m_hits = 0;
+		m_misses = 0;
+	}
+
+	CacheCounters counters() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return CacheCounters{m_hits, m_misses, m_entries.size()};
+	}
+
+	/// @brief Writes the entries (least recently used first) - count then (key, value) records
+	bool write(FILE* file) const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		uint64_t count = m_entries.size();
+		if (fwrite(&count, sizeof(count), 1, file) != 1)
+		{
+			return false;
+		}
+		for (auto it = m_entries.rbegin(); it != m_entries.rend(); ++it)
+		{
+			if ((fwrite(&it->first, sizeof(CacheKey), 1, file) != 1) || (fwrite(&it->second, sizeof(Value), 1, file) != 1))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/// @brief Reads entries written by write() (most recently used last)
+	bool read(FILE* file)
+	{
+		uint64_t count;
+		if (fread(&count, sizeof(count), 1, file) != 1)
+		{
+			return false;
+		}
+		for (uint64_t i = 0; i < count; i++)
+		{
+			CacheKey key;
+			Value value;
+			if ((fread(&key, sizeof(key), 1, file) != 1) || (fread(&value, sizeof(value), 1, file) != 1))
+			{
+				return false;
+			}
+			insert(key, value);
+		}
+		return true;
+	}
+
+private:
+	using Entry = std::pair<CacheKey, Value>;
+
+	size_t   m_capacity;
+	uint64_t m_hits;
+	uint64_t m_misses;
+
+	std::list<Entry> m_entries;   // most recently used first
+	std::unordered_map<CacheKey, typename std::list<Entry>::iterator, CacheKeyHash> m_index;
+	mutable std::mutex m_mutex;
+};
+
+/// @brief Header of the cache file - followed by the entries of each computation (CacheEvent order)
+using ResultCacheHeader = struct structResultCacheHeader
+{
+	char     magic[8];     // "cMoonRC"
+	uint32_t version;      // ResultCacheVersion
+	uint32_t events;       // CacheEvent::Count
+	double   precision;    // precision of the keys
+	uint32_t sizes[4];     // sizes of the values - files of other builds are ignored
+};
+
+class AResultCache
+{
+public:
+	/// @brief Constructor
+	/// @param[in] capacity - results kept of each computation (0 = nothing is cached)
+	/// @param[in] precision - latitude and longitude precision of keys (degrees)
+	AResultCache(const size_t capacity = ResultCacheCapacity, const double precision = ResultCachePrecision);
+
+	AResultCache(const AResultCache&) = delete;
+	AResultCache& operator=(const AResultCache&) = delete;
+
+	//--------------------------------------------------------------------------
+	// Cached computations (same results as the engines for the rounded site)
+	//--------------------------------------------------------------------------
+
+	/// @brief AMoon::computeMoonRise() of a day
+	void computeMoonRise(const AMoon& moon, const ALocation& location, const AInstant dayStart, MoonRiseInfo& info);
+
+	/// @brief ASun::computeSun() of the day of an instant
+	void computeSun(const ASun& sun, const ALocation& location, const AInstant instant, SunInfo& info);
+
+	/// @brief AMoon::computeMoonPhase() at an instant
+	/// @return "Next Phase" value
+	int computeMoonPhase(const AMoon& moon, const AInstant instant, PhaseInfo& info);
+
+	/// @brief AMoon::computeNextPhases() from an instant (settings of parseNextPhase()) - events are appended
+	/// @return phase of the first event
+	int computeNextPhases(const AMoon& moon, const AInstant instant, std::vector<PhaseEvent>& events);
+
+	//--------------------------------------------------------------------------
+	// Statistics and persistence
+	//--------------------------------------------------------------------------
+
+	/// @brief Hits, misses and entries of a computation
+	CacheCounters counters(const CacheEvent event) const;
+
+	/// @brief Hits, misses and entries of all computations
+	CacheCounters counters() const;
+
+	double precision() const
+	{
+		return m_precision;
+	}
+
+	void clear();
+
+	/// @brief Writes the cache to a file (written to 'path.tmp' then renamed)
+	/// @return true if written
+	bool save(const std::string& path) const;
+
+	/// @brief Reads a cache file written by save() - a missing file is an empty cache
+	/// @return true if read (false if missing, of another version or precision)
+	bool load(const std::string& path);
+
+private:
+	/// @brief Key of a site (rounded) - 'rounded' is the site the result is computed for
+	CacheKey siteKey(const AInstant instant, const ALocation& location, ALocation& rounded) const;
+
+	double m_precision;
+
+	ALruCache<MoonRiseInfo> m_moonRise;
+	ALruCache<SunInfo>      m_sun;
+	ALruCache<CachedPhase>  m_phase;
+	ALruCache<CachedPhases> m_nextPhases;
+};
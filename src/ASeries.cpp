@@ -0,0 +1,303 @@
+/// @file
+///
+/// @brief ASeries class implementation.
+///
+/// @copyright 2019-2020 M.Mashimo and licensors. All Right Reserved.
+///
+/// This file is part of cMoon application.
+///
+/// cMoon is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// any later version.
+///
+/// cMoon is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with cMoon.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+#include "ASeries.h"
+#include "ASimd.h"
+
+ASeries::ASeries(const std::vector<SeriesTerm>& terms, const bool cosine)
+	: m_terms(terms)
+	, m_cosine(cosine)
+	, m_maxMultiple{0, 0, 0, 0}
+{
+	for (auto& term : m_terms)
+	{
+		for (int a = 0; a < SeriesArguments; a++)
+		{
+			int multiple = abs(term.multiple[a]);
+			if (multiple > m_maxMultiple[a])
+			{
+				m_maxMultiple[a] = multiple;
+			}
+		}
+	}
+}
+
+ASeries::~ASeries()
+{
+	// Nothing here
+}
+
+size_t ASeries::termsUsed(const double minAmplitude) const
+{
+	size_t used = 0;
+	for (auto& term : m_terms)
+	{
+		if (fabs(term.coefficient) >= minAmplitude)
+		{
+			used++;
+		}
+	}
+	return used;
+}
+
+/// @brief Sine and cosine of multiples of packed arguments: [argument][multiple]
+using Harmonics = struct structHarmonics
+{
+	VDouble s[SeriesArguments][SeriesMaxMultiple + 1];
+	VDouble c[SeriesArguments][SeriesMaxMultiple + 1];
+};
+
+/// @brief Computes harmonics up to the largest multiple of each argument
+static inline void computeHarmonics(const int* maxMultiple, const VDouble* arguments, Harmonics& h)
+{
+	for (int a = 0; a < SeriesArguments; a++)
+	{
+		if (maxMultiple[a] == 0)
+		{
+			continue;
+		}
+
+		h.s[a][0] = vset(0.);
+		h.c[a][0] = vset(1.);
+		vsincos(arguments[a], h.s[a][1], h.c[a][1]);
+
+		// sin(nx) = sin((n-1)x) cos x + cos((n-1)x) sin x; cos(nx) = cos((n-1)x) cos x - sin((n-1)x) sin x
+		for (int n = 2; n <= maxMultiple[a]; n++)
+		{
+			h.s[a][n] = (h.s[a][n - 1] * h.c[a][1]) + (h.c[a][n - 1] * h.s[a][1]);
+			h.c[a][n] = (h.c[a][n - 1] * h.c[a][1]) - (h.s[a][n - 1] * h.s[a][1]);
+		}
+	}
+}
+
+/// @brief Sums terms from harmonics
+static inline VDouble sumTerms(const std::vector<SeriesTerm>& terms, const bool cosine, const Harmonics& h,
+	const VDouble E, const double minAmplitude)
+{
+	const VDouble ePower[3]{vset(1.), E, E * E};
+
+	VDouble sum = vset(0.);
+	for (auto& term : terms)
+	{
+		if (fabs(term.coefficient) < minAmplitude)
+		{
+			continue;
+		}
+
+		// Angle addition over the arguments of the term
+		VDouble s = vset(0.);
+		VDouble c = vset(1.);
+		bool first = true;
+		for (int a = 0; a < SeriesArguments; a++)
+		{
+			int multiple = term.multiple[a];
+			if (multiple == 0)
+			{
+				continue;
+			}
+
+			VDouble sn = (multiple < 0) ? -h.s[a][-multiple] : h.s[a][multiple];
+			VDouble cn = (multiple < 0) ? h.c[a][-multiple] : h.c[a][multiple];
+			if (first)
+			{
+				s = sn;
+				c = cn;
+				first = false;
+			}
+			else
+			{
+				VDouble st = (s * cn) + (c * sn);
+				c = (c * cn) - (s * sn);
+				s = st;
+			}
+		}
+
+		VDouble value = cosine ? c : s;
+		if (term.ePower != 0)
+		{
+			value = value * ePower[term.ePower];
+		}
+		sum = vmadd(vset(term.coefficient), value, sum);
+	}
+
+	return sum;
+}
+
+void ASeries::evaluate(const double* const arguments[SeriesArguments], const double* E, const size_t count,
+	double* result, const double minAmplitude) const
+{
+	const ASeries* series[1]{this};
+	double* results[1]{result};
+
+	evaluate(series, 1, arguments, E, count, results, minAmplitude);
+}
+
+void ASeries::evaluate(const ASeries* const* series, const size_t seriesCount, const double* const arguments[SeriesArguments],
+	const double* E, const size_t count, double* const* results, const double minAmplitude)
+{
+	// Harmonics for all series
+	int maxMultiple[SeriesArguments]{0, 0, 0, 0};
+	for (size_t n = 0; n < seriesCount; n++)
+	{
+		for (int a = 0; a < SeriesArguments; a++)
+		{
+			maxMultiple[a] = std::max(maxMultiple[a], series[n]->m_maxMultiple[a]);
+		}
+	}
+
+	VDouble args[SeriesArguments];
+	for (int a = 0; a < SeriesArguments; a++)
+	{
+		args[a] = vset(0.);
+	}
+
+	Harmonics h;
+
+	size_t i = 0;
+	for (; i + VDoubleWidth <= count; i += VDoubleWidth)
+	{
+		for (int a = 0; a < SeriesArguments; a++)
+		{
+			if (maxMultiple[a] != 0)
+			{
+				args[a] = vload(arguments[a] + i);
+			}
+		}
+
+		VDouble e = (E != nullptr) ? vload(E + i) : vset(1.);
+		computeHarmonics(maxMultiple, args, h);
+		for (size_t n = 0; n < seriesCount; n++)
+		{
+			vstore(results[n] + i, sumTerms(series[n]->m_terms, series[n]->m_cosine, h, e, minAmplitude));
+		}
+	}
+
+	// Remaining elements - padded to a full vector
+	if (i < count)
+	{
+		double pad[SeriesArguments][VDoubleWidth] = {};
+		double ePad[VDoubleWidth];
+		double out[VDoubleWidth];
+
+		for (int k = 0; k < VDoubleWidth; k++)
+		{
+			ePad[k] = 1.;
+		}
+
+		for (size_t k = i; k < count; k++)
+		{
+			for (int a = 0; a < SeriesArguments; a++)
+			{
+				if (maxMultiple[a] != 0)
+				{
+					pad[a][k - i] = arguments[a][k];
+				}
+			}
+			if (E != nullptr)
+			{
+				ePad[k - i] = E[k];
+			}
+		}
+
+		for (int a = 0; a < SeriesArguments; a++)
+		{
+			args[a] = vload(pad[a]);
+		}
+
+		computeHarmonics(maxMultiple, args, h);
+		for (size_t n = 0; n < seriesCount; n++)
+		{
+			vstore(out, sumTerms(series[n]->m_terms, series[n]->m_cosine, h, vload(ePad), minAmplitude));
+			for (size_t k = i; k < count; k++)
+			{
+				results[n][k] = out[k - i];
+			}
+		}
+	}
+}
+
+double ASeries::evaluate(const double arguments[SeriesArguments], const double E, const double minAmplitude) const
+{
+	const double* args[SeriesArguments]{&arguments[0], &arguments[1], &arguments[2], &arguments[3]};
+	double result;
+
+	evaluate(args, &E, 1, &result, minAmplitude);
+
+	return result;
+}
+
+/// @brief Sum of linear sine terms for packed x
+static inline VDouble evaluateLinearTerms(const std::vector<LinearSineTerm>& terms, const VDouble x, const double minAmplitude)
+{
+	const VDouble x2 = x * x;
+
+	VDouble sum = vset(0.);
+	for (auto& term : terms)
+	{
+		if (fabs(term.coefficient) < minAmplitude)
+		{
+			continue;
+		}
+
+		// Same as AlgBase::radianConvert() - range 0-360 degrees first
+		VDouble degrees = vmadd(vset(term.a2), x2, vmadd(vset(term.a1), x, vset(term.a0)));
+		degrees = degrees - (vfloor(degrees * vset(1. / 360.)) * vset(360.));
+
+		VDouble s, c;
+		vsincos(degrees * vset(3.14159265358979323846 / 180.), s, c);
+		sum = vmadd(vset(term.coefficient), s, sum);
+	}
+
+	return sum;
+}
+
+void ASeries::evaluateLinear(const std::vector<LinearSineTerm>& terms, const double* x, const size_t count,
+	double* result, const double minAmplitude)
+{
+	size_t i = 0;
+	for (; i + VDoubleWidth <= count; i += VDoubleWidth)
+	{
+		vstore(result + i, evaluateLinearTerms(terms, vload(x + i), minAmplitude));
+	}
+
+	// Remaining elements - padded to a full vector
+	if (i < count)
+	{
+		double pad[VDoubleWidth] = {};
+		double out[VDoubleWidth];
+
+		for (size_t k = i; k < count; k++)
+		{
+			pad[k - i] = x[k];
+		}
+
+		vstore(out, evaluateLinearTerms(terms, vload(pad), minAmplitude));
+
+		for (size_t k = i; k < count; k++)
+		{
+			result[k] = out[k - i];
+		}
+	}
+}
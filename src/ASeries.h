@@ -0,0 +1,117 @@
+/// @file
+///
+/// @brief ASeries class definitions.
+///
+/// ASeries evaluates periodic series (sums of sine or cosine terms) of up to
+/// four fundamental arguments - e.g. Moon phase corrections (M, M', F, Omega)
+/// or lunar theory (D, M, M', F). Coefficients are tables of SeriesTerm.
+///
+/// Only one sine/cosine per argument is computed; multiples (2M, 3M', ...)
+/// are built with angle-addition recurrences and terms combine them by angle
+/// addition. Arrays of arguments are evaluated with packed doubles (ASimd.h).
+///
+/// @copyright 2019-2020 M.Mashimo and licensors. All Right Reserved.
+///
+/// This file is part of cMoon application.
+///
+/// cMoon is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// any later version.
+///
+/// cMoon is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with cMoon.  If not, see <https://www.gnu.org/licenses/>.
+///
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+/// @brief Number of fundamental arguments of a series
+constexpr int SeriesArguments{4};
+
+/// @brief Largest multiple of an argument in a term
+constexpr int SeriesMaxMultiple{4};
+
+/// @brief One term: coefficient * E^ePower * sin (or cos) of (sum of multiple[i] * argument[i])
+using SeriesTerm = struct structSeriesTerm
+{
+	double coefficient;
+	int    ePower;                      // 0, 1 or 2 - power of eccentricity factor E
+	int    multiple[SeriesArguments];   // -SeriesMaxMultiple to SeriesMaxMultiple
+};
+
+/// @brief Sine term of a linear argument (degrees): coefficient * sin(a0 + a1 * x + a2 * x^2)
+using LinearSineTerm = struct structLinearSineTerm
+{
+	double coefficient;
+	double a0;
+	double a1;
+	double a2;
+};
+
+class ASeries
+{
+public:
+	/// @brief Constructor
+	/// @param[in] terms - coefficient table
+	/// @param[in] cosine - true for cosine terms, false for sine terms
+	ASeries(const std::vector<SeriesTerm>& terms, const bool cosine = false);
+
+	~ASeries();
+
+	/// @brief Evaluates the series for one set of arguments.
+	/// @param[in] arguments - fundamental arguments (radians)
+	/// @param[in] E - eccentricity factor (1 if not used)
+	/// @param[in] minAmplitude - terms with |coefficient| below this are skipped (0 = all terms)
+	/// @return sum of terms
+	double evaluate(const double arguments[SeriesArguments], const double E = 1., const double minAmplitude = 0.) const;
+
+	/// @brief Evaluates the series for arrays of arguments.
+	/// @param[in] arguments - array of each fundamental argument (radians); nullptr if all multiples are 0
+	/// @param[in] E - eccentricity factors (nullptr if not used)
+	/// @param[in] count - number of elements in each array
+	/// @param[out] result - sums of terms
+	/// @param[in] minAmplitude - terms with |coefficient| below this are skipped (0 = all terms)
+	void evaluate(const double* const arguments[SeriesArguments], const double* E, const size_t count,
+		double* result, const double minAmplitude = 0.) const;
+
+	/// @brief Evaluates several series of the same arguments - sines/cosines of the arguments are computed once.
+	/// @param[in] series - series to evaluate
+	/// @param[in] seriesCount - number of series
+	/// @param[in] arguments - array of each fundamental argument (radians); nullptr if not used by any series
+	/// @param[in] E - eccentricity factors (nullptr if not used)
+	/// @param[in] count - number of elements in each array
+	/// @param[out] results - sums of terms of each series
+	/// @param[in] minAmplitude - terms with |coefficient| below this are skipped (0 = all terms)
+	static void evaluate(const ASeries* const* series, const size_t seriesCount, const double* const arguments[SeriesArguments],
+		const double* E, const size_t count, double* const* results, const double minAmplitude = 0.);
+
+	/// @brief Evaluates sums of sine terms with linear arguments for arrays of x (e.g. planetary arguments).
+	/// @param[in] terms - coefficient table (arguments in degrees)
+	/// @param[in] x - array of x
+	/// @param[in] count - number of x
+	/// @param[out] result - sums of terms
+	/// @param[in] minAmplitude - terms with |coefficient| below this are skipped (0 = all terms)
+	static void evaluateLinear(const std::vector<LinearSineTerm>& terms, const double* x, const size_t count,
+		double* result, const double minAmplitude = 0.);
+
+	/// @brief Number of terms
+	size_t size() const { return m_terms.size(); }
+
+	/// @brief Number of terms used for a minimum amplitude
+	size_t termsUsed(const double minAmplitude) const;
+
+private:
+	std::vector<SeriesTerm> m_terms;
+	bool m_cosine;
+
+	/// @brief Largest multiple of each argument (0 - argument not used)
+	int m_maxMultiple[SeriesArguments];
+};
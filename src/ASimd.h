@@ -0,0 +1,255 @@
+/// @file
+///
+/// @brief ASimd - packed double operations for batch (array) computations.
+///
+/// VDouble holds VDoubleWidth doubles: 4 with AVX2, 2 with SSE2, otherwise 1
+/// (scalar fallback). Kernels are written once with the functions below and
+/// compile to the instruction set selected by the compiler flags
+/// (see CMOON_NATIVE_ARCH in CMakeLists.txt).
+///
+/// @copyright 2019-2020 M.Mashimo and licensors. All Right Reserved.
+///
+/// This file is part of cMoon application.
+///
+/// cMoon is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// any later version.
+///
+/// cMoon is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with cMoon.  If not, see <https://www.gnu.org/licenses/>.
+///
+
+#pragma once
+
+#include <cmath>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#if defined(__AVX2__)
+
+/// @brief Name of the instruction set used for VDouble
+constexpr const char* SimdName{"AVX2"};
+constexpr int VDoubleWidth{4};
+
+using VDouble = struct structVDouble { __m256d v; };
+using VMask = struct structVMask { __m256d m; };
+
+inline VDouble vset(const double x) { return {_mm256_set1_pd(x)}; }
+inline VDouble vload(const double* p) { return {_mm256_loadu_pd(p)}; }
+inline void vstore(double* p, const VDouble a) { _mm256_storeu_pd(p, a.v); }
+
+inline VDouble operator+(const VDouble a, const VDouble b) { return {_mm256_add_pd(a.v, b.v)}; }
+inline VDouble operator-(const VDouble a, const VDouble b) { return {_mm256_sub_pd(a.v, b.v)}; }
+inline VDouble operator*(const VDouble a, const VDouble b) { return {_mm256_mul_pd(a.v, b.v)}; }
+inline VDouble operator/(const VDouble a, const VDouble b) { return {_mm256_div_pd(a.v, b.v)}; }
+
+/// @brief a * b + c (fused if FMA is available)
+inline VDouble vmadd(const VDouble a, const VDouble b, const VDouble c)
+{
+#if defined(__FMA__)
+	return {_mm256_fmadd_pd(a.v, b.v, c.v)};
+#else
+	return {_mm256_add_pd(_mm256_mul_pd(a.v, b.v), c.v)};
+#endif
+}
+
+inline VDouble vsqrt(const VDouble a) { return {_mm256_sqrt_pd(a.v)}; }
+inline VDouble vround(const VDouble a) { return {_mm256_round_pd(a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC)}; }
+inline VDouble vfloor(const VDouble a) { return {_mm256_floor_pd(a.v)}; }
+inline VDouble vabs(const VDouble a) { return {_mm256_andnot_pd(_mm256_set1_pd(-0.), a.v)}; }
+
+inline VMask vless(const VDouble a, const VDouble b) { return {_mm256_cmp_pd(a.v, b.v, _CMP_LT_OQ)}; }
+inline VMask vgreater(const VDouble a, const VDouble b) { return {_mm256_cmp_pd(a.v, b.v, _CMP_GT_OQ)}; }
+inline VMask vequal(const VDouble a, const VDouble b) { return {_mm256_cmp_pd(a.v, b.v, _CMP_EQ_OQ)}; }
+inline VMask operator&(const VMask a, const VMask b) { return {_mm256_and_pd(a.m, b.m)}; }
+inline VMask operator|(const VMask a, const VMask b) { return {_mm256_or_pd(a.m, b.m)}; }
+
+/// @brief Selects a where mask is set, otherwise b
+inline VDouble vselect(const VMask mask, const VDouble a, const VDouble b) { return {_mm256_blendv_pd(b.v, a.v, mask.m)}; }
+
+#elif defined(__SSE2__)
+
+constexpr const char* SimdName{"SSE2"};
+constexpr int VDoubleWidth{2};
+
+using VDouble = struct structVDouble { __m128d v; };
+using VMask = struct structVMask { __m128d m; };
+
+inline VDouble vset(const double x) { return {_mm_set1_pd(x)}; }
+inline VDouble vload(const double* p) { return {_mm_loadu_pd(p)}; }
+inline void vstore(double* p, const VDouble a) { _mm_storeu_pd(p, a.v); }
+
+inline VDouble operator+(const VDouble a, const VDouble b) { return {_mm_add_pd(a.v, b.v)}; }
+inline VDouble operator-(const VDouble a, const VDouble b) { return {_mm_sub_pd(a.v, b.v)}; }
+inline VDouble operator*(const VDouble a, const VDouble b) { return {_mm_mul_pd(a.v, b.v)}; }
+inline VDouble operator/(const VDouble a, const VDouble b) { return {_mm_div_pd(a.v, b.v)}; }
+
+inline VDouble vmadd(const VDouble a, const VDouble b, const VDouble c) { return {_mm_add_pd(_mm_mul_pd(a.v, b.v), c.v)}; }
+
+inline VDouble vsqrt(const VDouble a) { return {_mm_sqrt_pd(a.v)}; }
+
+/// @brief Round to nearest (|a| < 2^51) - SSE2 has no round instruction
+inline VDouble vround(const VDouble a)
+{
+	const __m128d magic = _mm_set1_pd(6755399441055744.);
+	return {_mm_sub_pd(_mm_add_pd(a.v, magic), magic)};
+}
+
+inline VDouble vabs(const VDouble a) { return {_mm_andnot_pd(_mm_set1_pd(-0.), a.v)}; }
+
+inline VMask vless(const VDouble a, const VDouble b) { return {_mm_cmplt_pd(a.v, b.v)}; }
+inline VMask vgreater(const VDouble a, const VDouble b) { return {_mm_cmpgt_pd(a.v, b.v)}; }
+inline VMask vequal(const VDouble a, const VDouble b) { return {_mm_cmpeq_pd(a.v, b.v)}; }
+inline VMask operator&(const VMask a, const VMask b) { return {_mm_and_pd(a.m, b.m)}; }
+inline VMask operator|(const VMask a, const VMask b) { return {_mm_or_pd(a.m, b.m)}; }
+
+inline VDouble vselect(const VMask mask, const VDouble a, const VDouble b)
+{
+	return {_mm_or_pd(_mm_and_pd(mask.m, a.v), _mm_andnot_pd(mask.m, b.v))};
+}
+
+inline VDouble vfloor(const VDouble a)
+{
+	VDouble r = vround(a);
+	return vselect(vgreater(r, a), r - vset(1.), r);
+}
+
+#else
+
+constexpr const char* SimdName{"scalar"};
+constexpr int VDoubleWidth{1};
+
+using VDouble = struct structVDouble { double v; };
+using VMask = struct structVMask { bool m; };
+
+inline VDouble vset(const double x) { return {x}; }
+inline VDouble vload(const double* p) { return {*p}; }
+inline void vstore(double* p, const VDouble a) { *p = a.v; }
+
+inline VDouble operator+(const VDouble a, const VDouble b) { return {a.v + b.v}; }
+inline VDouble operator-(const VDouble a, const VDouble b) { return {a.v - b.v}; }
+inline VDouble operator*(const VDouble a, const VDouble b) { return {a.v * b.v}; }
+inline VDouble operator/(const VDouble a, const VDouble b) { return {a.v / b.v}; }
+
+inline VDouble vmadd(const VDouble a, const VDouble b, const VDouble c) { return {(a.v * b.v) + c.v}; }
+
+inline VDouble vsqrt(const VDouble a) { return {sqrt(a.v)}; }
+inline VDouble vround(const VDouble a) { return {nearbyint(a.v)}; }
+inline VDouble vfloor(const VDouble a) { return {floor(a.v)}; }
+inline VDouble vabs(const VDouble a) { return {fabs(a.v)}; }
+
+inline VMask vless(const VDouble a, const VDouble b) { return {a.v < b.v}; }
+inline VMask vgreater(const VDouble a, const VDouble b) { return {a.v > b.v}; }
+inline VMask vequal(const VDouble a, const VDouble b) { return {a.v == b.v}; }
+inline VMask operator&(const VMask a, const VMask b) { return {a.m && b.m}; }
+inline VMask operator|(const VMask a, const VMask b) { return {a.m || b.m}; }
+
+inline VDouble vselect(const VMask mask, const VDouble a, const VDouble b) { return mask.m ? a : b; }
+
+#endif
+
+inline VDouble operator-(const VDouble a) { return vset(0.) - a; }
+
+
+/// @brief Sine and cosine (radians) of packed doubles.
+///
+/// Cody-Waite reduction by pi/2 (valid for |x| < 2^20 * pi/2) and the fdlibm
+/// kernel polynomials on [-pi/4, pi/4] - within 1-2 ulp of libm sin/cos.
+///
+/// @param[in] x - angles in radians
+/// @param[out] s - sine
+/// @param[out] c - cosine
+inline void vsincos(const VDouble x, VDouble& s, VDouble& c)
+{
+	// pi/2 in three parts (33 + 33 + 53 bits) - q * part is exact
+	const VDouble pio2a = vset(1.57079632673412561417e+00);
+	const VDouble pio2b = vset(6.07710050630396597660e-11);
+	const VDouble pio2c = vset(2.02226624871116645580e-21);
+
+	VDouble q = vround(x * vset(0.63661977236758134308));
+	VDouble r = x - (q * pio2a);
+	r = r - (q * pio2b);
+	r = r - (q * pio2c);
+
+	// quadrant 0..3
+	VDouble quad = q - (vset(4.) * vfloor(q * vset(0.25)));
+
+	VDouble z = r * r;
+
+	VDouble ps = vmadd(z, vset(1.58969099521155010221e-10), vset(-2.50507602534068634195e-08));
+	ps = vmadd(z, ps, vset(2.75573137070700676789e-06));
+	ps = vmadd(z, ps, vset(-1.98412698298579493134e-04));
+	ps = vmadd(z, ps, vset(8.33333333332248946124e-03));
+	ps = vmadd(z, ps, vset(-1.66666666666666324348e-01));
+	VDouble sr = vmadd(r * z, ps, r);
+
+	VDouble pc = vmadd(z, vset(-1.13596475577881948265e-11), vset(2.08757232129817482790e-09));
+	pc = vmadd(z, pc, vset(-2.75573143513906633035e-07));
+	pc = vmadd(z, pc, vset(2.48015872894767294178e-05));
+	pc = vmadd(z, pc, vset(-1.38888888888741095749e-03));
+	pc = vmadd(z, pc, vset(4.16666666666666019037e-02));
+	VDouble cr = vmadd(z * z, pc, vset(1.) - (vset(0.5) * z));
+
+	// Quadrants 1 and 3 swap sine and cosine
+	VMask odd = vequal(quad, vset(1.)) | vequal(quad, vset(3.));
+	VDouble ss = vselect(odd, cr, sr);
+	VDouble cc = vselect(odd, sr, cr);
+
+	// Sine is negative in quadrants 2, 3 - cosine in quadrants 1, 2
+	s = vselect(vgreater(quad, vset(1.5)), -ss, ss);
+	c = vselect(vequal(quad, vset(1.)) | vequal(quad, vset(2.)), -cc, cc);
+}
+
+/// @brief Arc-tangent of packed doubles (Cephes atan - rational approximation after
+/// reduction by tan(3pi/8) and tan(pi/8)).
+inline VDouble vatan(const VDouble x)
+{
+	const VDouble morebits = vset(6.123233995736765886130e-17);
+
+	VDouble a = vabs(x);
+	VMask big = vgreater(a, vset(2.41421356237309504880));
+	VMask mid = vgreater(a, vset(0.66)) & vless(a, vset(2.41421356237309504881));
+
+	VDouble y = vselect(big, vset(1.57079632679489661923), vselect(mid, vset(0.78539816339744830962), vset(0.)));
+	VDouble extra = vselect(big, morebits, vselect(mid, vset(0.5) * morebits, vset(0.)));
+	VDouble xr = vselect(big, vset(-1.) / a, vselect(mid, (a - vset(1.)) / (a + vset(1.)), a));
+
+	VDouble z = xr * xr;
+	VDouble p = vmadd(z, vset(-8.750608600031904122785e-01), vset(-1.615753718733365076637e+01));
+	p = vmadd(z, p, vset(-7.500855792314704667340e+01));
+	p = vmadd(z, p, vset(-1.228866684490136173410e+02));
+	p = vmadd(z, p, vset(-6.485021904942025371773e+01));
+	VDouble qq = z + vset(2.485846490142306297962e+01);
+	qq = vmadd(z, qq, vset(1.650270098316988542046e+02));
+	qq = vmadd(z, qq, vset(4.328810604912902668951e+02));
+	qq = vmadd(z, qq, vset(4.853903996359136964868e+02));
+	qq = vmadd(z, qq, vset(1.945506571482613964425e+02));
+
+	VDouble r = vmadd(xr, z * p / qq, xr);
+	r = y + (r + extra);
+
+	return vselect(vless(x, vset(0.)), -r, r);
+}
+
+/// @brief Angle of (x, y) in the range 0 to two pi (see AlgBase::fnatn2) of packed doubles
+inline VDouble vatan2pos(const VDouble y, const VDouble x)
+{
+	VDouble t = vatan(vabs(y) / vabs(x));
+	t = vselect(vless(x, vset(0.)), vset(3.14159265358979323846) - t, t);
+	return vselect(vless(y, vset(0.)), vset(6.28318530717958647692) - t, t);
+}
+
+/// @brief Arc-cosine of packed doubles in [-1, 1] - 2 atan(sqrt((1 - x) / (1 + x)))
+/// (no cancellation near -1 or 1, atan of +inf is pi/2 at -1)
+inline VDouble vacos(const VDouble x)
+{
+	return vset(2.) * vatan(vsqrt((vset(1.) - x) / (vset(1.) + x)));
+}
@@ -33,12 +33,14 @@
 
 #include <stdlib.h>
 
+#include "ASimd.h"
 #include "ASun.h"
 #include "ALocation.h"
 
-int ASun::m_verboseLevel = 1;
-
-ASun::ASun()
+ASun::ASun(const AContext& context)
+	: m_verboseLevel(context.sunVerbose)
+	, m_context(context)
+	, m_timeZone(ATimeZone::fromContext(context))
 {
 
 }
@@ -49,112 +51,137 @@ void ASun::setVerboseMode(const int level)
     m_verboseLevel = level;
 }
 
-
-// Computation of sunrise/sunset
-void ASun::showSun(const ALocation& location, const ADateTime& procTime)
+void ASun::setContext(const AContext& context)
 {
-	ADateTime dateTime(procTime);
-
-	std::cout << "\n-----------------Sunrise-Sunset------------------" << std::endl;
-
-	// Temporary use of struct tm to get time
+    m_verboseLevel = context.sunVerbose;
+    m_context = context;
+    m_timeZone = ATimeZone::fromContext(context);
+}
 
-	struct tm jTime = dateTime.getTimeStruct();
 
-	// sunrise equation is cos w0 = -tan phi x tan delta
-	// w0 is the hour andle at sunrise (negative) sunset (positive)
-	// phi is the latitude of the observer on Earth
-	// delta is the sun declination
-
-	// Earth rotate as an angular velocity of 15degrees/hour. 'w0 x 15degrees / hour' is the local solar noon
-	// phi is 0 at equator, positive for Nother Hemisphere.
-	// delta is 0 at vernal and autumnal equnoxes when sun is exactly above the equator; positive in Northern summer
-	//    and negative at Northern hemisphere winter.
+/// @brief Sets the date and time of a struct tm from a Julian date counted from midnight (0.5 is noon)
+static void setTimeStruct(const ADateTime& dateTime, const double midnightJd, struct tm& jTime)
+{
+	int year, month, day;
+	double civilDay = floor(midnightJd);
+	AlgBase::convertJulianToDate(civilDay, year, month, day);
+	jTime.tm_year = year - 1900;
+	jTime.tm_mon  = month - 1;
+	jTime.tm_mday = day;
+	// Julian day 0 was a Monday
+	jTime.tm_wday = static_cast<int>(fmod(civilDay + 1., 7.));
+	dateTime.convertJulianToTime(midnightJd, jTime);
+}
 
-	// Atmospheric refraction - lifts the solar disc be approx 0.6 degrees on the horizon (solar disc is 0.5degrees)
-	// cos(w0) = ( sin(alpha) - sin(phi) x sin(delta) ) / ( cos(phi) x cos(delta) )
+std::string ASun::eventTimeString(const ADateTime& dateTime, const double jd) const
+{
+	if (std::isnan(jd))
+	{
+		// Sun does not rise or set that day
+		return "none";
+	}
 
-	// alpha is altitude of the center of solar disc set to about -0.83degrees (or -50 arcminuntes).
+	// Fraction of sunrise/sunset Julian dates is the time from midnight (UTC) - the event's own day
+	AInstant instant = AInstant::fromJulian(jd + 0.5);
+	LocalTimeInfo local = m_timeZone->lookupJulian(instant.julian());
 
-	// 0.0008 is Julian seconds
-	// Jnoon is the number of days since 2000-1-1-12:00pm (noon) = 2451545.
-	// double Jnoon = jd - 2451545. + 0.0008;
-	// NOTE: Our Julian already computes the UTC time. We need to add the 12-noon (0.5)
-	// double Jnoon = floor(dateTime.julianDay()) - 2451544.5 + 0.0008;
-	double Jnoon = dateTime.j2000Noon() + 0.0008;
+	struct tm utcTime{};
+	setTimeStruct(dateTime, instant.julian() + 0.5, utcTime);
 
-	// TT was set to 32.184 seconds laggin TAI on January 1958. By 1972, when leap seconds were introduced, 10 sec were added.
-	// By Jan 1, 2017, 27 more seconds were added comin to the total of 68.184 sec.
-	// This is computed as 68.184 / 86400 or 0.0008 with DUT1 (UT1 - UTC)
+	struct tm jTime{};
+	setTimeStruct(dateTime, instant.julian() + 0.5 + (local.offset / 86400.), jTime);
 
-	// Mean solar noon
-	double Jmean = Jnoon - (location.longitude() / 360.);
+	// Same as strftime "%F %T %Z %z" in the zone
+	int minutes = abs(local.offset) / 60;
+	char offset[24];
+	snprintf(offset, sizeof(offset), "%c%02d%02d", (local.offset < 0) ? '-' : '+', minutes / 60, minutes % 60);
 
-	if (m_verboseLevel & DebugComputation)
-	{
-		std::cout << "Jnoon = " << Jnoon << " Jmean = " << Jmean << std::endl;
-	}
+	return dateTime.asString(utcTime, "(%c UTC) ") + dateTime.asString(jTime, "%F %T ") + local.abbreviation + " " + offset;
+}
 
-	// Jmean is an approximation of the mean solar time at noon (Jnoon) as Julian date with the day fraction.
-	// lw (LONG) is the longitude west in decimal degrees (in US, longitude is negative, east in Europe is positive) of observer.
 
+void ASun::solarTerms(const double Jmean, double& M, double& C, double& lambda, double& equTime, double& radDelta)
+{
 	// Solar mean anomaly (M) - in degrees, for sin/cos, use rads (Mrd) - Need conversion as degrees/time
 	// M = (357.5291 + (0.98560028 * Jmean)) MOD 360.;
 	// https://en.wikipedia.org/wiki/Mean_anomaly
-	double M = roundDegrees(357.5291 + (0.98560028 * Jmean));
+	M = roundDegrees(357.5291 + (0.98560028 * Jmean));
 	double Mrad = radianConvert(M);
 
-	if (m_verboseLevel & DebugComputation)
-	{
-		std::cout << "Mean anomaly: " << M << " rad: " << Mrad << std::endl;
-	}
-
 	// Equation of the center (C) (need to use radianConvert) - used to calculate lambda
 	// https://en.wikipedia.org/wiki/Equation_of_the_center
 	// C = 1.9148 * sin(M) + 0.0200 * sin(2*M) + 0.0003 * sin(3*M)
 	// double C = (1.9148 * sin(Mrad)) + (0.0200 * sin(radianConvert(2*M))) + (0.0003 * sin(radianConvert(3*M)));
-	double C = (1.9148 * sin(Mrad)) + (0.0200 * sin(2 * Mrad)) + (0.0003 * sin(3 * Mrad));
+	C = (1.9148 * sin(Mrad)) + (0.0200 * sin(2 * Mrad)) + (0.0003 * sin(3 * Mrad));
 	// 1.9148 is the coefficient of the equation of the center for the planet the observer is on (earth)
 
 	// Ecliptic longitude (lambda) - in degrees
 	// https://en.wikipedia.org/wiki/Ecliptic_coordinate_system#Spherical_coordinates
 	// lambda = (M + C + 180 + 102.9372) % 360;
-	double lambda = roundDegrees(M + C + 180. + 102.9372);
+	// 102.9372 is the value for the argument of perihelion.
+	lambda = roundDegrees(M + C + 180. + 102.9372);
 	double lrad = radianConvert(lambda);
 
-	if (m_verboseLevel & DebugComputation)
-	{
-		// 102.9372 is the value for the argument of perihelion.
-		std::cout << "Equation of Center: " << C << " degrees." << std::endl;
-		std::cout << " Ecliptic longitude (lambda)  = " << lambda << " rad:" << lrad << std::endl;
-	}
-
 	// Solar Transit
 	// Jtransit = 2451545.0 + Jmean + 0.0053 * sin(M) - 0.0069 * sin(2 * lambda);
-	double equTime = (0.0053 * sin(Mrad)) - (0.0069 * sin(2 * lrad));
-	double Jtransit = 2451545.0 + Jmean + equTime;
+	equTime = (0.0053 * sin(Mrad)) - (0.0069 * sin(2 * lrad));
 	// where: Jtransit is the julian date for the local true solar transit for solar noon)
 	// 0.0053sinM - 0.0069sin2lambda is the simplified version of the equation of time.
 	// https://en.wikipedia.org/wiki/Equation_of_time
 	// The coefficients are fractional day minutes.
-	if (m_verboseLevel & DebugComputation)
-	{
-		std::cout << "Jtransit = " << Jtransit << "  Equation of Time: " << equTime << " -- ";
-	}
-
-	dateTime.convertJulianToTime(fabs(equTime), jTime);
 
 	// Declination of the Sun (delta)
 	// sin(delta) = sin(lambda) * sin(23.44)
-	double radDelta = asin(sin(lrad) * sin(radianConvert(23.44)));
-
-	if (m_verboseLevel & DebugComputation)
-	{
-		std::cout << "Solar eclination (delta) = " << radDelta << " degrees: " << degreeConvert(radDelta) << std::endl;
-	}
+	radDelta = asin(sin(lrad) * sin(radianConvert(23.44)));
 
 	// delta is the declination of the sun. arc-sin needed to get the declination in degrees.
 	// 23.44 degrees is the Earth's maximum axial tilt towards the sunrise
+}
+
+
+// Computation of sunrise/sunset
+void ASun::computeSun(const ALocation& location, const ADateTime& procTime, SunInfo& info) const
+{
+	computeSun(location, procTime.instant(), info);
+}
+
+void ASun::computeSun(const ALocation& location, const AInstant instant, SunInfo& info) const
+{
+	// sunrise equation is cos w0 = -tan phi x tan delta
+	// w0 is the hour andle at sunrise (negative) sunset (positive)
+	// phi is the latitude of the observer on Earth
+	// delta is the sun declination
+
+	// Earth rotate as an angular velocity of 15degrees/hour. 'w0 x 15degrees / hour' is the local solar noon
+	// phi is 0 at equator, positive for Nother Hemisphere.
+	// delta is 0 at vernal and autumnal equnoxes when sun is exactly above the equator; positive in Northern summer
+	//    and negative at Northern hemisphere winter.
+
+	// Atmospheric refraction - lifts the solar disc be approx 0.6 degrees on the horizon (solar disc is 0.5degrees)
+	// cos(w0) = ( sin(alpha) - sin(phi) x sin(delta) ) / ( cos(phi) x cos(delta) )
+
+	// alpha is altitude of the center of solar disc set to about -0.83degrees (or -50 arcminuntes).
+
+	// 0.0008 is Julian seconds
+	// Jnoon is the number of days since 2000-1-1-12:00pm (noon) = 2451545.
+	// double Jnoon = jd - 2451545. + 0.0008;
+	// NOTE: Our Julian already computes the UTC time. We need to add the 12-noon (0.5)
+	// double Jnoon = floor(dateTime.julianDay()) - 2451544.5 + 0.0008;
+	double Jnoon = floor(instant.julian()) - 2451544.5 + 0.0008;
+
+	// TT was set to 32.184 seconds laggin TAI on January 1958. By 1972, when leap seconds were introduced, 10 sec were added.
+	// By Jan 1, 2017, 27 more seconds were added comin to the total of 68.184 sec.
+	// This is computed as 68.184 / 86400 or 0.0008 with DUT1 (UT1 - UTC)
+
+	// Mean solar noon
+	double Jmean = Jnoon - (location.longitude() / 360.);
+
+	// Jmean is an approximation of the mean solar time at noon (Jnoon) as Julian date with the day fraction.
+	// lw (LONG) is the longitude west in decimal degrees (in US, longitude is negative, east in Europe is positive) of observer.
+
+	double M, C, lambda, equTime, radDelta;
+	solarTerms(Jmean, M, C, lambda, equTime, radDelta);
+	double Jtransit = 2451545.0 + Jmean + equTime;
 
 	// Hour Angle (w0)
 	// https://en.wikipedia.org/wiki/Hour_angle
@@ -181,79 +208,188 @@ void ASun::showSun(const ALocation& location, const ADateTime& procTime)
 	double radw0 = acos((sin(radHorizon) - sin(phi) * sin(radDelta)) / (cos(phi) * cos(radDelta)));
 	double w0 = degreeConvert(radw0);
 
-	if (m_verboseLevel & DebugComputation)
-	{
-		std::cout << "Hour angle w0 = " << w0 << " (radian = " << radw0 << ")" << std::endl;
-	}
-
 	// Calculate sunrise and sunset:
-	double Jrise = Jtransit - w0 / 360.;
-	double Jset = Jtransit + w0 / 360.;
+	info.Jnoon       = Jnoon;
+	info.Jmean       = Jmean;
+	info.meanAnomaly = M;
+	info.center      = C;
+	info.lambda      = lambda;
+	info.equTime     = equTime;
+	info.declination = degreeConvert(radDelta);
+	info.hourAngle   = w0;
+	info.Jrise       = Jtransit - w0 / 360.;
+	info.Jtransit    = Jtransit;
+	info.Jset        = Jtransit + w0 / 360.;
+}
+
 
-	double tzTime = dateTime.timeZoneAsFractionOfDay();
+/// @brief Quadratic through values at t = -0.5, 0 and 0.5: c[0] + c[1] t + c[2] t^2
+static void fitQuadratic(const double* f, double* c)
+{
+	c[0] = f[1];
+	c[1] = f[2] - f[0];
+	c[2] = 2. * (f[0] + f[2] - (2. * f[1]));
+}
 
-	double tmpJdTime;
+/// @brief Term of SunDayTerms at longitudes t (turns)
+static inline VDouble dayTerm(const double* c, const VDouble t)
+{
+	return vmadd(vmadd(vset(c[2]), t, vset(c[1])), t, vset(c[0]));
+}
+
+/// @brief Sunrise, solar noon and sunset of packed sites (Julian dates)
+static inline void sunSites(const SunDayTerms& terms, const VDouble t, const VDouble sinLat, const VDouble cosLat,
+	const VDouble sinHorizon, VDouble& rise, VDouble& transit, VDouble& set)
+{
+	// Jtransit = 2451545.0 + Jmean + equTime, Jmean = Jnoon - t
+	transit = (vset(2451545.0 + terms.Jnoon) - t) + dayTerm(terms.equTime, t);
 
-	char *tzStr = getenv("TZ");
-	if (tzStr != nullptr)
+	// cos(w0) = ( sin(horizon) - sin(phi) * sin(delta) ) / ( cos(phi) * cos(delta) ) - w0 as fraction of day
+	// NaN if the Sun does not cross the horizon (|cos(w0)| > 1) - as acos() of computeSun()
+	VDouble cosw0 = (sinHorizon - (sinLat * dayTerm(terms.sinDecl, t))) / (cosLat * dayTerm(terms.cosDecl, t));
+	VDouble w0 = vacos(cosw0) * vset(1. / (2. * M_PI));
+
+	rise = transit - w0;
+	set = transit + w0;
+}
+
+void ASun::prepareSites(const std::vector<ALocation>& locations, SunSites& sites)
+{
+	sites.count = locations.size();
+	sites.longitude.resize(sites.count);
+	sites.sinLatitude.resize(sites.count);
+	sites.cosLatitude.resize(sites.count);
+	sites.sinHorizon.resize(sites.count);
+
+	for (size_t i = 0; i < sites.count; i++)
 	{
-		std::cout << "\nTimezone = " << tzStr << std::endl;
+		const ALocation& location = locations[i];
+		double phi = radianConvert(location.latitude());
+
+		// As computeSun() - elevation correction added to -0.83 degrees
+		double elev = -1.15 * sqrt(location.elevation()) / 60.;
+
+		sites.longitude[i] = location.longitude() / 360.;
+		sites.sinLatitude[i] = sin(phi);
+		sites.cosLatitude[i] = cos(phi);
+		sites.sinHorizon[i] = sin(radianConvert(-0.83 + elev));
 	}
+}
 
-	if (ADateTime::m_verboseLevel & DebugComputation)
+void ASun::computeSunDay(const AInstant instant, SunDayTerms& terms)
+{
+	terms.Jnoon = floor(instant.julian()) - 2451544.5 + 0.0008;
+
+	// Terms at longitudes -180, 0 and 180 degrees (Jmean = Jnoon - t) - they change by a
+	// degree a day at most, so a quadratic in the longitude is within 1e-9 of computeSun()
+	double equTime[3];
+	double sinDecl[3];
+	double cosDecl[3];
+	for (int i = 0; i < 3; i++)
 	{
-		std::cout << "Sunrise: ";
+		double M, C, lambda, radDelta;
+		solarTerms(terms.Jnoon + 0.5 - (0.5 * i), M, C, lambda, equTime[i], radDelta);
+		sinDecl[i] = sin(radDelta);
+		cosDecl[i] = cos(radDelta);
 	}
 
-	dateTime.convertJulianToTime(Jrise, jTime);
-	std::cout << "Sunrise: " << dateTime.asString(jTime, "(%c UTC) ");
+	fitQuadratic(equTime, terms.equTime);
+	fitQuadratic(sinDecl, terms.sinDecl);
+	fitQuadratic(cosDecl, terms.cosDecl);
+}
 
-	tmpJdTime = Jrise + tzTime;
-	dateTime.convertJulianToTime(tmpJdTime, jTime);
-	time_t tmpTime = mktime(&jTime);
+void ASun::computeSunSites(const SunDayTerms& terms, const SunSites& sites, SunSiteTimes& times)
+{
+	const size_t count = sites.count;
+	times.count = count;
+	times.Jrise.resize(count);
+	times.Jtransit.resize(count);
+	times.Jset.resize(count);
 
-#ifdef USE_IOMANIP
-	std::cout << std::put_time(localtime(&tmpTime), "%F %T %Z %z") << std::endl;
-#else
-	char tmpStr[128];
-	strftime(tmpStr, 128, "%F %T %Z %z", localtime(&tmpTime));
-	std::cout << tmpStr << std::endl;
-#endif
+	VDouble rise, transit, set;
 
-	if (ADateTime::m_verboseLevel & DebugComputation)
+	size_t i = 0;
+	for (; i + VDoubleWidth <= count; i += VDoubleWidth)
 	{
-		std::cout << "Solar noon: ";
+		sunSites(terms, vload(&sites.longitude[i]), vload(&sites.sinLatitude[i]), vload(&sites.cosLatitude[i]),
+			vload(&sites.sinHorizon[i]), rise, transit, set);
+		vstore(&times.Jrise[i], rise);
+		vstore(&times.Jtransit[i], transit);
+		vstore(&times.Jset[i], set);
 	}
-	dateTime.convertJulianToTime(Jtransit, jTime);
-	std::cout << "Solar noon: " << dateTime.asString(jTime, "(%c UTC) ");
 
-	tmpJdTime = Jtransit + tzTime;
-	dateTime.convertJulianToTime(tmpJdTime, jTime);
-	tmpTime = mktime(&jTime);
-#ifdef USE_IOMANIP
-	std::cout << std::put_time(localtime(&tmpTime), "%F %T %Z %z") << std::endl;
-#else
-	strftime(tmpStr, 128, "%F %T %Z %z", localtime(&tmpTime));
-	std::cout << tmpStr << std::endl;
-#endif
+	// Remaining sites - padded to a full vector (latitude 0)
+	if (i < count)
+	{
+		double t[VDoubleWidth] = {0.};
+		double sinLat[VDoubleWidth] = {0.};
+		double cosLat[VDoubleWidth];
+		double sinHorizon[VDoubleWidth] = {0.};
+		double rt[VDoubleWidth];
+		double tt[VDoubleWidth];
+		double st[VDoubleWidth];
+		for (int k = 0; k < VDoubleWidth; k++)
+		{
+			cosLat[k] = 1.;
+		}
+		for (size_t k = i; k < count; k++)
+		{
+			t[k - i] = sites.longitude[k];
+			sinLat[k - i] = sites.sinLatitude[k];
+			cosLat[k - i] = sites.cosLatitude[k];
+			sinHorizon[k - i] = sites.sinHorizon[k];
+		}
+
+		sunSites(terms, vload(t), vload(sinLat), vload(cosLat), vload(sinHorizon), rise, transit, set);
+		vstore(rt, rise);
+		vstore(tt, transit);
+		vstore(st, set);
+
+		for (size_t k = i; k < count; k++)
+		{
+			times.Jrise[k] = rt[k - i];
+			times.Jtransit[k] = tt[k - i];
+			times.Jset[k] = st[k - i];
+		}
+	}
+}
+
+void ASun::computeSunSites(const AInstant instant, const SunSites& sites, SunSiteTimes& times)
+{
+	SunDayTerms terms;
+	computeSunDay(instant, terms);
+	computeSunSites(terms, sites, times);
+}
+
+
+// Display of sunrise/sunset
+void ASun::showSun(const ALocation& location, const ADateTime& procTime)
+{
+	SunInfo info;
 
-	if (ADateTime::m_verboseLevel & DebugComputation)
+	std::cout << "\n-----------------Sunrise-Sunset------------------" << std::endl;
+
+	computeSun(location, procTime, info);
+
+	if (m_verboseLevel & DebugComputation)
 	{
-		std::cout << "Sunset: ";
+		std::cout << "Jnoon = " << info.Jnoon << " Jmean = " << info.Jmean << std::endl;
+		std::cout << "Mean anomaly: " << info.meanAnomaly << " rad: " << radianConvert(info.meanAnomaly) << std::endl;
+		std::cout << "Equation of Center: " << info.center << " degrees." << std::endl;
+		std::cout << " Ecliptic longitude (lambda)  = " << info.lambda << " rad:" << radianConvert(info.lambda) << std::endl;
+		std::cout << "Jtransit = " << info.Jtransit << "  Equation of Time: " << info.equTime << std::endl;
+		std::cout << "Solar eclination (delta) = " << (info.declination * pi() / 180.) << " degrees: " << info.declination << std::endl;
+		std::cout << "Hour angle w0 = " << info.hourAngle << " (radian = " << radianConvert(info.hourAngle) << ")" << std::endl;
 	}
-	dateTime.convertJulianToTime(Jset, jTime);
-	std::cout << "Sunset: " << dateTime.asString(jTime, "(%c UTC) ");
 
-	tmpJdTime = Jset + tzTime;
-	dateTime.convertJulianToTime(tmpJdTime, jTime);
-	tmpTime = mktime(&jTime);
+	if (m_context.timeZoneName[0] != '\0')
+	{
+		std::cout << "\nTimezone = " << m_timeZone->name() << std::endl;
+	}
 
-#ifdef USE_IOMANIP
-	std::cout << std::put_time(localtime(&tmpTime), "%F %T %Z %z") << std::endl;
-#else
-	strftime(tmpStr, 128, "%F %T %Z %z", localtime(&tmpTime));
-	std::cout << tmpStr << std::endl;
-#endif
+	std::cout << "Sunrise: " << eventTimeString(procTime, info.Jrise) << std::endl;
+	std::cout << "Solar noon: " << eventTimeString(procTime, info.Jtransit) << std::endl;
+	std::cout << "Sunset: " << eventTimeString(procTime, info.Jset) << std::endl;
 
 	// NOTE: These are all Julian date and fractional time
 
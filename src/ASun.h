@@ -32,28 +32,139 @@
 #include <cstdio>
 #include <cstring>
 #include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
 
 #include "ADateTime.h"
 #include "ALocation.h"
 
 #include "AlgBase.h"
+#include "ATimeZone.h"
+
+/// @brief Sunrise/sunset results (and intermediate terms) computed by ASun::computeSun().
+/// NOTE: Angles are in degrees; the fraction of the Julian dates of the events is the time from
+/// midnight UTC (0.5 is noon), sunrise/sunset are NaN if the Sun does not rise or set
+using SunInfo = struct _sunInfo
+{
+	double Jnoon;        // J2000 day at noon (with 0.0008 TT offset)
+	double Jmean;        // J2000 mean solar noon at longitude
+	double meanAnomaly;  // solar mean anomaly (M)
+	double center;       // equation of the center (C)
+	double lambda;       // ecliptic longitude
+	double equTime;      // equation of time (fraction of day)
+	double declination;  // solar declination
+	double hourAngle;    // hour angle at sunrise/set (w0)
+	double Jrise;        // Julian date of sunrise
+	double Jtransit;     // Julian date of solar noon
+	double Jset;         // Julian date of sunset
+};
+
+/// @brief Terms of sunrise/sunset of a day shared by all sites (see ASun::computeSunDay()).
+/// Terms depend on the mean solar noon at the longitude (Jmean = Jnoon - longitude / 360), so
+/// each is kept as a quadratic in the longitude in turns (t = longitude / 360): c[0] + c[1] t + c[2] t^2
+using SunDayTerms = struct structSunDayTerms
+{
+	double Jnoon;          // J2000 day at noon (with 0.0008 TT offset)
+	double equTime[3];     // equation of time (fraction of day)
+	double sinDecl[3];     // sine of the solar declination
+	double cosDecl[3];     // cosine of the solar declination
+};
+
+/// @brief Sites of ASun::computeSunSites() - terms independent of the date (structure-of-arrays)
+using SunSites = struct structSunSites
+{
+	size_t count;
+	std::vector<double> longitude;    // turns (degrees / 360)
+	std::vector<double> sinLatitude;
+	std::vector<double> cosLatitude;
+	std::vector<double> sinHorizon;   // sine of the altitude of sunrise (-0.83 degrees and the elevation)
+};
+
+/// @brief Results of ASun::computeSunSites() by site (Julian dates - rise/set NaN if the Sun does not cross)
+using SunSiteTimes = struct structSunSiteTimes
+{
+	size_t count;
+	std::vector<double> Jrise;
+	std::vector<double> Jtransit;
+	std::vector<double> Jset;
+};
 
 class ASun : public AlgBase
 {
 public:
-	ASun();
+	/// @brief Constructor
+	/// @param[in] context - verbose level of the request
+	ASun(const AContext& context = DefaultContext);
 
     /// @brief Sets print statement verbose mode
     /// @param[in] level - 0=quiet(results only) non-zero(prints debug info)
     void setVerboseMode(const int level);
 
+    /// @brief Sets verbose level from context
+    /// @param[in] context - settings of the request
+    void setContext(const AContext& context);
+
+	/// @brief Computes Sunrise/Sunset times (no console output).
+	/// @param[in] location - LAT/LONG
+	/// @param[in] procTime - date
+	/// @param[out] info - sunrise, solar noon and sunset
+	void computeSun(const ALocation& location, const ADateTime& procTime, SunInfo& info) const;
+
+	/// @brief Computes Sunrise/Sunset times of the day of an instant (no console output).
+	/// @param[in] location - LAT/LONG
+	/// @param[in] instant - date
+	/// @param[out] info - sunrise, solar noon and sunset
+	void computeSun(const ALocation& location, const AInstant instant, SunInfo& info) const;
+
+	/// @brief Prepares sites for computeSunSites() (once for all days)
+	/// @param[in] locations - LAT/LONG and elevation of the sites
+	/// @param[out] sites
+	static void prepareSites(const std::vector<ALocation>& locations, SunSites& sites);
+
+	/// @brief Computes the terms of a day shared by all sites (mean anomaly to equation of time)
+	/// @param[in] instant - date
+	/// @param[out] terms
+	static void computeSunDay(const AInstant instant, SunDayTerms& terms);
+
+	/// @brief Computes Sunrise/Sunset times of many sites from the terms of the day - only the
+	/// hour angle of each site is computed (packed doubles, see ASimd.h). Within a millisecond of computeSun()
+	/// to latitude 55, 0.1 seconds where the Sun just rises or sets (polar circles).
+	/// @param[in] terms - of the day (computeSunDay())
+	/// @param[in] sites - (prepareSites())
+	/// @param[out] times - sunrise, solar noon and sunset by site
+	static void computeSunSites(const SunDayTerms& terms, const SunSites& sites, SunSiteTimes& times);
+
+	/// @brief Computes Sunrise/Sunset times of many sites for the day of an instant
+	/// @param[in] instant - date
+	/// @param[in] sites - (prepareSites())
+	/// @param[out] times - sunrise, solar noon and sunset by site
+	static void computeSunSites(const AInstant instant, const SunSites& sites, SunSiteTimes& times);
+
 	/// @brief Show Sunrise/Sunset times.
 	/// @param[in] procTime - date
 	/// @param[in] location - LAT/LONG
 	void showSun(const ALocation& location, const ADateTime& procTime);
 
-	static int m_verboseLevel;
+	int m_verboseLevel;
 
 private:
+	/// @brief Terms of the Sun at a mean solar noon (mean anomaly to declination)
+	/// @param[in] Jmean - J2000 mean solar noon at longitude
+	/// @param[out] M - solar mean anomaly (degrees)
+	/// @param[out] C - equation of the center (degrees)
+	/// @param[out] lambda - ecliptic longitude (degrees)
+	/// @param[out] equTime - equation of time (fraction of day)
+	/// @param[out] radDelta - solar declination (radians)
+	static void solarTerms(const double Jmean, double& M, double& C, double& lambda, double& equTime, double& radDelta);
+
+	/// @brief UTC and local time (in the time zone of the context) of a sunrise/sunset Julian date -
+	/// "(%c UTC) %F %T %Z %z" or "none" if the Sun does not rise or set (NaN)
+	std::string eventTimeString(const ADateTime& dateTime, const double jd) const;
+
+	AContext m_context;
+
+	/// @brief Time zone of the context (shared, read only)
+	std::shared_ptr<const ATimeZone> m_timeZone;
 
 };
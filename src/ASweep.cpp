@@ -0,0 +1,360 @@
+/// @file
+///
+/// @brief ASweep class implementation.
+///
+/// @copyright 2019-2020 M.Mashimo and licensors. All Right Reserved.
+///
+/// This file is part of cMoon application.
+///
+/// cMoon is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// any later version.
+///
+/// cMoon is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with cMoon.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <algorithm>
+#include <cmath>
+
+#include "ASweep.h"
+#include "AInstant.h"
+#include "AMoon.h"
+#include "ASimd.h"
+
+const std::vector<SweepHorizon> DefaultSweepHorizons
+{
+	{SweepBody::Moon, AltitudeType::MoonObject,  "Moon"},
+	{SweepBody::Sun,  AltitudeType::ActualSun,   "Sun"},
+	{SweepBody::Sun,  AltitudeType::NauticalSun, "Nautical twilight"}
+};
+
+const std::vector<SweepHorizon> AlmanacSweepHorizons
+{
+	{SweepBody::Sun,  AltitudeType::AtElevation,     "Sun center"},
+	{SweepBody::Moon, AltitudeType::MoonObject,      "Moon"},
+	{SweepBody::Sun,  AltitudeType::ActualSun,       "Sun"},
+	{SweepBody::Sun,  AltitudeType::CivilSun,        "Civil twilight"},
+	{SweepBody::Sun,  AltitudeType::NauticalSun,     "Nautical twilight"},
+	{SweepBody::Sun,  AltitudeType::AstronomicalSun, "Astronomical twilight"}
+};
+
+ASweep::ASweep(const ALocation& location, const std::vector<SweepHorizon>& horizons)
+	: m_location(location)
+	, m_sinLatitude(AlgBase::sinDegrees(location.latitude()))
+	, m_cosLatitude(AlgBase::cosDegrees(location.latitude()))
+	, m_horizons(horizons)
+	, m_aboveAtStart(horizons.size(), false)
+	, m_useBody{false, false}
+	, m_ephemeris(nullptr)
+	, m_lunarTheory(nullptr)
+	, m_samples(0)
+{
+	for (auto& horizon : m_horizons)
+	{
+		AObject obj(horizon.name, horizon.altType, false);
+		m_sinHorizon.push_back(obj.m_sinHorizontal);
+		m_useBody[static_cast<int>(horizon.body)] = true;
+	}
+}
+
+ASweep::~ASweep()
+{
+	// Nothing here
+}
+
+double ASweep::sinAltitude(const SweepBody body, const double mjd) const
+{
+	double y = 0;
+	double* moon = (body == SweepBody::Moon) ? &y : nullptr;
+	double* sun = (body == SweepBody::Sun) ? &y : nullptr;
+
+	if ((m_ephemeris != nullptr) && sinAltitudesFitted(&mjd, 1, moon, sun))
+	{
+		return y;
+	}
+
+	// One time - same as sinAltitudes() without the arrays
+	double t = (mjd - 51544.5) / 36525.;
+	double ra, dec;
+	double offset = 0.;
+	if (body == SweepBody::Sun)
+	{
+		AMoon::sunEquatorial(t, ra, dec);
+	}
+	else if (m_lunarTheory != nullptr)
+	{
+		double tt = t + (AInstant::fromModifiedJulian(mjd).deltaT() / (86400. * 36525.));
+		double distance;
+		m_lunarTheory->positions(&tt, 1, &ra, &dec, &distance);
+		offset = AlgBase::sinDegrees(ALunarTheory::riseSetAltitude(distance)) - AlgBase::sinDegrees(8. / 60.);
+	}
+	else
+	{
+		AMoon::moonEquatorial(t, ra, dec);
+	}
+
+	double tau = 15. * (AlgBase::localSiderialTime(mjd, m_location) - ra);   // 'hour angle of object
+	return (m_sinLatitude * AlgBase::sinDegrees(dec)) + (m_cosLatitude * AlgBase::cosDegrees(dec) * AlgBase::cosDegrees(tau)) - offset;
+}
+
+void ASweep::sinAltitudes(const double* mjd, const size_t count, double* moon, double* sun) const
+{
+	if (count == 0)
+	{
+		return;
+	}
+
+	if ((m_ephemeris != nullptr) && sinAltitudesFitted(mjd, count, moon, sun))
+	{
+		return;
+	}
+
+	// Padded to full vectors with the last time
+	size_t padded = ((count + VDoubleWidth - 1) / VDoubleWidth) * VDoubleWidth;
+	std::vector<double> t(padded);
+	std::vector<double> lst(padded);
+	std::vector<double> ra(2 * padded);
+	std::vector<double> dec(2 * padded);
+	std::vector<double> out(padded);
+
+	for (size_t i = 0; i < padded; i++)
+	{
+		double m = mjd[std::min(i, count - 1)];
+		t[i] = (m - 51544.5) / 36525.;
+		lst[i] = AlgBase::localSiderialTime(m, m_location);
+	}
+
+	// Moon from the lunar theory (TT - deltaT is taken once for the times)
+	std::vector<double> distance;
+	bool theory = (m_lunarTheory != nullptr) && (moon != nullptr);
+	if (theory)
+	{
+		std::vector<double> tt(padded);
+		double dt = AInstant::fromModifiedJulian(mjd[0]).deltaT() / (86400. * 36525.);
+		for (size_t i = 0; i < padded; i++)
+		{
+			tt[i] = t[i] + dt;
+		}
+		distance.resize(padded);
+		m_lunarTheory->positions(tt.data(), padded, &ra[0], &dec[0], distance.data());
+	}
+
+	// Moon and Sun share the fundamental arguments
+	if (!theory || (sun != nullptr))
+	{
+		AMoon::moonSunEquatorial(t.data(), padded,
+			((moon != nullptr) && !theory) ? &ra[0] : nullptr, &dec[0],
+			(sun != nullptr) ? &ra[padded] : nullptr, &dec[padded]);
+	}
+
+	const VDouble degrees = vset(M_PI / 180.);
+
+	double* y[NumberOfSweepBodies]{moon, sun};
+	for (int b = 0; b < NumberOfSweepBodies; b++)
+	{
+		if (y[b] == nullptr)
+		{
+			continue;
+		}
+
+		for (size_t i = 0; i < padded; i += VDoubleWidth)
+		{
+			// Same as AlgBase::localAltitude() - latitude terms computed once
+			VDouble tau = vset(15.) * (vload(&lst[i]) - vload(&ra[(b * padded) + i]));   // 'hour angle of object
+
+			VDouble sinDec, cosDec, sinTau, cosTau;
+			vsincos(vload(&dec[(b * padded) + i]) * degrees, sinDec, cosDec);
+			vsincos(tau * degrees, sinTau, cosTau);
+
+			vstore(&out[i], (vset(m_sinLatitude) * sinDec) + (vset(m_cosLatitude) * cosDec * cosTau));
+		}
+
+		if (theory && (b == static_cast<int>(SweepBody::Moon)))
+		{
+			// Rise/set altitude of the distance (parallax and semi-diameter) instead of the average 8'
+			const double sinAverage = AlgBase::sinDegrees(8. / 60.);
+			for (size_t i = 0; i < count; i++)
+			{
+				out[i] -= AlgBase::sinDegrees(ALunarTheory::riseSetAltitude(distance[i])) - sinAverage;
+			}
+		}
+
+		std::copy(out.begin(), out.begin() + count, y[b]);
+	}
+}
+
+bool ASweep::sinAltitudesFitted(const double* mjd, const size_t count, double* moon, double* sun) const
+{
+	const ChebyshevBody bodies[NumberOfSweepBodies]{ChebyshevBody::Moon, ChebyshevBody::Sun};
+	double* y[NumberOfSweepBodies]{moon, sun};
+
+	for (size_t i = 0; i < count; i++)
+	{
+		for (int b = 0; b < NumberOfSweepBodies; b++)
+		{
+			if ((y[b] != nullptr) && !m_ephemeris->covers(bodies[b], mjd[i] - 51544.5))
+			{
+				return false;
+			}
+		}
+	}
+
+	for (size_t i = 0; i < count; i++)
+	{
+		// cos(dec) cos(lst - ra) = x cos(lst) + y sin(lst) - no trigonometry of the body
+		double lst = AlgBase::localSiderialTime(mjd[i], m_location) * (M_PI / 12.);
+		double cosLst = cos(lst);
+		double sinLst = sin(lst);
+
+		for (int b = 0; b < NumberOfSweepBodies; b++)
+		{
+			double direction[3];
+			if ((y[b] != nullptr) && m_ephemeris->direction(bodies[b], mjd[i] - 51544.5, direction))
+			{
+				y[b][i] = (m_sinLatitude * direction[2]) + (m_cosLatitude * ((direction[0] * cosLst) + (direction[1] * sinLst)));
+			}
+		}
+	}
+
+	return true;
+}
+
+AEventFinder ASweep::finder(const SweepBody body) const
+{
+	double decRate = (body == SweepBody::Moon) ? MoonMaxDecRate : SunMaxDecRate;
+	return AEventFinder([this, body](const double mjd) { return sinAltitude(body, mjd); },
+		AEventFinder::maxRate(m_location.latitude(), SiderealRate, decRate));
+}
+
+int ASweep::sweep(const double mjdStart, const int days, const SweepCallback& callback)
+{
+	std::vector<SweepEvent> events;
+
+	m_samples = 0;
+
+	for (int b = 0; b < NumberOfSweepBodies; b++)
+	{
+		if (!m_useBody[b])
+		{
+			continue;
+		}
+
+		// Horizons of the body - found together
+		SweepBody body = static_cast<SweepBody>(b);
+		std::vector<double> sinHorizons;
+		std::vector<int> index;
+		for (size_t i = 0; i < m_horizons.size(); i++)
+		{
+			if (m_horizons[i].body == body)
+			{
+				sinHorizons.push_back(m_sinHorizon[i]);
+				index.push_back(static_cast<int>(i));
+			}
+		}
+
+		AEventFinder bodyFinder = finder(body);
+		bodyFinder.find(mjdStart, mjdStart + days, sinHorizons, false, [this, &events, &index, body](const AltitudeEvent& event)
+		{
+			int horizon = index[event.horizon];
+			events.push_back(SweepEvent{horizon, body, m_horizons[horizon].altType, event.type == AltitudeEventType::Rise, event.mjd});
+		});
+		m_samples += bodyFinder.evaluations();
+
+		for (size_t k = 0; k < index.size(); k++)
+		{
+			m_aboveAtStart[index[k]] = (bodyFinder.sinAltitudeAtStart() - sinHorizons[k]) > 0;
+		}
+	}
+
+	// Events of both bodies in time order
+	std::stable_sort(events.begin(), events.end(),
+		[](const SweepEvent& a, const SweepEvent& b) { return a.mjd < b.mjd; });
+
+	for (auto& event : events)
+	{
+		callback(event);
+	}
+
+	return static_cast<int>(events.size());
+}
+
+int ASweep::riseSetDays(const double mjdStart, const int days, std::vector<RiseSetInfo>& info)
+{
+	std::vector<double> dayStarts(days + 1);
+	for (int d = 0; d <= days; d++)
+	{
+		dayStarts[d] = mjdStart + d;
+	}
+	return riseSetDays(dayStarts, info);
+}
+
+int ASweep::riseSetDays(const std::vector<double>& dayStarts, std::vector<RiseSetInfo>& info)
+{
+	const int days = static_cast<int>(dayStarts.size()) - 1;
+	if (days < 1)
+	{
+		info.clear();
+		return 0;
+	}
+
+	// Whole days of sweep covering the local days - events after the last are left out
+	std::vector<SweepEvent> events;
+	sweep(dayStarts[0], static_cast<int>(ceil(dayStarts[days] - dayStarts[0])), events);
+
+	const size_t horizons = m_horizons.size();
+	std::vector<bool> above(m_aboveAtStart);
+	info.resize(days * horizons);
+
+	int count = 0;
+	size_t e = 0;
+	for (int d = 0; d < days; d++)
+	{
+		RiseSetInfo* day = &info[d * horizons];
+		for (size_t h = 0; h < horizons; h++)
+		{
+			day[h] = RiseSetInfo{0., 0., false, false, above[h]};
+		}
+
+		for (; (e < events.size()) && (events[e].mjd < dayStarts[d + 1]); e++)
+		{
+			const SweepEvent& event = events[e];
+			RiseSetInfo& riseSet = day[event.horizon];
+			double hour = (event.mjd - dayStarts[d]) * 24.;
+			if (event.rise && !riseSet.rise)
+			{
+				riseSet.utRise = hour;
+				riseSet.rise = true;
+			}
+			else if (!event.rise && !riseSet.sett)
+			{
+				riseSet.utSet = hour;
+				riseSet.sett = true;
+			}
+			above[event.horizon] = event.rise;
+			count++;
+		}
+	}
+
+	return count;
+}
+
+int ASweep::culminations(const SweepBody body, const double mjdStart, const int days, std::vector<AltitudeEvent>& events)
+{
+	AEventFinder bodyFinder = finder(body);
+	int count = bodyFinder.find(mjdStart, mjdStart + days, std::vector<double>(), true,
+		[&events](const AltitudeEvent& event) { events.push_back(event); });
+	m_samples = bodyFinder.evaluations();
+
+	return count;
+}
+
+int ASweep::sweep(const double mjdStart, const int days, std::vector<SweepEvent>& events)
+{
+	return sweep(mjdStart, days, [&events](const SweepEvent& event) { events.push_back(event); });
+}
@@ -0,0 +1,182 @@
+/// @file
+///
+/// @brief ASweep class definitions.
+///
+/// ASweep finds rise/set events of the Moon and Sun (and twilights) over a
+/// range of days. Crossings of each body are found by AEventFinder - steps
+/// bounded by the rate of the altitude, refined by Brent's method - once for
+/// all horizons of the body.
+///
+/// @copyright 2019-2020 M.Mashimo and licensors. All Right Reserved.
+///
+/// This file is part of cMoon application.
+///
+/// cMoon is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// any later version.
+///
+/// cMoon is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with cMoon.  If not, see <https://www.gnu.org/licenses/>.
+///
+
+#pragma once
+
+#include <functional>
+#include <vector>
+
+#include "AChebyshev.h"
+#include "AEventFinder.h"
+#include "AlgBase.h"
+#include "ALocation.h"
+#include "ALunarTheory.h"
+#include "AObject.h"
+
+/// @brief Body sampled by the sweep
+enum class SweepBody : int
+{
+	Moon = 0,
+	Sun
+};
+
+/// @brief Number of bodies (SweepBody)
+constexpr int NumberOfSweepBodies{2};
+
+/// @brief Largest rate of the declination (radians per day) - Moon (with the change of its parallax) and Sun
+constexpr double MoonMaxDecRate{0.125};
+constexpr double SunMaxDecRate{0.0075};
+
+/// @brief Horizon to find rise/set crossings for - body and altitude
+using SweepHorizon = struct structSweepHorizon
+{
+	SweepBody    body;
+	AltitudeType altType;
+	const char*  name;
+};
+
+/// @brief Rise or set event found by the sweep
+using SweepEvent = struct structSweepEvent
+{
+	int          horizon;  // index of the horizon (of ASweep::horizons())
+	SweepBody    body;
+	AltitudeType altType;
+	bool         rise;     // true - rise (above the horizon after), false - set
+	double       mjd;      // modified Julian date (UTC) of the event
+};
+
+/// @brief Receives events in time order
+using SweepCallback = std::function<void(const SweepEvent&)>;
+
+/// @brief Horizons of AMoon::moonRise - Moon, Sun and Nautical twilight
+extern const std::vector<SweepHorizon> DefaultSweepHorizons;
+
+/// @brief Horizons of all AltitudeTypes (AltitudeType order) - Sun center, Moon, Sun and the three twilights
+extern const std::vector<SweepHorizon> AlmanacSweepHorizons;
+
+
+class ASweep
+{
+public:
+	/// @brief Constructor
+	/// @param[in] location - observer location
+	/// @param[in] horizons - horizons to find events for (bodies are sampled once for all horizons)
+	ASweep(const ALocation& location, const std::vector<SweepHorizon>& horizons = DefaultSweepHorizons);
+
+	~ASweep();
+
+	/// @brief Finds rise/set events from a start time for a number of days.
+	/// @param[in] mjdStart - modified Julian date (UTC) to start (e.g. local midnight - ADateTime::modifiedJuiianDate(true))
+	/// @param[in] days - number of days
+	/// @param[in] callback - called for each event (in time order)
+	/// @return number of events found
+	int sweep(const double mjdStart, const int days, const SweepCallback& callback);
+
+	/// @brief Finds rise/set events from a start time for a number of days.
+	/// @param[in] mjdStart - modified Julian date (UTC) to start
+	/// @param[in] days - number of days
+	/// @param[out] events - events are appended (in time order)
+	/// @return number of events found
+	int sweep(const double mjdStart, const int days, std::vector<SweepEvent>& events);
+
+	/// @brief First rise and first set of each horizon on each day
+	/// @param[in] mjdStart - modified Julian date (UTC) of the start of the first day (e.g. local midnight)
+	/// @param[in] days - number of days
+	/// @param[out] info - horizon h of day d at [(d * horizons().size()) + h] - hours from the start of the day,
+	/// above at the start of the day
+	/// @return number of events found
+	int riseSetDays(const double mjdStart, const int days, std::vector<RiseSetInfo>& info);
+
+	/// @brief First rise and first set of each horizon on days of any length (local days - e.g. ATimeZone::localMidnight())
+	/// @param[in] dayStarts - modified Julian dates (UTC) of the start of each day and the end of the last (days + 1)
+	/// @param[out] info - horizon h of day d at [(d * horizons().size()) + h] - hours from the start of the day,
+	/// above at the start of the day
+	/// @return number of events found
+	int riseSetDays(const std::vector<double>& dayStarts, std::vector<RiseSetInfo>& info);
+
+	/// @brief Finds transits (upper culminations) and lower transits of a body
+	/// @param[in] body - Moon or Sun
+	/// @param[in] mjdStart - modified Julian date (UTC) to start
+	/// @param[in] days - number of days
+	/// @param[out] events - events are appended (in time order)
+	/// @return number of events found
+	int culminations(const SweepBody body, const double mjdStart, const int days, std::vector<AltitudeEvent>& events);
+
+	/// @brief Sine of the altitude of a body
+	/// @param[in] body - Moon or Sun
+	/// @param[in] mjd - modified Julian date (UTC)
+	double sinAltitude(const SweepBody body, const double mjd) const;
+
+	/// @brief Sine of the altitudes of the Moon and the Sun for an array of times
+	/// @param[in] mjd - modified Julian dates (UTC)
+	/// @param[in] count - number of times
+	/// @param[out] moon - Moon altitudes (nullptr - not computed)
+	/// @param[out] sun - Sun altitudes (nullptr - not computed)
+	void sinAltitudes(const double* mjd, const size_t count, double* moon, double* sun) const;
+
+	/// @brief Samples positions from a Chebyshev ephemeris where it covers the times (nullptr - computed)
+	/// @param[in] ephemeris - not owned
+	void setEphemeris(const AChebyshev* ephemeris) { m_ephemeris = ephemeris; }
+
+	/// @brief Computes the Moon from a lunar theory (nullptr - low precision) - the ephemeris still has precedence.
+	/// Moon altitudes are offset so that the MoonObject horizon stands for the rise/set altitude of the Moon's distance.
+	/// @param[in] theory - not owned
+	void setLunarTheory(const ALunarTheory* theory) { m_lunarTheory = theory; }
+
+	/// @brief Horizons of this sweep
+	const std::vector<SweepHorizon>& horizons() const { return m_horizons; }
+
+	/// @brief True if the horizon's body was above it at the start of the last sweep
+	bool aboveAtStart(const int horizon) const { return m_aboveAtStart[horizon]; }
+
+	/// @brief Number of altitudes computed by the last sweep
+	long samples() const { return m_samples; }
+
+private:
+	/// @brief Finder of the events of a body - rate bound of the body at the location
+	AEventFinder finder(const SweepBody body) const;
+
+	/// @brief sinAltitudes() from the ephemeris - false if it does not cover all times
+	bool sinAltitudesFitted(const double* mjd, const size_t count, double* moon, double* sun) const;
+
+	ALocation m_location;
+
+	/// @brief Sine and cosine of the latitude
+	double m_sinLatitude;
+	double m_cosLatitude;
+
+	std::vector<SweepHorizon> m_horizons;
+	std::vector<double> m_sinHorizon;
+	std::vector<bool>   m_aboveAtStart;
+
+	bool m_useBody[NumberOfSweepBodies];
+
+	const AChebyshev* m_ephemeris;
+	const ALunarTheory* m_lunarTheory;
+
+	long m_samples;
+};
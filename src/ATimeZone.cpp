@@ -0,0 +1,558 @@
+/// @file
+///
+/// @brief ATimeZone class implementation.
+///
+/// @copyright 2019-2020 M.Mashimo and licensors. All Right Reserved.
+///
+/// This file is part of cMoon application.
+///
+/// cMoon is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// any later version.
+///
+/// cMoon is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with cMoon.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <mutex>
+
+#include "ATimeZone.h"
+#include "AlgBase.h"
+
+/// @brief Julian day number of 1970-01-01 (Unix epoch)
+static constexpr long JulianDayOfEpoch{2440588};
+
+/// @brief Julian date of 1970-01-01 00:00 UTC
+static constexpr double JulianDateOfEpoch{2440587.5};
+
+static constexpr int64_t SecondsPerDay{86400};
+
+/// @brief US daylight savings rule (since 2007) - used for fixed offsets with DST
+static const char* UsDaylightRule{",M3.2.0,M11.1.0"};
+
+/// @brief Zones loaded by find() - shared by all threads
+static std::mutex s_cacheLock;
+static std::map<std::string, std::shared_ptr<const ATimeZone>> s_cache;
+static std::string s_zoneInfoPath{DefaultZoneInfoPath};
+
+/// @brief Integer division rounded down
+static inline int64_t floorDivide(const int64_t value, const int64_t divisor)
+{
+	int64_t quotient = value / divisor;
+	return ((value % divisor) < 0) ? quotient - 1 : quotient;
+}
+
+/// @brief Big-endian integers of TZif files
+static inline int32_t readInt32(const unsigned char* p)
+{
+	return static_cast<int32_t>((static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16)
+		| (static_cast<uint32_t>(p[2]) << 8) | static_cast<uint32_t>(p[3]));
+}
+
+static inline int64_t readInt64(const unsigned char* p)
+{
+	return static_cast<int64_t>((static_cast<uint64_t>(static_cast<uint32_t>(readInt32(p))) << 32)
+		| static_cast<uint32_t>(readInt32(p + 4)));
+}
+
+/// @brief Days since epoch of January 1st of a year
+static inline int64_t epochDayOfYear(const int year)
+{
+	return AlgBase::convertDateToJulianDay(year, 1, 1) - JulianDayOfEpoch;
+}
+
+/// @brief Days since epoch of a rule date in a year
+static int64_t ruleDay(const TimeZoneRuleDate& date, const int year)
+{
+	switch (date.kind)
+	{
+	case 'J':
+	{
+		// Day 1-365 - February 29th is never counted
+		bool leap = ((year % 4) == 0) && (((year % 100) != 0) || ((year % 400) == 0));
+		return epochDayOfYear(year) + (date.day - 1) + ((leap && (date.day >= 60)) ? 1 : 0);
+	}
+
+	case 'D':
+		return epochDayOfYear(year) + date.day;
+
+	default:
+	{
+		// Day of week (date.day) of week 1-5 of the month - week 5 is the last one in the month
+		long first = AlgBase::convertDateToJulianDay(year, date.month, 1);
+		long next = (date.month == 12) ? AlgBase::convertDateToJulianDay(year + 1, 1, 1)
+			: AlgBase::convertDateToJulianDay(year, date.month + 1, 1);
+
+		long day = first + ((date.day - ((first + 1) % 7) + 7) % 7) + ((date.week - 1) * 7);
+		while (day >= next)
+		{
+			day -= 7;
+		}
+		return day - JulianDayOfEpoch;
+	}
+	}
+}
+
+/// @brief Parses a zone abbreviation: alphabetic or quoted <...>
+static bool parseAbbreviation(const char*& p, std::string& name)
+{
+	const char* start = p;
+	if (*p == '<')
+	{
+		start = ++p;
+		while ((*p != '\0') && (*p != '>'))
+		{
+			p++;
+		}
+		if (*p != '>')
+		{
+			return false;
+		}
+		name.assign(start, p - start);
+		p++;
+	}
+	else
+	{
+		while (isalpha(static_cast<unsigned char>(*p)))
+		{
+			p++;
+		}
+		name.assign(start, p - start);
+	}
+
+	return name.size() >= 3;
+}
+
+/// @brief Parses [+-]hh[:mm[:ss]] into seconds
+static bool parseSeconds(const char*& p, int32_t& seconds)
+{
+	int sign = 1;
+	if ((*p == '+') || (*p == '-'))
+	{
+		sign = (*p == '-') ? -1 : 1;
+		p++;
+	}
+
+	if (!isdigit(static_cast<unsigned char>(*p)))
+	{
+		return false;
+	}
+
+	int32_t value = 0;
+	int32_t unit = 3600;
+	while (unit > 0)
+	{
+		int32_t field = 0;
+		while (isdigit(static_cast<unsigned char>(*p)))
+		{
+			field = (field * 10) + (*p++ - '0');
+		}
+		value += field * unit;
+
+		if ((*p != ':') || (unit == 1))
+		{
+			break;
+		}
+		p++;
+		unit /= 60;
+	}
+
+	seconds = sign * value;
+	return true;
+}
+
+/// @brief Parses a rule date: Jn, n or Mm.w.d with optional /time
+static bool parseRuleDate(const char*& p, TimeZoneRuleDate& date)
+{
+	date = TimeZoneRuleDate{'D', 0, 0, 0, 7200};
+
+	if (*p == 'M')
+	{
+		date.kind = 'M';
+		p++;
+		date.month = static_cast<int>(strtol(p, const_cast<char**>(&p), 10));
+		if (*p++ != '.')
+		{
+			return false;
+		}
+		date.week = static_cast<int>(strtol(p, const_cast<char**>(&p), 10));
+		if (*p++ != '.')
+		{
+			return false;
+		}
+		date.day = static_cast<int>(strtol(p, const_cast<char**>(&p), 10));
+
+		if ((date.month < 1) || (date.month > 12) || (date.week < 1) || (date.week > 5) || (date.day < 0) || (date.day > 6))
+		{
+			return false;
+		}
+	}
+	else
+	{
+		if (*p == 'J')
+		{
+			date.kind = 'J';
+			p++;
+		}
+		if (!isdigit(static_cast<unsigned char>(*p)))
+		{
+			return false;
+		}
+		date.day = static_cast<int>(strtol(p, const_cast<char**>(&p), 10));
+	}
+
+	if (*p == '/')
+	{
+		p++;
+		return parseSeconds(p, date.time);
+	}
+
+	return true;
+}
+
+
+ATimeZone::ATimeZone()
+	: m_initialType(0)
+	, m_rule{}
+	, m_hasRule(false)
+{
+	// Nothing here
+}
+
+ATimeZone::~ATimeZone()
+{
+	// Nothing here
+}
+
+std::shared_ptr<const ATimeZone> ATimeZone::find(const std::string& name)
+{
+	std::lock_guard<std::mutex> lock(s_cacheLock);
+
+	auto itr = s_cache.find(name);
+	if (itr != s_cache.end())
+	{
+		return itr->second;
+	}
+
+	std::shared_ptr<ATimeZone> zone = std::make_shared<ATimeZone>();
+
+	// ":Area/City" is the same as "Area/City" (as in TZ) - no paths outside of the zoneinfo directory
+	std::string file = (!name.empty() && (name[0] == ':')) ? name.substr(1) : name;
+	bool found = !file.empty() && (file[0] != '/') && (file.find("..") == std::string::npos)
+		&& zone->load(s_zoneInfoPath + "/" + file);
+
+	if (!found)
+	{
+		found = zone->parseRule(name);
+	}
+
+	std::shared_ptr<const ATimeZone> result;
+	if (found)
+	{
+		zone->m_name = name;
+		result = zone;
+	}
+
+	s_cache[name] = result;
+	return result;
+}
+
+std::shared_ptr<const ATimeZone> ATimeZone::fromContext(const AContext& context)
+{
+	if (context.timeZoneName[0] != '\0')
+	{
+		std::shared_ptr<const ATimeZone> zone = find(std::string(context.timeZoneName, strnlen(context.timeZoneName, sizeof(context.timeZoneName))));
+		if (zone)
+		{
+			return zone;
+		}
+	}
+
+	// Fixed offset - abbreviations as in zoneinfo (e.g. "<-05>5<-04>,M3.2.0,M11.1.0")
+	auto abbreviation = [](const int minutes)
+	{
+		char text[16];
+		int value = abs(minutes);
+		if ((value % 60) == 0)
+		{
+			snprintf(text, sizeof(text), "<%c%02d>", (minutes < 0) ? '-' : '+', value / 60);
+		}
+		else
+		{
+			snprintf(text, sizeof(text), "<%c%02d%02d>", (minutes < 0) ? '-' : '+', value / 60, value % 60);
+		}
+		return std::string(text);
+	};
+
+	int minutes = static_cast<int>(lround(context.timeZone * 60.));
+	char offset[16];
+	// POSIX offsets are west of UTC - the sign is written apart (-0:30 has no hours to carry it)
+	snprintf(offset, sizeof(offset), "%s%d:%02d", (minutes > 0) ? "-" : "", abs(minutes) / 60, abs(minutes) % 60);
+
+	std::string rule = abbreviation(minutes) + offset;
+	if (context.useDST)
+	{
+		rule += abbreviation(minutes + 60) + UsDaylightRule;
+	}
+
+	std::shared_ptr<const ATimeZone> zone = find(rule);
+	return zone ? zone : find("UTC0");
+}
+
+void ATimeZone::setZoneInfoPath(const std::string& path)
+{
+	std::lock_guard<std::mutex> lock(s_cacheLock);
+	s_zoneInfoPath = path;
+}
+
+bool ATimeZone::load(const std::string& path)
+{
+	std::ifstream file(path, std::ios::binary);
+	if (!file)
+	{
+		return false;
+	}
+
+	std::vector<unsigned char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+	// Header: "TZif", version, 15 unused, isutcnt, isstdcnt, leapcnt, timecnt, typecnt, charcnt
+	constexpr size_t headerSize{44};
+	if ((data.size() < headerSize) || (memcmp(data.data(), "TZif", 4) != 0))
+	{
+		return false;
+	}
+
+	char version = static_cast<char>(data[4]);
+	size_t offset = 0;
+	size_t timeSize = 4;
+
+	for (int block = 0; ; block++)
+	{
+		if (data.size() < offset + headerSize)
+		{
+			return false;
+		}
+
+		const unsigned char* header = &data[offset + 20];
+		size_t isutcnt = static_cast<uint32_t>(readInt32(header));
+		size_t isstdcnt = static_cast<uint32_t>(readInt32(header + 4));
+		size_t leapcnt = static_cast<uint32_t>(readInt32(header + 8));
+		size_t timecnt = static_cast<uint32_t>(readInt32(header + 12));
+		size_t typecnt = static_cast<uint32_t>(readInt32(header + 16));
+		size_t charcnt = static_cast<uint32_t>(readInt32(header + 20));
+
+		size_t blockSize = (timecnt * timeSize) + timecnt + (typecnt * 6) + charcnt
+			+ (leapcnt * (timeSize + 4)) + isstdcnt + isutcnt;
+
+		offset += headerSize;
+		if ((typecnt == 0) || (data.size() < offset + blockSize))
+		{
+			return false;
+		}
+
+		// Version 1 data is skipped when 64-bit data follows
+		if ((block == 0) && (version >= '2'))
+		{
+			offset += blockSize;
+			timeSize = 8;
+			continue;
+		}
+
+		const unsigned char* p = &data[offset];
+		m_transitions.resize(timecnt);
+		for (size_t i = 0; i < timecnt; i++, p += timeSize)
+		{
+			m_transitions[i] = (timeSize == 8) ? readInt64(p) : readInt32(p);
+		}
+
+		m_transitionTypes.assign(p, p + timecnt);
+		p += timecnt;
+
+		const unsigned char* chars = p + (typecnt * 6);
+		m_types.resize(typecnt);
+		for (size_t i = 0; i < typecnt; i++, p += 6)
+		{
+			size_t index = std::min<size_t>(p[5], charcnt);
+			const char* start = reinterpret_cast<const char*>(chars + index);
+			m_types[i] = TimeZoneType{readInt32(p), p[4] != 0, std::string(start, strnlen(start, charcnt - index))};
+		}
+
+		for (auto type : m_transitionTypes)
+		{
+			if (type >= typecnt)
+			{
+				return false;
+			}
+		}
+
+		offset += blockSize;
+		break;
+	}
+
+	// Footer (version 2+): "\n" POSIX TZ rule "\n" - used after the last transition
+	m_hasRule = false;
+	if ((timeSize == 8) && (offset < data.size()) && (data[offset] == '\n'))
+	{
+		size_t end = offset + 1;
+		while ((end < data.size()) && (data[end] != '\n'))
+		{
+			end++;
+		}
+
+		// An empty footer - no rule (local time after the last transition is unspecified)
+		ATimeZone footer;
+		if (footer.parseRule(std::string(data.begin() + offset + 1, data.begin() + end)))
+		{
+			m_rule = footer.m_rule;
+			m_hasRule = true;
+		}
+	}
+
+	m_initialType = 0;
+	m_name = path;
+
+	return true;
+}
+
+bool ATimeZone::parseRule(const std::string& rule)
+{
+	TimeZoneRule parsed{};
+	const char* p = rule.c_str();
+
+	// std offset [dst [offset] [,start[/time],end[/time]]] - offsets are hours west of UTC
+	int32_t west = 0;
+	if (!parseAbbreviation(p, parsed.standard.abbreviation) || !parseSeconds(p, west))
+	{
+		return false;
+	}
+	parsed.standard.offset = -west;
+	parsed.standard.isDst = false;
+
+	if (*p != '\0')
+	{
+		if (!parseAbbreviation(p, parsed.daylight.abbreviation))
+		{
+			return false;
+		}
+
+		parsed.hasDst = true;
+		parsed.daylight.isDst = true;
+		parsed.daylight.offset = parsed.standard.offset + 3600;
+		if ((*p != ',') && (*p != '\0'))
+		{
+			if (!parseSeconds(p, west))
+			{
+				return false;
+			}
+			parsed.daylight.offset = -west;
+		}
+
+		const char* dates = (*p == '\0') ? UsDaylightRule : p;
+		if ((*dates++ != ',') || !parseRuleDate(dates, parsed.start) || (*dates++ != ',')
+			|| !parseRuleDate(dates, parsed.end) || (*dates != '\0'))
+		{
+			return false;
+		}
+	}
+	else if (*p != '\0')
+	{
+		return false;
+	}
+
+	m_rule = parsed;
+	m_hasRule = true;
+
+	// No transition table - standard type only
+	m_transitions.clear();
+	m_transitionTypes.clear();
+	m_types.assign(1, parsed.standard);
+	m_initialType = 0;
+	m_name = rule;
+
+	return true;
+}
+
+LocalTimeInfo ATimeZone::lookupRule(const int64_t utc) const
+{
+	const TimeZoneType& standard = m_rule.standard;
+	if (!m_rule.hasDst)
+	{
+		return LocalTimeInfo{standard.offset, false, standard.abbreviation.c_str()};
+	}
+
+	const TimeZoneType& daylight = m_rule.daylight;
+
+	// Year of the local (standard) time
+	int year, month, day;
+	AlgBase::convertJulianToDate(static_cast<double>(JulianDayOfEpoch + floorDivide(utc + standard.offset, SecondsPerDay)), year, month, day);
+
+	// Start is in standard time, end in daylight time
+	int64_t start = (ruleDay(m_rule.start, year) * SecondsPerDay) + m_rule.start.time - standard.offset;
+	int64_t end = (ruleDay(m_rule.end, year) * SecondsPerDay) + m_rule.end.time - daylight.offset;
+
+	bool isDst = (start < end) ? ((utc >= start) && (utc < end))   // northern hemisphere
+		: ((utc >= start) || (utc < end));                          // southern - daylight time over new year
+
+	const TimeZoneType& type = isDst ? daylight : standard;
+	return LocalTimeInfo{type.offset, type.isDst, type.abbreviation.c_str()};
+}
+
+LocalTimeInfo ATimeZone::lookup(const int64_t utc) const
+{
+	if (m_transitions.empty() || (utc >= m_transitions.back()))
+	{
+		if (m_hasRule)
+		{
+			return lookupRule(utc);
+		}
+	}
+
+	size_t typeIndex = m_initialType;
+	if (!m_transitions.empty() && (utc >= m_transitions.front()))
+	{
+		size_t index = static_cast<size_t>(std::upper_bound(m_transitions.begin(), m_transitions.end(), utc) - m_transitions.begin()) - 1;
+		typeIndex = m_transitionTypes[index];
+	}
+
+	const TimeZoneType& type = m_types[typeIndex];
+	return LocalTimeInfo{type.offset, type.isDst, type.abbreviation.c_str()};
+}
+
+LocalTimeInfo ATimeZone::lookupJulian(const double jd) const
+{
+	return lookup(static_cast<int64_t>(floor(((jd - JulianDateOfEpoch) * SecondsPerDay) + 0.5)));
+}
+
+AInstant ATimeZone::localMidnight(const int year, const int month, const int day) const
+{
+	// Offset at the UTC time of the same clock time first - then at that instant (across a transition)
+	AInstant local = AInstant::fromDate(year, month, day);
+	AInstant utc = local.plusSeconds(-lookupJulian(local.julian()).offset);
+	return local.plusSeconds(-lookupJulian(utc.julian()).offset);
+}
+
+AInstant ATimeZone::localMidnight(const AInstant instant) const
+{
+	int year, month, day;
+	instant.date(year, month, day);
+	return localMidnight(year, month, day);
+}
+
+double ATimeZone::clockHours(const double mjd) const
+{
+	double local = mjd + (static_cast<double>(lookupJulian(mjd + ModifiedJulianOffset).offset) / SecondsPerDay);
+	return (local - floor(local)) * 24.;
+}
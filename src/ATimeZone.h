@@ -0,0 +1,159 @@
+/// @file
+///
+/// @brief ATimeZone class definitions.
+///
+/// ATimeZone converts UTC to local time for a time zone of the system's
+/// zoneinfo database (TZif files, e.g. /usr/share/zoneinfo/America/New_York)
+/// or for a POSIX TZ rule (e.g. "EST5EDT,M3.2.0,M11.1.0"). Each zone is read
+/// once and cached for the process; lookups are a binary search of the
+/// transition table (POSIX footer rule after the last transition) and do not
+/// use the C library time functions or the TZ environment variable.
+///
+/// @copyright 2019-2020 M.Mashimo and licensors. All Right Reserved.
+///
+/// This file is part of cMoon application.
+///
+/// cMoon is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// any later version.
+///
+/// cMoon is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with cMoon.  If not, see <https://www.gnu.org/licenses/>.
+///
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "AContext.h"
+#include "AInstant.h"
+
+/// @brief Default directory of TZif files
+constexpr const char* DefaultZoneInfoPath{"/usr/share/zoneinfo"};
+
+/// @brief Local time type - offset from UTC and its abbreviation
+using TimeZoneType = struct structTimeZoneType
+{
+	int32_t     offset;         // seconds east of UTC (local = UTC + offset)
+	bool        isDst;          // daylight savings time
+	std::string abbreviation;   // e.g. "EST", "EDT"
+};
+
+/// @brief Date of a POSIX TZ rule transition: Jn, n or Mm.w.d
+using TimeZoneRuleDate = struct structTimeZoneRuleDate
+{
+	char    kind;     // 'J' - Julian day 1-365 (no Feb 29), 'D' - zero based day 0-365, 'M' - month/week/day
+	int     day;      // J/D - day; M - day of week (0 = Sunday)
+	int     week;     // M - week 1-5 (5 = last)
+	int     month;    // M - month 1-12
+	int32_t time;     // seconds after local midnight of the transition
+};
+
+/// @brief POSIX TZ rule (TZif footer or TZ string)
+using TimeZoneRule = struct structTimeZoneRule
+{
+	TimeZoneType     standard;
+	TimeZoneType     daylight;
+	bool             hasDst;
+	TimeZoneRuleDate start;    // start of daylight time (local standard time)
+	TimeZoneRuleDate end;      // end of daylight time (local daylight time)
+};
+
+/// @brief Result of a lookup
+using LocalTimeInfo = struct structLocalTimeInfo
+{
+	int32_t     offset;         // seconds east of UTC
+	bool        isDst;
+	const char* abbreviation;   // valid while the zone is referenced
+};
+
+class ATimeZone
+{
+public:
+	ATimeZone();
+
+	~ATimeZone();
+
+	/// @brief Finds a time zone by name - loaded once and cached for the process (thread-safe).
+	/// @param[in] name - zoneinfo name (e.g. "America/New_York", "UTC") or POSIX TZ rule (e.g. "EST5EDT,M3.2.0,M11.1.0")
+	/// @return time zone, nullptr if not found
+	static std::shared_ptr<const ATimeZone> find(const std::string& name);
+
+	/// @brief Time zone of a request: context.timeZoneName if set, otherwise a fixed offset
+	/// (context.timeZone) with US daylight savings rules if context.useDST.
+	/// @param[in] context - settings of the request
+	/// @return time zone (never nullptr - UTC if the name is not found)
+	static std::shared_ptr<const ATimeZone> fromContext(const AContext& context);
+
+	/// @brief Sets the directory of TZif files (before the first find())
+	static void setZoneInfoPath(const std::string& path);
+
+	/// @brief Reads a TZif file (version 1 to 4).
+	/// @param[in] path - TZif file
+	/// @return true if read
+	bool load(const std::string& path);
+
+	/// @brief Sets the zone from a POSIX TZ rule (no transition table).
+	/// @param[in] rule - e.g. "EST5EDT,M3.2.0,M11.1.0" or "<-03>3"
+	/// @return true if the rule is valid
+	bool parseRule(const std::string& rule);
+
+	/// @brief Local time type for a UTC time
+	/// @param[in] utc - seconds since 1970-01-01 00:00 UTC
+	LocalTimeInfo lookup(const int64_t utc) const;
+
+	/// @brief Local time type for a Julian date (UTC)
+	/// @param[in] jd - Julian date
+	LocalTimeInfo lookupJulian(const double jd) const;
+
+	/// @brief Start of a local day in the zone (offset of that day - 23 or 25 hours on DST changes)
+	/// @param[in] year
+	/// @param[in] month - 1 to 12
+	/// @param[in] day - 1 to 31
+	/// @return UTC instant of local midnight
+	AInstant localMidnight(const int year, const int month, const int day) const;
+
+	/// @brief Start of the day of the date of an instant in the zone (as AInstant::localMidnight() with the
+	/// offset of that day)
+	/// @param[in] instant - UTC (its date is the day)
+	/// @return UTC instant of local midnight
+	AInstant localMidnight(const AInstant instant) const;
+
+	/// @brief Wall-clock time of day in the zone (offset at that instant)
+	/// @param[in] mjd - modified Julian date (UTC)
+	/// @return hours 0 to 24
+	double clockHours(const double mjd) const;
+
+	/// @brief Name of the zone (or the rule)
+	const std::string& name() const { return m_name; }
+
+	/// @brief Number of transitions in the table
+	size_t transitions() const { return m_transitions.size(); }
+
+private:
+	/// @brief Local time type from the footer rule
+	LocalTimeInfo lookupRule(const int64_t utc) const;
+
+	std::string m_name;
+
+	/// @brief Transition times (UTC seconds, ascending) and the type starting at each
+	std::vector<int64_t> m_transitions;
+	std::vector<uint8_t> m_transitionTypes;
+
+	std::vector<TimeZoneType> m_types;
+
+	/// @brief Type before the first transition
+	size_t m_initialType;
+
+	TimeZoneRule m_rule;
+	bool         m_hasRule;
+};
@@ -0,0 +1,419 @@
+/// @file
+///
+/// @brief AVsop87 class implementation.
+///
+/// @copyright 2019-2020 M.Mashimo and licensors. All Right Reserved.
+///
+/// This file is part of cMoon application.
+///
+/// cMoon is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// any later version.
+///
+/// cMoon is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with cMoon.  If not, see <https://www.gnu.org/licenses/>.
+///
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+
+#include "AInstant.h"
+#include "AVsop87.h"
+
+/// @brief Julian date of J2000.0
+static constexpr double J2000Epoch{2451545.};
+
+/// @brief Days of a Julian millennium (time argument of the theory)
+static constexpr double DaysPerMillennium{365250.};
+
+/// @brief Light time of one AU (days)
+static constexpr double LightDaysPerAu{499.004784 / 86400.};
+
+/// @brief Obliquity of the ecliptic at J2000.0 (IAU 1976 - 84381.448")
+static constexpr double J2000Obliquity{84381.448 / 3600. * M_PI / 180.};
+
+/// @brief Arc second (radians)
+static constexpr double ArcSecond{M_PI / (180. * 3600.)};
+
+/// @brief Timestamps of a batch block - frequencies are computed once per block
+static constexpr size_t BlockSize{64};
+
+/// @brief Largest phase error of the evenly spaced timestamps of a block (radians) - otherwise
+/// frequencies are computed for each timestamp
+static constexpr double MaxRotationError{1e-4};
+
+/// @brief Series of a planet, coordinate and power (index of m_first)
+static constexpr size_t seriesIndex(const int planet, const int coordinate, const int power)
+{
+	return (((planet * NumberOfVsopCoordinates) + coordinate) * (VsopMaxPower + 1)) + power;
+}
+
+/// @brief Rotation from the ecliptic and equinox of a date to J2000.0 (Meeus 21.5)
+using Precession = struct structPrecession
+{
+	double cosPi;    // longitude of the axis of rotation (ecliptic of date)
+	double sinPi;
+	double cosEta;   // angle between the ecliptics
+	double sinEta;
+	double cosNode;  // longitude of the axis of rotation (J2000 ecliptic) - p + Pi
+	double sinNode;
+};
+
+static Precession precession(const double tau)
+{
+	// From the date (T) to J2000 (t = -T) - Julian centuries
+	const double T = tau * 10.;
+	const double t = -T;
+	double eta = (((47.0029 - (0.06603 * T) + (0.000598 * T * T)) * t) + ((-0.03302 + (0.000598 * T)) * t * t)
+		+ (0.00006 * t * t * t)) * ArcSecond;
+	double pi = (174.876384 * M_PI / 180.) + (((3289.4789 * T) + (0.60622 * T * T) - ((869.8089 + (0.50491 * T)) * t)
+		+ (0.03536 * t * t)) * ArcSecond);
+	double p = (((5029.0966 + (2.22226 * T) - (0.000042 * T * T)) * t) + ((1.11113 - (0.000042 * T)) * t * t)
+		- (0.000006 * t * t * t)) * ArcSecond;
+
+	return Precession{cos(pi), sin(pi), cos(eta), sin(eta), cos(p + pi), sin(p + pi)};
+}
+
+/// @brief Rectangular coordinates (ecliptic J2000) of L, B, R of date
+static void rectangular(const Precession& rotation, const double l, const double b, const double r, double xyz[3])
+{
+	double x = r * cos(b) * cos(l);
+	double y = r * cos(b) * sin(l);
+	double z = r * sin(b);
+
+	// Longitudes from the axis of rotation, rotated between the ecliptics, then from the equinox of J2000
+	double x1 = (x * rotation.cosPi) + (y * rotation.sinPi);
+	double y1 = (y * rotation.cosPi) - (x * rotation.sinPi);
+	double y2 = (y1 * rotation.cosEta) + (z * rotation.sinEta);
+	xyz[2] = (z * rotation.cosEta) - (y1 * rotation.sinEta);
+	xyz[0] = (x1 * rotation.cosNode) - (y2 * rotation.sinNode);
+	xyz[1] = (x1 * rotation.sinNode) + (y2 * rotation.cosNode);
+}
+
+/// @brief Astrometric position of a planet from its L, B, R (and rates) and the Earth's coordinates
+/// @param[in] lbr - L, B, R of the planet (date)
+/// @param[in] rates - L, B, R per millennium
+/// @param[in] earth - heliocentric coordinates of the Earth (ecliptic J2000)
+/// @param[out] xyz - heliocentric coordinates of the planet when the light left it (ecliptic J2000)
+static void astrometric(const Precession& rotation, const double lbr[3], const double rates[3], const double earth[3],
+	double xyz[3], double& ra, double& dec, double& dist)
+{
+	// Planet when the light left it - first order in the light time
+	rectangular(rotation, lbr[0], lbr[1], lbr[2], xyz);
+	double dx = xyz[0] - earth[0];
+	double dy = xyz[1] - earth[1];
+	double dz = xyz[2] - earth[2];
+	double dtau = sqrt((dx * dx) + (dy * dy) + (dz * dz)) * LightDaysPerAu / DaysPerMillennium;
+	rectangular(rotation, lbr[0] - (rates[0] * dtau), lbr[1] - (rates[1] * dtau), lbr[2] - (rates[2] * dtau), xyz);
+
+	// Geocentric - rotated from ecliptic to equatorial coords
+	double xg = xyz[0] - earth[0];
+	double yg = xyz[1] - earth[1];
+	double zg = xyz[2] - earth[2];
+	double yeq = (yg * cos(J2000Obliquity)) - (zg * sin(J2000Obliquity));
+	double zeq = (yg * sin(J2000Obliquity)) + (zg * cos(J2000Obliquity));
+
+	double rxy = (xg * xg) + (yeq * yeq);
+	double a = atan2(yeq, xg) * (12. / M_PI);
+	ra = (a < 0.) ? (a + 24.) : a;
+	dec = atan2(zeq, sqrt(rxy)) * (180. / M_PI);
+	dist = sqrt(rxy + (zeq * zeq));
+}
+
+AVsop87::AVsop87(const double truncation)
+	: m_truncation(0.)
+{
+	setTruncation(truncation);
+}
+
+void AVsop87::setTruncation(const double truncation)
+{
+	m_truncation = std::max(truncation, 0.);
+	m_terms.clear();
+	m_frequencies.clear();
+
+	// Terms of each series until the amplitude is below the truncation - frequencies are numbered as they come
+	std::map<double, int> frequencyIndex;
+	std::array<std::vector<int>, NumberOfVsopPlanets> used;
+	for (int planet = 0; planet < NumberOfVsopPlanets; planet++)
+	{
+		for (int coordinate = 0; coordinate < NumberOfVsopCoordinates; coordinate++)
+		{
+			for (int power = 0; power <= VsopMaxPower; power++)
+			{
+				m_first[seriesIndex(planet, coordinate, power)] = m_terms.size();
+
+				const VsopSeries& series = VsopPlanets[planet].series[coordinate][power];
+				for (int k = 0; k < series.count; k++)
+				{
+					const VsopTerm& term = series.terms[k];
+					double a = term.a * 1e-8;
+					if (a < m_truncation)
+					{
+						break;
+					}
+
+					auto found = frequencyIndex.find(term.c);
+					if (found == frequencyIndex.end())
+					{
+						found = frequencyIndex.emplace(term.c, static_cast<int>(m_frequencies.size())).first;
+						m_frequencies.push_back(term.c);
+					}
+					m_terms.push_back(Term{a * cos(term.b), a * sin(term.b), term.c, found->second});
+					used[planet].push_back(found->second);
+				}
+			}
+		}
+	}
+	m_first[seriesIndex(NumberOfVsopPlanets, 0, 0)] = m_terms.size();
+
+	// A position needs the planet and the Earth
+	for (int planet = 0; planet < NumberOfVsopPlanets; planet++)
+	{
+		std::vector<int>& frequencies = m_planetFrequencies[planet];
+		frequencies = used[planet];
+		frequencies.insert(frequencies.end(), used[PlanetType::Earth].begin(), used[PlanetType::Earth].end());
+		std::sort(frequencies.begin(), frequencies.end());
+		frequencies.erase(std::unique(frequencies.begin(), frequencies.end()), frequencies.end());
+	}
+}
+
+size_t AVsop87::terms(const int planet) const
+{
+	if (!hasPlanet(planet))
+	{
+		return 0;
+	}
+	return m_first[seriesIndex(planet + 1, 0, 0)] - m_first[seriesIndex(planet, 0, 0)];
+}
+
+bool AVsop87::heliocentric(const int planet, const double jde, double& l, double& b, double& r) const
+{
+	if (!hasPlanet(planet))
+	{
+		return false;
+	}
+
+	const double tau = (jde - J2000Epoch) / DaysPerMillennium;
+	double coordinates[NumberOfVsopCoordinates];
+	for (int coordinate = 0; coordinate < NumberOfVsopCoordinates; coordinate++)
+	{
+		double value = 0.;
+		for (int power = VsopMaxPower; power >= 0; power--)
+		{
+			size_t index = seriesIndex(planet, coordinate, power);
+			double sum = 0.;
+			for (size_t k = m_first[index]; k < m_first[index + 1]; k++)
+			{
+				const Term& term = m_terms[k];
+				double phase = term.c * tau;
+				sum += (term.p * cos(phase)) - (term.q * sin(phase));
+			}
+			value = (value * tau) + sum;
+		}
+		coordinates[coordinate] = value;
+	}
+
+	l = fmod(coordinates[VsopLongitude], 2. * M_PI);
+	l += (l < 0.) ? (2. * M_PI) : 0.;
+	b = coordinates[VsopLatitude];
+	r = coordinates[VsopRadius];
+	return true;
+}
+
+void AVsop87::phases(const std::vector<int>& frequencies, const double tau, double* cosines, double* sines) const
+{
+	for (int f : frequencies)
+	{
+		double phase = m_frequencies[f] * tau;
+		cosines[f] = cos(phase);
+		sines[f] = sin(phase);
+	}
+}
+
+void AVsop87::evaluate(const int planet, const double tau, const double* cosines, const double* sines,
+	double coordinates[NumberOfVsopCoordinates], double rates[NumberOfVsopCoordinates]) const
+{
+	const Term* terms = m_terms.data();
+	for (int coordinate = 0; coordinate < NumberOfVsopCoordinates; coordinate++)
+	{
+		// Horner's scheme of the powers of tau - and of the derivative
+		double value = 0.;
+		double rate = 0.;
+		for (int power = VsopMaxPower; power >= 0; power--)
+		{
+			size_t index = seriesIndex(planet, coordinate, power);
+			double sum = 0.;
+			double derivative = 0.;
+			for (size_t k = m_first[index]; k < m_first[index + 1]; k++)
+			{
+				const Term& term = terms[k];
+				double c = cosines[term.frequency];
+				double s = sines[term.frequency];
+				sum += (term.p * c) - (term.q * s);
+				derivative -= term.c * ((term.p * s) + (term.q * c));
+			}
+			rate = (rate * tau) + value + derivative;
+			value = (value * tau) + sum;
+		}
+		coordinates[coordinate] = value;
+		rates[coordinate] = rate;
+	}
+}
+
+std::vector<int> AVsop87::maskFrequencies(const unsigned mask) const
+{
+	std::vector<int> frequencies;
+	for (int planet = 0; planet < NumberOfVsopPlanets; planet++)
+	{
+		if ((mask & planetMask(planet)) != 0)
+		{
+			const std::vector<int>& used = m_planetFrequencies[planet];
+			frequencies.insert(frequencies.end(), used.begin(), used.end());
+		}
+	}
+	std::sort(frequencies.begin(), frequencies.end());
+	frequencies.erase(std::unique(frequencies.begin(), frequencies.end()), frequencies.end());
+	return frequencies;
+}
+
+bool AVsop87::planetPosition(const int planet, const double j2000, PlanetPosition& position) const
+{
+	if (!hasPlanet(planet) || (planet == PlanetType::Earth))
+	{
+		return false;
+	}
+
+	const double tau = (AInstant::fromJulian(j2000 + J2000Epoch).julianTT() - J2000Epoch) / DaysPerMillennium;
+	std::vector<double> cosines(m_frequencies.size());
+	std::vector<double> sines(m_frequencies.size());
+	phases(m_planetFrequencies[planet], tau, cosines.data(), sines.data());
+
+	double lbr[NumberOfVsopCoordinates];
+	double rates[NumberOfVsopCoordinates];
+	double earth[3];
+	const Precession rotation = precession(tau);
+	evaluate(PlanetType::Earth, tau, cosines.data(), sines.data(), lbr, rates);
+	rectangular(rotation, lbr[0], lbr[1], lbr[2], earth);
+
+	double xyz[3];
+	evaluate(planet, tau, cosines.data(), sines.data(), lbr, rates);
+	astrometric(rotation, lbr, rates, earth, xyz, position.ra, position.dec, position.dist);
+	position.x = xyz[0];
+	position.y = xyz[1];
+	position.z = xyz[2];
+	return true;
+}
+
+void AVsop87::computeBatch(const double* j2000, const size_t count, const unsigned mask, PlanetBatch& batch) const
+{
+	batch.count = count;
+	batch.mask = mask & VsopPlanetsMask;
+	for (int index = 0; index < NumberOfPlanets; index++)
+	{
+		if ((batch.mask & planetMask(index)) == 0)
+		{
+			batch.ra[index].clear();
+			batch.dec[index].clear();
+			batch.dist[index].clear();
+			continue;
+		}
+		batch.ra[index].resize(count);
+		batch.dec[index].resize(count);
+		batch.dist[index].resize(count);
+	}
+	if ((count == 0) || (batch.mask == 0))
+	{
+		return;
+	}
+
+	const std::vector<int> frequencies = maskFrequencies(batch.mask);
+	double maxFrequency = 0.;
+	for (int f : frequencies)
+	{
+		maxFrequency = std::max(maxFrequency, m_frequencies[f]);
+	}
+
+	// Phases at the first timestamp of a block and of the step between timestamps (rotation),
+	// then at the timestamp being evaluated
+	std::vector<double> blockCos(m_frequencies.size());
+	std::vector<double> blockSin(m_frequencies.size());
+	std::vector<double> stepCos(m_frequencies.size());
+	std::vector<double> stepSin(m_frequencies.size());
+	std::vector<double> cosines(m_frequencies.size());
+	std::vector<double> sines(m_frequencies.size());
+
+	double tau[BlockSize];
+	for (size_t first = 0; first < count; first += BlockSize)
+	{
+		size_t n = std::min(BlockSize, count - first);
+		for (size_t i = 0; i < n; i++)
+		{
+			tau[i] = (AInstant::fromJulian(j2000[first + i] + J2000Epoch).julianTT() - J2000Epoch) / DaysPerMillennium;
+		}
+
+		// Evenly spaced (UT) - TT - UT changes a little within a block, it is corrected to the first order
+		double step = (n > 1) ? ((tau[n - 1] - tau[0]) / (n - 1)) : 0.;
+		double maxResidual = 0.;
+		for (size_t i = 0; i < n; i++)
+		{
+			maxResidual = std::max(maxResidual, fabs(tau[i] - (tau[0] + (i * step))));
+		}
+		bool rotate = (n > 2) && ((maxResidual * maxFrequency) < MaxRotationError);
+		if (rotate)
+		{
+			phases(frequencies, tau[0], blockCos.data(), blockSin.data());
+			phases(frequencies, step, stepCos.data(), stepSin.data());
+		}
+
+		for (size_t i = 0; i < n; i++)
+		{
+			if (rotate)
+			{
+				double residual = tau[i] - (tau[0] + (i * step));
+				for (int f : frequencies)
+				{
+					if (i > 0)
+					{
+						double c = (blockCos[f] * stepCos[f]) - (blockSin[f] * stepSin[f]);
+						blockSin[f] = (blockSin[f] * stepCos[f]) + (blockCos[f] * stepSin[f]);
+						blockCos[f] = c;
+					}
+					double e = m_frequencies[f] * residual;
+					cosines[f] = blockCos[f] - (e * blockSin[f]);
+					sines[f] = blockSin[f] + (e * blockCos[f]);
+				}
+			}
+			else
+			{
+				phases(frequencies, tau[i], cosines.data(), sines.data());
+			}
+
+			// The Earth then the planets of the same phases
+			double lbr[NumberOfVsopCoordinates];
+			double rates[NumberOfVsopCoordinates];
+			double earth[3];
+			double xyz[3];
+			const Precession rotation = precession(tau[i]);
+			evaluate(PlanetType::Earth, tau[i], cosines.data(), sines.data(), lbr, rates);
+			rectangular(rotation, lbr[0], lbr[1], lbr[2], earth);
+
+			for (int planet = 0; planet < NumberOfVsopPlanets; planet++)
+			{
+				if ((batch.mask & planetMask(planet)) != 0)
+				{
+					evaluate(planet, tau[i], cosines.data(), sines.data(), lbr, rates);
+					astrometric(rotation, lbr, rates, earth, xyz,
+						batch.ra[planet][first + i], batch.dec[planet][first + i], batch.dist[planet][first + i]);
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,181 @@
+/// @file
+///
+/// @brief AVsop87 class definitions.
+///
+/// AVsop87 computes heliocentric positions of Mercury to Neptune from the
+/// VSOP87 planetary theory (Bretagnon and Francou - version D: ecliptic and
+/// equinox of date). The term tables (AVsop87Terms.cpp) are compiled in;
+/// a truncation drops the terms with amplitudes below a threshold at run time.
+/// Terms of all planets share the frequencies of the theory (combinations of
+/// the planets' mean motions), so the cosine and sine of each frequency are
+/// computed once per timestamp for all planets. Batches of evenly spaced
+/// timestamps rotate them from one timestamp to the next (angle addition)
+/// instead of computing them again. Planet positions are astrometric
+/// geocentric J2000 coordinates as of APlanets::computePlanetPos().
+///
+/// @copyright 2019-2020 M.Mashimo and licensors. All Right Reserved.
+///
+/// This file is part of cMoon application.
+///
+/// cMoon is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// any later version.
+///
+/// cMoon is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with cMoon.  If not, see <https://www.gnu.org/licenses/>.
+///
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include "APlanets.h"
+
+/// @brief Planets of the theory - Mercury to Neptune (PlanetType - Earth included)
+constexpr int NumberOfVsopPlanets{8};
+
+/// @brief Highest power of time of a series
+constexpr int VsopMaxPower{5};
+
+/// @brief Coordinates of the theory
+enum VsopCoordinate : int
+{
+	VsopLongitude = 0,   // L (radians)
+	VsopLatitude,        // B (radians)
+	VsopRadius,          // R (AU)
+	NumberOfVsopCoordinates
+};
+
+/// @brief One term: a * cos(b + c * tau) - tau in Julian millennia (TT) from J2000
+using VsopTerm = struct structVsopTerm
+{
+	double a;   // amplitude (1e-8 radians or AU)
+	double b;   // phase (radians)
+	double c;   // frequency (radians per millennium)
+};
+
+/// @brief Terms of a coordinate and power of tau (amplitudes in descending order)
+using VsopSeries = struct structVsopSeries
+{
+	const VsopTerm* terms;
+	int             count;
+};
+
+/// @brief Series of a planet - coordinate = sum of series[coordinate][power] * tau^power
+using VsopPlanet = struct structVsopPlanet
+{
+	VsopSeries series[NumberOfVsopCoordinates][VsopMaxPower + 1];
+};
+
+/// @brief Planet mask of the planets of the theory except Earth (the view position)
+constexpr unsigned VsopPlanetsMask{AllPlanetsMask & ~(1u << PlanetType::Pluto)};
+
+/// @brief Term tables of the planets (PlanetType order)
+extern const std::array<VsopPlanet, NumberOfVsopPlanets> VsopPlanets;
+
+class AVsop87
+{
+public:
+	/// @brief Constructor
+	/// @param[in] truncation - terms with amplitudes below this are skipped (radians or AU - 0 = all terms)
+	explicit AVsop87(const double truncation = 0.);
+
+	/// @brief Changes the truncation (see constructor)
+	void setTruncation(const double truncation);
+
+	double truncation() const
+	{
+		return m_truncation;
+	}
+
+	/// @brief Number of terms used (all planets)
+	size_t terms() const
+	{
+		return m_terms.size();
+	}
+
+	/// @brief Number of terms used of a planet
+	size_t terms(const int planet) const;
+
+	/// @brief Number of frequencies of the terms used (all planets)
+	size_t frequencies() const
+	{
+		return m_frequencies.size();
+	}
+
+	/// @brief Heliocentric coordinates of a planet - ecliptic and equinox of date
+	/// @param[in] planet - PlanetType (Mercury to Neptune)
+	/// @param[in] jde - Julian ephemeris date (TT)
+	/// @param[out] l - longitude (radians, 0 to two pi)
+	/// @param[out] b - latitude (radians)
+	/// @param[out] r - radius (AU)
+	/// @return false if the planet is not in the theory
+	bool heliocentric(const int planet, const double jde, double& l, double& b, double& r) const;
+
+	/// @brief Astrometric geocentric position of a planet (same as APlanets::computePlanetPos())
+	/// @param[in] planet - PlanetType (Mercury to Neptune - not Earth)
+	/// @param[in] j2000 - J2000 day (UTC)
+	/// @param[out] position - heliocentric x, y, z (ecliptic J2000, AU), RA (hours), DEC (degrees) and distance (AU)
+	/// @return false if the planet is not in the theory
+	bool planetPosition(const int planet, const double j2000, PlanetPosition& position) const;
+
+	/// @brief Computes geocentric RA/DEC/distance of planets for an array of J2000 days
+	///
+	/// Timestamps are evaluated in blocks; the frequencies of a block are computed once and
+	/// rotated from one timestamp to the next if the timestamps are evenly spaced. Results are
+	/// the same as planetPosition() for each planet and day (within 1e-9 radians).
+	///
+	/// @param[in] j2000 - J2000 days (UTC)
+	/// @param[in] count - number of J2000 days
+	/// @param[in] mask - planets to compute (see planetMask() - Pluto is left empty)
+	/// @param[out] batch - computed positions (arrays are re-sized - capacity is reused)
+	void computeBatch(const double* j2000, const size_t count, const unsigned mask, PlanetBatch& batch) const;
+
+	/// @brief True if a planet is in the theory
+	static bool hasPlanet(const int planet)
+	{
+		return (planet >= PlanetType::Mercury) && (planet < NumberOfVsopPlanets);
+	}
+
+private:
+	/// @brief Term of the truncated series: p * cos(c * tau) - q * sin(c * tau) - p and q in radians or AU
+	using Term = struct structTerm
+	{
+		double p;           // a * cos(b)
+		double q;           // a * sin(b)
+		double c;           // frequency (radians per millennium)
+		int    frequency;   // index of c in m_frequencies
+	};
+
+	/// @brief Cosines and sines of frequencies at a tau (arrays are indexed as m_frequencies)
+	void phases(const std::vector<int>& frequencies, const double tau, double* cosines, double* sines) const;
+
+	/// @brief Heliocentric L, B, R and their rates (per millennium) of a planet from the phases of a tau
+	void evaluate(const int planet, const double tau, const double* cosines, const double* sines,
+		double coordinates[NumberOfVsopCoordinates], double rates[NumberOfVsopCoordinates]) const;
+
+	/// @brief Frequencies used by the planets of a mask
+	std::vector<int> maskFrequencies(const unsigned mask) const;
+
+	double m_truncation;
+
+	/// @brief Terms used - series of a planet, coordinate and power follow each other
+	std::vector<Term> m_terms;
+
+	/// @brief First term of each series (the next one is its end)
+	std::array<size_t, (NumberOfVsopPlanets * NumberOfVsopCoordinates * (VsopMaxPower + 1)) + 1> m_first;
+
+	/// @brief Frequencies of the terms used (radians per millennium)
+	std::vector<double> m_frequencies;
+
+	/// @brief Frequencies of the position of each planet - its terms and the Earth's (indexes in m_frequencies)
+	std::array<std::vector<int>, NumberOfVsopPlanets> m_planetFrequencies;
+};
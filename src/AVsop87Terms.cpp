@@ -0,0 +1,2825 @@
+/// @file
+///
+/// @brief VSOP87 term tables of AVsop87.
+///
+/// Series of VSOP87D (heliocentric L, B and R of the ecliptic and equinox of
+/// date) of Mercury to Neptune as truncated by J. Meeus (Astronomical
+/// Algorithms, appendix III). Terms of a series are in descending order of
+/// amplitude. Frequencies printed with fewer digits in some series are the
+/// full-precision frequency of the same argument in the others, so that terms
+/// of all planets share them.
+///
+/// @copyright 2019-2020 M.Mashimo and licensors. All Right Reserved.
+///
+/// This file is part of cMoon application.
+///
+/// cMoon is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// any later version.
+///
+/// cMoon is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with cMoon.  If not, see <https://www.gnu.org/licenses/>.
+///
+
+#include "AVsop87.h"
+
+// Terms are a * cos(b + c * tau): a in 1e-8 radians (L, B) or AU (R), b in radians,
+// c in radians per Julian millennium
+
+//------------------------------------------------------------------------------
+// Mercury
+//------------------------------------------------------------------------------
+
+static const VsopTerm s_mercuryL0[]
+{
+	{440250710., 0.,         0.},
+	{40989415.,  1.48302034, 26087.90314157},
+	{5046294.,   4.4778549,  52175.8062831},
+	{855347.,    1.165203,   78263.709425},
+	{165590.,    4.119692,   104351.612566},
+	{34562.,     0.77931,    130439.51571},
+	{7583.,      3.7135,     156527.4188},
+	{3560.,      1.5120,     1109.3786},
+	{1803.,      4.1033,     5661.3320},
+	{1726.,      0.3583,     182615.3220},
+	{1590.,      2.9951,     25028.5212},
+	{1365.,      4.5992,     27197.2817},
+	{1017.,      0.8803,     31749.2352},
+	{714.,       1.541,      24978.525},
+	{644.,       5.303,      21535.950},
+	{451.,       6.050,      51116.424},
+	{404.,       3.282,      208703.225},
+	{352.,       5.242,      20426.57109},
+	{345.,       2.792,      15874.618},
+	{343.,       5.765,      955.600},
+	{339.,       5.863,      25558.212},
+	{325.,       1.337,      53285.185},
+	{273.,       2.495,      529.69096509},
+	{264.,       3.917,      57837.138},
+	{260.,       0.987,      4551.953},
+	{239.,       0.113,      1059.381930},
+	{235.,       0.267,      11322.664},
+	{217.,       0.660,      13521.751},
+	{209.,       2.092,      47623.853},
+	{183.,       2.629,      27043.503},
+	{182.,       2.434,      25661.305},
+	{176.,       4.536,      51066.428},
+	{173.,       2.452,      24498.830},
+	{142.,       3.360,      37410.567},
+	{138.,       0.291,      10213.2855462},
+	{125.,       3.721,      39609.655},
+	{118.,       2.781,      77204.327},
+	{106.,       4.206,      19804.827}
+};
+
+static const VsopTerm s_mercuryL1[]
+{
+	{2608814706223., 0.,        0.},
+	{1126008.,       6.2170397, 26087.90314157},
+	{303471.,        3.055655,  52175.8062831},
+	{80538.,         6.10455,   78263.709425},
+	{21245.,         2.83532,   104351.612566},
+	{5592.,          5.8268,    130439.51571},
+	{1472.,          2.5185,    156527.4188},
+	{388.,           5.480,     182615.3220},
+	{352.,           3.052,     1109.3786},
+	{103.,           2.149,     208703.225},
+	{94.,            6.12,      27197.2817},
+	{91.,            0.00,      24978.52},
+	{52.,            5.62,      5661.3320},
+	{44.,            4.57,      25028.5212},
+	{28.,            3.04,      51066.428},
+	{27.,            5.09,      234791.128}
+};
+
+static const VsopTerm s_mercuryL2[]
+{
+	{53050., 0.,      0.},
+	{16904., 4.69072, 26087.90314157},
+	{7397.,  1.3474,  52175.8062831},
+	{3018.,  4.4564,  78263.709425},
+	{1107.,  1.2623,  104351.612566},
+	{378.,   4.320,   130439.51571},
+	{123.,   1.069,   156527.4188},
+	{39.,    4.08,    182615.3220},
+	{15.,    4.63,    1109.3786},
+	{12.,    0.79,    208703.23}
+};
+
+static const VsopTerm s_mercuryL3[]
+{
+	{188., 0.035, 52175.8062831},
+	{142., 3.125, 26087.90314157},
+	{97.,  3.00,  78263.709425},
+	{44.,  6.02,  104351.612566},
+	{35.,  0.,    0.},
+	{18.,  2.78,  130439.51571},
+	{7.,   5.82,  156527.4188},
+	{3.,   2.57,  182615.3220}
+};
+
+static const VsopTerm s_mercuryL4[]
+{
+	{114., 3.1416, 0.},
+	{2.,   2.03,   26087.90314157},
+	{2.,   1.42,   78263.709425},
+	{2.,   4.50,   52175.8062831},
+	{1.,   4.50,   104351.612566},
+	{1.,   1.27,   130439.51571}
+};
+
+static const VsopTerm s_mercuryL5[]
+{
+	{1., 3.14, 0.}
+};
+
+static const VsopTerm s_mercuryB0[]
+{
+	{11737529., 1.98357499, 26087.90314157},
+	{2388077.,  5.0373896,  52175.8062831},
+	{1222840.,  3.1415927,  0.},
+	{543252.,   1.796444,   78263.709425},
+	{129779.,   4.832325,   104351.612566},
+	{31867.,    1.58088,    130439.51571},
+	{7963.,     4.6097,     156527.4188},
+	{2014.,     1.3532,     182615.3220},
+	{514.,      4.378,      208703.225},
+	{209.,      2.020,      24978.525},
+	{208.,      4.918,      27197.2817},
+	{132.,      1.119,      234791.128},
+	{121.,      1.813,      53285.185},
+	{100.,      5.657,      20426.57109}
+};
+
+static const VsopTerm s_mercuryB1[]
+{
+	{429151., 3.501698, 26087.90314157},
+	{146234., 3.141593, 0.},
+	{22675.,  0.01515,  52175.8062831},
+	{10895.,  0.48540,  78263.709425},
+	{6353.,   3.4294,   104351.612566},
+	{2496.,   0.1605,   130439.51571},
+	{860.,    3.185,    156527.4188},
+	{278.,    6.210,    182615.3220},
+	{86.,     2.95,     208703.23},
+	{28.,     0.29,     27197.2817},
+	{26.,     5.98,     234791.128}
+};
+
+static const VsopTerm s_mercuryB2[]
+{
+	{11831., 4.79066, 26087.90314157},
+	{1914.,  0.,      0.},
+	{1045.,  1.2122,  52175.8062831},
+	{266.,   4.434,   78263.709425},
+	{170.,   1.623,   104351.612566},
+	{96.,    4.80,    130439.51571},
+	{45.,    1.61,    156527.4188},
+	{18.,    4.67,    182615.3220},
+	{7.,     1.43,    208703.23}
+};
+
+static const VsopTerm s_mercuryB3[]
+{
+	{235., 0.354, 26087.90314157},
+	{161., 0.,    0.},
+	{19.,  4.36,  52175.8062831},
+	{6.,   2.51,  78263.709425},
+	{5.,   6.14,  104351.612566},
+	{3.,   3.14,  156527.4188},
+	{2.,   6.27,  130439.51571}
+};
+
+static const VsopTerm s_mercuryB4[]
+{
+	{4., 1.75, 26087.90314157},
+	{1., 3.14, 0.}
+};
+
+static const VsopTerm s_mercuryR0[]
+{
+	{39528272., 0.,        0.},
+	{7834132.,  6.1923372, 26087.90314157},
+	{795526.,   2.959897,  52175.8062831},
+	{121282.,   6.010642,  78263.709425},
+	{21922.,    2.77820,   104351.612566},
+	{4354.,     5.8289,    130439.51571},
+	{918.,      2.597,     156527.4188},
+	{290.,      1.424,     25028.5212},
+	{260.,      3.028,     27197.2817},
+	{202.,      5.647,     182615.3220},
+	{201.,      5.592,     31749.2352},
+	{142.,      6.253,     24978.525},
+	{100.,      3.734,     21535.950}
+};
+
+static const VsopTerm s_mercuryR1[]
+{
+	{217348., 4.656172, 26087.90314157},
+	{44142.,  1.42386,  52175.8062831},
+	{10094.,  4.47466,  78263.709425},
+	{2433.,   1.2423,   104351.612566},
+	{1624.,   0.,       0.},
+	{604.,    4.293,    130439.51571},
+	{153.,    1.061,    156527.4188},
+	{39.,     4.11,     182615.3220}
+};
+
+static const VsopTerm s_mercuryR2[]
+{
+	{3118., 3.0823, 26087.90314157},
+	{1245., 6.1518, 52175.8062831},
+	{425.,  2.926,  78263.709425},
+	{136.,  5.980,  104351.612566},
+	{42.,   2.75,   130439.51571},
+	{22.,   3.14,   0.},
+	{13.,   5.80,   156527.4188}
+};
+
+static const VsopTerm s_mercuryR3[]
+{
+	{33., 1.68, 26087.90314157},
+	{24., 4.63, 52175.8062831},
+	{12., 1.39, 78263.709425},
+	{5.,  4.44, 104351.612566},
+	{2.,  1.21, 130439.51571}
+};
+
+//------------------------------------------------------------------------------
+// Venus
+//------------------------------------------------------------------------------
+
+static const VsopTerm s_venusL0[]
+{
+	{317614667., 0.,        0.},
+	{1353968.,   5.5931332, 10213.2855462},
+	{89892.,     5.30650,   20426.57109},
+	{5477.,      4.4163,    7860.4194},
+	{3456.,      2.6996,    11790.6291},
+	{2372.,      2.9938,    3930.2097},
+	{1664.,      4.2502,    1577.3435},
+	{1438.,      4.1575,    9683.5946},
+	{1317.,      5.1867,    26.2983},
+	{1201.,      6.1536,    30639.8566},
+	{769.,       0.816,     9437.763},
+	{761.,       1.950,     529.69096509},
+	{708.,       1.065,     775.523},
+	{585.,       3.998,     191.4483},
+	{500.,       4.123,     15720.839},
+	{429.,       3.586,     19367.189},
+	{327.,       5.677,     5507.553},
+	{326.,       4.591,     10404.734},
+	{232.,       3.163,     9153.904},
+	{180.,       4.653,     1109.3786},
+	{155.,       5.570,     13521.751},
+	{128.,       4.226,     20.775},
+	{128.,       0.962,     5661.3320},
+	{106.,       1.537,     801.821}
+};
+
+static const VsopTerm s_venusL1[]
+{
+	{1021352943053., 0.,      0.},
+	{95708.,         2.46424, 10213.2855462},
+	{14445.,         0.51625, 20426.57109},
+	{213.,           1.795,   30639.8566},
+	{174.,           2.655,   26.2983},
+	{152.,           6.106,   1577.3435},
+	{82.,            5.70,    191.4483},
+	{70.,            2.68,    9437.763},
+	{52.,            3.60,    775.523},
+	{38.,            1.03,    529.69096509},
+	{30.,            1.25,    5507.553},
+	{25.,            6.11,    10404.734}
+};
+
+static const VsopTerm s_venusL2[]
+{
+	{54127., 0.,     0.},
+	{3891.,  0.3451, 10213.2855462},
+	{1338.,  2.0201, 20426.57109},
+	{24.,    2.05,   26.2983},
+	{19.,    3.54,   30639.8566},
+	{10.,    3.97,   775.523},
+	{7.,     1.52,   1577.3435},
+	{6.,     1.00,   191.4483}
+};
+
+static const VsopTerm s_venusL3[]
+{
+	{136., 4.804, 10213.2855462},
+	{78.,  3.67,  20426.57109},
+	{26.,  0.,    0.}
+};
+
+static const VsopTerm s_venusL4[]
+{
+	{114., 3.1416, 0.},
+	{3.,   5.21,   20426.57109},
+	{2.,   2.51,   10213.2855462}
+};
+
+static const VsopTerm s_venusL5[]
+{
+	{1., 3.14, 0.}
+};
+
+static const VsopTerm s_venusB0[]
+{
+	{5923638., 0.2670278, 10213.2855462},
+	{40108.,   1.14737,   20426.57109},
+	{32815.,   3.14159,   0.},
+	{1011.,    1.0895,    30639.8566},
+	{149.,     6.254,     18073.705},
+	{138.,     0.860,     1577.3435},
+	{130.,     3.672,     9437.763},
+	{120.,     3.705,     2352.866},
+	{108.,     4.539,     22003.915}
+};
+
+static const VsopTerm s_venusB1[]
+{
+	{513348., 1.803643, 10213.2855462},
+	{4380.,   3.3862,   20426.57109},
+	{199.,    0.,       0.},
+	{197.,    2.530,    30639.8566}
+};
+
+static const VsopTerm s_venusB2[]
+{
+	{22378., 3.38509, 10213.2855462},
+	{282.,   0.,      0.},
+	{173.,   5.256,   20426.57109},
+	{27.,    3.87,    30639.8566}
+};
+
+static const VsopTerm s_venusB3[]
+{
+	{647., 4.992, 10213.2855462},
+	{20.,  3.14,  0.},
+	{6.,   0.77,  20426.57109},
+	{3.,   5.44,  30639.8566}
+};
+
+static const VsopTerm s_venusB4[]
+{
+	{14., 0.32, 10213.2855462}
+};
+
+static const VsopTerm s_venusR0[]
+{
+	{72334821., 0.,       0.},
+	{489824.,   4.021518, 10213.2855462},
+	{1658.,     4.9021,   20426.57109},
+	{1632.,     2.8455,   7860.4194},
+	{1378.,     1.1285,   11790.6291},
+	{498.,      2.587,    9683.5946},
+	{374.,      1.423,    3930.2097},
+	{264.,      5.529,    9437.763},
+	{237.,      2.551,    15720.839},
+	{222.,      2.013,    19367.189},
+	{126.,      2.728,    1577.3435},
+	{119.,      3.020,    10404.734}
+};
+
+static const VsopTerm s_venusR1[]
+{
+	{34551., 0.89199, 10213.2855462},
+	{234.,   1.772,   20426.57109},
+	{234.,   3.142,   0.}
+};
+
+static const VsopTerm s_venusR2[]
+{
+	{1407., 5.0637, 10213.2855462},
+	{16.,   5.47,   20426.57109},
+	{13.,   0.,     0.}
+};
+
+static const VsopTerm s_venusR3[]
+{
+	{50., 3.22, 10213.2855462}
+};
+
+static const VsopTerm s_venusR4[]
+{
+	{1., 0.92, 10213.2855462}
+};
+
+//------------------------------------------------------------------------------
+// Earth
+//------------------------------------------------------------------------------
+
+static const VsopTerm s_earthL0[]
+{
+	{175347046., 0.,        0.},
+	{3341656.,   4.6692568, 6283.0758500},
+	{34894.,     4.62610,   12566.15170},
+	{3497.,      2.7441,    5753.3849},
+	{3418.,      2.8289,    3.52312},
+	{3136.,      3.6277,    77713.7715},
+	{2676.,      4.4181,    7860.4194},
+	{2343.,      6.1352,    3930.2097},
+	{1324.,      0.7425,    11506.7698},
+	{1273.,      2.0371,    529.69096509},
+	{1199.,      1.1096,    1577.3435},
+	{990.,       5.233,     5884.927},
+	{902.,       2.045,     26.2983},
+	{857.,       3.508,     398.1490},
+	{780.,       1.179,     5223.694},
+	{753.,       2.533,     5507.553},
+	{505.,       4.583,     18849.228},
+	{492.,       4.205,     775.523},
+	{357.,       2.920,     0.0673},
+	{317.,       5.849,     11790.6291},
+	{284.,       1.899,     796.2980},
+	{271.,       0.315,     10977.079},
+	{243.,       0.345,     5486.778},
+	{206.,       4.806,     2544.3144},
+	{205.,       1.869,     5573.143},
+	{202.,       2.458,     6069.777},
+	{156.,       0.833,     213.29909544},
+	{132.,       3.411,     2942.4634},
+	{126.,       1.083,     20.775},
+	{115.,       0.645,     0.980},
+	{103.,       0.636,     4694.003},
+	{102.,       0.976,     15720.839},
+	{102.,       4.267,     7.1135470},
+	{99.,        6.21,      2146.1654},
+	{98.,        0.68,      155.420},
+	{86.,        5.98,      161000.69},
+	{85.,        1.30,      6275.96},
+	{85.,        3.67,      71430.70},
+	{80.,        1.81,      17260.15},
+	{79.,        3.04,      12036.46},
+	{75.,        1.76,      5088.629},
+	{74.,        3.50,      3154.69},
+	{74.,        4.68,      801.821},
+	{70.,        0.83,      9437.763},
+	{62.,        3.98,      8827.390},
+	{61.,        1.82,      7084.90},
+	{57.,        2.78,      6286.60},
+	{56.,        4.39,      14143.50},
+	{56.,        3.47,      6279.55},
+	{52.,        0.19,      12139.55},
+	{52.,        1.33,      1748.016},
+	{51.,        0.28,      5856.48},
+	{49.,        0.49,      1194.447},
+	{41.,        5.37,      8429.24},
+	{41.,        2.40,      19651.05},
+	{39.,        6.17,      10447.39},
+	{37.,        6.04,      10213.2855462},
+	{37.,        2.57,      1059.381930},
+	{36.,        1.71,      2352.866},
+	{36.,        1.78,      6812.77},
+	{33.,        0.59,      17789.85},
+	{30.,        0.44,      83996.85},
+	{30.,        2.74,      1349.867},
+	{25.,        3.16,      4690.48}
+};
+
+static const VsopTerm s_earthL1[]
+{
+	{628331966747., 0.,       0.},
+	{206059.,       2.678235, 6283.0758500},
+	{4303.,         2.6351,   12566.15170},
+	{425.,          1.590,    3.52312},
+	{119.,          5.796,    26.2983},
+	{109.,          2.966,    1577.3435},
+	{93.,           2.59,     18849.228},
+	{72.,           1.14,     529.69096509},
+	{68.,           1.87,     398.1490},
+	{67.,           4.41,     5507.553},
+	{59.,           2.89,     5223.694},
+	{56.,           2.17,     155.420},
+	{45.,           0.40,     796.2980},
+	{36.,           0.47,     775.523},
+	{29.,           2.65,     7.1135470},
+	{21.,           5.34,     0.980},
+	{19.,           1.85,     5486.778},
+	{19.,           4.97,     213.29909544},
+	{17.,           2.99,     6275.96},
+	{16.,           0.03,     2544.3144},
+	{16.,           1.43,     2146.1654},
+	{15.,           1.21,     10977.079},
+	{12.,           2.83,     1748.016},
+	{12.,           3.26,     5088.629},
+	{12.,           5.27,     1194.447},
+	{12.,           2.08,     4694.003},
+	{11.,           0.77,     553.569},
+	{10.,           1.30,     6286.60},
+	{10.,           4.24,     1349.867},
+	{9.,            2.70,     242.729},
+	{9.,            5.64,     951.718},
+	{8.,            5.30,     2352.866},
+	{6.,            2.65,     9437.763},
+	{6.,            4.67,     4690.48}
+};
+
+static const VsopTerm s_earthL2[]
+{
+	{52919., 0.,     0.},
+	{8720.,  1.0721, 6283.0758500},
+	{309.,   0.867,  12566.15170},
+	{27.,    0.05,   3.52312},
+	{16.,    5.19,   26.2983},
+	{16.,    3.68,   155.420},
+	{10.,    0.76,   18849.228},
+	{9.,     2.06,   77713.7715},
+	{7.,     0.83,   775.523},
+	{5.,     4.66,   1577.3435},
+	{4.,     1.03,   7.1135470},
+	{4.,     3.44,   5573.143},
+	{3.,     5.14,   796.2980},
+	{3.,     6.05,   5507.553},
+	{3.,     1.19,   242.729},
+	{3.,     6.12,   529.69096509},
+	{3.,     0.31,   398.1490},
+	{3.,     2.28,   553.569},
+	{2.,     4.38,   5223.694},
+	{2.,     3.75,   0.980}
+};
+
+static const VsopTerm s_earthL3[]
+{
+	{289., 5.844, 6283.0758500},
+	{35.,  0.,    0.},
+	{17.,  5.49,  12566.15170},
+	{3.,   5.20,  155.420},
+	{1.,   4.72,  3.52312},
+	{1.,   5.30,  18849.228},
+	{1.,   5.97,  242.729}
+};
+
+static const VsopTerm s_earthL4[]
+{
+	{114., 3.142, 0.},
+	{8.,   4.13,  6283.0758500},
+	{1.,   3.84,  12566.15170}
+};
+
+static const VsopTerm s_earthL5[]
+{
+	{1., 3.14, 0.}
+};
+
+static const VsopTerm s_earthB0[]
+{
+	{280., 3.199, 84334.662},
+	{102., 5.422, 5507.553},
+	{80.,  3.88,  5223.694},
+	{44.,  3.70,  2352.866},
+	{32.,  4.00,  1577.3435}
+};
+
+static const VsopTerm s_earthB1[]
+{
+	{9., 3.90, 5507.553},
+	{6., 1.73, 5223.694}
+};
+
+static const VsopTerm s_earthR0[]
+{
+	{100013989., 0.,        0.},
+	{1670700.,   3.0984635, 6283.0758500},
+	{13956.,     3.05525,   12566.15170},
+	{3084.,      5.1985,    77713.7715},
+	{1628.,      1.1739,    5753.3849},
+	{1576.,      2.8469,    7860.4194},
+	{925.,       5.453,     11506.7698},
+	{542.,       4.564,     3930.2097},
+	{472.,       3.661,     5884.927},
+	{346.,       0.964,     5507.553},
+	{329.,       5.900,     5223.694},
+	{307.,       0.299,     5573.143},
+	{243.,       4.273,     11790.6291},
+	{212.,       5.847,     1577.3435},
+	{186.,       5.022,     10977.079},
+	{175.,       3.012,     18849.228},
+	{110.,       5.055,     5486.778},
+	{98.,        0.89,      6069.777},
+	{86.,        5.69,      15720.839},
+	{86.,        1.27,      161000.69},
+	{65.,        0.27,      17260.15},
+	{63.,        0.92,      529.69096509},
+	{57.,        2.01,      83996.85},
+	{56.,        5.24,      71430.70},
+	{49.,        3.25,      2544.3144},
+	{47.,        2.58,      775.523},
+	{45.,        5.54,      9437.763},
+	{43.,        6.01,      6275.96},
+	{39.,        5.36,      4694.003},
+	{38.,        2.39,      8827.390},
+	{37.,        0.83,      19651.05},
+	{37.,        4.90,      12139.55},
+	{36.,        1.67,      12036.46},
+	{35.,        1.84,      2942.4634},
+	{33.,        0.24,      7084.90},
+	{32.,        0.18,      5088.629},
+	{32.,        1.78,      398.1490},
+	{28.,        1.21,      6286.60},
+	{28.,        1.90,      6279.55},
+	{26.,        4.59,      10447.39}
+};
+
+static const VsopTerm s_earthR1[]
+{
+	{103019., 1.107490, 6283.0758500},
+	{1721.,   1.0644,   12566.15170},
+	{702.,    3.142,    0.},
+	{32.,     1.02,     18849.228},
+	{31.,     2.84,     5507.553},
+	{25.,     1.32,     5223.694},
+	{18.,     1.42,     1577.3435},
+	{10.,     5.91,     10977.079},
+	{9.,      1.42,     6275.96},
+	{9.,      0.27,     5486.778}
+};
+
+static const VsopTerm s_earthR2[]
+{
+	{4359., 5.7846, 6283.0758500},
+	{124.,  5.579,  12566.15170},
+	{12.,   3.14,   0.},
+	{9.,    3.63,   77713.7715},
+	{6.,    1.87,   5573.143},
+	{3.,    5.47,   18849.228}
+};
+
+static const VsopTerm s_earthR3[]
+{
+	{145., 4.273, 6283.0758500},
+	{7.,   3.92,  12566.15170}
+};
+
+static const VsopTerm s_earthR4[]
+{
+	{4., 2.56, 6283.0758500}
+};
+
+//------------------------------------------------------------------------------
+// Mars
+//------------------------------------------------------------------------------
+
+static const VsopTerm s_marsL0[]
+{
+	{620347712., 0.,         0.},
+	{18656368.,  5.05037100, 3340.61242670},
+	{1108217.,   5.4009984,  6681.2248534},
+	{91798.,     5.75479,    10021.83728},
+	{27745.,     5.97050,    3.52312},
+	{12316.,     0.84956,    2810.92146},
+	{10610.,     2.93959,    2281.23050},
+	{8927.,      4.1570,     0.0173},
+	{8716.,      6.1101,     13362.4497},
+	{7775.,      3.3397,     5621.8429},
+	{6798.,      0.3646,     398.1490},
+	{4161.,      0.2281,     2942.4634},
+	{3575.,      1.6619,     2544.3144},
+	{3075.,      0.8570,     191.4483},
+	{2938.,      6.0789,     0.0673},
+	{2628.,      0.6481,     3337.0893},
+	{2580.,      0.0300,     3344.1355},
+	{2389.,      5.0390,     796.2980},
+	{1799.,      0.6563,     529.69096509},
+	{1546.,      2.9158,     1751.5395},
+	{1528.,      1.1498,     6151.5339},
+	{1286.,      3.0680,     2146.1654},
+	{1264.,      3.6228,     5092.1520},
+	{1025.,      3.6933,     8962.4553},
+	{892.,       0.183,      16703.062},
+	{859.,       2.401,      2914.014},
+	{833.,       4.495,      3340.630},
+	{833.,       2.464,      3340.595},
+	{749.,       3.822,      155.420},
+	{724.,       0.675,      3738.761},
+	{713.,       3.663,      1059.381930},
+	{655.,       0.489,      3127.313},
+	{636.,       2.922,      8432.764},
+	{553.,       4.475,      1748.016},
+	{550.,       3.810,      0.980},
+	{472.,       3.625,      1194.447},
+	{426.,       0.554,      6283.0758500},
+	{415.,       0.497,      213.29909544},
+	{312.,       0.999,      6677.702},
+	{307.,       0.381,      6684.748},
+	{302.,       4.486,      3532.061},
+	{299.,       2.783,      6254.627},
+	{293.,       4.221,      20.775},
+	{284.,       5.769,      3149.164},
+	{281.,       5.882,      1349.867},
+	{274.,       0.542,      3340.545},
+	{274.,       0.134,      3340.680},
+	{239.,       5.372,      4136.910},
+	{236.,       5.755,      3333.499},
+	{231.,       1.282,      3870.303},
+	{221.,       3.505,      382.897},
+	{204.,       2.821,      1221.849},
+	{193.,       3.357,      3.590},
+	{189.,       1.491,      9492.146},
+	{179.,       1.006,      951.718},
+	{174.,       2.414,      553.569},
+	{172.,       0.439,      5486.778},
+	{160.,       3.949,      4562.461},
+	{144.,       1.419,      135.065},
+	{140.,       3.326,      2700.715},
+	{138.,       4.301,      7.1135470},
+	{131.,       4.045,      12303.068},
+	{128.,       2.208,      1592.596},
+	{128.,       1.807,      5088.629},
+	{117.,       3.128,      7903.073},
+	{113.,       3.701,      1589.07290},
+	{110.,       1.052,      242.729},
+	{105.,       0.785,      8827.390},
+	{100.,       3.243,      11773.377}
+};
+
+static const VsopTerm s_marsL1[]
+{
+	{334085627474., 0.,        0.},
+	{1458227.,      3.6042605, 3340.61242670},
+	{164901.,       3.926313,  6681.2248534},
+	{19963.,        4.26594,   10021.83728},
+	{3452.,         4.7321,    3.52312},
+	{2485.,         4.6128,    13362.4497},
+	{842.,          4.459,     2281.23050},
+	{538.,          5.016,     398.1490},
+	{521.,          4.994,     3344.1355},
+	{433.,          2.561,     191.4483},
+	{430.,          5.316,     155.420},
+	{382.,          3.539,     796.2980},
+	{314.,          4.963,     16703.062},
+	{283.,          3.160,     2544.3144},
+	{206.,          4.569,     2146.1654},
+	{169.,          1.329,     3337.0893},
+	{158.,          4.185,     1751.5395},
+	{134.,          2.233,     0.980},
+	{134.,          5.974,     1748.016},
+	{118.,          6.024,     6151.5339},
+	{117.,          2.213,     1059.381930},
+	{114.,          2.129,     1194.447},
+	{114.,          5.428,     3738.761},
+	{91.,           1.10,      1349.867},
+	{85.,           3.91,      553.569},
+	{83.,           5.30,      6684.748},
+	{81.,           4.43,      529.69096509},
+	{80.,           2.25,      8962.4553},
+	{73.,           2.50,      951.718},
+	{73.,           5.84,      242.729},
+	{71.,           3.86,      2914.014},
+	{68.,           5.02,      382.897},
+	{65.,           1.02,      3340.595},
+	{65.,           3.05,      3340.630},
+	{62.,           4.15,      3149.164},
+	{57.,           3.89,      4136.910},
+	{48.,           4.87,      213.29909544},
+	{48.,           1.18,      3333.499},
+	{47.,           1.31,      3185.19},
+	{41.,           0.71,      1592.596},
+	{40.,           2.73,      7.1135470},
+	{40.,           5.32,      20043.67},
+	{33.,           5.41,      6283.0758500},
+	{28.,           0.05,      9492.146},
+	{27.,           3.89,      1221.849},
+	{27.,           5.11,      2700.715}
+};
+
+static const VsopTerm s_marsL2[]
+{
+	{58016., 2.04979, 3340.61242670},
+	{54188., 0.,      0.},
+	{13908., 2.45742, 6681.2248534},
+	{2465.,  2.8000,  10021.83728},
+	{398.,   3.141,   13362.4497},
+	{222.,   3.194,   3.52312},
+	{121.,   0.543,   155.420},
+	{62.,    3.49,    16703.062},
+	{54.,    3.54,    3344.1355},
+	{34.,    6.00,    2281.23050},
+	{32.,    4.14,    191.4483},
+	{30.,    2.00,    796.2980},
+	{23.,    4.33,    242.729},
+	{22.,    3.45,    398.1490},
+	{20.,    5.42,    553.569},
+	{16.,    0.66,    0.980},
+	{16.,    6.11,    2146.1654},
+	{16.,    1.22,    1748.016},
+	{15.,    6.10,    3185.19},
+	{14.,    4.02,    951.718},
+	{14.,    2.62,    1349.867},
+	{13.,    0.60,    1194.447},
+	{12.,    3.86,    6684.748},
+	{11.,    4.72,    2544.3144},
+	{10.,    0.25,    382.897},
+	{9.,     0.68,    1059.381930},
+	{9.,     3.83,    20043.67},
+	{9.,     3.88,    3738.761},
+	{8.,     5.46,    1751.5395},
+	{7.,     2.58,    3149.164},
+	{7.,     2.38,    4136.910},
+	{6.,     5.48,    1592.596},
+	{6.,     2.34,    3097.88}
+};
+
+static const VsopTerm s_marsL3[]
+{
+	{1482., 0.4443, 3340.61242670},
+	{662.,  0.885,  6681.2248534},
+	{188.,  1.288,  10021.83728},
+	{41.,   1.65,   13362.4497},
+	{26.,   0.,     0.},
+	{23.,   2.05,   155.420},
+	{10.,   1.58,   3.52312},
+	{8.,    2.00,   16703.062},
+	{5.,    2.82,   242.729},
+	{4.,    2.02,   3344.1355},
+	{3.,    4.59,   3185.19},
+	{3.,    0.65,   553.569}
+};
+
+static const VsopTerm s_marsL4[]
+{
+	{114., 3.1416, 0.},
+	{29.,  5.64,   6681.2248534},
+	{24.,  5.14,   3340.61242670},
+	{11.,  6.03,   10021.83728},
+	{3.,   0.13,   13362.4497},
+	{3.,   3.56,   155.420},
+	{1.,   0.49,   16703.062},
+	{1.,   1.32,   242.729}
+};
+
+static const VsopTerm s_marsL5[]
+{
+	{1., 3.14, 0.},
+	{1., 4.04, 6681.2248534}
+};
+
+static const VsopTerm s_marsB0[]
+{
+	{3197135., 3.7683204, 3340.61242670},
+	{298033.,  4.106170,  6681.2248534},
+	{289105.,  0.,        0.},
+	{31366.,   4.44651,   10021.83728},
+	{3484.,    4.7881,    13362.4497},
+	{443.,     5.026,     3344.1355},
+	{443.,     5.652,     3337.0893},
+	{399.,     5.131,     16703.062},
+	{293.,     3.793,     2281.23050},
+	{182.,     6.136,     6151.5339},
+	{163.,     4.264,     529.69096509},
+	{160.,     2.232,     1059.381930},
+	{149.,     2.165,     5621.8429},
+	{143.,     1.182,     3340.595},
+	{143.,     3.213,     3340.630},
+	{139.,     2.418,     8962.4553}
+};
+
+static const VsopTerm s_marsB1[]
+{
+	{350069., 5.368478, 3340.61242670},
+	{14116.,  3.14159,  0.},
+	{9671.,   5.4788,   6681.2248534},
+	{1472.,   3.2021,   10021.83728},
+	{426.,    3.408,    13362.4497},
+	{102.,    0.776,    3337.0893},
+	{79.,     3.72,     16703.062},
+	{33.,     3.46,     5621.8429},
+	{26.,     2.48,     2281.23050}
+};
+
+static const VsopTerm s_marsB2[]
+{
+	{16727., 0.60221, 3340.61242670},
+	{4987.,  3.1416,  0.},
+	{302.,   5.559,   6681.2248534},
+	{26.,    1.90,    13362.4497},
+	{21.,    0.92,    10021.83728},
+	{12.,    2.24,    3337.0893},
+	{8.,     2.25,    16703.062}
+};
+
+static const VsopTerm s_marsB3[]
+{
+	{607., 1.981, 3340.61242670},
+	{43.,  0.,    0.},
+	{14.,  1.80,  6681.2248534},
+	{3.,   3.45,  10021.83728}
+};
+
+static const VsopTerm s_marsB4[]
+{
+	{13., 0.,   0.},
+	{11., 3.46, 3340.61242670},
+	{1.,  0.50, 6681.2248534}
+};
+
+static const VsopTerm s_marsR0[]
+{
+	{153033488., 0.,         0.},
+	{14184953.,  3.47971284, 3340.61242670},
+	{660776.,    3.817834,   6681.2248534},
+	{46179.,     4.15595,    10021.83728},
+	{8110.,      5.5596,     2810.92146},
+	{7485.,      1.7724,     5621.8429},
+	{5523.,      1.3644,     2281.23050},
+	{3825.,      4.4941,     13362.4497},
+	{2484.,      4.9255,     2942.4634},
+	{2307.,      0.0908,     2544.3144},
+	{1999.,      5.3606,     3337.0893},
+	{1960.,      4.7425,     3344.1355},
+	{1167.,      2.1126,     5092.1520},
+	{1103.,      5.0091,     398.1490},
+	{992.,       5.839,      6151.5339},
+	{899.,       4.408,      529.69096509},
+	{807.,       2.102,      1059.381930},
+	{798.,       3.448,      796.2980},
+	{741.,       1.499,      2146.1654},
+	{726.,       1.245,      8432.764},
+	{692.,       2.134,      8962.4553},
+	{633.,       0.894,      3340.595},
+	{633.,       2.924,      3340.630},
+	{630.,       1.287,      1751.5395},
+	{574.,       0.829,      2914.014},
+	{526.,       5.383,      3738.761},
+	{473.,       5.199,      3127.313},
+	{348.,       4.832,      16703.062},
+	{284.,       2.907,      3532.061},
+	{280.,       5.257,      6283.0758500},
+	{276.,       1.218,      6254.627},
+	{275.,       2.908,      1748.016},
+	{270.,       3.764,      5884.927},
+	{239.,       2.037,      1194.447},
+	{234.,       5.105,      5486.778},
+	{228.,       3.255,      6872.673},
+	{223.,       4.199,      3149.164},
+	{219.,       5.583,      191.4483},
+	{208.,       5.255,      3340.545},
+	{208.,       4.846,      3340.680},
+	{186.,       5.699,      6677.702},
+	{183.,       5.081,      6684.748},
+	{179.,       4.184,      3333.499},
+	{176.,       5.953,      3870.303},
+	{164.,       3.799,      4136.910}
+};
+
+static const VsopTerm s_marsR1[]
+{
+	{1107433., 2.0325052, 3340.61242670},
+	{103176.,  2.370718,  6681.2248534},
+	{12877.,   0.,        0.},
+	{10816.,   2.70888,   10021.83728},
+	{1195.,    3.0470,    13362.4497},
+	{439.,     2.888,     2281.23050},
+	{396.,     3.423,     3344.1355},
+	{183.,     1.584,     2544.3144},
+	{136.,     3.385,     16703.062},
+	{128.,     6.043,     3337.0893},
+	{128.,     0.630,     1059.381930},
+	{127.,     1.954,     796.2980},
+	{118.,     2.998,     2146.1654},
+	{88.,      3.42,      398.1490},
+	{83.,      3.86,      3738.761},
+	{76.,      4.45,      6151.5339},
+	{72.,      2.76,      529.69096509},
+	{67.,      2.55,      1751.5395},
+	{66.,      4.41,      1748.016},
+	{58.,      0.54,      1194.447},
+	{54.,      0.68,      8962.4553},
+	{51.,      3.73,      6684.748},
+	{49.,      5.73,      3340.595},
+	{49.,      1.48,      3340.630},
+	{48.,      2.58,      3149.164},
+	{48.,      2.29,      2914.014},
+	{39.,      2.32,      4136.910}
+};
+
+static const VsopTerm s_marsR2[]
+{
+	{44242., 0.47931, 3340.61242670},
+	{8138.,  0.8700,  6681.2248534},
+	{1275.,  1.2259,  10021.83728},
+	{217.,   1.566,   13362.4497}
+};
+
+static const VsopTerm s_marsR3[]
+{
+	{1113., 5.1499, 3340.61242670},
+	{424.,  5.613,  6681.2248534},
+	{100.,  5.997,  10021.83728},
+	{20.,   0.08,   13362.4497},
+	{5.,    3.14,   0.},
+	{3.,    0.43,   16703.062}
+};
+
+static const VsopTerm s_marsR4[]
+{
+	{20., 3.58, 3340.61242670},
+	{16., 4.05, 6681.2248534},
+	{6.,  4.46, 10021.83728},
+	{2.,  4.84, 13362.4497}
+};
+
+//------------------------------------------------------------------------------
+// Jupiter
+//------------------------------------------------------------------------------
+
+static const VsopTerm s_jupiterL0[]
+{
+	{59954691., 0.,        0.},
+	{9695899.,  5.0619179, 529.69096509},
+	{573610.,   1.444062,  7.1135470},
+	{306389.,   5.417347,  1059.381930},
+	{97178.,    4.14265,   632.783739},
+	{72903.,    3.64043,   522.577418},
+	{64264.,    3.41145,   103.092774},
+	{39806.,    2.29377,   419.48464},
+	{38858.,    1.27232,   316.391870},
+	{27965.,    1.78455,   536.80451},
+	{13590.,    5.77481,   1589.07290},
+	{8769.,     3.6300,    949.17561},
+	{8246.,     3.5823,    206.1855484},
+	{7368.,     5.0810,    735.87651},
+	{6263.,     0.0250,    213.29909544},
+	{6114.,     4.5132,    1162.47470},
+	{5305.,     4.1863,    1052.26838},
+	{5305.,     1.3067,    14.22709},
+	{4905.,     1.3208,    110.206321},
+	{4647.,     4.6996,    3.93215},
+	{3045.,     4.3168,    426.5981909},
+	{2610.,     1.5667,    846.08283},
+	{2028.,     1.0638,    3.1814},
+	{1921.,     0.9717,    639.89729},
+	{1765.,     2.1415,    1066.4955},
+	{1723.,     3.8804,    1265.5675},
+	{1633.,     3.5820,    515.4639},
+	{1432.,     4.2968,    625.6702},
+	{973.,      4.098,     95.9792},
+	{884.,      2.437,     412.3711},
+	{733.,      6.085,     838.9693},
+	{731.,      3.806,     1581.9593},
+	{709.,      1.293,     742.9901},
+	{692.,      6.134,     2118.764},
+	{614.,      4.109,     1478.8666},
+	{582.,      4.540,     309.2783},
+	{495.,      3.756,     323.50542},
+	{441.,      2.958,     454.909367},
+	{417.,      1.036,     2.4477},
+	{390.,      4.897,     1692.166},
+	{376.,      4.703,     1368.6603},
+	{341.,      5.715,     533.623},
+	{330.,      4.740,     0.048},
+	{262.,      1.877,     0.963},
+	{261.,      0.820,     380.12777},
+	{257.,      3.724,     199.07200},
+	{244.,      5.220,     728.763},
+	{235.,      1.227,     909.819},
+	{220.,      1.651,     543.918},
+	{207.,      1.855,     525.759},
+	{202.,      1.807,     1375.7738},
+	{197.,      5.293,     1155.361},
+	{175.,      3.730,     942.062},
+	{175.,      3.226,     1898.351},
+	{175.,      5.910,     956.289},
+	{158.,      4.365,     1795.258},
+	{151.,      3.906,     74.78159857},
+	{149.,      4.377,     1685.052},
+	{141.,      3.136,     491.557929},
+	{138.,      1.318,     1169.588},
+	{131.,      4.169,     1045.155},
+	{117.,      2.500,     1596.186},
+	{117.,      3.389,     0.521},
+	{106.,      4.554,     526.510}
+};
+
+static const VsopTerm s_jupiterL1[]
+{
+	{52993480757., 0.,       0.},
+	{489741.,      4.220667, 529.69096509},
+	{228919.,      6.026475, 7.1135470},
+	{27655.,       4.57266,  536.80451},
+	{20721.,       5.45939,  522.577418},
+	{12106.,       0.16986,  1059.381930},
+	{6068.,        4.4242,   103.092774},
+	{5434.,        3.9848,   419.48464},
+	{4238.,        5.8901,   14.22709},
+	{2212.,        5.2677,   206.1855484},
+	{1746.,        4.9267,   1589.07290},
+	{1296.,        5.5513,   3.1814},
+	{1173.,        5.8565,   1052.26838},
+	{1163.,        0.5145,   3.93215},
+	{1099.,        5.3070,   515.4639},
+	{1007.,        0.4648,   735.87651},
+	{1004.,        3.1504,   426.5981909},
+	{848.,         5.758,    110.206321},
+	{827.,         4.803,    213.29909544},
+	{816.,         0.586,    1066.4955},
+	{725.,         5.518,    639.89729},
+	{568.,         5.989,    625.6702},
+	{474.,         4.132,    412.3711},
+	{413.,         5.737,    95.9792},
+	{345.,         4.242,    632.783739},
+	{336.,         3.732,    1162.47470},
+	{234.,         4.035,    949.17561},
+	{234.,         6.243,    309.2783},
+	{199.,         1.505,    838.9693},
+	{195.,         2.219,    323.50542},
+	{187.,         6.086,    742.9901},
+	{184.,         6.280,    543.918},
+	{171.,         5.417,    199.07200},
+	{131.,         0.626,    728.763},
+	{115.,         0.680,    846.08283},
+	{115.,         5.286,    2118.764},
+	{108.,         4.493,    956.289},
+	{80.,          5.82,     1045.155},
+	{72.,          5.34,     942.062},
+	{70.,          5.97,     532.872},
+	{67.,          5.73,     21.341},
+	{66.,          0.13,     526.510},
+	{65.,          6.09,     1581.9593}
+};
+
+static const VsopTerm s_jupiterL2[]
+{
+	{47234., 4.32148, 7.1135470},
+	{38966., 0.,      0.},
+	{30629., 2.93021, 529.69096509},
+	{3189.,  1.0550,  522.577418},
+	{2729.,  4.8455,  536.80451},
+	{2723.,  3.4141,  1059.381930},
+	{1721.,  4.1873,  14.22709},
+	{383.,   5.768,   419.48464},
+	{378.,   0.760,   515.4639},
+	{367.,   6.055,   103.092774},
+	{337.,   3.786,   3.1814},
+	{308.,   0.694,   206.1855484},
+	{218.,   3.814,   1589.07290},
+	{199.,   5.340,   1066.4955},
+	{197.,   2.484,   3.93215},
+	{156.,   1.406,   1052.26838},
+	{146.,   3.814,   639.89729},
+	{142.,   1.634,   426.5981909},
+	{130.,   5.837,   412.3711},
+	{117.,   1.414,   625.6702},
+	{97.,    4.03,    110.206321},
+	{91.,    1.11,    95.9792},
+	{87.,    2.52,    632.783739},
+	{79.,    4.64,    543.918},
+	{72.,    2.22,    735.87651},
+	{58.,    0.83,    199.07200},
+	{57.,    3.12,    213.29909544},
+	{49.,    1.67,    309.2783},
+	{40.,    4.02,    21.341},
+	{40.,    0.62,    323.50542},
+	{36.,    2.33,    728.763},
+	{29.,    3.61,    10.295},
+	{28.,    3.24,    838.9693},
+	{26.,    4.50,    742.9901},
+	{26.,    2.51,    1162.47470},
+	{25.,    1.22,    1045.155},
+	{24.,    3.01,    956.289},
+	{19.,    4.29,    532.872},
+	{18.,    0.81,    508.35},
+	{17.,    4.20,    2118.764},
+	{17.,    1.83,    526.510},
+	{15.,    5.81,    1596.186},
+	{15.,    0.68,    942.062},
+	{15.,    4.00,    117.3199},
+	{14.,    5.95,    316.391870},
+	{14.,    1.80,    302.165},
+	{13.,    2.52,    88.87},
+	{13.,    4.37,    1169.588},
+	{11.,    4.44,    525.759},
+	{10.,    1.72,    1581.9593},
+	{9.,     2.18,    1155.361},
+	{9.,     3.29,    242.729},
+	{9.,     3.32,    1265.5675}
+};
+
+static const VsopTerm s_jupiterL3[]
+{
+	{6502., 2.5986, 7.1135470},
+	{1357., 1.3464, 529.69096509},
+	{471.,  2.475,  14.22709},
+	{417.,  3.245,  536.80451},
+	{353.,  2.974,  522.577418},
+	{155.,  2.076,  1059.381930},
+	{87.,   2.59,   515.4639},
+	{44.,   0.,     0.},
+	{34.,   3.83,   1066.4955},
+	{28.,   2.45,   206.1855484},
+	{24.,   1.28,   412.3711},
+	{23.,   2.98,   543.918},
+	{20.,   2.10,   639.89729},
+	{20.,   1.40,   419.48464},
+	{19.,   1.59,   103.092774},
+	{17.,   2.30,   21.341},
+	{17.,   2.60,   1589.07290},
+	{16.,   3.15,   625.6702},
+	{16.,   3.36,   1052.26838},
+	{13.,   2.76,   95.9792},
+	{13.,   2.54,   199.07200},
+	{13.,   6.27,   426.5981909},
+	{9.,    1.76,   10.295},
+	{9.,    2.27,   110.206321},
+	{7.,    3.43,   309.2783},
+	{7.,    4.04,   728.763},
+	{6.,    2.52,   508.35},
+	{5.,    2.91,   1045.155},
+	{5.,    5.25,   323.50542},
+	{4.,    4.30,   88.87},
+	{4.,    3.52,   302.165},
+	{4.,    4.09,   735.87651},
+	{3.,    1.43,   956.289},
+	{3.,    4.36,   1596.186},
+	{3.,    1.25,   213.29909544},
+	{3.,    5.02,   838.9693},
+	{3.,    2.24,   117.3199},
+	{2.,    2.90,   742.9901},
+	{2.,    2.36,   942.062}
+};
+
+static const VsopTerm s_jupiterL4[]
+{
+	{669., 0.853, 7.1135470},
+	{114., 3.142, 0.},
+	{100., 0.743, 14.22709},
+	{50.,  1.65,  536.80451},
+	{44.,  5.82,  529.69096509},
+	{32.,  4.86,  522.577418},
+	{15.,  4.29,  515.4639},
+	{9.,   0.71,  1059.381930},
+	{5.,   1.30,  543.918},
+	{4.,   2.32,  1066.4955},
+	{4.,   0.48,  21.341},
+	{3.,   3.00,  412.3711},
+	{2.,   0.40,  639.89729},
+	{2.,   4.26,  199.07200},
+	{2.,   4.91,  625.6702},
+	{2.,   4.26,  206.1855484},
+	{1.,   5.26,  1052.26838},
+	{1.,   4.72,  95.9792},
+	{1.,   1.29,  1589.07290}
+};
+
+static const VsopTerm s_jupiterL5[]
+{
+	{50., 5.26, 7.1135470},
+	{16., 5.25, 14.22709},
+	{4.,  0.01, 536.80451},
+	{2.,  1.10, 522.577418},
+	{1.,  3.14, 0.}
+};
+
+static const VsopTerm s_jupiterB0[]
+{
+	{2268616., 3.5585261, 529.69096509},
+	{110090.,  0.,        0.},
+	{109972.,  3.908093,  1059.381930},
+	{8101.,    3.6051,    522.577418},
+	{6438.,    0.3063,    536.80451},
+	{6044.,    4.2588,    1589.07290},
+	{1107.,    2.9853,    1162.47470},
+	{944.,     1.675,     426.5981909},
+	{942.,     2.936,     1052.26838},
+	{894.,     1.754,     7.1135470},
+	{836.,     5.179,     103.092774},
+	{767.,     2.155,     632.783739},
+	{684.,     3.678,     213.29909544},
+	{629.,     0.643,     1066.4955},
+	{559.,     0.014,     846.08283},
+	{532.,     2.703,     110.206321},
+	{464.,     1.173,     949.17561},
+	{431.,     2.608,     419.48464},
+	{351.,     4.611,     2118.764},
+	{132.,     4.778,     742.9901},
+	{123.,     3.350,     1692.166},
+	{116.,     1.387,     323.50542},
+	{115.,     5.049,     316.391870},
+	{104.,     3.701,     515.4639},
+	{103.,     2.319,     1478.8666},
+	{102.,     3.153,     1581.9593}
+};
+
+static const VsopTerm s_jupiterB1[]
+{
+	{177352., 5.701665, 529.69096509},
+	{3230.,   5.7794,   1059.381930},
+	{3081.,   5.4746,   522.577418},
+	{2212.,   4.7348,   536.80451},
+	{1694.,   3.1416,   0.},
+	{346.,    4.746,    1052.26838},
+	{234.,    5.189,    1066.4955},
+	{196.,    6.186,    7.1135470},
+	{150.,    3.927,    1589.07290},
+	{114.,    3.439,    632.783739},
+	{97.,     2.91,     949.17561},
+	{82.,     5.08,     1162.47470},
+	{77.,     2.51,     103.092774},
+	{77.,     0.61,     419.48464},
+	{74.,     5.50,     515.4639},
+	{61.,     5.45,     213.29909544},
+	{50.,     3.95,     735.87651},
+	{46.,     0.54,     110.206321},
+	{45.,     1.90,     846.08283},
+	{37.,     4.70,     543.918},
+	{36.,     6.11,     316.391870},
+	{32.,     4.92,     1581.9593}
+};
+
+static const VsopTerm s_jupiterB2[]
+{
+	{8094., 1.4632, 529.69096509},
+	{813.,  3.1416, 0.},
+	{742.,  0.957,  522.577418},
+	{399.,  2.899,  536.80451},
+	{342.,  1.447,  1059.381930},
+	{74.,   0.41,   1052.26838},
+	{46.,   3.48,   1066.4955},
+	{30.,   1.93,   1589.07290},
+	{29.,   0.99,   515.4639},
+	{23.,   4.27,   7.1135470},
+	{14.,   2.92,   543.918},
+	{12.,   5.22,   632.783739},
+	{11.,   4.88,   949.17561},
+	{6.,    6.21,   1045.155}
+};
+
+static const VsopTerm s_jupiterB3[]
+{
+	{252., 3.381, 529.69096509},
+	{122., 2.733, 522.577418},
+	{49.,  1.04,  536.80451},
+	{11.,  2.31,  1052.26838},
+	{8.,   2.77,  515.4639},
+	{7.,   4.25,  1059.381930},
+	{6.,   1.78,  1066.4955},
+	{4.,   1.13,  543.918},
+	{3.,   3.14,  0.}
+};
+
+static const VsopTerm s_jupiterB4[]
+{
+	{15., 4.53, 522.577418},
+	{5.,  4.47, 529.69096509},
+	{4.,  5.44, 536.80451},
+	{3.,  0.,   0.},
+	{2.,  4.52, 515.4639},
+	{1.,  4.20, 1052.26838}
+};
+
+static const VsopTerm s_jupiterB5[]
+{
+	{1., 0.09, 522.577418}
+};
+
+static const VsopTerm s_jupiterR0[]
+{
+	{520887429., 0.,         0.},
+	{25209327.,  3.49108640, 529.69096509},
+	{610600.,    3.841154,   1059.381930},
+	{282029.,    2.574199,   632.783739},
+	{187647.,    2.075904,   522.577418},
+	{86793.,     0.71001,    419.48464},
+	{72063.,     0.21466,    536.80451},
+	{65517.,     5.97996,    316.391870},
+	{30135.,     2.16132,    949.17561},
+	{29135.,     1.67759,    103.092774},
+	{23947.,     0.27458,    7.1135470},
+	{23453.,     3.54023,    735.87651},
+	{22284.,     4.19363,    1589.07290},
+	{13033.,     2.96043,    1162.47470},
+	{12749.,     2.71550,    1052.26838},
+	{9703.,      1.9067,     206.1855484},
+	{9161.,      4.4135,     213.29909544},
+	{7895.,      2.4791,     426.5981909},
+	{7058.,      2.1818,     1265.5675},
+	{6138.,      6.2642,     846.08283},
+	{5477.,      5.6573,     639.89729},
+	{4170.,      2.0161,     515.4639},
+	{4137.,      2.7222,     625.6702},
+	{3503.,      0.5653,     1066.4955},
+	{2617.,      2.0099,     1581.9593},
+	{2500.,      4.5518,     838.9693},
+	{2128.,      6.1275,     742.9901},
+	{1912.,      0.8562,     412.3711},
+	{1611.,      3.0887,     1375.7738},
+	{1479.,      2.6803,     1478.8666},
+	{1231.,      1.8904,     323.50542},
+	{1217.,      1.8017,     110.206321},
+	{1015.,      1.3867,     454.909367},
+	{999.,       2.872,      309.2783},
+	{961.,       4.549,      2118.764},
+	{886.,       4.148,      533.623},
+	{821.,       1.593,      1898.351},
+	{812.,       5.941,      909.819},
+	{777.,       3.677,      728.763},
+	{727.,       3.988,      1155.361},
+	{655.,       2.791,      1685.052},
+	{654.,       3.382,      1692.166},
+	{621.,       4.823,      956.289},
+	{615.,       2.276,      942.062},
+	{562.,       0.081,      543.918},
+	{542.,       0.284,      525.759}
+};
+
+static const VsopTerm s_jupiterR1[]
+{
+	{1271802., 2.6493751, 529.69096509},
+	{61662.,   3.00076,   1059.381930},
+	{53444.,   3.89718,   522.577418},
+	{41390.,   0.,        0.},
+	{31185.,   4.88277,   536.80451},
+	{11847.,   2.41330,   419.48464},
+	{9166.,    4.7598,    7.1135470},
+	{3404.,    3.3469,    1589.07290},
+	{3203.,    5.2108,    735.87651},
+	{3176.,    2.7930,    103.092774},
+	{2806.,    3.7422,    515.4639},
+	{2677.,    4.3305,    1052.26838},
+	{2600.,    3.6344,    206.1855484},
+	{2412.,    1.4695,    426.5981909},
+	{2101.,    3.9276,    639.89729},
+	{1646.,    5.3095,    1066.4955},
+	{1641.,    4.4163,    625.6702},
+	{1050.,    3.1611,    213.29909544},
+	{1025.,    2.5543,    412.3711},
+	{806.,     2.678,     632.783739},
+	{741.,     2.171,     1162.47470},
+	{677.,     6.250,     838.9693},
+	{567.,     4.577,     742.9901},
+	{485.,     2.469,     949.17561},
+	{469.,     4.710,     543.918},
+	{445.,     0.403,     323.50542},
+	{416.,     5.368,     728.763},
+	{402.,     4.605,     309.2783},
+	{347.,     4.681,     14.22709},
+	{338.,     3.168,     956.289},
+	{261.,     5.343,     846.08283},
+	{247.,     3.923,     942.062},
+	{220.,     4.842,     1368.6603},
+	{203.,     5.600,     1155.361},
+	{200.,     4.439,     1045.155},
+	{197.,     3.706,     2118.764},
+	{196.,     3.759,     199.07200},
+	{184.,     4.265,     95.9792},
+	{180.,     4.402,     532.872},
+	{170.,     4.846,     526.510},
+	{146.,     6.130,     533.623},
+	{133.,     1.322,     110.206321},
+	{132.,     4.512,     525.759}
+};
+
+static const VsopTerm s_jupiterR2[]
+{
+	{79645., 1.35866, 529.69096509},
+	{8252.,  5.7777,  522.577418},
+	{7030.,  3.2748,  536.80451},
+	{5314.,  1.8384,  1059.381930},
+	{1861.,  2.9768,  7.1135470},
+	{964.,   5.480,   515.4639},
+	{836.,   4.199,   419.48464},
+	{498.,   3.142,   0.},
+	{427.,   2.228,   639.89729},
+	{406.,   3.783,   1066.4955},
+	{377.,   2.242,   1589.07290},
+	{363.,   5.368,   206.1855484},
+	{342.,   6.099,   1052.26838},
+	{339.,   6.127,   625.6702},
+	{333.,   0.003,   426.5981909},
+	{280.,   4.262,   412.3711},
+	{257.,   0.963,   632.783739},
+	{230.,   0.705,   735.87651},
+	{201.,   3.069,   543.918},
+	{200.,   4.429,   103.092774},
+	{139.,   2.932,   14.22709},
+	{114.,   0.787,   728.763},
+	{95.,    1.70,    838.9693},
+	{86.,    5.14,    323.50542},
+	{83.,    0.06,    309.2783},
+	{80.,    2.98,    742.9901},
+	{75.,    1.60,    956.289},
+	{70.,    1.51,    213.29909544},
+	{67.,    5.47,    199.07200},
+	{62.,    6.10,    1045.155},
+	{56.,    0.96,    1162.47470},
+	{52.,    5.58,    942.062},
+	{50.,    2.72,    532.872}
+};
+
+static const VsopTerm s_jupiterR3[]
+{
+	{3519., 6.0580, 529.69096509},
+	{1073., 1.6732, 536.80451},
+	{916.,  1.413,  522.577418},
+	{342.,  0.523,  1059.381930},
+	{255.,  1.196,  7.1135470},
+	{222.,  0.952,  515.4639},
+	{90.,   3.14,   0.},
+	{69.,   2.27,   1066.4955},
+	{58.,   1.41,   543.918},
+	{58.,   0.53,   639.89729},
+	{51.,   5.98,   412.3711},
+	{47.,   1.58,   625.6702},
+	{43.,   6.12,   419.48464},
+	{37.,   1.18,   14.22709},
+	{34.,   1.67,   1052.26838},
+	{34.,   0.85,   206.1855484},
+	{31.,   1.04,   1589.07290},
+	{30.,   4.63,   426.5981909},
+	{21.,   2.50,   728.763},
+	{15.,   0.89,   199.07200},
+	{14.,   0.96,   508.35},
+	{13.,   1.50,   1045.155},
+	{12.,   2.61,   735.87651},
+	{12.,   3.56,   323.50542},
+	{11.,   1.79,   309.2783},
+	{11.,   6.28,   956.289},
+	{10.,   6.26,   103.092774},
+	{9.,    3.45,   838.9693}
+};
+
+static const VsopTerm s_jupiterR4[]
+{
+	{129., 0.084, 536.80451},
+	{113., 4.249, 529.69096509},
+	{83.,  3.30,  522.577418},
+	{38.,  2.73,  515.4639},
+	{27.,  5.69,  7.1135470},
+	{18.,  5.40,  1059.381930},
+	{13.,  6.02,  543.918},
+	{9.,   0.77,  1066.4955},
+	{8.,   5.68,  14.22709},
+	{7.,   1.43,  412.3711},
+	{6.,   5.12,  639.89729},
+	{5.,   3.34,  625.6702},
+	{3.,   3.40,  1052.26838},
+	{3.,   4.16,  728.763},
+	{3.,   2.90,  426.5981909}
+};
+
+static const VsopTerm s_jupiterR5[]
+{
+	{11., 4.75, 536.80451},
+	{4.,  5.92, 522.577418},
+	{2.,  5.57, 515.4639},
+	{2.,  4.30, 543.918},
+	{2.,  3.69, 7.1135470},
+	{2.,  4.13, 1059.381930},
+	{2.,  5.49, 1066.4955}
+};
+
+//------------------------------------------------------------------------------
+// Saturn
+//------------------------------------------------------------------------------
+
+static const VsopTerm s_saturnL0[]
+{
+	{87401354., 0.,         0.},
+	{11107660., 3.96205090, 213.29909544},
+	{1414151.,  4.5858152,  7.1135470},
+	{398379.,   0.521120,   206.1855484},
+	{350769.,   3.303299,   426.5981909},
+	{206816.,   0.246584,   103.092774},
+	{79271.,    3.84007,    220.412642},
+	{23990.,    4.66977,    110.206321},
+	{16574.,    0.43719,    419.48464},
+	{15820.,    0.93809,    632.783739},
+	{15054.,    2.71670,    639.89729},
+	{14907.,    5.76903,    316.391870},
+	{14610.,    1.56519,    3.93215},
+	{13160.,    4.44891,    14.22709},
+	{13005.,    5.98119,    11.045700},
+	{10725.,    3.12940,    202.25340},
+	{6126.,     1.7633,     277.03499},
+	{5863.,     0.2366,     529.69096509},
+	{5228.,     4.2078,     3.1814},
+	{5020.,     3.1779,     433.71174},
+	{4593.,     0.6198,     199.07200},
+	{4006.,     2.2448,     63.735898},
+	{3874.,     3.2228,     138.517497},
+	{3269.,     0.7749,     949.17561},
+	{2954.,     0.9828,     95.9792},
+	{2461.,     2.0316,     735.87651},
+	{1758.,     3.2658,     522.577418},
+	{1640.,     5.5050,     846.08283},
+	{1581.,     4.3727,     309.2783},
+	{1391.,     4.0233,     323.50542},
+	{1124.,     2.8373,     415.5525},
+	{1087.,     4.1834,     2.4477},
+	{1017.,     3.7170,     227.5262},
+	{957.,      0.507,      1265.5675},
+	{853.,      3.421,      175.166060},
+	{849.,      3.191,      209.3669},
+	{789.,      5.007,      0.963},
+	{749.,      2.144,      853.1964},
+	{744.,      5.253,      224.34480},
+	{687.,      1.747,      1052.26838},
+	{654.,      1.599,      0.048},
+	{634.,      2.299,      412.3711},
+	{625.,      0.970,      210.1177},
+	{580.,      3.093,      234.640},
+	{546.,      2.127,      350.3321},
+	{543.,      1.518,      9.5612},
+	{530.,      4.449,      117.3199},
+	{478.,      2.965,      137.0330},
+	{474.,      5.475,      742.9901},
+	{452.,      1.044,      490.334},
+	{449.,      1.290,      127.47180},
+	{372.,      2.278,      217.231},
+	{355.,      3.213,      362.862}
+};
+
+static const VsopTerm s_saturnL1[]
+{
+	{21354295596., 0.,        0.},
+	{1296855.,     1.8282054, 213.29909544},
+	{564348.,      2.885001,  7.1135470},
+	{107679.,      2.277699,  206.1855484},
+	{98323.,       1.08070,   426.5981909},
+	{40255.,       2.04128,   220.412642},
+	{19942.,       1.27955,   103.092774},
+	{10512.,       2.74880,   14.22709},
+	{6939.,        0.4049,    639.89729},
+	{4803.,        2.4419,    419.48464},
+	{4056.,        2.9217,    110.206321},
+	{3769.,        3.6497,    3.93215},
+	{3385.,        2.4169,    3.1814},
+	{3302.,        1.2626,    433.71174},
+	{3071.,        2.3274,    199.07200},
+	{1953.,        3.5639,    11.045700},
+	{1249.,        2.6280,    95.9792},
+	{922.,         1.961,     227.5262},
+	{706.,         4.417,     529.69096509},
+	{650.,         6.174,     202.25340},
+	{628.,         6.111,     309.2783},
+	{487.,         6.040,     853.1964},
+	{479.,         4.988,     522.577418},
+	{468.,         4.617,     63.735898},
+	{417.,         2.117,     323.50542},
+	{408.,         1.299,     209.3669},
+	{352.,         2.317,     632.783739},
+	{344.,         3.959,     412.3711},
+	{340.,         3.634,     316.391870},
+	{336.,         3.772,     735.87651},
+	{332.,         2.861,     210.1177},
+	{289.,         2.733,     117.3199},
+	{281.,         5.744,     2.4477},
+	{266.,         0.543,     647.011},
+	{230.,         1.644,     216.4805},
+	{192.,         2.965,     224.34480},
+	{173.,         4.077,     846.08283},
+	{167.,         2.597,     21.341},
+	{136.,         2.286,     10.295},
+	{131.,         3.441,     742.9901},
+	{128.,         4.095,     217.231},
+	{109.,         6.161,     415.5525}
+};
+
+static const VsopTerm s_saturnL2[]
+{
+	{116441., 1.179879, 7.1135470},
+	{91921.,  0.07425,  213.29909544},
+	{90592.,  0.,       0.},
+	{15277.,  4.06492,  206.1855484},
+	{10631.,  0.25778,  220.412642},
+	{10605.,  5.40964,  426.5981909},
+	{4265.,   1.0460,   14.22709},
+	{1216.,   2.9186,   103.092774},
+	{1165.,   4.6094,   639.89729},
+	{1082.,   5.6913,   433.71174},
+	{1045.,   4.0421,   199.07200},
+	{1020.,   0.6337,   3.1814},
+	{634.,    4.388,    419.48464},
+	{549.,    5.573,    3.93215},
+	{457.,    1.268,    110.206321},
+	{425.,    0.209,    227.5262},
+	{274.,    4.288,    95.9792},
+	{162.,    1.381,    11.045700},
+	{129.,    1.566,    309.2783},
+	{117.,    3.881,    853.1964},
+	{105.,    4.900,    647.011},
+	{101.,    0.893,    21.341}
+};
+
+static const VsopTerm s_saturnL3[]
+{
+	{16039., 5.73945, 7.1135470},
+	{4250.,  4.5854,  213.29909544},
+	{1907.,  4.7608,  220.412642},
+	{1466.,  5.9133,  206.1855484},
+	{1162.,  5.6197,  14.22709},
+	{1067.,  3.6082,  426.5981909},
+	{239.,   3.861,   433.71174},
+	{237.,   5.768,   199.07200},
+	{166.,   5.116,   3.1814},
+	{151.,   2.736,   639.89729},
+	{131.,   4.743,   227.5262},
+	{63.,    0.23,    419.48464},
+	{62.,    4.74,    103.092774},
+	{40.,    5.47,    21.341},
+	{40.,    5.96,    95.9792},
+	{39.,    5.83,    110.206321},
+	{28.,    3.01,    647.011},
+	{25.,    0.99,    3.93215},
+	{19.,    1.92,    853.1964},
+	{18.,    4.97,    10.295},
+	{18.,    1.03,    412.3711},
+	{18.,    4.20,    216.4805},
+	{18.,    3.32,    309.2783},
+	{16.,    3.90,    440.825},
+	{16.,    5.62,    117.3199},
+	{13.,    1.18,    88.87},
+	{11.,    5.58,    11.045700},
+	{11.,    5.93,    191.958},
+	{10.,    3.95,    209.3669},
+	{9.,     3.39,    302.165},
+	{8.,     4.88,    323.50542},
+	{7.,     0.38,    632.783739},
+	{6.,     2.25,    522.577418},
+	{6.,     1.06,    210.1177},
+	{5.,     4.64,    234.640},
+	{4.,     3.14,    0.}
+};
+
+static const VsopTerm s_saturnL4[]
+{
+	{1662., 3.9983, 7.1135470},
+	{257.,  2.984,  220.412642},
+	{236.,  3.902,  14.22709},
+	{149.,  2.741,  213.29909544},
+	{114.,  3.142,  0.},
+	{110.,  1.515,  206.1855484},
+	{68.,   1.72,   426.5981909},
+	{40.,   2.05,   433.71174},
+	{38.,   1.24,   199.07200},
+	{31.,   3.01,   227.5262},
+	{15.,   0.83,   639.89729},
+	{9.,    3.71,   21.341},
+	{6.,    2.42,   419.48464},
+	{6.,    1.16,   647.011},
+	{4.,    1.45,   95.9792},
+	{4.,    2.12,   440.825},
+	{3.,    4.09,   110.206321},
+	{3.,    2.77,   412.3711},
+	{3.,    3.01,   88.87},
+	{3.,    0.00,   853.1964},
+	{3.,    0.39,   103.092774},
+	{2.,    3.78,   117.3199},
+	{2.,    2.83,   234.640},
+	{2.,    5.08,   309.2783},
+	{2.,    2.24,   216.4805},
+	{2.,    5.19,   302.165},
+	{1.,    1.55,   191.958}
+};
+
+static const VsopTerm s_saturnL5[]
+{
+	{124., 2.259, 7.1135470},
+	{34.,  2.16,  14.22709},
+	{28.,  1.20,  220.412642},
+	{6.,   1.22,  227.5262},
+	{5.,   0.24,  433.71174},
+	{4.,   6.23,  426.5981909},
+	{3.,   2.97,  199.07200},
+	{3.,   4.29,  206.1855484},
+	{2.,   6.25,  213.29909544},
+	{1.,   5.28,  639.89729},
+	{1.,   0.24,  440.825},
+	{1.,   3.14,  0.}
+};
+
+static const VsopTerm s_saturnB0[]
+{
+	{4330678., 3.6028443, 213.29909544},
+	{240348.,  2.852385,  426.5981909},
+	{84746.,   0.,        0.},
+	{34116.,   0.57297,   206.1855484},
+	{30863.,   3.48442,   220.412642},
+	{14734.,   2.11847,   639.89729},
+	{9917.,    5.7900,    419.48464},
+	{6994.,    4.7360,    7.1135470},
+	{4808.,    5.4331,    316.391870},
+	{4788.,    4.9651,    110.206321},
+	{3432.,    2.7326,    433.71174},
+	{1506.,    6.0130,    103.092774},
+	{1060.,    5.6310,    529.69096509},
+	{969.,     5.204,     632.783739},
+	{942.,     1.396,     853.1964},
+	{708.,     3.803,     323.50542},
+	{552.,     5.131,     202.25340},
+	{400.,     3.359,     227.5262},
+	{319.,     3.626,     209.3669},
+	{316.,     1.997,     647.011},
+	{314.,     0.465,     217.231},
+	{284.,     4.886,     224.34480},
+	{236.,     2.139,     11.045700},
+	{215.,     5.950,     846.08283},
+	{209.,     2.120,     415.5525},
+	{207.,     0.730,     199.07200},
+	{179.,     2.954,     63.735898},
+	{141.,     0.644,     490.334},
+	{139.,     4.595,     14.22709},
+	{139.,     1.998,     735.87651},
+	{135.,     5.245,     742.9901},
+	{122.,     3.115,     522.577418},
+	{116.,     3.109,     216.4805},
+	{114.,     0.963,     210.1177}
+};
+
+static const VsopTerm s_saturnB1[]
+{
+	{397555., 5.332900, 213.29909544},
+	{49479.,  3.14159,  0.},
+	{18572.,  6.09919,  426.5981909},
+	{14801.,  2.30586,  206.1855484},
+	{9644.,   1.6967,   220.412642},
+	{3757.,   1.2543,   419.48464},
+	{2717.,   5.9117,   639.89729},
+	{1455.,   0.8516,   433.71174},
+	{1291.,   2.9177,   7.1135470},
+	{853.,    0.436,    316.391870},
+	{298.,    0.919,    632.783739},
+	{292.,    5.316,    853.1964},
+	{284.,    1.619,    227.5262},
+	{275.,    3.889,    103.092774},
+	{172.,    0.052,    647.011},
+	{166.,    2.444,    199.07200},
+	{158.,    5.209,    110.206321},
+	{128.,    1.207,    529.69096509},
+	{110.,    2.457,    217.231},
+	{82.,     2.76,     210.1177},
+	{81.,     2.86,     14.22709},
+	{69.,     1.66,     202.25340},
+	{65.,     1.26,     216.4805},
+	{61.,     1.25,     209.3669},
+	{59.,     1.82,     323.50542},
+	{46.,     0.82,     440.825},
+	{36.,     1.82,     224.34480},
+	{34.,     2.84,     117.3199},
+	{33.,     1.31,     412.3711},
+	{32.,     1.19,     846.08283},
+	{27.,     4.65,     1066.4955},
+	{27.,     4.44,     11.045700}
+};
+
+static const VsopTerm s_saturnB2[]
+{
+	{20630., 0.50482, 213.29909544},
+	{3720.,  3.9983,  206.1855484},
+	{1627.,  6.1819,  220.412642},
+	{1346.,  0.,      0.},
+	{706.,   3.039,   419.48464},
+	{365.,   5.099,   426.5981909},
+	{330.,   5.279,   433.71174},
+	{219.,   3.828,   639.89729},
+	{139.,   1.043,   7.1135470},
+	{104.,   6.157,   227.5262},
+	{93.,    1.98,    316.391870},
+	{71.,    4.15,    199.07200},
+	{52.,    2.88,    632.783739},
+	{49.,    4.43,    647.011},
+	{41.,    3.16,    853.1964},
+	{29.,    4.53,    210.1177},
+	{24.,    1.12,    14.22709},
+	{21.,    4.35,    217.231},
+	{20.,    5.31,    440.825},
+	{18.,    0.85,    110.206321},
+	{17.,    5.68,    216.4805},
+	{16.,    4.26,    103.092774},
+	{14.,    3.00,    412.3711},
+	{12.,    2.53,    529.69096509},
+	{8.,     3.32,    202.25340},
+	{7.,     5.56,    209.3669},
+	{7.,     0.29,    323.50542},
+	{6.,     1.16,    117.3199},
+	{6.,     3.61,    860.31}
+};
+
+static const VsopTerm s_saturnB3[]
+{
+	{666., 1.990, 213.29909544},
+	{632., 5.698, 206.1855484},
+	{398., 0.,    0.},
+	{188., 4.338, 220.412642},
+	{92.,  4.84,  419.48464},
+	{52.,  3.42,  433.71174},
+	{42.,  2.38,  426.5981909},
+	{26.,  4.40,  227.5262},
+	{21.,  5.85,  199.07200},
+	{18.,  1.99,  639.89729},
+	{11.,  5.37,  7.1135470},
+	{10.,  2.44,  440.825},
+	{7.,   2.46,  647.011}
+};
+
+static const VsopTerm s_saturnB4[]
+{
+	{80., 1.12, 206.1855484},
+	{32., 3.12, 213.29909544},
+	{17., 2.48, 220.412642},
+	{12., 3.14, 0.},
+	{9.,  0.38, 419.48464},
+	{6.,  1.56, 433.71174},
+	{5.,  2.63, 227.5262}
+};
+
+static const VsopTerm s_saturnB5[]
+{
+	{8., 2.82, 206.1855484},
+	{1., 0.51, 220.412642}
+};
+
+static const VsopTerm s_saturnR0[]
+{
+	{955758136., 0.,         0.},
+	{52921382.,  2.39226220, 213.29909544},
+	{1873680.,   5.2354961,  206.1855484},
+	{1464664.,   1.6476305,  426.5981909},
+	{821891.,    5.935200,   316.391870},
+	{547507.,    5.015326,   103.092774},
+	{371684.,    2.271148,   220.412642},
+	{361778.,    3.139043,   7.1135470},
+	{140618.,    5.704067,   632.783739},
+	{108975.,    3.293136,   110.206321},
+	{69007.,     5.94100,    419.48464},
+	{61053.,     0.94038,    639.89729},
+	{48913.,     1.55733,    202.25340},
+	{34144.,     0.19519,    277.03499},
+	{32402.,     5.47085,    949.17561},
+	{20937.,     0.46349,    735.87651},
+	{20839.,     1.52103,    433.71174},
+	{20747.,     5.33256,    199.07200},
+	{15298.,     3.05944,    529.69096509},
+	{14296.,     2.60434,    323.50542},
+	{12884.,     1.64892,    138.517497},
+	{11993.,     5.98051,    846.08283},
+	{11380.,     1.73106,    522.577418},
+	{9796.,      5.2048,     1265.5675},
+	{7753.,      5.8519,     95.9792},
+	{6771.,      3.0043,     14.22709},
+	{6466.,      0.1773,     1052.26838},
+	{5850.,      1.4552,     415.5525},
+	{5307.,      0.5974,     63.735898},
+	{4696.,      2.1492,     227.5262},
+	{4044.,      1.6401,     209.3669},
+	{3688.,      0.7802,     412.3711},
+	{3461.,      1.8509,     175.166060},
+	{3420.,      4.9455,     1581.9593},
+	{3401.,      0.5539,     350.3321},
+	{3376.,      3.6953,     224.34480},
+	{2976.,      5.6847,     210.1177},
+	{2885.,      1.3876,     838.9693},
+	{2881.,      0.1796,     853.1964},
+	{2508.,      3.5385,     742.9901},
+	{2448.,      6.1841,     1368.6603},
+	{2406.,      2.9656,     117.3199},
+	{2174.,      0.0151,     340.7709},
+	{2024.,      5.0541,     11.045700}
+};
+
+static const VsopTerm s_saturnR1[]
+{
+	{6182981., 0.2584352, 213.29909544},
+	{506578.,  0.711147,  206.1855484},
+	{341394.,  5.796358,  426.5981909},
+	{188491.,  0.472157,  220.412642},
+	{186262.,  3.141593,  0.},
+	{143891.,  1.407449,  7.1135470},
+	{49621.,   6.01744,   103.092774},
+	{20928.,   5.09246,   639.89729},
+	{19953.,   1.17560,   419.48464},
+	{18840.,   1.60820,   110.206321},
+	{13877.,   0.75886,   199.07200},
+	{12893.,   5.94330,   433.71174},
+	{5397.,    1.2885,    14.22709},
+	{4869.,    0.8679,    323.50542},
+	{4247.,    0.3930,    227.5262},
+	{3252.,    1.2585,    95.9792},
+	{3081.,    3.4366,    522.577418},
+	{2909.,    4.6068,    202.25340},
+	{2856.,    2.1673,    735.87651},
+	{1988.,    2.4505,    412.3711},
+	{1941.,    6.0239,    209.3669},
+	{1581.,    1.2919,    210.1177},
+	{1340.,    4.3080,    853.1964},
+	{1316.,    1.2530,    117.3199},
+	{1203.,    1.8665,    316.391870},
+	{1091.,    0.0753,    216.4805},
+	{966.,     0.480,     632.783739},
+	{954.,     5.152,     647.011},
+	{898.,     0.983,     529.69096509},
+	{882.,     1.885,     1052.26838},
+	{874.,     1.402,     224.34480},
+	{785.,     3.064,     838.9693},
+	{740.,     1.382,     625.6702},
+	{658.,     4.144,     309.2783},
+	{650.,     1.725,     742.9901},
+	{613.,     3.033,     63.735898},
+	{599.,     2.549,     217.231},
+	{503.,     2.130,     3.93215}
+};
+
+static const VsopTerm s_saturnR2[]
+{
+	{436902., 4.786717, 213.29909544},
+	{71923.,  2.50070,  206.1855484},
+	{49767.,  4.97168,  220.412642},
+	{43221.,  3.86940,  426.5981909},
+	{29646.,  5.96310,  7.1135470},
+	{4721.,   2.4753,   199.07200},
+	{4142.,   4.1067,   433.71174},
+	{3789.,   3.0977,   639.89729},
+	{2964.,   1.3721,   103.092774},
+	{2556.,   2.8507,   419.48464},
+	{2327.,   0.,       0.},
+	{2208.,   6.2759,   110.206321},
+	{2188.,   5.8555,   14.22709},
+	{1957.,   4.9245,   227.5262},
+	{924.,    5.464,    323.50542},
+	{706.,    2.971,    95.9792},
+	{546.,    4.129,    412.3711},
+	{431.,    5.178,    522.577418},
+	{405.,    4.173,    209.3669},
+	{391.,    4.481,    216.4805},
+	{374.,    5.834,    117.3199},
+	{361.,    3.277,    647.011},
+	{356.,    3.192,    210.1177},
+	{326.,    2.269,    853.1964},
+	{207.,    4.022,    735.87651},
+	{204.,    0.088,    202.25340},
+	{180.,    3.597,    632.783739},
+	{178.,    4.097,    440.825},
+	{154.,    3.135,    625.6702},
+	{148.,    0.136,    302.165},
+	{133.,    2.594,    191.958},
+	{132.,    5.933,    309.2783}
+};
+
+static const VsopTerm s_saturnR3[]
+{
+	{20315., 3.02187, 213.29909544},
+	{8924.,  3.1914,  220.412642},
+	{6909.,  4.3517,  206.1855484},
+	{4087.,  4.2241,  7.1135470},
+	{3879.,  2.0106,  426.5981909},
+	{1071.,  4.2036,  199.07200},
+	{907.,   2.283,   433.71174},
+	{606.,   3.175,   227.5262},
+	{597.,   4.135,   14.22709},
+	{483.,   1.173,   639.89729},
+	{393.,   0.,      0.},
+	{229.,   4.698,   419.48464},
+	{188.,   4.590,   110.206321},
+	{150.,   3.202,   103.092774},
+	{121.,   3.768,   323.50542},
+	{102.,   4.710,   95.9792},
+	{101.,   5.819,   412.3711},
+	{93.,    1.44,    647.011},
+	{84.,    2.63,    216.4805},
+	{73.,    4.15,    117.3199},
+	{62.,    2.31,    440.825},
+	{55.,    0.31,    853.1964},
+	{50.,    2.39,    209.3669},
+	{45.,    4.37,    191.958},
+	{41.,    0.69,    522.577418},
+	{40.,    1.84,    302.165},
+	{38.,    5.94,    88.87},
+	{32.,    4.01,    21.341}
+};
+
+static const VsopTerm s_saturnR4[]
+{
+	{1202., 1.4150, 220.412642},
+	{708.,  1.162,  213.29909544},
+	{516.,  6.240,  206.1855484},
+	{427.,  2.469,  7.1135470},
+	{268.,  0.187,  426.5981909},
+	{170.,  5.959,  199.07200},
+	{150.,  0.480,  433.71174},
+	{145.,  1.442,  227.5262},
+	{121.,  2.405,  14.22709},
+	{47.,   5.57,   639.89729},
+	{19.,   5.86,   647.011},
+	{17.,   0.53,   440.825},
+	{16.,   2.90,   110.206321},
+	{15.,   0.30,   419.48464},
+	{14.,   1.30,   412.3711},
+	{13.,   2.09,   323.50542},
+	{11.,   0.22,   95.9792},
+	{11.,   2.46,   117.3199},
+	{10.,   3.14,   0.},
+	{9.,    1.56,   88.87},
+	{9.,    2.28,   21.341},
+	{9.,    0.68,   216.4805},
+	{8.,    1.27,   234.640}
+};
+
+static const VsopTerm s_saturnR5[]
+{
+	{129., 5.913, 220.412642},
+	{32.,  0.69,  7.1135470},
+	{27.,  5.91,  227.5262},
+	{20.,  4.95,  433.71174},
+	{20.,  0.67,  14.22709},
+	{14.,  2.67,  206.1855484},
+	{14.,  1.46,  199.07200},
+	{13.,  4.59,  426.5981909},
+	{7.,   4.63,  213.29909544},
+	{5.,   3.61,  639.89729},
+	{4.,   4.90,  440.825},
+	{3.,   4.07,  647.011},
+	{3.,   4.66,  191.958},
+	{3.,   0.49,  323.50542},
+	{3.,   3.18,  419.48464},
+	{2.,   3.70,  88.87},
+	{2.,   3.32,  95.9792},
+	{2.,   0.56,  117.3199}
+};
+
+//------------------------------------------------------------------------------
+// Uranus
+//------------------------------------------------------------------------------
+
+static const VsopTerm s_uranusL0[]
+{
+	{548129294., 0.,        0.},
+	{9260408.,   0.8910642, 74.78159857},
+	{1504248.,   3.6271926, 1.4844727},
+	{365982.,    1.899622,  73.2971259},
+	{272328.,    3.358237,  149.5631971},
+	{70328.,     5.39254,   63.735898},
+	{68893.,     6.09292,   76.266071},
+	{61999.,     2.26952,   2.96895},
+	{61951.,     2.85099,   11.045700},
+	{26469.,     3.14152,   71.812653},
+	{25711.,     6.11380,   454.909367},
+	{21079.,     4.36059,   148.078724},
+	{17819.,     1.74437,   36.6485629},
+	{14613.,     4.73732,   3.93215},
+	{11163.,     5.82682,   224.34480},
+	{10998.,     0.48865,   138.517497},
+	{9527.,      2.9552,    35.164090},
+	{7546.,      5.2363,    109.94569},
+	{4220.,      3.2333,    70.84945},
+	{4052.,      2.2775,    151.04767},
+	{3490.,      5.4831,    146.59425},
+	{3355.,      1.0655,    4.4534},
+	{3144.,      4.7520,    77.75054},
+	{2927.,      4.6290,    9.5612},
+	{2922.,      5.3524,    85.82730},
+	{2273.,      4.3660,    70.32818},
+	{2149.,      0.6075,    38.13303564},
+	{2051.,      1.5177,    0.1119},
+	{1992.,      4.9244,    277.03499},
+	{1667.,      3.6274,    380.12777},
+	{1533.,      2.5859,    52.69020},
+	{1376.,      2.0428,    65.22037},
+	{1372.,      4.1964,    111.43016},
+	{1284.,      3.1135,    202.25340},
+	{1282.,      0.5427,    222.8603},
+	{1244.,      0.9161,    2.4477},
+	{1221.,      0.1990,    108.46122},
+	{1151.,      4.1790,    33.67962},
+	{1150.,      0.9334,    3.1814},
+	{1090.,      1.7750,    12.5302},
+	{1072.,      0.2356,    62.2514},
+	{946.,       1.192,     127.47180},
+	{708.,       5.183,     213.29909544},
+	{653.,       0.966,     78.7138},
+	{628.,       0.182,     984.60033},
+	{607.,       5.432,     529.69096509},
+	{559.,       3.358,     0.521},
+	{524.,       2.013,     299.1264},
+	{483.,       2.106,     0.963},
+	{471.,       1.407,     184.7273},
+	{467.,       0.415,     145.1098},
+	{434.,       5.521,     183.2428},
+	{405.,       5.987,     8.077},
+	{399.,       0.338,     415.5525},
+	{396.,       5.870,     351.8166},
+	{379.,       2.350,     56.6224},
+	{310.,       5.833,     145.631}
+};
+
+static const VsopTerm s_uranusL1[]
+{
+	{7502543122., 0.,       0.},
+	{154458.,     5.242017, 74.78159857},
+	{24456.,      1.71256,  1.4844727},
+	{9258.,       0.4284,   11.045700},
+	{8266.,       1.5022,   63.735898},
+	{7842.,       1.3198,   149.5631971},
+	{3899.,       0.4648,   3.93215},
+	{2284.,       4.1737,   76.266071},
+	{1927.,       0.5301,   2.96895},
+	{1233.,       1.5863,   70.84945},
+	{791.,        5.436,    3.1814},
+	{767.,        1.996,    73.2971259},
+	{482.,        2.984,    85.82730},
+	{450.,        4.138,    138.517497},
+	{446.,        3.723,    224.34480},
+	{427.,        4.731,    71.812653},
+	{354.,        2.583,    148.078724},
+	{348.,        2.454,    9.5612},
+	{317.,        5.579,    52.69020},
+	{206.,        2.363,    2.4477},
+	{189.,        4.202,    56.6224},
+	{184.,        0.284,    151.04767},
+	{180.,        5.684,    12.5302},
+	{171.,        3.001,    78.7138},
+	{158.,        2.909,    0.963},
+	{155.,        5.591,    4.4534},
+	{154.,        4.652,    35.164090},
+	{152.,        2.942,    77.75054},
+	{143.,        2.590,    62.2514},
+	{121.,        4.148,    127.47180},
+	{116.,        3.732,    65.22037},
+	{102.,        4.188,    145.631}
+};
+
+static const VsopTerm s_uranusL2[]
+{
+	{53033., 0.,     0.},
+	{2358.,  2.2601, 74.78159857},
+	{769.,   4.526,  11.045700},
+	{552.,   3.258,  63.735898},
+	{542.,   2.276,  3.93215},
+	{529.,   4.923,  1.4844727},
+	{258.,   3.691,  3.1814},
+	{239.,   5.858,  149.5631971},
+	{182.,   6.218,  70.84945},
+	{54.,    1.44,   76.266071},
+	{49.,    6.03,   56.6224},
+	{45.,    3.91,   2.4477},
+	{45.,    0.81,   85.82730},
+	{38.,    1.78,   52.69020},
+	{37.,    4.46,   2.96895},
+	{33.,    0.86,   9.5612},
+	{29.,    5.10,   73.2971259},
+	{24.,    3.63,   2.96895},
+	{22.,    5.10,   12.5302},
+	{22.,    4.35,   77.75054},
+	{18.,    4.53,   9.5612}
+};
+
+static const VsopTerm s_uranusL3[]
+{
+	{121., 0.024, 74.78159857},
+	{68.,  4.12,  3.93215},
+	{53.,  2.39,  11.045700},
+	{46.,  0.,    0.},
+	{45.,  2.04,  3.1814},
+	{44.,  2.96,  1.4844727},
+	{25.,  4.89,  63.735898},
+	{21.,  4.55,  70.84945},
+	{20.,  2.31,  149.5631971}
+};
+
+static const VsopTerm s_uranusL4[]
+{
+	{114., 3.142, 0.},
+	{6.,   4.58,  74.78159857},
+	{3.,   0.35,  11.045700},
+	{1.,   3.42,  56.6224}
+};
+
+static const VsopTerm s_uranusB0[]
+{
+	{1346278., 2.6187781, 74.78159857},
+	{62341.,   5.08111,   149.5631971},
+	{61601.,   3.14159,   0.},
+	{9964.,    1.6160,    76.266071},
+	{9926.,    0.5763,    73.2971259},
+	{3259.,    1.2612,    224.34480},
+	{2972.,    2.2437,    1.4844727},
+	{2010.,    6.0555,    148.078724},
+	{1522.,    0.2796,    63.735898},
+	{924.,     4.038,     151.04767},
+	{761.,     6.140,     71.812653},
+	{522.,     3.321,     138.517497},
+	{463.,     0.743,     85.82730},
+	{437.,     3.381,     529.69096509},
+	{435.,     0.341,     77.75054},
+	{431.,     3.554,     213.29909544},
+	{420.,     5.213,     11.045700},
+	{245.,     0.788,     2.96895},
+	{233.,     2.257,     222.8603},
+	{216.,     1.591,     38.13303564},
+	{180.,     3.725,     299.1264},
+	{175.,     1.236,     146.59425},
+	{174.,     1.937,     380.12777},
+	{160.,     5.336,     111.43016},
+	{144.,     5.962,     35.164090},
+	{116.,     5.739,     70.84945},
+	{106.,     0.941,     70.32818},
+	{102.,     2.619,     78.7138}
+};
+
+static const VsopTerm s_uranusB1[]
+{
+	{206366., 4.123943, 74.78159857},
+	{8563.,   0.3382,   149.5631971},
+	{1726.,   2.1219,   73.2971259},
+	{1374.,   0.,       0.},
+	{1369.,   3.0686,   76.266071},
+	{451.,    3.777,    1.4844727},
+	{400.,    2.848,    224.34480},
+	{307.,    1.255,    148.078724},
+	{154.,    3.786,    63.735898},
+	{112.,    5.573,    151.04767},
+	{111.,    5.329,    138.517497},
+	{83.,     3.59,     71.812653},
+	{56.,     3.40,     85.82730},
+	{54.,     1.70,     77.75054},
+	{42.,     1.21,     11.045700},
+	{41.,     4.45,     78.7138},
+	{32.,     3.77,     222.8603},
+	{30.,     2.56,     2.96895},
+	{27.,     5.34,     213.29909544},
+	{26.,     0.42,     380.12777}
+};
+
+static const VsopTerm s_uranusB2[]
+{
+	{9212., 5.8004, 74.78159857},
+	{557.,  0.,     0.},
+	{286.,  2.177,  149.5631971},
+	{95.,   3.84,   73.2971259},
+	{45.,   4.88,   76.266071},
+	{20.,   5.46,   1.4844727},
+	{15.,   0.88,   138.517497},
+	{14.,   2.85,   148.078724},
+	{14.,   5.07,   63.735898},
+	{10.,   5.00,   224.34480},
+	{8.,    6.27,   78.7138}
+};
+
+static const VsopTerm s_uranusB3[]
+{
+	{268., 1.251, 74.78159857},
+	{11.,  3.14,  0.},
+	{6.,   4.01,  149.5631971},
+	{3.,   5.78,  73.2971259}
+};
+
+static const VsopTerm s_uranusB4[]
+{
+	{6., 2.85, 74.78159857}
+};
+
+static const VsopTerm s_uranusR0[]
+{
+	{1921264848., 0.,         0.},
+	{88784984.,   5.60377527, 74.78159857},
+	{3440836.,    0.3283610,  73.2971259},
+	{2055653.,    1.7829517,  149.5631971},
+	{649322.,     4.522473,   76.266071},
+	{602248.,     3.860038,   63.735898},
+	{496404.,     1.401399,   454.909367},
+	{338526.,     1.580027,   138.517497},
+	{243508.,     1.570866,   71.812653},
+	{190522.,     1.998094,   1.4844727},
+	{161858.,     2.791379,   148.078724},
+	{143706.,     1.383686,   11.045700},
+	{93192.,      0.17437,    36.6485629},
+	{89806.,      3.66105,    109.94569},
+	{71424.,      4.24509,    224.34480},
+	{46677.,      1.39977,    35.164090},
+	{39026.,      3.36235,    277.03499},
+	{39010.,      1.66971,    70.84945},
+	{36755.,      3.88649,    146.59425},
+	{30349.,      0.70100,    151.04767},
+	{29156.,      3.18056,    77.75054},
+	{25786.,      3.78538,    85.82730},
+	{25620.,      5.25656,    380.12777},
+	{22637.,      0.72519,    529.69096509},
+	{20473.,      2.79640,    70.32818},
+	{20472.,      1.55589,    202.25340},
+	{17901.,      0.55455,    2.96895},
+	{15503.,      5.35405,    38.13303564},
+	{14702.,      4.90434,    108.46122},
+	{12897.,      2.62154,    111.43016},
+	{12328.,      5.96039,    127.47180},
+	{11959.,      1.75044,    984.60033},
+	{11853.,      0.99343,    52.69020},
+	{11696.,      3.29826,    3.93215},
+	{11495.,      0.43774,    65.22037},
+	{10793.,      1.42105,    213.29909544},
+	{9111.,       4.9964,     62.2514},
+	{8421.,       5.2535,     222.8603},
+	{8402.,       5.0388,     415.5525},
+	{7449.,       0.7949,     351.8166},
+	{7329.,       3.9728,     183.2428},
+	{6046.,       5.6796,     78.7138},
+	{5524.,       3.1150,     9.5612},
+	{5445.,       5.1058,     145.1098},
+	{5238.,       2.6296,     33.67962},
+	{4079.,       3.2206,     340.7709},
+	{3919.,       4.2502,     39.617508},
+	{3802.,       6.1099,     184.7273},
+	{3781.,       3.4584,     456.3938},
+	{3687.,       2.4872,     453.4249},
+	{3102.,       4.1403,     219.8914},
+	{2963.,       0.8298,     56.6224},
+	{2942.,       0.4239,     299.1264},
+	{2940.,       2.1464,     137.0330},
+	{2938.,       3.6766,     140.0020},
+	{2865.,       0.3100,     12.5302},
+	{2538.,       4.8546,     131.4039},
+	{2364.,       0.4425,     554.0700},
+	{2183.,       2.9404,     305.3462}
+};
+
+static const VsopTerm s_uranusR1[]
+{
+	{1479896., 3.6720571, 74.78159857},
+	{71212.,   6.22601,   63.735898},
+	{68627.,   6.13411,   149.5631971},
+	{24060.,   3.14159,   0.},
+	{21468.,   2.60177,   76.266071},
+	{20857.,   5.24625,   11.045700},
+	{11405.,   0.01848,   70.84945},
+	{7497.,    0.4236,    73.2971259},
+	{4244.,    1.4169,    85.82730},
+	{3927.,    3.1551,    71.812653},
+	{3578.,    2.3116,    224.34480},
+	{3506.,    2.5835,    138.517497},
+	{3229.,    5.2550,    3.93215},
+	{3060.,    0.1532,    1.4844727},
+	{2564.,    0.9808,    148.078724},
+	{2429.,    3.9944,    52.69020},
+	{1645.,    2.6535,    127.47180},
+	{1584.,    1.4305,    78.7138},
+	{1508.,    5.0600,    151.04767},
+	{1490.,    2.6756,    56.6224},
+	{1413.,    4.5746,    202.25340},
+	{1403.,    1.3699,    77.75054},
+	{1228.,    1.0470,    62.2514},
+	{1033.,    0.2646,    131.4039},
+	{992.,     2.172,     65.22037},
+	{862.,     5.055,     351.8166},
+	{744.,     3.076,     35.164090},
+	{687.,     2.499,     77.963},
+	{647.,     4.473,     70.32818},
+	{624.,     0.863,     9.5612},
+	{604.,     0.907,     984.60033},
+	{575.,     3.231,     447.796},
+	{562.,     2.718,     462.023},
+	{530.,     5.917,     213.29909544},
+	{528.,     5.151,     2.96895}
+};
+
+static const VsopTerm s_uranusR2[]
+{
+	{22440., 0.69953, 74.78159857},
+	{4727.,  1.6990,  63.735898},
+	{1682.,  4.6483,  70.84945},
+	{1650.,  3.0966,  11.045700},
+	{1434.,  3.5212,  149.5631971},
+	{770.,   0.,      0.},
+	{500.,   6.172,   76.266071},
+	{461.,   0.767,   3.93215},
+	{390.,   4.496,   56.6224},
+	{390.,   5.527,   85.82730},
+	{292.,   0.204,   52.69020},
+	{287.,   3.534,   73.2971259},
+	{273.,   3.847,   138.517497},
+	{220.,   1.964,   131.4039},
+	{216.,   0.848,   77.963},
+	{205.,   3.248,   78.7138},
+	{149.,   4.898,   127.47180},
+	{129.,   2.081,   3.1814}
+};
+
+static const VsopTerm s_uranusR3[]
+{
+	{1164., 4.7345, 74.78159857},
+	{212.,  3.343,  63.735898},
+	{196.,  2.980,  70.84945},
+	{105.,  0.958,  11.045700},
+	{73.,   1.00,   149.5631971},
+	{72.,   0.03,   56.6224},
+	{55.,   2.59,   3.93215},
+	{36.,   5.65,   77.963},
+	{34.,   3.82,   76.266071},
+	{32.,   3.60,   131.4039}
+};
+
+static const VsopTerm s_uranusR4[]
+{
+	{53., 3.01, 74.78159857},
+	{10., 1.91, 56.6224},
+	{7.,  5.09, 11.045700},
+	{7.,  5.43, 149.5631971},
+	{6.,  5.96, 63.735898},
+	{6.,  4.27, 70.84945},
+	{4.,  4.26, 127.47180}
+};
+
+//------------------------------------------------------------------------------
+// Neptune
+//------------------------------------------------------------------------------
+
+static const VsopTerm s_neptuneL0[]
+{
+	{531188633., 0.,        0.},
+	{1798476.,   2.9010127, 38.13303564},
+	{1019728.,   0.4858092, 1.4844727},
+	{124532.,    4.830081,  36.6485629},
+	{42064.,     5.41055,   2.96895},
+	{37715.,     6.09222,   35.164090},
+	{33785.,     1.24489,   76.266071},
+	{16483.,     0.00008,   491.557929},
+	{9199.,      4.9375,    39.617508},
+	{8994.,      0.2746,    175.166060},
+	{4216.,      1.9871,    73.2971259},
+	{3365.,      1.0359,    33.67962},
+	{2285.,      4.2061,    4.4534},
+	{1434.,      2.7834,    74.78159857},
+	{900.,       2.076,     109.94569},
+	{745.,       3.190,     71.812653},
+	{506.,       5.748,     114.399},
+	{400.,       0.350,     1021.24889},
+	{345.,       3.462,     41.1020},
+	{340.,       3.304,     77.75054},
+	{323.,       2.248,     32.1951},
+	{306.,       0.497,     0.521},
+	{287.,       4.505,     0.048},
+	{282.,       2.246,     146.59425},
+	{267.,       4.889,     0.963},
+	{252.,       5.782,     388.4652},
+	{245.,       1.247,     9.5612},
+	{233.,       2.505,     137.0330},
+	{227.,       1.797,     453.4249},
+	{170.,       3.324,     108.46122},
+	{151.,       2.192,     33.9402},
+	{150.,       2.997,     5.938},
+	{148.,       0.859,     111.43016},
+	{119.,       3.677,     2.4477},
+	{109.,       2.416,     183.2428},
+	{103.,       0.041,     0.261},
+	{103.,       4.404,     70.32818},
+	{102.,       5.705,     0.1119}
+};
+
+static const VsopTerm s_neptuneL1[]
+{
+	{3837687717., 0.,      0.},
+	{16604.,      4.86319, 1.4844727},
+	{15807.,      2.27923, 38.13303564},
+	{3335.,       3.6820,  76.266071},
+	{1306.,       3.6732,  2.96895},
+	{605.,        1.505,   35.164090},
+	{179.,        3.453,   39.617508},
+	{107.,        2.451,   4.4534},
+	{106.,        2.755,   33.67962},
+	{73.,         5.49,    36.6485629},
+	{57.,         1.86,    114.399},
+	{57.,         5.22,    0.521},
+	{35.,         4.52,    74.78159857},
+	{32.,         5.90,    77.75054},
+	{30.,         3.67,    388.4652},
+	{29.,         5.17,    9.5612},
+	{29.,         5.17,    2.4477},
+	{26.,         5.25,    168.053}
+};
+
+static const VsopTerm s_neptuneL2[]
+{
+	{53893., 0.,    0.},
+	{296.,   1.855, 1.4844727},
+	{281.,   1.191, 38.13303564},
+	{270.,   5.721, 76.266071},
+	{23.,    1.21,  2.96895},
+	{9.,     4.43,  35.164090},
+	{7.,     0.54,  2.4477}
+};
+
+static const VsopTerm s_neptuneL3[]
+{
+	{31., 0.,   0.},
+	{15., 1.35, 76.266071},
+	{12., 6.04, 1.4844727},
+	{12., 6.11, 38.13303564}
+};
+
+static const VsopTerm s_neptuneL4[]
+{
+	{114., 3.142, 0.}
+};
+
+static const VsopTerm s_neptuneB0[]
+{
+	{3088623., 1.4410437, 38.13303564},
+	{27780.,   5.91272,   76.266071},
+	{27624.,   0.,        0.},
+	{15448.,   3.50877,   39.617508},
+	{15355.,   2.52124,   36.6485629},
+	{2000.,    1.5100,    74.78159857},
+	{1968.,    4.3778,    1.4844727},
+	{1015.,    3.2156,    35.164090},
+	{606.,     2.802,     73.2971259},
+	{595.,     2.129,     41.1020},
+	{589.,     3.187,     2.96895},
+	{402.,     4.169,     114.399},
+	{280.,     1.682,     77.75054},
+	{262.,     3.767,     213.29909544},
+	{254.,     3.271,     453.4249},
+	{206.,     4.257,     529.69096509},
+	{140.,     3.530,     137.0330}
+};
+
+static const VsopTerm s_neptuneB1[]
+{
+	{227279., 3.807931, 38.13303564},
+	{1803.,   1.9758,   76.266071},
+	{1433.,   3.1416,   0.},
+	{1386.,   4.8256,   36.6485629},
+	{1073.,   6.0805,   39.617508},
+	{148.,    3.858,    74.78159857},
+	{136.,    0.478,    1.4844727},
+	{70.,     6.19,     35.164090},
+	{52.,     5.05,     73.2971259},
+	{43.,     0.31,     114.399},
+	{37.,     4.89,     41.1020},
+	{37.,     5.76,     2.96895},
+	{26.,     5.22,     213.29909544}
+};
+
+static const VsopTerm s_neptuneB2[]
+{
+	{9691., 5.5712, 38.13303564},
+	{79.,   3.63,   76.266071},
+	{72.,   0.45,   36.6485629},
+	{59.,   3.14,   0.},
+	{30.,   1.61,   39.617508},
+	{6.,    5.61,   74.78159857}
+};
+
+static const VsopTerm s_neptuneB3[]
+{
+	{273., 1.017, 38.13303564},
+	{2.,   0.,    0.},
+	{2.,   2.37,  36.6485629},
+	{2.,   5.33,  76.266071}
+};
+
+static const VsopTerm s_neptuneB4[]
+{
+	{6., 2.67, 38.13303564}
+};
+
+static const VsopTerm s_neptuneR0[]
+{
+	{3007013206., 0.,         0.},
+	{27062259.,   1.32999459, 38.13303564},
+	{1691764.,    3.2518614,  36.6485629},
+	{807831.,     5.185928,   76.266071},
+	{537761.,     4.521139,   35.164090},
+	{495726.,     1.571057,   491.557929},
+	{274572.,     1.845523,   175.166060},
+	{135134.,     3.372206,   39.617508},
+	{121802.,     5.797544,   76.478713},
+	{100895.,     0.377027,   73.2971259},
+	{69792.,      3.79617,    2.96895},
+	{46688.,      5.74938,    33.67962},
+	{24594.,      0.50802,    109.94569},
+	{16939.,      1.59422,    71.812653},
+	{14230.,      1.07786,    74.78159857},
+	{12012.,      1.92062,    1021.24889},
+	{8395.,       0.6782,     146.59425},
+	{7572.,       1.0715,     388.4652},
+	{5721.,       2.5906,     4.4534},
+	{4840.,       1.9069,     41.1020},
+	{4483.,       2.9057,     529.69096509},
+	{4421.,       1.7499,     108.46122},
+	{4354.,       0.6799,     32.1951},
+	{4270.,       3.4134,     453.4249},
+	{3381.,       0.8481,     183.2428},
+	{2881.,       1.9860,     137.0330},
+	{2879.,       3.6742,     350.3321},
+	{2636.,       3.0976,     213.29909544},
+	{2530.,       5.7984,     490.0735},
+	{2523.,       0.4863,     493.0424},
+	{2306.,       2.8096,     70.32818},
+	{2087.,       0.6186,     33.9402}
+};
+
+static const VsopTerm s_neptuneR1[]
+{
+	{236339., 0.704980, 38.13303564},
+	{13220.,  3.32015,  1.4844727},
+	{8622.,   6.2163,   35.164090},
+	{2702.,   1.8814,   39.617508},
+	{2155.,   2.0943,   2.96895},
+	{2153.,   5.1687,   76.266071},
+	{1603.,   0.,       0.},
+	{1464.,   1.1842,   33.67962},
+	{1136.,   3.9189,   36.6485629},
+	{898.,    5.241,    388.4652},
+	{790.,    0.533,    168.053},
+	{760.,    0.021,    182.280},
+	{607.,    1.077,    1021.24889},
+	{572.,    3.401,    484.444},
+	{561.,    2.887,    498.671}
+};
+
+static const VsopTerm s_neptuneR2[]
+{
+	{4247., 5.8991, 38.13303564},
+	{218.,  0.346,  1.4844727},
+	{163.,  2.239,  168.053},
+	{156.,  4.594,  182.280},
+	{127.,  2.848,  35.164090},
+	{118.,  5.10,   484.444},
+	{112.,  1.19,   498.671},
+	{99.,   3.42,   175.166060},
+	{77.,   0.02,   491.557929},
+	{65.,   3.46,   388.4652},
+	{50.,   4.07,   76.266071},
+	{39.,   6.09,   1021.24889},
+	{37.,   5.17,   137.0330},
+	{37.,   5.97,   2.96895},
+	{34.,   0.12,   33.67962},
+	{32.,   1.13,   36.6485629},
+	{27.,   5.81,   39.617508}
+};
+
+static const VsopTerm s_neptuneR3[]
+{
+	{166., 4.552, 38.13303564}
+};
+
+static const VsopTerm s_neptuneR4[]
+{
+	{4., 0., 0.}
+};
+
+/// @brief Series of a table
+template <size_t N>
+static constexpr VsopSeries series(const VsopTerm (&terms)[N])
+{
+	return VsopSeries{terms, static_cast<int>(N)};
+}
+
+/// @brief No series of the power
+static constexpr VsopSeries None{nullptr, 0};
+
+const std::array<VsopPlanet, NumberOfVsopPlanets> VsopPlanets
+{{
+	// Mercury
+	{{
+		{series(s_mercuryL0), series(s_mercuryL1), series(s_mercuryL2), series(s_mercuryL3), series(s_mercuryL4), series(s_mercuryL5)},
+		{series(s_mercuryB0), series(s_mercuryB1), series(s_mercuryB2), series(s_mercuryB3), series(s_mercuryB4), None},
+		{series(s_mercuryR0), series(s_mercuryR1), series(s_mercuryR2), series(s_mercuryR3), None, None}
+	}},
+	// Venus
+	{{
+		{series(s_venusL0), series(s_venusL1), series(s_venusL2), series(s_venusL3), series(s_venusL4), series(s_venusL5)},
+		{series(s_venusB0), series(s_venusB1), series(s_venusB2), series(s_venusB3), series(s_venusB4), None},
+		{series(s_venusR0), series(s_venusR1), series(s_venusR2), series(s_venusR3), series(s_venusR4), None}
+	}},
+	// Earth
+	{{
+		{series(s_earthL0), series(s_earthL1), series(s_earthL2), series(s_earthL3), series(s_earthL4), series(s_earthL5)},
+		{series(s_earthB0), series(s_earthB1), None, None, None, None},
+		{series(s_earthR0), series(s_earthR1), series(s_earthR2), series(s_earthR3), series(s_earthR4), None}
+	}},
+	// Mars
+	{{
+		{series(s_marsL0), series(s_marsL1), series(s_marsL2), series(s_marsL3), series(s_marsL4), series(s_marsL5)},
+		{series(s_marsB0), series(s_marsB1), series(s_marsB2), series(s_marsB3), series(s_marsB4), None},
+		{series(s_marsR0), series(s_marsR1), series(s_marsR2), series(s_marsR3), series(s_marsR4), None}
+	}},
+	// Jupiter
+	{{
+		{series(s_jupiterL0), series(s_jupiterL1), series(s_jupiterL2), series(s_jupiterL3), series(s_jupiterL4), series(s_jupiterL5)},
+		{series(s_jupiterB0), series(s_jupiterB1), series(s_jupiterB2), series(s_jupiterB3), series(s_jupiterB4), series(s_jupiterB5)},
+		{series(s_jupiterR0), series(s_jupiterR1), series(s_jupiterR2), series(s_jupiterR3), series(s_jupiterR4), series(s_jupiterR5)}
+	}},
+	// Saturn
+	{{
+		{series(s_saturnL0), series(s_saturnL1), series(s_saturnL2), series(s_saturnL3), series(s_saturnL4), series(s_saturnL5)},
+		{series(s_saturnB0), series(s_saturnB1), series(s_saturnB2), series(s_saturnB3), series(s_saturnB4), series(s_saturnB5)},
+		{series(s_saturnR0), series(s_saturnR1), series(s_saturnR2), series(s_saturnR3), series(s_saturnR4), series(s_saturnR5)}
+	}},
+	// Uranus
+	{{
+		{series(s_uranusL0), series(s_uranusL1), series(s_uranusL2), series(s_uranusL3), series(s_uranusL4), None},
+		{series(s_uranusB0), series(s_uranusB1), series(s_uranusB2), series(s_uranusB3), series(s_uranusB4), None},
+		{series(s_uranusR0), series(s_uranusR1), series(s_uranusR2), series(s_uranusR3), series(s_uranusR4), None}
+	}},
+	// Neptune
+	{{
+		{series(s_neptuneL0), series(s_neptuneL1), series(s_neptuneL2), series(s_neptuneL3), series(s_neptuneL4), None},
+		{series(s_neptuneB0), series(s_neptuneB1), series(s_neptuneB2), series(s_neptuneB3), series(s_neptuneB4), None},
+		{series(s_neptuneR0), series(s_neptuneR1), series(s_neptuneR2), series(s_neptuneR3), series(s_neptuneR4), None}
+	}}
+}};
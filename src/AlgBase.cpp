@@ -260,3 +260,12 @@ double AlgBase::convertDateToJulianNoon(const int Y, const int M, const int D)
 
     return jd;
 }
+
+long AlgBase::convertDateToJulianDay(const int Y, const int M, const int D)
+{
+    // Fliegel and Van Flandern - inverse of convertJulianToDate()
+    long a = (M - 14) / 12;
+    long y = Y + 4800 + a;
+
+    return ((1461 * y) / 4) + ((367 * (M - 2 - (12 * a))) / 12) - ((3 * ((y + 100) / 100)) / 4) + D - 32075;
+}
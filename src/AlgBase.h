@@ -26,6 +26,7 @@
 
 #include <cmath>
 
+#include "AInstant.h"
 #include "ALocation.h"
 
 #include <boost/math/constants/constants.hpp>
@@ -78,6 +79,12 @@ public:
 	// the mjd and longitude specified
 	static double localSiderialTime(const double mjd, const ALocation& location);
 
+	/// @brief Local siderial time of an instant
+	static double localSiderialTime(const AInstant instant, const ALocation& location)
+	{
+		return localSiderialTime(instant.modifiedJulian(), location);
+	}
+
 	/// @brief Given locatio and current time, get RA and Decl
 	/// @param[in] location
 	/// @param[in] instant - current time
@@ -85,6 +92,12 @@ public:
 	/// @param[out] dec
 	static double localAltitude(const ALocation& location, const double instant, double ra, double dec);
 
+	/// @brief Altitude (degrees) of RA/Decl at an instant
+	static double localAltitude(const ALocation& location, const AInstant instant, double ra, double dec)
+	{
+		return localAltitude(location, instant.modifiedJulian(), ra, dec);
+	}
+
 
 //=========================================
 // Basic Date / Time functions
@@ -119,4 +132,12 @@ public:
 	/// @param[in] D
 	/// @return Julian day at Noon
 	static double convertDateToJulianNoon(const int Y, const int M, const int D);
+
+	/// @brief Converts Gregorian Date (Y, M, D) into Julian day number (days from civil, integer math only).
+	/// NOTE: Exact for any Gregorian date after 4800 BC - convertJulianToDate() converts back
+	/// @param[in] Y
+	/// @param[in] M - 1 to 12
+	/// @param[in] D
+	/// @return Julian day number (Julian day starting at noon of the date)
+	static long convertDateToJulianDay(const int Y, const int M, const int D);
 };
\ No newline at end of file
@@ -0,0 +1,293 @@
+/// @file
+///
+/// @brief Almanac (annual rise/set and twilight table) mode class implementation.
+///
+/// @copyright 2019-2020 M.Mashimo and licensors. All Right Reserved.
+///
+/// cMoon is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// any later version.
+///
+/// cMoon is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with cMoon.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "pch.h"
+
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#include "ASweep.h"
+#include "almanac.hpp"
+
+/// @brief Output is written in blocks of this size
+static constexpr size_t AlmanacBufferSize{65536};
+
+/// @brief Keys of the horizons of AlmanacSweepHorizons (CSV and JSON)
+static const char* s_horizonKeys[NumberOfAltTypes]{"center", "moon", "sun", "civil", "nautical", "astronomical"};
+
+/// @brief Column of the text table - rise or set of a horizon of AlmanacSweepHorizons
+using AlmanacColumn = struct structAlmanacColumn
+{
+	int         horizon;
+	bool        rise;
+	const char* title;
+};
+
+/// @brief Text columns - dawn (lowest horizon first), dusk, then the Moon
+static const AlmanacColumn s_textColumns[]
+{
+	{5, true,  "A-dawn"},
+	{4, true,  "N-dawn"},
+	{3, true,  "C-dawn"},
+	{2, true,  "Sunrise"},
+	{0, true,  "Ctr-up"},
+	{0, false, "Ctr-dn"},
+	{2, false, "Sunset"},
+	{3, false, "C-dusk"},
+	{4, false, "N-dusk"},
+	{5, false, "A-dusk"},
+	{1, true,  "M-rise"},
+	{1, false, "M-set"}
+};
+
+static void appendNumber(std::string& buffer, const char* format, const double value)
+{
+	char text[40];
+	int length = snprintf(text, sizeof(text), format, value);
+	buffer.append(text, static_cast<size_t>(length));
+}
+
+/// @brief Appends the wall-clock time of an event as "   hh:mm", "   --:--" (no crossing) or "   ++:++" (above all day)
+/// @param[in] zone - time zone of the day (its offset at the event - DST days)
+/// @param[in] dayStart - local midnight (MJD)
+/// @param[in] hours - hours from local midnight
+static void appendHours(std::string& buffer, const bool valid, const ATimeZone& zone, const double dayStart,
+	const double hours, const bool aboveAllDay)
+{
+	if (!valid)
+	{
+		buffer.append(aboveAllDay ? "   ++:++" : "   --:--");
+		return;
+	}
+
+	char text[16];
+	long minutes = lround(zone.clockHours(dayStart + (hours / 24.)) * 60.) % 1440;
+	int length = snprintf(text, sizeof(text), "   %02ld:%02ld", minutes / 60, minutes % 60);
+	buffer.append(text, static_cast<size_t>(length));
+}
+
+
+Almanac::Almanac(const ADateTime& dateObj, const ALocation& location, const AMoon& moonObj)
+	: m_dateTime(dateObj)
+	, m_location(location)
+	, m_moon(moonObj)
+	, m_ephemeris(nullptr)
+	, m_samples(0)
+	, m_output(stdout)
+{
+	// Intentionally left blank
+}
+
+Almanac::~Almanac()
+{
+	// Intentionally left blank
+}
+
+void Almanac::setEphemeris(const AChebyshev* ephemeris)
+{
+	m_ephemeris = ephemeris;
+}
+
+bool Almanac::parseFormat(const char* arg, AlmanacFormat& format)
+{
+#ifdef WIN32
+	if (_stricmp(arg, "text") == 0)
+#else
+	if (strcasecmp(arg, "text") == 0)
+#endif
+	{
+		format = AlmanacFormat::Text;
+	}
+#ifdef WIN32
+	else if (_stricmp(arg, "csv") == 0)
+#else
+	else if (strcasecmp(arg, "csv") == 0)
+#endif
+	{
+		format = AlmanacFormat::Csv;
+	}
+#ifdef WIN32
+	else if (_stricmp(arg, "json") == 0)
+#else
+	else if (strcasecmp(arg, "json") == 0)
+#endif
+	{
+		format = AlmanacFormat::Json;
+	}
+	else
+	{
+		return false;
+	}
+	return true;
+}
+
+void Almanac::flush(const bool always)
+{
+	if (always || (m_buffer.size() >= AlmanacBufferSize))
+	{
+		fwrite(m_buffer.data(), 1, m_buffer.size(), m_output);
+		m_buffer.clear();
+	}
+}
+
+int Almanac::run(const int year, const AlmanacFormat format, FILE* output)
+{
+	if ((year < 1) || (year > 9999))
+	{
+		return 0;
+	}
+
+	// Local days of the year - local midnights in the zone (DST days are 23 or 25 hours)
+	long firstDay = AlgBase::convertDateToJulianDay(year, 1, 1);
+	int days = static_cast<int>(AlgBase::convertDateToJulianDay(year + 1, 1, 1) - firstDay);
+	std::vector<double> dayStarts(days + 1);
+	for (int d = 0; d <= days; d++)
+	{
+		int yr, month, dayOfMonth;
+		AlgBase::convertJulianToDate(static_cast<double>(firstDay + d), yr, month, dayOfMonth);
+		dayStarts[d] = m_dateTime.zone()->localMidnight(yr, month, dayOfMonth).modifiedJulian();
+	}
+
+	// One search of the Sun for all its horizons, one of the Moon
+	std::vector<RiseSetInfo> info;
+	ASweep sweep(m_location, AlmanacSweepHorizons);
+	sweep.setEphemeris(m_ephemeris);
+	sweep.setLunarTheory(m_moon.lunarTheory());
+	sweep.riseSetDays(dayStarts, info);
+	m_samples = sweep.samples();
+
+	const int horizons = static_cast<int>(AlmanacSweepHorizons.size());
+
+	m_output = output;
+	m_buffer.reserve(AlmanacBufferSize + 4096);
+
+	// Printed by std::cout before
+	fflush(m_output);
+
+	if (format == AlmanacFormat::Text)
+	{
+		char text[160];
+		snprintf(text, sizeof(text), "\n-----------------Almanac %04d (local time)--------------------------------\nDate      ", year);
+		m_buffer.append(text);
+		for (const auto& column : s_textColumns)
+		{
+			snprintf(text, sizeof(text), "%8s", column.title);
+			m_buffer.append(text);
+		}
+		m_buffer.push_back('\n');
+	}
+	else if (format == AlmanacFormat::Csv)
+	{
+		m_buffer.append("date,midnight_mjd");
+		for (int h = 0; h < horizons; h++)
+		{
+			m_buffer.append(",").append(s_horizonKeys[h]).append("_rise,");
+			m_buffer.append(s_horizonKeys[h]).append("_set,");
+			m_buffer.append(s_horizonKeys[h]).append("_above");
+		}
+		m_buffer.push_back('\n');
+	}
+
+	for (int d = 0; d < days; d++)
+	{
+		const RiseSetInfo* day = &info[d * horizons];
+
+		int yr, month, dayOfMonth;
+		AlgBase::convertJulianToDate(static_cast<double>(firstDay + d), yr, month, dayOfMonth);
+		char date[16];
+		snprintf(date, sizeof(date), "%04d-%02d-%02d", yr, month, dayOfMonth);
+
+		if (format == AlmanacFormat::Text)
+		{
+			m_buffer.append(date);
+			for (const auto& column : s_textColumns)
+			{
+				const RiseSetInfo& riseSet = day[column.horizon];
+				bool aboveAllDay = riseSet.above && !riseSet.rise && !riseSet.sett;
+				appendHours(m_buffer, column.rise ? riseSet.rise : riseSet.sett, *m_dateTime.zone(), dayStarts[d],
+					column.rise ? riseSet.utRise : riseSet.utSet, aboveAllDay);
+			}
+			m_buffer.push_back('\n');
+		}
+		else if (format == AlmanacFormat::Csv)
+		{
+			// Empty fields if no crossing
+			m_buffer.append(date);
+			appendNumber(m_buffer, ",%.6f", dayStarts[d]);
+			for (int h = 0; h < horizons; h++)
+			{
+				m_buffer.push_back(',');
+				if (day[h].rise)
+				{
+					appendNumber(m_buffer, "%.4f", day[h].utRise);
+				}
+				m_buffer.push_back(',');
+				if (day[h].sett)
+				{
+					appendNumber(m_buffer, "%.4f", day[h].utSet);
+				}
+				m_buffer.append(day[h].above ? ",1" : ",0");
+			}
+			m_buffer.push_back('\n');
+		}
+		else
+		{
+			// Hours from local midnight - null if no crossing, above at local midnight
+			m_buffer.append("{\"date\":\"").append(date).append("\"");
+			appendNumber(m_buffer, ",\"midnight_mjd\":%.6f", dayStarts[d]);
+			for (int h = 0; h < horizons; h++)
+			{
+				m_buffer.append(",\"").append(s_horizonKeys[h]).append("\":{\"rise\":");
+				if (day[h].rise)
+				{
+					appendNumber(m_buffer, "%.4f", day[h].utRise);
+				}
+				else
+				{
+					m_buffer.append("null");
+				}
+				m_buffer.append(",\"set\":");
+				if (day[h].sett)
+				{
+					appendNumber(m_buffer, "%.4f", day[h].utSet);
+				}
+				else
+				{
+					m_buffer.append("null");
+				}
+				m_buffer.append(day[h].above ? ",\"above\":true}" : ",\"above\":false}");
+			}
+			m_buffer.append("}\n");
+		}
+
+		flush();
+	}
+
+	if (format == AlmanacFormat::Text)
+	{
+		m_buffer.append("A/N/C - astronomical, nautical and civil twilight, Ctr - center of the Sun, M - Moon\n");
+		m_buffer.append("--:-- no crossing that day, ++:++ above the horizon all day\n");
+	}
+
+	flush(true);
+	fflush(m_output);
+
+	return days;
+}
@@ -0,0 +1,91 @@
+/// @file
+///
+/// @brief Almanac (annual rise/set and twilight table) mode class definitions.
+///
+/// Almanac prints the crossings of all six horizons of AltitudeType for each
+/// local day of a year at one site: dawn and dusk of the astronomical, nautical
+/// and civil twilights, sunrise and sunset (upper limb and center) and moonrise
+/// and moonset. The Sun is searched once for its five horizons and the Moon once
+/// (ASweep - AlmanacSweepHorizons) for the whole year. Tables are printed as text
+/// or written as CSV or JSON lines.
+///
+/// @copyright 2019-2020 M.Mashimo and licensors. All Right Reserved.
+///
+/// cMoon is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// any later version.
+///
+/// cMoon is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with cMoon.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <cstdio>
+#include <string>
+
+#include "AChebyshev.h"
+#include "ADateTime.h"
+#include "ALocation.h"
+#include "AMoon.h"
+
+/// @brief Output format of the almanac
+enum class AlmanacFormat : int
+{
+	Text,
+	Csv,
+	Json
+};
+
+class Almanac
+{
+public:
+	/// @brief Constructor
+	/// @param[in] dateObj - time zone of the days
+	/// @param[in] location
+	/// @param[in] moonObj - lunar theory (if set)
+	Almanac(const ADateTime& dateObj, const ALocation& location, const AMoon& moonObj);
+
+	/// @brief Destructor
+	virtual ~Almanac();
+
+	/// @brief Positions from a Chebyshev ephemeris where it covers the year
+	/// @param[in] ephemeris - not owned (nullptr - computed)
+	void setEphemeris(const AChebyshev* ephemeris);
+
+	/// @brief Parses an output format: text, csv or json
+	/// @param[in] arg - argument
+	/// @param[out] format
+	/// @return true if parsed
+	static bool parseFormat(const char* arg, AlmanacFormat& format);
+
+	/// @brief Writes the almanac of a year
+	/// @param[in] year - of the local days
+	/// @param[in] format - text, CSV or JSON lines
+	/// @param[in] output - stream to write to
+	/// @return number of days (0 if the year is invalid)
+	int run(const int year, const AlmanacFormat format, FILE* output);
+
+	/// @brief Number of altitudes computed by the last run
+	long samples() const { return m_samples; }
+
+private:
+	/// @brief Writes the buffer if full (or always)
+	void flush(const bool always = false);
+
+	ADateTime m_dateTime;
+	ALocation m_location;
+	AMoon     m_moon;
+
+	const AChebyshev* m_ephemeris;
+
+	long m_samples;
+
+	FILE*       m_output;
+	std::string m_buffer;
+};
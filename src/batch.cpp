@@ -0,0 +1,896 @@
+/// @file
+///
+/// @brief Batch mode class implementation.
+///
+/// @copyright 2019-2020 M.Mashimo and licensors. All Right Reserved.
+///
+/// cMoon is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// any later version.
+///
+/// cMoon is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with cMoon.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "pch.h"
+
+#include <cctype>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#ifdef WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "ADateParser.h"
+#include "batch.hpp"
+
+/// @brief Size of input reads and of output writes
+static constexpr size_t BatchBufferSize{65536};
+
+/// @brief Names of rise/set objects (MoonRiseInfo)
+static const char* s_riseSetNames[NumberOfRiseSetObjects]{"moon", "sun", "twilight"};
+
+/// @brief Text field of a record (not terminated)
+using BatchField = struct structBatchField
+{
+	const char* text;
+	size_t      length;
+};
+
+/// @brief Fields of a record - empty fields use the default settings
+using BatchFields = struct structBatchFields
+{
+	BatchField date;
+	BatchField time;
+	BatchField julian;
+	BatchField latitude;
+	BatchField longitude;
+	BatchField elevation;
+	BatchField computations;
+};
+
+static int readInput(const int fd, char* buffer, const size_t size)
+{
+#ifdef WIN32
+	return _read(fd, buffer, static_cast<unsigned>(size));
+#else
+	ssize_t count;
+	do
+	{
+		count = read(fd, buffer, size);
+	} while ((count < 0) && (errno == EINTR));
+	return static_cast<int>(count);
+#endif
+}
+
+static bool writeOutput(const int fd, std::string& buffer)
+{
+	const char* p = buffer.data();
+	size_t remaining = buffer.size();
+	while (remaining > 0)
+	{
+#ifdef WIN32
+		int count = _write(fd, p, static_cast<unsigned>(remaining));
+#else
+		ssize_t count = write(fd, p, remaining);
+		if ((count < 0) && (errno == EINTR))
+		{
+			continue;
+		}
+#endif
+		if (count <= 0)
+		{
+			return false;
+		}
+		p += count;
+		remaining -= static_cast<size_t>(count);
+	}
+	buffer.clear();
+	return true;
+}
+
+static inline void trim(BatchField& field)
+{
+	while ((field.length > 0) && isspace(static_cast<unsigned char>(*field.text)))
+	{
+		field.text++;
+		field.length--;
+	}
+	while ((field.length > 0) && isspace(static_cast<unsigned char>(field.text[field.length - 1])))
+	{
+		field.length--;
+	}
+	if ((field.length >= 2) && (field.text[0] == '"') && (field.text[field.length - 1] == '"'))
+	{
+		field.text++;
+		field.length -= 2;
+	}
+}
+
+/// @brief Numeric value of a field
+static inline bool parseNumber(const BatchField& field, double& value)
+{
+	return ADateParser::parseDecimal(field.text, field.text + field.length, value);
+}
+
+/// @brief CSV record: date[ time],lat,long,elevation,computations
+/// @return false if the record is a header line (first line only)
+static bool parseCsv(const char* record, const size_t length, const bool firstLine, BatchFields& fields)
+{
+	BatchField* columns[5]{&fields.date, &fields.latitude, &fields.longitude, &fields.elevation, &fields.computations};
+
+	const char* p = record;
+	const char* end = record + length;
+	for (int column = 0; (column < 5) && (p <= end); column++)
+	{
+		const char* comma = static_cast<const char*>(memchr(p, ',', end - p));
+		const char* fieldEnd = (comma != nullptr) ? comma : end;
+
+		*columns[column] = BatchField{p, static_cast<size_t>(fieldEnd - p)};
+		trim(*columns[column]);
+
+		p = fieldEnd + 1;
+	}
+
+	// Header line (e.g. "date,lat,long,elev,ops") - not "JD..." or "MJD..." - later lines are records (errors)
+	ParsedInstant instant;
+	if (firstLine && (fields.date.length > 0) && isalpha(static_cast<unsigned char>(fields.date.text[0]))
+		&& !ADateParser::parse(fields.date.text, fields.date.text + fields.date.length, instant))
+	{
+		return false;
+	}
+
+	return true;
+}
+
+/// @brief Flat JSON object of strings and numbers: {"date":"2020-11-23","lat":42.9,...}
+static const char* parseJson(const char* record, const size_t length, BatchFields& fields)
+{
+	const char* p = record;
+	const char* end = record + length;
+
+	auto skipSpace = [&]()
+	{
+		while ((p < end) && isspace(static_cast<unsigned char>(*p)))
+		{
+			p++;
+		}
+	};
+
+	auto parseString = [&](BatchField& field)
+	{
+		// p at opening quote - escapes are kept as they are
+		const char* start = ++p;
+		while ((p < end) && (*p != '"'))
+		{
+			p += (*p == '\\') ? 2 : 1;
+		}
+		if (p >= end)
+		{
+			return false;
+		}
+		field = BatchField{start, static_cast<size_t>(p - start)};
+		p++;
+		return true;
+	};
+
+	skipSpace();
+	if ((p >= end) || (*p != '{'))
+	{
+		return "record is not a JSON object";
+	}
+	p++;
+
+	skipSpace();
+	if ((p < end) && (*p == '}'))
+	{
+		return nullptr;
+	}
+
+	while (p < end)
+	{
+		BatchField key;
+		skipSpace();
+		if ((p >= end) || (*p != '"') || !parseString(key))
+		{
+			return "invalid JSON key";
+		}
+
+		skipSpace();
+		if ((p >= end) || (*p != ':'))
+		{
+			return "invalid JSON object";
+		}
+		p++;
+		skipSpace();
+
+		BatchField value{p, 0};
+		if ((p < end) && (*p == '"'))
+		{
+			if (!parseString(value))
+			{
+				return "invalid JSON string";
+			}
+		}
+		else
+		{
+			while ((p < end) && (*p != ',') && (*p != '}') && !isspace(static_cast<unsigned char>(*p)))
+			{
+				if ((*p == '{') || (*p == '['))
+				{
+					return "unsupported JSON value";
+				}
+				p++;
+			}
+			value.length = static_cast<size_t>(p - value.text);
+			if ((value.length == 4) && (strncmp(value.text, "null", 4) == 0))
+			{
+				value.length = 0;
+			}
+		}
+
+		auto isKey = [&key](const char* name)
+		{
+			return (strlen(name) == key.length) && (strncmp(key.text, name, key.length) == 0);
+		};
+
+		if (isKey("date"))
+		{
+			fields.date = value;
+		}
+		else if (isKey("time"))
+		{
+			fields.time = value;
+		}
+		else if (isKey("jd"))
+		{
+			fields.julian = value;
+		}
+		else if (isKey("lat"))
+		{
+			fields.latitude = value;
+		}
+		else if (isKey("long") || isKey("lon"))
+		{
+			fields.longitude = value;
+		}
+		else if (isKey("elev"))
+		{
+			fields.elevation = value;
+		}
+		else if (isKey("ops"))
+		{
+			fields.computations = value;
+		}
+
+		skipSpace();
+		if ((p < end) && (*p == ','))
+		{
+			p++;
+			continue;
+		}
+		if ((p < end) && (*p == '}'))
+		{
+			return nullptr;
+		}
+		break;
+	}
+
+	return "invalid JSON object";
+}
+
+static inline void appendText(std::string& buffer, const char* text)
+{
+	buffer.append(text);
+}
+
+static inline void appendNumber(std::string& buffer, const double value, const int precision = 6)
+{
+	char text[40];
+	int length = snprintf(text, sizeof(text), "%.*f", precision, value);
+	buffer.append(text, static_cast<size_t>(length));
+}
+
+/// @brief Appends a Julian date - or a text if there is none (NaN - the Sun does not rise or set)
+static inline void appendJulian(std::string& buffer, const double value, const char* none)
+{
+	if (std::isnan(value))
+	{
+		buffer.append(none);
+		return;
+	}
+	appendNumber(buffer, value);
+}
+
+static inline void appendInteger(std::string& buffer, const long value)
+{
+	char text[24];
+	int length = snprintf(text, sizeof(text), "%ld", value);
+	buffer.append(text, static_cast<size_t>(length));
+}
+
+/// @brief JSON string (error messages and planet names - no escapes needed)
+static inline void appendQuoted(std::string& buffer, const char* text)
+{
+	buffer.push_back('"');
+	buffer.append(text);
+	buffer.push_back('"');
+}
+
+
+Batch::Batch(const ADateTime& dateObj,
+			 const ALocation& location,
+			 const AMoon& moonObj,
+			 const ASun& sunObj,
+			 const APlanets& planets,
+			 const unsigned computations)
+	: m_location(location)
+	, m_moon(moonObj)
+	, m_sun(sunObj)
+	, m_planets(planets)
+	, m_computations(computations)
+	, m_defaultInstant(dateObj.instant())
+	, m_zone(dateObj.zone())
+	, m_cache(nullptr)
+{
+	// Intentionally left blank
+}
+
+Batch::~Batch()
+{
+	// Intentionally left blank
+}
+
+void Batch::setCache(AResultCache* cache)
+{
+	m_cache = cache;
+}
+
+AInstant Batch::defaultInstant() const
+{
+	return m_defaultInstant;
+}
+
+const ALocation& Batch::defaultLocation() const
+{
+	return m_location;
+}
+
+unsigned Batch::defaultComputations() const
+{
+	return m_computations;
+}
+
+bool Batch::parseComputations(const char* text, const size_t length, unsigned& computations)
+{
+	computations = 0;
+	for (size_t i = 0; i < length; i++)
+	{
+		switch (tolower(static_cast<unsigned char>(text[i])))
+		{
+		case 'm':
+			computations |= BatchMoonPhase;
+			break;
+		case 'r':
+			computations |= BatchMoonRise;
+			break;
+		case 's':
+			computations |= BatchSun;
+			break;
+		case 'p':
+			computations |= BatchPlanets;
+			break;
+		case 'n':
+			computations |= BatchNextMoon;
+			break;
+		default:
+			return false;
+		}
+	}
+	return true;
+}
+
+bool Batch::processRecord(const char* record, const size_t length, BatchResult& result)
+{
+	BatchFields fields{};
+
+	// Empty lines and comments
+	size_t start = 0;
+	while ((start < length) && isspace(static_cast<unsigned char>(record[start])))
+	{
+		start++;
+	}
+	if ((start == length) || (record[start] == '#'))
+	{
+		return false;
+	}
+
+	result.computations = 0;
+	result.error = nullptr;
+
+	if (record[start] == '{')
+	{
+		result.error = parseJson(record + start, length - start, fields);
+	}
+	else if (!parseCsv(record + start, length - start, result.line == 1, fields))
+	{
+		return false;
+	}
+
+	if (result.error != nullptr)
+	{
+		return true;
+	}
+
+	// Date/time - parsed in place (a date without time is its midnight, as the command line date)
+	AInstant instant = m_defaultInstant;
+	if (fields.julian.length > 0)
+	{
+		double jd;
+		if (!parseNumber(fields.julian, jd) || (jd == 0.))
+		{
+			result.error = "invalid Julian date";
+			return true;
+		}
+		instant = AInstant::fromJulian(jd);
+	}
+	else if (fields.date.length > 0)
+	{
+		ParsedInstant parsed;
+		if (!ADateParser::parse(fields.date.text, fields.date.text + fields.date.length, parsed))
+		{
+			result.error = "invalid date (YYYY-MM-DD[Thh:mm[:ss]][Z|+hh:mm], JD, MJD or @seconds)";
+			return true;
+		}
+
+		if (fields.time.length > 0)
+		{
+			int64_t timeOfDay;
+			if ((parsed.format != InputFormat::Date)
+				|| !ADateParser::parseTimeOfDay(fields.time.text, fields.time.text + fields.time.length, timeOfDay))
+			{
+				result.error = "invalid time (HH:MM[:SS])";
+				return true;
+			}
+			parsed.ticks += timeOfDay;
+		}
+		instant = AInstant::fromParsed(parsed);
+	}
+
+	ALocation location(m_location);
+	double value;
+	if (fields.latitude.length > 0)
+	{
+		if (!parseNumber(fields.latitude, value) || (fabs(value) > 90.))
+		{
+			result.error = "invalid latitude";
+			return true;
+		}
+		location.setLatitude(value);
+	}
+	if (fields.longitude.length > 0)
+	{
+		if (!parseNumber(fields.longitude, value) || (fabs(value) > 180.))
+		{
+			result.error = "invalid longitude";
+			return true;
+		}
+		location.setLongitude(value);
+	}
+	if (fields.elevation.length > 0)
+	{
+		if (!parseNumber(fields.elevation, value))
+		{
+			result.error = "invalid elevation";
+			return true;
+		}
+		location.setElevation(value);
+	}
+
+	unsigned computations = m_computations;
+	if ((fields.computations.length > 0)
+		&& !parseComputations(fields.computations.text, fields.computations.length, computations))
+	{
+		result.error = "invalid ops (m, r, s, p, n)";
+		return true;
+	}
+
+	compute(instant, location, computations, m_moon, m_planets, result);
+	return true;
+}
+
+void Batch::compute(const AInstant instant, const ALocation& location, const unsigned computations,
+	const AMoon& moon, const APlanets& planets, BatchResult& result) const
+{
+	result.julian = instant.julian();
+	result.latitude = location.latitude();
+	result.longitude = location.longitude();
+
+	if (computations & BatchMoonPhase)
+	{
+		result.nextPhase = (m_cache != nullptr) ? m_cache->computeMoonPhase(moon, instant.midnight(), result.phase)
+			: moon.computeMoonPhase(instant.midnight(), result.phase);
+	}
+
+	if (computations & BatchMoonRise)
+	{
+		if (m_cache != nullptr)
+		{
+			m_cache->computeMoonRise(moon, location, m_zone->localMidnight(instant), result.rise);
+		}
+		else
+		{
+			moon.computeMoonRise(location, m_zone->localMidnight(instant), result.rise);
+		}
+	}
+
+	if (computations & BatchNextMoon)
+	{
+		result.events.clear();
+		if (m_cache != nullptr)
+		{
+			m_cache->computeNextPhases(moon, instant, result.events);
+		}
+		else
+		{
+			moon.computeNextPhases(instant, result.events);
+		}
+	}
+
+	if (computations & BatchSun)
+	{
+		if (m_cache != nullptr)
+		{
+			m_cache->computeSun(m_sun, location, instant, result.sun);
+		}
+		else
+		{
+			m_sun.computeSun(location, instant, result.sun);
+		}
+	}
+
+	if (computations & BatchPlanets)
+	{
+		result.planets.clear();
+		planets.computePlanetPositions(location, instant, result.planets);
+	}
+
+	result.computations = computations;
+	result.error = nullptr;
+}
+
+void Batch::formatCsvHeader(std::string& buffer)
+{
+	appendText(buffer, "line,jd,lat,long,phase_percent,moon_age,next_phase,"
+		"moon_rise,moon_set,moon_above,sun_rise,sun_set,sun_above,twilight_rise,twilight_set,twilight_above,"
+		"sunrise_jd,noon_jd,sunset_jd,next_phases,planets,error\n");
+}
+
+void Batch::formatResult(const BatchResult& result, const BatchFormat format, std::string& buffer)
+{
+	const unsigned computations = (result.error == nullptr) ? result.computations : 0;
+
+	if (format == BatchFormat::Csv)
+	{
+		// Empty fields for computations not done
+		appendInteger(buffer, static_cast<long>(result.line));
+		buffer.push_back(',');
+		if (result.error == nullptr)
+		{
+			appendNumber(buffer, result.julian);
+			buffer.push_back(',');
+			appendNumber(buffer, result.latitude);
+			buffer.push_back(',');
+			appendNumber(buffer, result.longitude);
+		}
+		else
+		{
+			appendText(buffer, ",,");
+		}
+		buffer.push_back(',');
+
+		if (computations & BatchMoonPhase)
+		{
+			appendNumber(buffer, result.phase.phasePercent, 3);
+			buffer.push_back(',');
+			appendNumber(buffer, result.phase.daysFromNew, 4);
+			buffer.push_back(',');
+			appendInteger(buffer, result.nextPhase);
+		}
+		else
+		{
+			appendText(buffer, ",,");
+		}
+		buffer.push_back(',');
+
+		for (int i = 0; i < NumberOfRiseSetObjects; i++)
+		{
+			const RiseSetInfo& info = result.rise[i];
+			if ((computations & BatchMoonRise) && info.rise)
+			{
+				appendNumber(buffer, info.utRise, 4);
+			}
+			buffer.push_back(',');
+			if ((computations & BatchMoonRise) && info.sett)
+			{
+				appendNumber(buffer, info.utSet, 4);
+			}
+			buffer.push_back(',');
+			if (computations & BatchMoonRise)
+			{
+				buffer.push_back(info.above ? '1' : '0');
+			}
+			buffer.push_back(',');
+		}
+
+		if (computations & BatchSun)
+		{
+			appendJulian(buffer, result.sun.Jrise, "");
+			buffer.push_back(',');
+			appendJulian(buffer, result.sun.Jtransit, "");
+			buffer.push_back(',');
+			appendJulian(buffer, result.sun.Jset, "");
+		}
+		else
+		{
+			appendText(buffer, ",,");
+		}
+		buffer.push_back(',');
+
+		// phase:jde;phase:jde...
+		if (computations & BatchNextMoon)
+		{
+			for (size_t i = 0; i < result.events.size(); i++)
+			{
+				if (i > 0)
+				{
+					buffer.push_back(';');
+				}
+				appendInteger(buffer, result.events[i].phase);
+				buffer.push_back(':');
+				appendNumber(buffer, result.events[i].jde);
+			}
+		}
+		buffer.push_back(',');
+
+		// name:ra:dec:dist;...
+		if (computations & BatchPlanets)
+		{
+			for (size_t i = 0; i < result.planets.size(); i++)
+			{
+				const PlanetPosition& position = result.planets[i];
+				if (i > 0)
+				{
+					buffer.push_back(';');
+				}
+				appendText(buffer, position.planetName);
+				buffer.push_back(':');
+				appendNumber(buffer, position.ra);
+				buffer.push_back(':');
+				appendNumber(buffer, position.dec);
+				buffer.push_back(':');
+				appendNumber(buffer, position.dist);
+			}
+		}
+		buffer.push_back(',');
+
+		if (result.error != nullptr)
+		{
+			appendText(buffer, result.error);
+		}
+		buffer.push_back('\n');
+		return;
+	}
+
+	appendText(buffer, "{\"line\":");
+	appendInteger(buffer, static_cast<long>(result.line));
+
+	if (result.error != nullptr)
+	{
+		appendText(buffer, ",\"error\":");
+		appendQuoted(buffer, result.error);
+		appendText(buffer, "}\n");
+		return;
+	}
+
+	appendText(buffer, ",\"jd\":");
+	appendNumber(buffer, result.julian);
+	appendText(buffer, ",\"lat\":");
+	appendNumber(buffer, result.latitude);
+	appendText(buffer, ",\"long\":");
+	appendNumber(buffer, result.longitude);
+
+	if (computations & BatchMoonPhase)
+	{
+		appendText(buffer, ",\"phase\":{\"percent\":");
+		appendNumber(buffer, result.phase.phasePercent, 3);
+		appendText(buffer, ",\"age\":");
+		appendNumber(buffer, result.phase.daysFromNew, 4);
+		appendText(buffer, ",\"next\":");
+		appendInteger(buffer, result.nextPhase);
+		buffer.push_back('}');
+	}
+
+	// Rise/set in hours from local midnight - null if the object does not rise (set) that day, then whether it is
+	// above at local midnight (both null: up all day if above, down all day if not)
+	if (computations & BatchMoonRise)
+	{
+		appendText(buffer, ",\"rise\":{");
+		for (int i = 0; i < NumberOfRiseSetObjects; i++)
+		{
+			const RiseSetInfo& info = result.rise[i];
+			if (i > 0)
+			{
+				buffer.push_back(',');
+			}
+			appendQuoted(buffer, s_riseSetNames[i]);
+			appendText(buffer, ":[");
+			if (info.rise)
+			{
+				appendNumber(buffer, info.utRise, 4);
+			}
+			else
+			{
+				appendText(buffer, "null");
+			}
+			buffer.push_back(',');
+			if (info.sett)
+			{
+				appendNumber(buffer, info.utSet, 4);
+			}
+			else
+			{
+				appendText(buffer, "null");
+			}
+			appendText(buffer, info.above ? ",true]" : ",false]");
+		}
+		buffer.push_back('}');
+	}
+
+	if (computations & BatchSun)
+	{
+		appendText(buffer, ",\"sun\":{\"rise\":");
+		appendJulian(buffer, result.sun.Jrise, "null");
+		appendText(buffer, ",\"noon\":");
+		appendJulian(buffer, result.sun.Jtransit, "null");
+		appendText(buffer, ",\"set\":");
+		appendJulian(buffer, result.sun.Jset, "null");
+		buffer.push_back('}');
+	}
+
+	if (computations & BatchNextMoon)
+	{
+		appendText(buffer, ",\"next\":[");
+		for (size_t i = 0; i < result.events.size(); i++)
+		{
+			if (i > 0)
+			{
+				buffer.push_back(',');
+			}
+			appendText(buffer, "{\"phase\":");
+			appendInteger(buffer, result.events[i].phase);
+			appendText(buffer, ",\"jde\":");
+			appendNumber(buffer, result.events[i].jde);
+			buffer.push_back('}');
+		}
+		buffer.push_back(']');
+	}
+
+	if (computations & BatchPlanets)
+	{
+		appendText(buffer, ",\"planets\":[");
+		for (size_t i = 0; i < result.planets.size(); i++)
+		{
+			const PlanetPosition& position = result.planets[i];
+			if (i > 0)
+			{
+				buffer.push_back(',');
+			}
+			appendText(buffer, "{\"name\":");
+			appendQuoted(buffer, position.planetName);
+			appendText(buffer, ",\"ra\":");
+			appendNumber(buffer, position.ra);
+			appendText(buffer, ",\"dec\":");
+			appendNumber(buffer, position.dec);
+			appendText(buffer, ",\"dist\":");
+			appendNumber(buffer, position.dist);
+			buffer.push_back('}');
+		}
+		buffer.push_back(']');
+	}
+
+	appendText(buffer, "}\n");
+}
+
+size_t Batch::run(const int inputFd, const int outputFd, const BatchFormat format)
+{
+	std::vector<char> input(BatchBufferSize);
+	size_t begin = 0;
+	size_t end = 0;
+
+	std::string output;
+	output.reserve(BatchBufferSize + 4096);
+
+	if (format == BatchFormat::Csv)
+	{
+		formatCsvHeader(output);
+	}
+
+	BatchResult result{};
+	size_t lineNumber = 0;
+	size_t records = 0;
+	bool endOfInput = false;
+
+	while (!endOfInput || (begin < end))
+	{
+		const char* lineStart = input.data() + begin;
+		const char* newLine = static_cast<const char*>(memchr(lineStart, '\n', end - begin));
+
+		if ((newLine == nullptr) && !endOfInput)
+		{
+			// Partial line - move it to the front (or grow for long lines) and read more
+			if (begin > 0)
+			{
+				memmove(input.data(), lineStart, end - begin);
+				end -= begin;
+				begin = 0;
+			}
+			if (end == input.size())
+			{
+				input.resize(input.size() * 2);
+			}
+
+			// Results stream while waiting for more records
+			if (!output.empty() && !writeOutput(outputFd, output))
+			{
+				return records;
+			}
+
+			int count = readInput(inputFd, input.data() + end, input.size() - end);
+			if (count <= 0)
+			{
+				endOfInput = true;
+			}
+			else
+			{
+				end += static_cast<size_t>(count);
+			}
+			continue;
+		}
+
+		size_t length = (newLine != nullptr) ? static_cast<size_t>(newLine - lineStart) : (end - begin);
+		begin += length + ((newLine != nullptr) ? 1 : 0);
+
+		if ((length > 0) && (lineStart[length - 1] == '\r'))
+		{
+			length--;
+		}
+
+		result.line = ++lineNumber;
+		if (processRecord(lineStart, length, result))
+		{
+			formatResult(result, format, output);
+			records++;
+
+			if ((output.size() >= BatchBufferSize) && !writeOutput(outputFd, output))
+			{
+				return records;
+			}
+		}
+	}
+
+	writeOutput(outputFd, output);
+
+	return records;
+}
@@ -0,0 +1,159 @@
+/// @file
+///
+/// @brief Batch mode class definitions.
+///
+/// Batch reads newline-delimited records (CSV or JSON) from an input stream
+/// and writes one result record per input record. Each record has a date/time
+/// or Julian date, an optional location and the computations to run (letters
+/// of the command line options: m, r, s, p, n). Results are buffered and
+/// written whenever the input has no more data ready, so results stream while
+/// records arrive.
+///
+/// CSV:  date[ time],lat,long,elevation,computations  (e.g. 2020-11-23 06:30,42.9,-71.5,300,mr)
+///       Empty fields use the command line settings; a header on the first line is skipped.
+///       Dates are anything ADateParser accepts (ISO-8601 with offset, JD, MJD, @seconds).
+/// JSON: {"date":"2020-11-23","time":"06:30","lat":42.9,"long":-71.5,"elev":300,"ops":"mr"}
+///       or {"jd":2459177.25,...}
+///
+/// @copyright 2019-2020 M.Mashimo and licensors. All Right Reserved.
+///
+/// cMoon is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// any later version.
+///
+/// cMoon is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with cMoon.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "ADateTime.h"
+#include "ALocation.h"
+#include "AMoon.h"
+#include "ASun.h"
+#include "APlanets.h"
+#include "AResultCache.h"
+
+/// @brief Computations of a record (bit fields)
+constexpr unsigned BatchMoonPhase{0x1};   // m
+constexpr unsigned BatchMoonRise{0x2};    // r
+constexpr unsigned BatchSun{0x4};         // s
+constexpr unsigned BatchPlanets{0x8};     // p
+constexpr unsigned BatchNextMoon{0x10};   // n
+constexpr unsigned BatchAll{0x1F};
+
+/// @brief Output format of results
+enum class BatchFormat : int
+{
+	Json,
+	Csv
+};
+
+/// @brief Results of one record
+using BatchResult = struct structBatchResult
+{
+	size_t      line;          // input line number
+	unsigned    computations;  // computations done (0 if the record is invalid)
+	double      julian;        // Julian date of the record
+	double      latitude;
+	double      longitude;
+
+	PhaseInfo   phase;
+	int         nextPhase;
+	MoonRiseInfo rise;
+	SunInfo     sun;
+	std::vector<PhaseEvent> events;
+	std::vector<PlanetPosition> planets;
+
+	const char* error;         // nullptr if valid
+};
+
+class Batch
+{
+public:
+	/// @brief Constructor
+	/// @param[in] dateObj - default date (records without date/time)
+	/// @param[in] location - default location
+	/// @param[in] moonObj - Moon settings (next phases - '-n')
+	/// @param[in] sunObj
+	/// @param[in] planets - planets to compute ('-p')
+	/// @param[in] computations - computations of records without them (bit fields)
+	Batch(const ADateTime& dateObj,
+		  const ALocation& location,
+		  const AMoon& moonObj,
+		  const ASun& sunObj,
+		  const APlanets& planets,
+		  const unsigned computations);
+
+	/// @brief Destructor
+	virtual ~Batch();
+
+	/// @brief Processes records until end of input
+	/// @param[in] inputFd - file descriptor of records (0 = stdin)
+	/// @param[in] outputFd - file descriptor of results (1 = stdout)
+	/// @param[in] format - output format
+	/// @return number of records processed
+	size_t run(const int inputFd, const int outputFd, const BatchFormat format);
+
+	/// @brief Parses computation letters (m, r, s, p, n) into bit fields
+	/// @param[out] computations - bit fields
+	/// @return false if a letter is unknown
+	static bool parseComputations(const char* text, const size_t length, unsigned& computations);
+
+	/// @brief Processes one record (CSV or JSON - without line end)
+	/// @param[in] record - text of the record
+	/// @param[in] length - length of record
+	/// @param[out] result - results (result.error is set if the record is invalid)
+	/// @return false if the record is to be skipped (empty, comment or header)
+	bool processRecord(const char* record, const size_t length, BatchResult& result);
+
+	/// @brief Computes results of a record
+	/// @param[in] instant - date/time of the record
+	/// @param[in] location
+	/// @param[in] computations - computations (bit fields)
+	/// @param[in] moon - Moon settings of the record (next phases)
+	/// @param[in] planets - planets of the record
+	/// @param[out] result - results (julian, latitude, longitude and computations done)
+	void compute(const AInstant instant, const ALocation& location, const unsigned computations,
+		const AMoon& moon, const APlanets& planets, BatchResult& result) const;
+
+	/// @brief Date/time of records without date/time
+	AInstant defaultInstant() const;
+
+	/// @brief Location of records without location
+	const ALocation& defaultLocation() const;
+
+	/// @brief Computations of records without them
+	unsigned defaultComputations() const;
+
+	/// @brief Answers rise/set, sun and phase computations from a cache (nullptr = none)
+	/// @param[in] cache - shared by copies of Batch (thread-safe) - not owned
+	void setCache(AResultCache* cache);
+
+	/// @brief Appends a result record (and a line end) to a buffer
+	static void formatResult(const BatchResult& result, const BatchFormat format, std::string& buffer);
+
+	/// @brief Appends the CSV header line to a buffer
+	static void formatCsvHeader(std::string& buffer);
+
+private:
+	ALocation m_location;
+	AMoon     m_moon;
+	ASun      m_sun;
+	APlanets  m_planets;
+	unsigned  m_computations;
+
+	/// @brief Date/time of records without date/time and time zone of rise/set days (local midnight)
+	AInstant  m_defaultInstant;
+	std::shared_ptr<const ATimeZone> m_zone;
+
+	AResultCache* m_cache;
+};
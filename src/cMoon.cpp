@@ -22,10 +22,13 @@
 
 #include <iostream>
 #include <cstdio>
+#include <cstdlib>
 #include <cstring>
+#include <cctype>
 
 #include <string>
 #include <array>
+#include <memory>
 #include <vector>
 #include <ctime>
 
@@ -37,10 +40,18 @@
 #include "ASun.h"
 #include "ALocation.h"
 #include "APlanets.h"
+#include "AChebyshev.h"
+#include "AJplEphemeris.h"
+#include "APhaseTable.h"
+#include "AVsop87.h"
 
 #include "settings.hpp"
 
 #include "interpreter.hpp"
+#include "batch.hpp"
+#include "range.hpp"
+#include "almanac.hpp"
+#include "server.hpp"
 
 using namespace std;
 
@@ -50,6 +61,50 @@ static bool s_processDate = true;
 
 static bool s_doInteractive = false;
 
+// Batch mode - records from stdin, results to stdout
+static bool s_doBatch = false;
+static BatchFormat s_batchFormat = BatchFormat::Json;
+
+// Range mode - tables from start to end (Julian dates) by step (days)
+static bool s_doRange = false;
+static double s_rangeStart = 0.;
+static double s_rangeEnd = 0.;
+static double s_rangeStep = 0.;
+
+// Almanac mode - rise/set and twilights of each day of a year
+static bool s_doAlmanac = false;
+static int s_almanacYear = 0;
+static AlmanacFormat s_almanacFormat = AlmanacFormat::Text;
+
+// Server mode - requests from a Unix domain socket (workers - 0 = number of CPUs)
+static bool s_doServe = false;
+static const char* s_servePath = nullptr;
+static unsigned s_serveWorkers = 0;
+
+// Result cache of --batch and --serve (file "-" = not saved)
+static const char* s_cachePath = nullptr;
+static size_t s_cacheSize = ResultCacheCapacity;
+static double s_cachePrecision = ResultCachePrecision;
+
+// Chebyshev ephemeris - compiled from START to END (Julian dates) or used by --range
+static const char* s_compileEphemeris = nullptr;
+static double s_compileStart = 0.;
+static double s_compileEnd = 0.;
+static const char* s_ephemerisPath = nullptr;
+
+// JPL ephemeris (DE binary file or SPK kernel) of planet positions
+static const char* s_jplPath = nullptr;
+
+// VSOP87 planet positions - truncation of the terms
+static bool s_vsop87 = false;
+static double s_vsop87Truncation = 0.;
+
+// Moon phase and rise/set from the lunar theory
+static bool s_lunarTheory = false;
+
+// Phase table of next phases (-n, batch and serve) - generated on first use
+static const char* s_phaseTablePath = nullptr;
+
 static bool s_computeSun = false;
 static bool s_computeMoonPhase = false;
 static bool s_computeMoonRise = false;
@@ -67,14 +122,14 @@ static constexpr unsigned planets{0x8};
 // Set all bits
 static constexpr unsigned all{0xF};
 
-static void setDebugLevels(const unsigned setting, const int level)
+static void setDebugLevels(AContext& context, const unsigned setting, const int level)
 {
 	if (setting == all)
 	{
-		ADateTime::m_verboseLevel = level;
-		AMoon::m_verboseLevel = level;
-		ASun::m_verboseLevel = level;
-		APlanets::m_verboseLevel = level;
+		context.dateTimeVerbose = level;
+		context.moonVerbose = level;
+		context.sunVerbose = level;
+		context.planetsVerbose = level;
 		if (level == 0)
 			std::cout << "Resetting All verbose modes to " << level << std::endl;
 		else
@@ -84,29 +139,29 @@ static void setDebugLevels(const unsigned setting, const int level)
 	{
 		if (setting & dateTime)
 		{
-			ADateTime::m_verboseLevel = level;
+			context.dateTimeVerbose = level;
 			std::cout << "Setting DateTime verbose mode to " << level << std::endl;
 		}
 		if (setting & moon)
 		{
-			AMoon::m_verboseLevel = level;
+			context.moonVerbose = level;
 			std::cout << "Setting Moon verbose mode to " << level << std::endl;
 		}
 		if (setting & sun)
 		{
-			ASun::m_verboseLevel = level;
+			context.sunVerbose = level;
 			std::cout << "Setting Sun verbose mode to " << level << std::endl;
 		}
 		if (setting & planets)
 		{
-			APlanets::m_verboseLevel = level;
+			context.planetsVerbose = level;
 			std::cout << "Setting Planets verbose mode to " << level << std::endl;
 		}
 	}
 }
 
 
-void parseVerboseMode(char* arg)
+void parseVerboseMode(char* arg, AContext& context)
 {
 	// It starts out '-v[...]' or '-q' all in one string
 	char* options = arg + 1;
@@ -117,7 +172,7 @@ void parseVerboseMode(char* arg)
 	{
 		if (*options == '\0')
 		{
-			setDebugLevels(all, 0);
+			setDebugLevels(context, all, 0);
 			return;
 		}
 		level = 0;
@@ -156,11 +211,11 @@ void parseVerboseMode(char* arg)
 				// If nothing set, set them all
 				if (setting == 0)
 				{
-					setDebugLevels(all, level);
+					setDebugLevels(context, all, level);
 				}
 				else
 				{
-					setDebugLevels(setting, level);
+					setDebugLevels(context, setting, level);
 
 					// Make sure to clear bit field
 					setting = 0;
@@ -183,7 +238,7 @@ void parseVerboseMode(char* arg)
 				case 't':	// Set date-time verbose mode`
 					if (levelQueued && settingQueued)
 					{
-						setDebugLevels(setting, level);
+						setDebugLevels(context, setting, level);
 						levelQueued = false;
 						level = 0;
 						setting = 0;
@@ -194,7 +249,7 @@ void parseVerboseMode(char* arg)
 				case 'm':
 					if (levelQueued && settingQueued)
 					{
-						setDebugLevels(setting, level);
+						setDebugLevels(context, setting, level);
 						levelQueued = false;
 						level = 0;
 						setting = 0;
@@ -205,7 +260,7 @@ void parseVerboseMode(char* arg)
 				case 's':
 					if (levelQueued && settingQueued)
 					{
-						setDebugLevels(setting, level);
+						setDebugLevels(context, setting, level);
 						levelQueued = false;
 						level = 0;
 						setting = 0;
@@ -216,7 +271,7 @@ void parseVerboseMode(char* arg)
 				case 'p':
 					if (levelQueued && settingQueued)
 					{
-						setDebugLevels(setting, level);
+						setDebugLevels(context, setting, level);
 						levelQueued = false;
 						level = 0;
 						setting = 0;
@@ -252,7 +307,7 @@ void parseVerboseMode(char* arg)
 		}; // end while (options[0] != '\0')
 	}
 
-	setDebugLevels(setting, level);
+	setDebugLevels(context, setting, level);
 }
 
 static constexpr int helpQuiet{-1};
@@ -292,6 +347,22 @@ void printExtraHelp(const char* options)
 		std::cout << "  [--latlong LAT LONG] - sets the latitude and longitude for equations" << std::endl;
 		std::cout << "  [--elev ELEVATION]   - sets the elevation for equations" << std::endl;
 		std::cout << "  [--zone TIMEZONE]    - sets the timezone (float value - decimal not required)" << std::endl;
+		std::cout << "                         or zone name (e.g. America/New_York) or POSIX TZ rule" << std::endl;
+		std::cout << "  [--range START END STEP] - Tables of computations from START to END (yyyy-mm-dd[Thh:mm[:ss]] UTC or JD)" << std::endl;
+		std::cout << "                         every STEP (number with s (default), m, h or d - e.g. 10m)" << std::endl;
+		std::cout << "  [--almanac YEAR [text|csv|json]] - Rise/set of the Sun (center, upper limb), Moon and the three twilights for each day of YEAR" << std::endl;
+		std::cout << "  [--batch [csv|json]] - Reads records (CSV or JSON lines) from stdin, writes results (JSON default) to stdout" << std::endl;
+		std::cout << "                         CSV: date[ time],lat,long,elev,ops - JSON: {\"date\":..,\"jd\":..,\"lat\":..,\"long\":..,\"ops\":\"mrspn\"}" << std::endl;
+		std::cout << "  [--serve PATH]       - Answers requests (e.g. '2020-11-23T06:00Z l42.9,-71.5 mrs') on Unix socket PATH" << std::endl;
+		std::cout << "  [--workers N]        - Worker threads of --serve (default: number of CPUs)" << std::endl;
+		std::cout << "  [--cache FILE]       - Caches rise/set, sun and phase results of --batch/--serve in FILE between runs" << std::endl;
+		std::cout << "                         ('-' = memory only) - [--cache-size N] results of each, [--cache-precision DEG]" << std::endl;
+		std::cout << "  [--compile-ephemeris FILE START END] - Fits Sun, Moon and planet positions (Chebyshev) from START to END into FILE" << std::endl;
+		std::cout << "  [--ephemeris FILE]   - --range samples positions from FILE (see --compile-ephemeris) within its span" << std::endl;
+		std::cout << "  [--jpl FILE]         - Planet positions from JPL ephemeris FILE (DE binary or .bsp) within its span" << std::endl;
+		std::cout << "  [--vsop87 TRUNC]     - Planet positions from VSOP87 - terms below TRUNC (radians/AU, e.g. 1e-6) are skipped, 0 = all" << std::endl;
+		std::cout << "  [--lunar-theory]     - Moon phase (elongation) and rise/set (parallax of the distance) from the lunar theory" << std::endl;
+		std::cout << "  [--phase-table FILE] - Next phases (1600-2400) from table FILE - written on first use" << std::endl;
 		std::cout << "  [--ini <ini_file>]   - Use configuration from <ini_file> (in/from executable directory)" << std::endl;
 		std::cout << "  [--save[=<ini_file>]]- Save current configuration to INI or to <ini_file> (use '=' to set filename from exec-dir)" << std::endl;
 	}
@@ -410,24 +481,82 @@ void print_header(int details)
 
 
 
+/// @brief Computations of --range, --serve requests without commands and --batch records without "ops" -
+/// those of the options (all if none)
+static unsigned optionComputations()
+{
+	unsigned computations = (s_computeMoonPhase ? BatchMoonPhase : 0) | (s_computeMoonRise ? BatchMoonRise : 0)
+		| (s_computeSun ? BatchSun : 0) | (s_computePlanets ? BatchPlanets : 0) | (s_computeNextMoon ? BatchNextMoon : 0);
+
+	return (computations != 0) ? computations : BatchAll;
+}
+
+/// @brief Loads the result cache file (if any)
+static void loadCache(AResultCache& cache)
+{
+	if ((s_cachePath != nullptr) && (strcmp(s_cachePath, "-") != 0))
+	{
+		cache.load(s_cachePath);
+	}
+}
+
+/// @brief Saves the result cache file (if any) and reports the use of the cache (stderr - stdout is results)
+static void saveCache(const AResultCache& cache)
+{
+	if ((s_cachePath != nullptr) && (strcmp(s_cachePath, "-") != 0) && !cache.save(s_cachePath))
+	{
+		std::cerr << "!!! Cannot save cache: '" << s_cachePath << "'" << std::endl;
+	}
+
+	CacheCounters counters = cache.counters();
+	std::cerr << "Cache: " << counters.hits << " hits, " << counters.misses << " misses, " << counters.entries << " results" << std::endl;
+}
+
 int main(int argc, char** argv)
 {
-	ADateTime dateObj;
-	AMoon moonObj;
-	ASun  sunObj;
-	APlanets planets;
+	// Batch results are the only output - option messages and headers (INI file messages too) are suppressed
+	for (int i = 1; i < argc; i++)
+	{
+#ifdef WIN32
+		if (_strnicmp(argv[i], "--batch", 7) == 0)
+#else
+		if (strncasecmp(argv[i], "--batch", 7) == 0)
+#endif
+		{
+			std::cout.setstate(std::ios::failbit);
+		}
+
+		// Almanac written as CSV or JSON too
+		AlmanacFormat format;
+#ifdef WIN32
+		if ((_strnicmp(argv[i], "--almanac", 9) == 0) && ((i + 2) < argc)
+#else
+		if ((strncasecmp(argv[i], "--almanac", 9) == 0) && ((i + 2) < argc)
+#endif
+			&& Almanac::parseFormat(argv[i + 2], format) && (format != AlmanacFormat::Text))
+		{
+			std::cout.setstate(std::ios::failbit);
+		}
+	}
 
 	// Get default INI configuration
 	Settings settings(true);
 
 	ALocation location(settings.getLocation());
 
+	// Time zone, DST and verbose levels - applied to all objects once arguments are parsed
+	AContext context(settings.getContext());
+
+	ADateTime dateObj(context);
+	AMoon moonObj(context);
+	ASun  sunObj(context);
+	APlanets planets(PlanetType::All, context);
+
 	bool bProcess = true;
 
 	if (argc > 1)
 	{
 		// Parse arguments
-		static char s_tmp[1024];
 		bool bGoodDate = true;
 
 		std::string iniFile;
@@ -436,9 +565,8 @@ int main(int argc, char** argv)
 		{
 			char* ar = argv[i];
 			size_t len = strlen(ar);
-			strcpy(s_tmp, ar);
 			bGoodDate = false;
-			char* options = s_tmp;
+			char* options = ar;
 
 			if (len > 0)
 			{
@@ -505,9 +633,19 @@ int main(int argc, char** argv)
 							{
 								if ((i + 2) <= argc)
 								{
-									// Set the latitude
-									ADateTime::m_defaultTimeZone = atof(argv[i + 1]);
-									std::cout << "Setting Timezone: " << ADateTime::m_defaultTimeZone << std::endl;
+									// Hours from UTC, otherwise a zoneinfo name (e.g. America/New_York) or POSIX TZ rule
+									const char* zone = argv[i + 1];
+									if (isdigit(static_cast<unsigned char>(zone[0])) || (((zone[0] == '-') || (zone[0] == '+') || (zone[0] == '.')) && isdigit(static_cast<unsigned char>(zone[1]))))
+									{
+										context.timeZone = atof(zone);
+										std::cout << "Setting Timezone: " << context.timeZone << std::endl;
+									}
+									else
+									{
+										strncpy(context.timeZoneName, zone, sizeof(context.timeZoneName) - 1);
+										context.timeZoneName[sizeof(context.timeZoneName) - 1] = '\0';
+										std::cout << "Setting Timezone: " << context.timeZoneName << std::endl;
+									}
 									i += 1;
 								}
 								else
@@ -533,6 +671,277 @@ int main(int argc, char** argv)
 									std::cout << "Cannot set Eelvation: Argument count " << argc << " is not " << i + 2 << std::endl;
 								}
 							}
+	#ifdef WIN32
+							else if (_strnicmp(options, "range", 5) == 0)
+	#else
+							else if (strncasecmp(options, "range", 5) == 0)
+	#endif
+							{
+								if ((i + 4) <= argc)
+								{
+									if (Range::parseInstant(argv[i + 1], s_rangeStart) && Range::parseInstant(argv[i + 2], s_rangeEnd)
+										&& Range::parseStep(argv[i + 3], s_rangeStep) && (s_rangeEnd >= s_rangeStart))
+									{
+										std::cout << "Setting Range: JD " << std::fixed << s_rangeStart << " to " << s_rangeEnd
+											<< " step " << std::defaultfloat << s_rangeStep << " days" << std::endl;
+										s_doRange = true;
+									}
+									else
+									{
+										std::cout << "Cannot set Range: '" << argv[i + 1] << "' '" << argv[i + 2] << "' '" << argv[i + 3] << "'" << std::endl;
+										bProcess = false;
+									}
+									i += 3;
+								}
+								else
+								{
+									std::cout << "Cannot set Range: Argument count " << argc << " is not " << i + 4 << std::endl;
+									bProcess = false;
+								}
+							}
+	#ifdef WIN32
+							else if (_strnicmp(options, "almanac", 7) == 0)
+	#else
+							else if (strncasecmp(options, "almanac", 7) == 0)
+	#endif
+							{
+								if ((i + 2) <= argc)
+								{
+									s_almanacYear = atoi(argv[i + 1]);
+									if ((s_almanacYear > 0) && (s_almanacYear <= 9999))
+									{
+										s_doAlmanac = true;
+									}
+									else
+									{
+										std::cout << "Cannot set Almanac: year '" << argv[i + 1] << "'" << std::endl;
+										bProcess = false;
+									}
+									i += 1;
+
+									// Optional output format
+									if (((i + 2) <= argc) && Almanac::parseFormat(argv[i + 1], s_almanacFormat))
+									{
+										i += 1;
+									}
+								}
+								else
+								{
+									std::cout << "Cannot set Almanac: Argument count " << argc << " is not " << i + 2 << std::endl;
+									bProcess = false;
+								}
+							}
+	#ifdef WIN32
+							else if (_strnicmp(options, "batch", 5) == 0)
+	#else
+							else if (strncasecmp(options, "batch", 5) == 0)
+	#endif
+							{
+								// Optional output format
+								const char* format = ((i + 2) <= argc) ? argv[i + 1] : "";
+	#ifdef WIN32
+								if ((_stricmp(format, "csv") == 0) || (_stricmp(format, "json") == 0))
+	#else
+								if ((strcasecmp(format, "csv") == 0) || (strcasecmp(format, "json") == 0))
+	#endif
+								{
+									s_batchFormat = (tolower(argv[i + 1][0]) == 'c') ? BatchFormat::Csv : BatchFormat::Json;
+									i += 1;
+								}
+								s_doBatch = true;
+							}
+	#ifdef WIN32
+							else if (_strnicmp(options, "compile-ephemeris", 17) == 0)
+	#else
+							else if (strncasecmp(options, "compile-ephemeris", 17) == 0)
+	#endif
+							{
+								if ((i + 4) <= argc)
+								{
+									if (Range::parseInstant(argv[i + 2], s_compileStart) && Range::parseInstant(argv[i + 3], s_compileEnd)
+										&& (s_compileEnd > s_compileStart))
+									{
+										s_compileEphemeris = argv[i + 1];
+									}
+									else
+									{
+										std::cout << "Cannot compile Ephemeris: '" << argv[i + 2] << "' '" << argv[i + 3] << "'" << std::endl;
+										bProcess = false;
+									}
+									i += 3;
+								}
+								else
+								{
+									std::cout << "Cannot compile Ephemeris: Argument count " << argc << " is not " << i + 4 << std::endl;
+									bProcess = false;
+								}
+							}
+	#ifdef WIN32
+							else if (_strnicmp(options, "ephemeris", 9) == 0)
+	#else
+							else if (strncasecmp(options, "ephemeris", 9) == 0)
+	#endif
+							{
+								if ((i + 2) <= argc)
+								{
+									s_ephemerisPath = argv[i + 1];
+									i += 1;
+								}
+								else
+								{
+									std::cout << "Cannot set Ephemeris: Argument count " << argc << " is not " << i + 2 << std::endl;
+									bProcess = false;
+								}
+							}
+	#ifdef WIN32
+							else if (_strnicmp(options, "jpl", 3) == 0)
+	#else
+							else if (strncasecmp(options, "jpl", 3) == 0)
+	#endif
+							{
+								if ((i + 2) <= argc)
+								{
+									s_jplPath = argv[i + 1];
+									i += 1;
+								}
+								else
+								{
+									std::cout << "Cannot set JPL Ephemeris: Argument count " << argc << " is not " << i + 2 << std::endl;
+									bProcess = false;
+								}
+							}
+	#ifdef WIN32
+							else if (_strnicmp(options, "phase-table", 11) == 0)
+	#else
+							else if (strncasecmp(options, "phase-table", 11) == 0)
+	#endif
+							{
+								if ((i + 2) <= argc)
+								{
+									s_phaseTablePath = argv[i + 1];
+									i += 1;
+								}
+								else
+								{
+									std::cout << "Cannot set Phase table: Argument count " << argc << " is not " << i + 2 << std::endl;
+									bProcess = false;
+								}
+							}
+	#ifdef WIN32
+							else if (_strnicmp(options, "vsop87", 6) == 0)
+	#else
+							else if (strncasecmp(options, "vsop87", 6) == 0)
+	#endif
+							{
+								if ((i + 2) <= argc)
+								{
+									s_vsop87 = true;
+									s_vsop87Truncation = atof(argv[i + 1]);
+									i += 1;
+								}
+								else
+								{
+									std::cout << "Cannot set VSOP87: Argument count " << argc << " is not " << i + 2 << std::endl;
+									bProcess = false;
+								}
+							}
+	#ifdef WIN32
+							else if (_strnicmp(options, "lunar-theory", 12) == 0)
+	#else
+							else if (strncasecmp(options, "lunar-theory", 12) == 0)
+	#endif
+							{
+								s_lunarTheory = true;
+							}
+	#ifdef WIN32
+							else if (_strnicmp(options, "serve", 5) == 0)
+	#else
+							else if (strncasecmp(options, "serve", 5) == 0)
+	#endif
+							{
+								if ((i + 2) <= argc)
+								{
+									s_servePath = argv[i + 1];
+									s_doServe = true;
+									i += 1;
+								}
+								else
+								{
+									std::cout << "Cannot set Serve: Argument count " << argc << " is not " << i + 2 << std::endl;
+									bProcess = false;
+								}
+							}
+	#ifdef WIN32
+							else if (_strnicmp(options, "workers", 7) == 0)
+	#else
+							else if (strncasecmp(options, "workers", 7) == 0)
+	#endif
+							{
+								if ((i + 2) <= argc)
+								{
+									s_serveWorkers = static_cast<unsigned>(atoi(argv[i + 1]));
+									std::cout << "Setting Workers: " << s_serveWorkers << std::endl;
+									i += 1;
+								}
+								else
+								{
+									std::cout << "Cannot set Workers: Argument count " << argc << " is not " << i + 2 << std::endl;
+									bProcess = false;
+								}
+							}
+	#ifdef WIN32
+							else if (_strnicmp(options, "cache-size", 10) == 0)
+	#else
+							else if (strncasecmp(options, "cache-size", 10) == 0)
+	#endif
+							{
+								if ((i + 2) <= argc)
+								{
+									s_cacheSize = static_cast<size_t>(strtoull(argv[i + 1], nullptr, 10));
+									std::cout << "Setting Cache size: " << s_cacheSize << std::endl;
+									i += 1;
+								}
+								else
+								{
+									std::cout << "Cannot set Cache size: Argument count " << argc << " is not " << i + 2 << std::endl;
+									bProcess = false;
+								}
+							}
+	#ifdef WIN32
+							else if (_strnicmp(options, "cache-precision", 15) == 0)
+	#else
+							else if (strncasecmp(options, "cache-precision", 15) == 0)
+	#endif
+							{
+								if ((i + 2) <= argc)
+								{
+									s_cachePrecision = atof(argv[i + 1]);
+									std::cout << "Setting Cache precision: " << s_cachePrecision << " degrees" << std::endl;
+									i += 1;
+								}
+								else
+								{
+									std::cout << "Cannot set Cache precision: Argument count " << argc << " is not " << i + 2 << std::endl;
+									bProcess = false;
+								}
+							}
+	#ifdef WIN32
+							else if (_strnicmp(options, "cache", 5) == 0)
+	#else
+							else if (strncasecmp(options, "cache", 5) == 0)
+	#endif
+							{
+								if ((i + 2) <= argc)
+								{
+									s_cachePath = argv[i + 1];
+									i += 1;
+								}
+								else
+								{
+									std::cout << "Cannot set Cache: Argument count " << argc << " is not " << i + 2 << std::endl;
+									bProcess = false;
+								}
+							}
 	#ifdef WIN32
 							else if (_strnicmp(options, "ini", 3) == 0)
 	#else
@@ -557,8 +966,8 @@ int main(int argc, char** argv)
 									bProcess = settings.setDefaultIniFile(iniFile, true);
 								}
 								settings.save_location_info(location);
-								settings.save_date_time_info();
-								settings.save_debug_info();
+								settings.save_date_time_info(context);
+								settings.save_debug_info(context);
 							}
 							else
 							{
@@ -616,13 +1025,13 @@ int main(int argc, char** argv)
 							case 'Q':
 							case 'q':
 								// Quiets Verbose mode - NOTE '-q' suppresses, except # is referenced later
-								parseVerboseMode(options);
+								parseVerboseMode(options, context);
 								s_HelpType = helpQuiet;
 								break;
 
 							case 'v': // Verbal level (format: '-v#')
 							case 'V':
-								parseVerboseMode(options);
+								parseVerboseMode(options, context);
 								break;
 							}
 						}
@@ -710,9 +1119,159 @@ int main(int argc, char** argv)
 
 	std::cout << std::endl;
 
+	// Apply settings from INI and arguments
+	dateObj.setContext(context);
+	moonObj.setContext(context);
+	sunObj.setContext(context);
+	planets.setContext(context);
+
+	AJplEphemeris jpl;
+	if (bProcess && (s_jplPath != nullptr))
+	{
+		if (jpl.open(s_jplPath))
+		{
+			planets.setEphemeris(&jpl);
+		}
+		else
+		{
+			std::cerr << "!!! Cannot open JPL ephemeris: '" << s_jplPath << "' - planet positions are computed" << std::endl;
+		}
+	}
+
+	std::unique_ptr<AVsop87> vsop87;
+	if (bProcess && s_vsop87)
+	{
+		vsop87.reset(new AVsop87(s_vsop87Truncation));
+		planets.setVsop87(vsop87.get());
+	}
+
+	std::unique_ptr<ALunarTheory> lunarTheory;
+	if (bProcess && s_lunarTheory)
+	{
+		lunarTheory.reset(new ALunarTheory());
+		moonObj.setLunarTheory(lunarTheory.get());
+	}
+
+	APhaseTable phaseTable;
+	if (bProcess && (s_phaseTablePath != nullptr))
+	{
+		if (phaseTable.openOrGenerate(s_phaseTablePath))
+		{
+			moonObj.setPhaseTable(&phaseTable);
+		}
+		else
+		{
+			std::cerr << "!!! Cannot open phase table: '" << s_phaseTablePath << "' - phases are computed" << std::endl;
+		}
+	}
+
 	if (bProcess && dateObj.isParsedCorrectly())
 	{
-		if (s_doInteractive)
+		if (s_compileEphemeris != nullptr)
+		{
+			std::vector<ChebyshevSeries> report;
+			if (!AChebyshev::compile(s_compileEphemeris, s_compileStart, s_compileEnd, report))
+			{
+				std::cout << "!!! Cannot write ephemeris: '" << s_compileEphemeris << "'" << std::endl;
+				return 1;
+			}
+
+			// Errors against the computations fitted
+			printf("Ephemeris '%s' - JD %.1f to %.1f\n", s_compileEphemeris, s_compileStart, s_compileEnd);
+			printf("Body      Segment(d)  Degree  Segments  Max error(\")  Max dist error(AU)\n");
+			for (auto& series : report)
+			{
+				printf("%-8s  %10.1f  %6d  %8llu  %13.6f  %18.3e\n", AChebyshev::bodyName(static_cast<ChebyshevBody>(series.body)),
+					series.segmentDays, series.degree, static_cast<unsigned long long>(series.segments), series.maxError, series.maxDistanceError);
+			}
+		}
+		else if (s_doServe)
+		{
+			location.displayCoordinates();
+			std::cout << std::flush;
+
+			Batch batch(dateObj, location, moonObj, sunObj, planets, optionComputations());
+			AResultCache cache(s_cacheSize, s_cachePrecision);
+			if (s_cachePath != nullptr)
+			{
+				loadCache(cache);
+				batch.setCache(&cache);
+			}
+
+			Server server(batch, moonObj, planets, s_serveWorkers);
+			int error = server.run(s_servePath);
+			if (s_cachePath != nullptr)
+			{
+				saveCache(cache);
+			}
+			if (error != 0)
+			{
+				return 1;
+			}
+		}
+		else if (s_doBatch)
+		{
+			Batch batch(dateObj, location, moonObj, sunObj, planets, optionComputations());
+			AResultCache cache(s_cacheSize, s_cachePrecision);
+			if (s_cachePath != nullptr)
+			{
+				loadCache(cache);
+				batch.setCache(&cache);
+			}
+
+			batch.run(0, 1, s_batchFormat);
+
+			if (s_cachePath != nullptr)
+			{
+				saveCache(cache);
+			}
+		}
+		else if (s_doAlmanac)
+		{
+			if (s_almanacFormat == AlmanacFormat::Text)
+			{
+				location.displayCoordinates();
+				std::cout << std::flush;
+			}
+
+			Almanac almanac(dateObj, location, moonObj);
+
+			AChebyshev ephemeris;
+			if (s_ephemerisPath != nullptr)
+			{
+				if (ephemeris.open(s_ephemerisPath))
+				{
+					almanac.setEphemeris(&ephemeris);
+				}
+				else
+				{
+					std::cerr << "!!! Cannot open ephemeris: '" << s_ephemerisPath << "' - positions are computed" << std::endl;
+				}
+			}
+			almanac.run(s_almanacYear, s_almanacFormat, stdout);
+		}
+		else if (s_doRange)
+		{
+			location.displayCoordinates();
+			std::cout << std::flush;
+
+			Range range(dateObj, location, moonObj, sunObj, planets);
+
+			AChebyshev ephemeris;
+			if (s_ephemerisPath != nullptr)
+			{
+				if (ephemeris.open(s_ephemerisPath))
+				{
+					range.setEphemeris(&ephemeris);
+				}
+				else
+				{
+					std::cerr << "!!! Cannot open ephemeris: '" << s_ephemerisPath << "' - positions are computed" << std::endl;
+				}
+			}
+			range.run(s_rangeStart, s_rangeEnd, s_rangeStep, optionComputations(), stdout);
+		}
+		else if (s_doInteractive)
 		{
 			Interpreter interpret(dateObj, location, moonObj, sunObj, planets);
 
@@ -0,0 +1,422 @@
+/// @file
+///
+/// @brief Range (time-series) mode class implementation.
+///
+/// @copyright 2019-2020 M.Mashimo and licensors. All Right Reserved.
+///
+/// cMoon is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// any later version.
+///
+/// cMoon is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with cMoon.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "pch.h"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "ADateParser.h"
+#include "ASweep.h"
+#include "range.hpp"
+
+/// @brief Output is written in blocks of this size
+static constexpr size_t RangeBufferSize{65536};
+
+/// @brief Planet positions computed at once
+static constexpr size_t RangePlanetBlock{4096};
+
+static const char* s_phaseNames[4]{"New Moon", "Waxing Quarter", "Full Moon", "Waning Quarter"};
+
+/// @brief Appends "YYYY-MM-DD hh:mm:ss" (UTC) of a Julian date
+static void appendDateTime(std::string& buffer, const double jd)
+{
+	// Rounded to the second before splitting into day and time
+	long long seconds = llround((jd + 0.5) * 86400.);
+	long long day = seconds / 86400;
+	long secondOfDay = static_cast<long>(seconds - (day * 86400));
+
+	int year, month, dayOfMonth;
+	AlgBase::convertJulianToDate(static_cast<double>(day), year, month, dayOfMonth);
+
+	char text[40];
+	int length = snprintf(text, sizeof(text), "%04d-%02d-%02d %02ld:%02ld:%02ld", year, month, dayOfMonth,
+		secondOfDay / 3600, (secondOfDay / 60) % 60, secondOfDay % 60);
+	buffer.append(text, static_cast<size_t>(length));
+}
+
+/// @brief Appends hours as " hh:mm" or " --:--"
+static void appendHours(std::string& buffer, const bool valid, const double hours)
+{
+	char text[16];
+	if (!valid)
+	{
+		buffer.append("   --:--");
+		return;
+	}
+
+	long minutes = lround(hours * 60.) % 1440;
+	int length = snprintf(text, sizeof(text), "   %02ld:%02ld", minutes / 60, minutes % 60);
+	buffer.append(text, static_cast<size_t>(length));
+}
+
+/// @brief Appends the wall-clock time of an event in the zone (its offset at the event - DST days)
+/// @param[in] dayStart - local midnight (MJD)
+/// @param[in] hours - hours from local midnight
+static void appendClock(std::string& buffer, const bool valid, const ATimeZone& zone, const double dayStart,
+	const double hours)
+{
+	appendHours(buffer, valid, valid ? zone.clockHours(dayStart + (hours / 24.)) : 0.);
+}
+
+static void appendNumber(std::string& buffer, const char* format, const double value)
+{
+	char text[40];
+	int length = snprintf(text, sizeof(text), format, value);
+	buffer.append(text, static_cast<size_t>(length));
+}
+
+
+Range::Range(const ADateTime& dateObj,
+			 const ALocation& location,
+			 const AMoon& moonObj,
+			 const ASun& sunObj,
+			 const APlanets& planets)
+	: m_dateTime(dateObj)
+	, m_location(location)
+	, m_moon(moonObj)
+	, m_sun(sunObj)
+	, m_planets(planets)
+	, m_ephemeris(nullptr)
+	, m_output(stdout)
+{
+	// Intentionally left blank
+}
+
+Range::~Range()
+{
+	// Intentionally left blank
+}
+
+void Range::setEphemeris(const AChebyshev* ephemeris)
+{
+	m_ephemeris = ephemeris;
+}
+
+bool Range::parseInstant(const char* arg, double& jd)
+{
+	ParsedInstant instant;
+	if (!ADateParser::parse(arg, instant))
+	{
+		return false;
+	}
+
+	jd = ADateParser::julian(instant);
+	return true;
+}
+
+bool Range::parseStep(const char* arg, double& days)
+{
+	char* end;
+	double value = strtod(arg, &end);
+	if ((end == arg) || (value <= 0.))
+	{
+		return false;
+	}
+
+	switch (tolower(static_cast<unsigned char>(*end)))
+	{
+	case '\0':
+	case 's':
+		days = value / 86400.;
+		break;
+	case 'm':
+		days = value / 1440.;
+		break;
+	case 'h':
+		days = value / 24.;
+		break;
+	case 'd':
+		days = value;
+		break;
+	default:
+		return false;
+	}
+
+	return (*end == '\0') || (end[1] == '\0');
+}
+
+void Range::flush(const bool always)
+{
+	if (always || (m_buffer.size() >= RangeBufferSize))
+	{
+		fwrite(m_buffer.data(), 1, m_buffer.size(), m_output);
+		m_buffer.clear();
+	}
+}
+
+size_t Range::run(const double jdStart, const double jdEnd, const double step, const unsigned computations, FILE* output)
+{
+	if ((step <= 0.) || (jdEnd < jdStart) || (((jdEnd - jdStart) / step) >= RangeMaxSteps))
+	{
+		return 0;
+	}
+
+	// Steps from jdStart (not accumulated) - the end is included if on a step
+	size_t steps = static_cast<size_t>(floor(((jdEnd - jdStart) / step) + 1e-9)) + 1;
+
+	m_output = output;
+	m_buffer.reserve(RangeBufferSize + 4096);
+
+	// Printed by std::cout before
+	fflush(m_output);
+
+	if (computations & BatchMoonPhase)
+	{
+		printPhases(jdStart, step, steps);
+	}
+
+	if (computations & (BatchMoonRise | BatchSun))
+	{
+		printRiseSet(jdStart, jdEnd, computations);
+	}
+
+	if (computations & BatchNextMoon)
+	{
+		printNextPhases(jdStart, jdEnd);
+	}
+
+	if (computations & BatchPlanets)
+	{
+		printPlanets(jdStart, step, steps);
+	}
+
+	flush(true);
+	fflush(m_output);
+
+	return steps;
+}
+
+void Range::printPhases(const double jdStart, const double step, const size_t steps)
+{
+	m_buffer.append("\n-----------------Moon-Phase----------------------\n");
+	m_buffer.append("JD                UTC                  Percent   Age(d)  Next\n");
+
+	PhaseInfo phase;
+	for (size_t i = 0; i < steps; i++)
+	{
+		double jd = jdStart + (i * step);
+		int nextPhase = m_moon.computeMoonPhase(jd, phase);
+
+		appendNumber(m_buffer, "%.6f  ", jd);
+		appendDateTime(m_buffer, jd);
+		appendNumber(m_buffer, "  %7.3f", phase.phasePercent);
+		appendNumber(m_buffer, "  %7.4f  ", phase.daysFromNew);
+		m_buffer.append(s_phaseNames[nextPhase & 3]);
+		m_buffer.push_back('\n');
+
+		flush();
+	}
+}
+
+void Range::printRiseSet(const double jdStart, const double jdEnd, const unsigned computations)
+{
+	// Days (UTC dates) of the range - same as giving each date on the command line
+	long firstDay = static_cast<long>(floor(jdStart + 0.5));
+	long lastDay = static_cast<long>(floor(jdEnd + 0.5));
+	int days = static_cast<int>(lastDay - firstDay + 1);
+
+	// Midnight (UTC) and "YYYY-MM-DD" of each day
+	std::vector<AInstant> dates(days);
+	std::vector<std::array<char, 12>> dateText(days);
+	for (int d = 0; d < days; d++)
+	{
+		int year, month, day;
+		AlgBase::convertJulianToDate(static_cast<double>(firstDay + d), year, month, day);
+
+		dates[d] = AInstant::fromDate(year, month, day);
+		snprintf(dateText[d].data(), dateText[d].size(), "%04d-%02d-%02d", year, month, day);
+	}
+
+	if (computations & BatchMoonRise)
+	{
+		// One sweep for all days (from the first local midnight) - first rise and set of each day
+		std::vector<RiseSetInfo> info;
+
+		ASweep sweep(m_location);
+		sweep.setEphemeris(m_ephemeris);
+		sweep.setLunarTheory(m_moon.lunarTheory());
+		// Local midnights of the dates in the zone (DST days are 23 or 25 hours)
+		std::vector<double> dayStarts(days + 1);
+		for (int d = 0; d <= days; d++)
+		{
+			int year, month, day;
+			AlgBase::convertJulianToDate(static_cast<double>(firstDay + d), year, month, day);
+			dayStarts[d] = m_dateTime.zone()->localMidnight(year, month, day).modifiedJulian();
+		}
+		sweep.riseSetDays(dayStarts, info);
+
+		m_buffer.append("\n------Moon-Sun-Rise/Set (local time)---------------------\n");
+		m_buffer.append("Date        Moon-rise   Moon-set   Sun-rise    Sun-set  Naut-rise   Naut-set\n");
+		for (int d = 0; d < days; d++)
+		{
+			m_buffer.append(dateText[d].data());
+			for (int h = 0; h < NumberOfRiseSetObjects; h++)
+			{
+				const RiseSetInfo& riseSet = info[(d * NumberOfRiseSetObjects) + h];
+				appendClock(m_buffer, riseSet.rise, *m_dateTime.zone(), dayStarts[d], riseSet.utRise);
+				appendClock(m_buffer, riseSet.sett, *m_dateTime.zone(), dayStarts[d], riseSet.utSet);
+			}
+			m_buffer.push_back('\n');
+
+			flush();
+		}
+	}
+
+	if (computations & BatchSun)
+	{
+		m_buffer.append("\n-----------------Sunrise-Sunset (UTC)------------\n");
+		m_buffer.append("Date        Sunrise    Solar-noon  Sunset     Declination\n");
+
+		SunInfo info;
+		for (int d = 0; d < days; d++)
+		{
+			m_sun.computeSun(m_location, dates[d], info);
+
+			m_buffer.append(dateText[d].data());
+			appendHours(m_buffer, true, (info.Jrise - floor(info.Jrise)) * 24.);
+			appendHours(m_buffer, true, (info.Jtransit - floor(info.Jtransit)) * 24.);
+			appendHours(m_buffer, true, (info.Jset - floor(info.Jset)) * 24.);
+			appendNumber(m_buffer, "   %9.4f\n", info.declination);
+
+			flush();
+		}
+	}
+}
+
+void Range::printNextPhases(const double jdStart, const double jdEnd)
+{
+	std::vector<PhaseEvent> events;
+	m_moon.computePhasesInRange(jdStart, jdEnd, events);
+
+	m_buffer.append("\n-----------------Moon-Phases---------------------\n");
+	m_buffer.append("Phase           JDE               UTC\n");
+
+	for (auto& event : events)
+	{
+		char text[24];
+		snprintf(text, sizeof(text), "%-16s", s_phaseNames[event.phase & 3]);
+		m_buffer.append(text);
+		appendNumber(m_buffer, "%.6f  ", event.jde);
+		appendDateTime(m_buffer, event.jde);
+		m_buffer.push_back('\n');
+
+		flush();
+	}
+}
+
+bool Range::fittedPlanets(const double* j2000, const size_t count, const unsigned mask, PlanetBatch& batch) const
+{
+	if ((m_ephemeris == nullptr) || (count == 0))
+	{
+		return false;
+	}
+
+	// Steps are in time order - the first and the last are enough
+	for (int p = 0; p < NumberOfPlanets; p++)
+	{
+		if ((mask & planetMask(p) & AllPlanetsMask)
+			&& (!m_ephemeris->covers(AChebyshev::planetBody(p), j2000[0]) || !m_ephemeris->covers(AChebyshev::planetBody(p), j2000[count - 1])))
+		{
+			return false;
+		}
+	}
+
+	batch.count = count;
+	batch.mask = mask & AllPlanetsMask;
+	for (int p = 0; p < NumberOfPlanets; p++)
+	{
+		if (!(batch.mask & planetMask(p)))
+		{
+			batch.ra[p].clear();
+			batch.dec[p].clear();
+			batch.dist[p].clear();
+			continue;
+		}
+
+		batch.ra[p].resize(count);
+		batch.dec[p].resize(count);
+		batch.dist[p].resize(count);
+		for (size_t i = 0; i < count; i++)
+		{
+			m_ephemeris->position(AChebyshev::planetBody(p), j2000[i], batch.ra[p][i], batch.dec[p][i], batch.dist[p][i]);
+		}
+	}
+
+	return true;
+}
+
+void Range::printPlanets(const double jdStart, const double step, const size_t steps)
+{
+	unsigned mask = m_planets.selectedPlanets();
+
+	m_buffer.append("\n-----------------Planets (RA hours, DEC degrees)-\n");
+	m_buffer.append("JD                UTC                ");
+	for (int p = 0; p < NumberOfPlanets; p++)
+	{
+		if (mask & planetMask(p))
+		{
+			char text[40];
+			snprintf(text, sizeof(text), "  %-8s RA     DEC", APlanets::planetDescriptor(p).planetName);
+			m_buffer.append(text);
+		}
+	}
+	m_buffer.push_back('\n');
+
+	// Earth (view) position is computed once per step for all planets
+	std::vector<double> j2000(std::min(steps, RangePlanetBlock));
+	PlanetBatch batch;
+
+	for (size_t first = 0; first < steps; first += RangePlanetBlock)
+	{
+		size_t count = std::min(steps - first, RangePlanetBlock);
+		for (size_t i = 0; i < count; i++)
+		{
+			j2000[i] = (jdStart + ((first + i) * step)) - 2451545.;
+		}
+
+		if (!fittedPlanets(j2000.data(), count, mask, batch))
+		{
+			m_planets.computePlanetBatch(j2000.data(), count, mask, batch);
+		}
+
+		for (size_t i = 0; i < count; i++)
+		{
+			double jd = jdStart + ((first + i) * step);
+			appendNumber(m_buffer, "%.6f  ", jd);
+			appendDateTime(m_buffer, jd);
+			for (int p = 0; p < NumberOfPlanets; p++)
+			{
+				if (batch.mask & planetMask(p))
+				{
+					appendNumber(m_buffer, "  %9.5f", batch.ra[p][i]);
+					appendNumber(m_buffer, " %9.4f", batch.dec[p][i]);
+				}
+			}
+			m_buffer.push_back('\n');
+
+			flush();
+		}
+	}
+}
@@ -0,0 +1,111 @@
+/// @file
+///
+/// @brief Range (time-series) mode class definitions.
+///
+/// Range computes the enabled computations for each step of a span of time
+/// and prints a table per computation:
+///  - Moon phase and planet positions for every step,
+///  - Moon/Sun/twilight rise-set and sunrise/noon/sunset once per day of the span,
+///  - principal Moon phases within the span.
+/// Planet positions of all steps are computed in blocks (APlanets::computePlanetBatch)
+/// and rise/set times of all days with one sweep (ASweep).
+///
+/// @copyright 2019-2020 M.Mashimo and licensors. All Right Reserved.
+///
+/// cMoon is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// any later version.
+///
+/// cMoon is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with cMoon.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <cstdio>
+#include <string>
+
+#include "AChebyshev.h"
+#include "ADateTime.h"
+#include "ALocation.h"
+#include "AMoon.h"
+#include "ASun.h"
+#include "APlanets.h"
+#include "batch.hpp"
+
+/// @brief Largest number of steps of a range
+constexpr double RangeMaxSteps{1e8};
+
+class Range
+{
+public:
+	/// @brief Constructor
+	/// @param[in] dateObj - time zone of rise/set days
+	/// @param[in] location
+	/// @param[in] moonObj
+	/// @param[in] sunObj
+	/// @param[in] planets - planets to compute ('-p')
+	Range(const ADateTime& dateObj,
+		  const ALocation& location,
+		  const AMoon& moonObj,
+		  const ASun& sunObj,
+		  const APlanets& planets);
+
+	/// @brief Destructor
+	virtual ~Range();
+
+	/// @brief Parses a start or end of a range: YYYY-MM-DD[Thh:mm[:ss]][Z|+hh:mm] (UTC if no offset),
+	/// Julian date, MJD or Unix seconds (see ADateParser)
+	/// @param[in] arg - argument
+	/// @param[out] jd - Julian date
+	/// @return true if parsed
+	static bool parseInstant(const char* arg, double& jd);
+
+	/// @brief Parses a step: number with unit s (default), m, h or d - e.g. "600", "10m", "1d"
+	/// @param[in] arg - argument
+	/// @param[out] days - step in days
+	/// @return true if parsed (step is positive)
+	static bool parseStep(const char* arg, double& days);
+
+	/// @brief Rise/set sweep and planet positions from a Chebyshev ephemeris where it covers the range
+	/// @param[in] ephemeris - not owned (nullptr - computed)
+	void setEphemeris(const AChebyshev* ephemeris);
+
+	/// @brief Prints tables of computations for each step from jdStart to jdEnd (inclusive)
+	/// @param[in] jdStart - Julian date of the first step
+	/// @param[in] jdEnd - Julian date of the last step
+	/// @param[in] step - step in days
+	/// @param[in] computations - computations (Batch* bit fields)
+	/// @param[in] output - stream to print to
+	/// @return number of steps (0 if the range is invalid)
+	size_t run(const double jdStart, const double jdEnd, const double step, const unsigned computations, FILE* output);
+
+private:
+	/// @brief Tables
+	void printPhases(const double jdStart, const double step, const size_t steps);
+	void printRiseSet(const double jdStart, const double jdEnd, const unsigned computations);
+	void printNextPhases(const double jdStart, const double jdEnd);
+	void printPlanets(const double jdStart, const double step, const size_t steps);
+
+	/// @brief Planet positions from the ephemeris - false if it does not cover the planets and steps
+	bool fittedPlanets(const double* j2000, const size_t count, const unsigned mask, PlanetBatch& batch) const;
+
+	/// @brief Writes the buffer if full (or always)
+	void flush(const bool always = false);
+
+	ADateTime m_dateTime;
+	ALocation m_location;
+	AMoon     m_moon;
+	ASun      m_sun;
+	APlanets  m_planets;
+
+	const AChebyshev* m_ephemeris;
+
+	FILE*       m_output;
+	std::string m_buffer;
+};
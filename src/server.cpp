@@ -0,0 +1,621 @@
+/// @file
+///
+/// @brief Server (query daemon) mode class implementation.
+///
+/// @copyright 2019-2020 M.Mashimo and licensors. All Right Reserved.
+///
+/// This file is part of cMoon application.
+///
+/// cMoon is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// any later version.
+///
+/// cMoon is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with cMoon.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "pch.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cmath>
+#include <csignal>
+#include <cstring>
+#include <iostream>
+
+#ifndef WIN32
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+#include "ADateParser.h"
+#include "server.hpp"
+
+/// @brief Size of socket reads
+static constexpr size_t ServerReadSize{65536};
+
+/// @brief Seconds a worker waits for a client to take a response
+static constexpr int ServerSendTimeout{5};
+
+/// @brief Set by SIGINT/SIGTERM - the handler writes to the wake pipe
+static volatile sig_atomic_t s_signaled = 0;
+static int s_signalFd = -1;
+
+static void onSignal(int)
+{
+	s_signaled = 1;
+	if (s_signalFd >= 0)
+	{
+		char c = 's';
+		ssize_t count = write(s_signalFd, &c, 1);
+		(void)count;
+	}
+}
+
+static inline bool isBlank(const char c)
+{
+	return (c == ' ') || (c == '\t') || (c == '\r');
+}
+
+/// @brief Case insensitive prefix followed by a digit (JD, MJD)
+static inline bool isJulianToken(const char* token, const size_t length)
+{
+	size_t prefix = ((length > 3) && (tolower(token[0]) == 'm')) ? 1 : 0;
+	return (length > (prefix + 2)) && (tolower(token[prefix]) == 'j') && (tolower(token[prefix + 1]) == 'd')
+		&& (isdigit(static_cast<unsigned char>(token[prefix + 2])) || (token[prefix + 2] == '.'));
+}
+
+/// @brief Location "LAT,LONG[,ELEV]"
+static bool parseLocation(const char* text, const char* end, ALocation& location)
+{
+	double values[3]{location.latitude(), location.longitude(), location.elevation()};
+	int count = 0;
+	for (const char* p = text; (p <= end) && (count < 3); count++)
+	{
+		const char* comma = static_cast<const char*>(memchr(p, ',', end - p));
+		const char* valueEnd = (comma != nullptr) ? comma : end;
+		if (!ADateParser::parseDecimal(p, valueEnd, values[count]))
+		{
+			return false;
+		}
+		p = valueEnd + 1;
+		if (comma == nullptr)
+		{
+			count++;
+			break;
+		}
+	}
+
+	if ((count < 2) || (fabs(values[0]) > 90.) || (fabs(values[1]) > 180.))
+	{
+		return false;
+	}
+
+	location.setLatitude(values[0]);
+	location.setLongitude(values[1]);
+	location.setElevation(values[2]);
+	return true;
+}
+
+
+Server::Server(const Batch& batch, const AMoon& moonObj, const APlanets& planets, const unsigned workers)
+	: m_batch(batch)
+	, m_moon(moonObj)
+	, m_planets(planets)
+	, m_workers((workers > 0) ? workers : std::max(1u, std::thread::hardware_concurrency()))
+	, m_stop(false)
+	, m_wakeFds{-1, -1}
+{
+	// Intentionally left blank
+}
+
+Server::~Server()
+{
+	// Intentionally left blank
+}
+
+bool Server::processRequest(const char* request, const size_t length, const size_t number,
+	const Batch& batch, BatchResult& result, std::string& response) const
+{
+	AInstant instant = batch.defaultInstant();
+	ALocation location(batch.defaultLocation());
+	InputFormat dateFormat = InputFormat::Invalid;
+	unsigned computations = 0;
+	bool quit = false;
+
+	// Options of 'n' and 'p' (the settings if none)
+	const char* moonOptions = nullptr;
+	size_t moonOptionsLength = 0;
+	const char* planetOptions = nullptr;
+	size_t planetOptionsLength = 0;
+
+	result.line = number;
+	result.computations = 0;
+	result.error = nullptr;
+
+	const char* p = request;
+	const char* end = request + length;
+	while (result.error == nullptr)
+	{
+		while ((p < end) && isBlank(*p))
+		{
+			p++;
+		}
+		if (p == end)
+		{
+			break;
+		}
+
+		const char* token = p;
+		while ((p < end) && !isBlank(*p))
+		{
+			p++;
+		}
+		size_t tokenLength = static_cast<size_t>(p - token);
+
+		if (isdigit(static_cast<unsigned char>(*token)) || (*token == '@') || isJulianToken(token, tokenLength))
+		{
+			int64_t timeOfDay;
+			if ((dateFormat == InputFormat::Date) && (memchr(token, '-', tokenLength) == nullptr)
+				&& ADateParser::parseTimeOfDay(token, p, timeOfDay))
+			{
+				// Time after a date: "2020-11-23 06:30"
+				instant += timeOfDay;
+				dateFormat = InputFormat::DateTime;
+				continue;
+			}
+
+			ParsedInstant parsed;
+			if (!ADateParser::parse(token, p, parsed))
+			{
+				result.error = "invalid date/time (YYYY-MM-DD[Thh:mm[:ss]][Z|+hh:mm], JD, MJD or @seconds)";
+				break;
+			}
+			instant = AInstant::fromParsed(parsed);
+			dateFormat = parsed.format;
+			continue;
+		}
+
+		if ((*token == 'l') || (*token == 'L'))
+		{
+			if (!parseLocation(token + 1, p, location))
+			{
+				result.error = "invalid location (lLAT,LONG[,ELEV])";
+			}
+			continue;
+		}
+
+		// Computation letters ("mrs") - 'n' and 'p' take the rest of the token as options
+		const char* command = token;
+		while ((command < p) && (result.error == nullptr))
+		{
+			switch (*command++)
+			{
+			case 'm':
+			case 'M':
+				computations |= BatchMoonPhase;
+				break;
+			case 'n':
+			case 'N':
+				computations |= BatchNextMoon;
+				if (command < p)
+				{
+					moonOptions = command;
+					moonOptionsLength = static_cast<size_t>(p - command);
+					command = p;
+				}
+				break;
+			case 'p':
+			case 'P':
+				computations |= BatchPlanets;
+				if (command < p)
+				{
+					planetOptions = command;
+					planetOptionsLength = static_cast<size_t>(p - command);
+					command = p;
+				}
+				break;
+			case 'r':
+			case 'R':
+				computations |= BatchMoonRise;
+				break;
+			case 's':
+			case 'S':
+				computations |= BatchSun;
+				break;
+			case 'q':
+			case 'Q':
+				quit = true;
+				break;
+			default:
+				result.error = "unknown command (m, n, p, r, s, q, lLAT,LONG or date/time)";
+				break;
+			}
+		}
+	}
+
+	// 'q' alone is not answered
+	if (quit && (computations == 0) && (result.error == nullptr))
+	{
+		return false;
+	}
+
+	if (result.error == nullptr)
+	{
+		if (computations == 0)
+		{
+			computations = batch.defaultComputations();
+		}
+
+		if ((moonOptions == nullptr) && (planetOptions == nullptr))
+		{
+			batch.compute(instant, location, computations, m_moon, m_planets, result);
+		}
+		else
+		{
+			// Settings of this request only
+			AMoon moon(m_moon);
+			APlanets planets(m_planets);
+			if (moonOptions != nullptr)
+			{
+				// Options as '-n' (at most 31 characters)
+				char options[32]{};
+				memcpy(options, moonOptions, std::min(moonOptionsLength, sizeof(options) - 1));
+				moon.parseNextPhase(options);
+			}
+			if (planetOptions != nullptr)
+			{
+				planets.parseArgs(std::string(planetOptions, planetOptionsLength));
+			}
+			batch.compute(instant, location, computations, moon, planets, result);
+		}
+	}
+
+	Batch::formatResult(result, BatchFormat::Json, response);
+	return !quit;
+}
+
+#ifdef WIN32
+
+int Server::run(const char* path)
+{
+	std::cerr << "!!! --serve is not supported on this platform" << std::endl;
+	return ENOTSUP;
+}
+
+void Server::work()
+{
+	// Intentionally left blank
+}
+
+void Server::wake()
+{
+	// Intentionally left blank
+}
+
+#else
+
+void Server::wake()
+{
+	char c = 'w';
+	ssize_t count = write(m_wakeFds[1], &c, 1);
+	(void)count;
+}
+
+void Server::work()
+{
+	// Engines of this worker - nothing is shared between workers
+	Batch batch(m_batch);
+	BatchResult result{};
+	std::string lines;
+	std::string response;
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+	for (;;)
+	{
+		m_ready.wait(lock, [this]() { return m_stop || !m_queue.empty(); });
+		if (m_queue.empty())
+		{
+			return;
+		}
+
+		std::shared_ptr<ServerConnection> connection = m_queue.front();
+		m_queue.pop_front();
+
+		lines.clear();
+		lines.swap(connection->pending);
+		bool throttled = (lines.size() >= ServerMaxPending);
+		bool tooLong = connection->tooLong;
+		connection->tooLong = false;
+		lock.unlock();
+
+		// Requests in order - one worker at a time per connection
+		bool open = true;
+		response.clear();
+		const char* p = lines.data();
+		const char* end = p + lines.size();
+		while (open && (p < end))
+		{
+			const char* newline = static_cast<const char*>(memchr(p, '\n', end - p));
+			open = processRequest(p, newline - p, ++connection->requests, batch, result, response);
+			p = newline + 1;
+		}
+
+		if (open && tooLong)
+		{
+			// Answered after the requests before it - the connection is closed
+			result.line = ++connection->requests;
+			result.computations = 0;
+			result.error = "request too long";
+			Batch::formatResult(result, BatchFormat::Json, response);
+			open = false;
+		}
+
+		const char* out = response.data();
+		size_t remaining = response.size();
+		while (remaining > 0)
+		{
+			ssize_t count = send(connection->fd, out, remaining, MSG_NOSIGNAL);
+			if (count < 0)
+			{
+				if (errno == EINTR)
+				{
+					continue;
+				}
+				open = false;
+				break;
+			}
+			out += count;
+			remaining -= static_cast<size_t>(count);
+		}
+
+		lock.lock();
+		if (!open)
+		{
+			connection->closed = true;
+			connection->pending.clear();
+		}
+
+		if (!connection->pending.empty() || connection->tooLong)
+		{
+			m_queue.push_back(connection);
+		}
+		else
+		{
+			connection->busy = false;
+			if (connection->closed || throttled)
+			{
+				wake();
+			}
+		}
+	}
+}
+
+int Server::run(const char* path)
+{
+	sockaddr_un address{};
+	address.sun_family = AF_UNIX;
+	if (strlen(path) >= sizeof(address.sun_path))
+	{
+		std::cerr << "!!! Socket path is too long: '" << path << "'" << std::endl;
+		return ENAMETOOLONG;
+	}
+	strncpy(address.sun_path, path, sizeof(address.sun_path) - 1);
+
+	int listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (listenFd < 0)
+	{
+		return errno;
+	}
+
+	// Replace a stale socket (not a file, not a running server)
+	struct stat status;
+	if (lstat(path, &status) == 0)
+	{
+		if (!S_ISSOCK(status.st_mode) || (connect(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0))
+		{
+			std::cerr << "!!! Cannot serve on '" << path << "': " << (S_ISSOCK(status.st_mode) ? "server is running" : "not a socket") << std::endl;
+			close(listenFd);
+			return EADDRINUSE;
+		}
+		unlink(path);
+	}
+
+	if ((bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) || (listen(listenFd, SOMAXCONN) < 0)
+		|| (pipe(m_wakeFds) < 0))
+	{
+		int error = errno;
+		std::cerr << "!!! Cannot serve on '" << path << "': " << strerror(error) << std::endl;
+		close(listenFd);
+		return error;
+	}
+	fcntl(listenFd, F_SETFL, fcntl(listenFd, F_GETFL) | O_NONBLOCK);
+	fcntl(m_wakeFds[0], F_SETFL, fcntl(m_wakeFds[0], F_GETFL) | O_NONBLOCK);
+	fcntl(m_wakeFds[1], F_SETFL, fcntl(m_wakeFds[1], F_GETFL) | O_NONBLOCK);
+
+	s_signaled = 0;
+	s_signalFd = m_wakeFds[1];
+	signal(SIGINT, onSignal);
+	signal(SIGTERM, onSignal);
+	signal(SIGPIPE, SIG_IGN);
+
+	std::cerr << "Serving on '" << path << "' with " << m_workers << " workers" << std::endl;
+
+	m_stop = false;
+	for (unsigned i = 0; i < m_workers; i++)
+	{
+		m_threads.emplace_back(&Server::work, this);
+	}
+
+	// I/O thread - accepts connections and reads requests
+	std::vector<std::shared_ptr<ServerConnection>> connections;
+	std::vector<std::shared_ptr<ServerConnection>> polled;
+	std::vector<pollfd> fds;
+	std::vector<char> buffer(ServerReadSize);
+
+	while (!s_signaled)
+	{
+		fds.clear();
+		polled.clear();
+		fds.push_back(pollfd{listenFd, POLLIN, 0});
+		fds.push_back(pollfd{m_wakeFds[0], POLLIN, 0});
+		{
+			std::lock_guard<std::mutex> guard(m_mutex);
+
+			// Close connections that are done
+			auto done = std::remove_if(connections.begin(), connections.end(), [](const std::shared_ptr<ServerConnection>& connection)
+			{
+				if (connection->closed && !connection->busy)
+				{
+					close(connection->fd);
+					return true;
+				}
+				return false;
+			});
+			connections.erase(done, connections.end());
+
+			// Only connections read from - a hang-up (POLLHUP) is reported even without POLLIN
+			// and would wake this thread until the worker is done
+			for (auto& connection : connections)
+			{
+				if (!connection->closed && (connection->pending.size() < ServerMaxPending))
+				{
+					fds.push_back(pollfd{connection->fd, POLLIN, 0});
+					polled.push_back(connection);
+				}
+			}
+		}
+
+		if (poll(fds.data(), fds.size(), -1) < 0)
+		{
+			if (errno == EINTR)
+			{
+				continue;
+			}
+			break;
+		}
+
+		if (fds[1].revents & POLLIN)
+		{
+			while (read(m_wakeFds[0], buffer.data(), buffer.size()) > 0)
+			{
+				// Drained
+			}
+		}
+
+		for (size_t i = 0; i < polled.size(); i++)
+		{
+			short events = fds[i + 2].revents;
+			if (events == 0)
+			{
+				continue;
+			}
+
+			std::shared_ptr<ServerConnection>& connection = polled[i];
+			ssize_t count = read(connection->fd, buffer.data(), buffer.size());
+			if ((count < 0) && (errno == EINTR))
+			{
+				continue;
+			}
+
+			std::lock_guard<std::mutex> guard(m_mutex);
+			if (count <= 0)
+			{
+				// End of input - pending requests (and a last one without line end) are still answered
+				connection->closed = true;
+				if (connection->input.empty())
+				{
+					continue;
+				}
+				connection->pending.append(connection->input).push_back('\n');
+				connection->input.clear();
+			}
+			else
+			{
+				connection->input.append(buffer.data(), static_cast<size_t>(count));
+				size_t last = connection->input.rfind('\n');
+				if (last == std::string::npos)
+				{
+					if (connection->input.size() <= ServerMaxRequest)
+					{
+						continue;
+					}
+
+					// No line end within ServerMaxRequest - answered with an error and closed
+					connection->input.clear();
+					connection->closed = true;
+					connection->tooLong = true;
+				}
+				else
+				{
+					connection->pending.append(connection->input, 0, last + 1);
+					connection->input.erase(0, last + 1);
+				}
+			}
+
+			if (!connection->busy)
+			{
+				connection->busy = true;
+				m_queue.push_back(connection);
+				m_ready.notify_one();
+			}
+		}
+
+		if (fds[0].revents & POLLIN)
+		{
+			int fd;
+			while ((fd = accept(listenFd, nullptr, nullptr)) >= 0)
+			{
+				// Blocking - workers write whole responses (with a time limit)
+				fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) & ~O_NONBLOCK);
+				timeval timeout{ServerSendTimeout, 0};
+				setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+				std::shared_ptr<ServerConnection> connection(new ServerConnection{fd, std::string(), std::string(), 0, false, false, false});
+				std::lock_guard<std::mutex> guard(m_mutex);
+				connections.push_back(connection);
+			}
+		}
+	}
+
+	// Stop workers after the requests queued
+	{
+		std::lock_guard<std::mutex> guard(m_mutex);
+		m_stop = true;
+	}
+	m_ready.notify_all();
+	for (auto& thread : m_threads)
+	{
+		thread.join();
+	}
+	m_threads.clear();
+
+	for (auto& connection : connections)
+	{
+		close(connection->fd);
+	}
+
+	signal(SIGINT, SIG_DFL);
+	signal(SIGTERM, SIG_DFL);
+	s_signalFd = -1;
+
+	close(listenFd);
+	close(m_wakeFds[0]);
+	close(m_wakeFds[1]);
+	unlink(path);
+
+	std::cerr << "Server stopped" << std::endl;
+	return 0;
+}
+
+#endif
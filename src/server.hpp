@@ -0,0 +1,112 @@
+/// @file
+///
+/// @brief Server (query daemon) mode class definitions.
+///
+/// Server listens on a Unix domain socket and answers requests of any number
+/// of connections with a fixed pool of worker threads. A request is one line
+/// of interactive commands separated by blanks:
+///  - date/time: yyyy-mm-dd[Thh:mm[:ss]][Z|+hh:mm] (UTC), hh:mm[:ss] after a date, JD, MJDn or @seconds
+///  - location: lLAT,LONG[,ELEV]  (e.g. l42.9,-71.5,300)
+///  - m (phase), n[options] (next phases - as -n), p[options] (planets - as -p), r (rise/set), s (sun)
+///  - q closes the connection
+/// Missing date, location or computations use the command line settings.
+/// Each request is answered with one JSON line (same as --batch) in order of
+/// the requests of the connection; "line" is the request number.
+///
+/// @copyright 2019-2020 M.Mashimo and licensors. All Right Reserved.
+///
+/// cMoon is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// any later version.
+///
+/// cMoon is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with cMoon.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "batch.hpp"
+
+/// @brief Requests of a connection waiting for a worker (bytes) - reading stops above this
+constexpr size_t ServerMaxPending{1 << 20};
+
+/// @brief Longest request line (bytes) - a longer line is answered with an error and closes the connection
+constexpr size_t ServerMaxRequest{1 << 16};
+
+/// @brief Connection of a client
+using ServerConnection = struct structServerConnection
+{
+	int         fd;
+	std::string input;     // partial request line (I/O thread only)
+	std::string pending;   // complete request lines not processed yet
+	size_t      requests;  // requests answered (workers - one at a time)
+	bool        busy;      // queued for or processed by a worker
+	bool        closed;    // end of input, 'q' or write error
+	bool        tooLong;   // request line longer than ServerMaxRequest (error not answered yet)
+};
+
+class Server
+{
+public:
+	/// @brief Constructor
+	/// @param[in] batch - computations and defaults of requests (see Batch)
+	/// @param[in] moonObj - Moon settings (next phases - '-n')
+	/// @param[in] planets - planets to compute ('-p')
+	/// @param[in] workers - number of worker threads (0 = number of CPUs)
+	Server(const Batch& batch, const AMoon& moonObj, const APlanets& planets, const unsigned workers);
+
+	/// @brief Destructor
+	virtual ~Server();
+
+	/// @brief Serves requests on a Unix domain socket until SIGINT or SIGTERM
+	/// @param[in] path - socket path (a stale socket is replaced)
+	/// @return 0 if served, errno of the failure otherwise
+	int run(const char* path);
+
+	/// @brief Processes one request line - appends its JSON response (and line end)
+	/// @param[in] request - text of the request (without line end)
+	/// @param[in] length - length of request
+	/// @param[in] number - request number (response "line")
+	/// @param[in] batch - computations (worker's copy)
+	/// @param[out] result - results (capacity reused)
+	/// @param[out] response - buffer the response is appended to
+	/// @return false if the request closes the connection ('q')
+	bool processRequest(const char* request, const size_t length, const size_t number,
+		const Batch& batch, BatchResult& result, std::string& response) const;
+
+private:
+	/// @brief Worker thread - processes requests of queued connections
+	void work();
+
+	/// @brief Wakes up the I/O thread (poll)
+	void wake();
+
+	Batch    m_batch;
+	AMoon    m_moon;
+	APlanets m_planets;
+	unsigned m_workers;
+
+	/// @brief Queue of connections with pending requests (and stop) - guarded by m_mutex
+	std::mutex              m_mutex;
+	std::condition_variable m_ready;
+	std::deque<std::shared_ptr<ServerConnection>> m_queue;
+	bool                    m_stop;
+
+	/// @brief Pipe to wake up the I/O thread (signals and closed connections)
+	int m_wakeFds[2];
+
+	std::vector<std::thread> m_threads;
+};
@@ -46,6 +46,7 @@ Settings::Settings(const bool forceApply, const std::string& iniFile)
 	: m_iniFile(iniFile)
 	, m_fileWasRead(false)
 	, m_changed(false)
+	, m_context(DefaultContext)
 {
 	openIniHelper(iniFile, forceApply);
 }
@@ -69,6 +70,11 @@ const ALocation& Settings::getLocation() const
 	return m_location;
 }
 
+const AContext& Settings::getContext() const
+{
+	return m_context;
+}
+
 bool Settings::setDefaultIniFile(const std::string& defaultFileName, const bool forceSave)
 {
 	bool success = true;
@@ -200,20 +206,20 @@ void Settings::get_date_time_info()
 
 	if (m_changed)
 	{
-		std::cout << "Overwriting Date-Time Zone (from UTC): " << ADateTime::m_defaultTimeZone << " to " << tz <<
-			" DST-ON: " << ADateTime::m_useDST << " to " << dst << std::endl;
+		std::cout << "Overwriting Date-Time Zone (from UTC): " << m_context.timeZone << " to " << tz <<
+			" DST-ON: " << m_context.useDST << " to " << dst << std::endl;
 	}
 
-	ADateTime::m_defaultTimeZone = tz;
-	ADateTime::m_useDST = dst != 0;
+	m_context.timeZone = tz;
+	m_context.useDST = dst != 0;
 }
 
 void Settings::get_debug_info()
 {
 	std::string verbose = getString("Debug.Verbose");
-	ADateTime::m_verboseLevel = getInt("Debug.DateTime");
-	AMoon::m_verboseLevel = getInt("Debug.Moon");
-	ASun::m_verboseLevel = getInt("Debug.Sun");
+	m_context.dateTimeVerbose = getInt("Debug.DateTime");
+	m_context.moonVerbose = getInt("Debug.Moon");
+	m_context.sunVerbose = getInt("Debug.Sun");
 }
 
 void Settings::save_location_info(const ALocation& location)
@@ -231,22 +237,26 @@ void Settings::save_location_info(const ALocation& location)
 		<< " Elev=" << location.elevation() << "ft." << std::endl;
 }
 
-void Settings::save_date_time_info()
+void Settings::save_date_time_info(const AContext& context)
 {
-	m_pt.put("Time.Zone", ADateTime::m_defaultTimeZone);
+	m_pt.put("Time.Zone", context.timeZone);
 	m_pt.put("Time.DST", 1);
 	m_changed = true;
-	std::cout << "Saving Date-Time Zone (from UTC): " << ADateTime::m_defaultTimeZone
+	m_context.timeZone = context.timeZone;
+	std::cout << "Saving Date-Time Zone (from UTC): " << context.timeZone
 		<< " DST-ON" << std::endl;
 }
 
-void Settings::save_debug_info()
+void Settings::save_debug_info(const AContext& context)
 {
 	m_pt.put("Debug.Verbose", "vA");
-	m_pt.put("Debug.DateTime", ADateTime::m_verboseLevel);
-	m_pt.put("Debug.Moon", AMoon::m_verboseLevel);
-	m_pt.put("Debug.Sun", ASun::m_verboseLevel);
+	m_pt.put("Debug.DateTime", context.dateTimeVerbose);
+	m_pt.put("Debug.Moon", context.moonVerbose);
+	m_pt.put("Debug.Sun", context.sunVerbose);
 	m_changed = true;
+	m_context.dateTimeVerbose = context.dateTimeVerbose;
+	m_context.moonVerbose = context.moonVerbose;
+	m_context.sunVerbose = context.sunVerbose;
 }
 
 void Settings::write_default_settings()
@@ -254,8 +264,8 @@ void Settings::write_default_settings()
 	std::cout << "Writing to file: " << m_iniFile << std::endl;
 
 	save_location_info(m_location);
-	save_date_time_info();
-	save_debug_info();
+	save_date_time_info(m_context);
+	save_debug_info(m_context);
 
 	m_changed = true;
 }
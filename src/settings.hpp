@@ -30,6 +30,7 @@
 #include <cmath>
 
 #include "ALocation.h"
+#include "AContext.h"
 
 // namespace ...
 
@@ -51,15 +52,21 @@ public:
 	/// @return ALocation object retrieved from INI files
 	const ALocation& getLocation() const;
 
+	/// @brief Retrieve time zone, DST and verbose levels for this setting.
+	/// @return AContext retrieved from INI files
+	const AContext& getContext() const;
+
 	/// @brief Saves Location information
 	/// @param[in] location - saves items in location object
 	void save_location_info(const ALocation& location);
 
 	/// @brief Saves Date-Time info
-	void save_date_time_info();
+	/// @param[in] context - saves time zone and DST
+	void save_date_time_info(const AContext& context);
 
 	/// @brief Saves Debug Level info
-	void save_debug_info();
+	/// @param[in] context - saves verbose levels
+	void save_debug_info(const AContext& context);
 
 	/// @brief Create a list of all the settings that should be in the INI file
 	void write_default_settings();
@@ -114,6 +121,9 @@ private:
 	/// @brief Local copy of location
 	ALocation m_location;
 
+	/// @brief Local copy of time zone, DST and verbose levels
+	AContext  m_context;
+
 	/// @brief Default File name used to change
 	static std::string s_iniFile;
 
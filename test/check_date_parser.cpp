@@ -0,0 +1,159 @@
+/// @file
+///
+/// @brief Checks ADateParser inputs (ISO-8601, JD, MJD and Unix seconds).
+///
+/// Fixed inputs are compared with instants computed outside of cMoon; random
+/// date/times of 1600-2399 (offsets, fractions, separators) are compared with
+/// timegm() and with their JD, MJD and Unix forms.
+///
+/// @copyright 2019-2020 M.Mashimo and licensors. All Right Reserved.
+///
+/// This file is part of cMoon application.
+///
+/// cMoon is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// any later version.
+///
+/// cMoon is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with cMoon.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <random>
+
+#include "ADateParser.h"
+
+/// @brief Unix seconds of J2000.0 (2000-01-01 12:00 UTC)
+static constexpr int64_t UnixSecondsOfJ2000{946728000};
+
+static constexpr int RandomInputs{200000};
+
+using ParserCase = struct structParserCase
+{
+	const char* input;
+	int64_t     ticks;
+	InputFormat format;
+};
+
+static const ParserCase s_cases[]
+{
+	{"2000-01-01T12:00:00Z",          0LL,                  InputFormat::DateTime},
+	{"2000-01-01",                    -43200000000LL,       InputFormat::Date},
+	{"2024-07-15 12:34:56.5+09:00",   774286496500000LL,    InputFormat::DateTime},
+	{"1969-07-20T20:17:40z",          -960910940000000LL,   InputFormat::DateTime},
+	{"1600-02-29T00:00-0530",         -12617706600000000LL, InputFormat::DateTime},
+	{"2100-12-31",                    3187166400000000LL,   InputFormat::Date},
+	{"JD2451545.25",                  21600000000LL,        InputFormat::JulianDate},
+	{"2459177.25",                    659426400000000LL,    InputFormat::JulianDate},
+	{"mjd60000.5",                    730598400000000LL,    InputFormat::ModifiedJulianDate},
+	{"@1700000000",                   753272000000000LL,    InputFormat::UnixSeconds},
+	{" 1700000000\r\n",               753272000000000LL,    InputFormat::UnixSeconds}
+};
+
+static const char* s_invalid[]
+{
+	"", "abc", "2024-13-01", "2023-02-29", "2024-04-31", "2024-07-15T25:00", "2024-07-15T12:60",
+	"2024-07-15X12:00", "2024-07-15T12:00+24:00", "2024-07-15T12:00Z1", "JD", "12.3.4",
+	"jd999999999999", "jd10000001", "jd-10000001", "-10000001", "mjd10000001", "@99999999999999", "@-1000000000001", "99999999999999"
+};
+
+/// @brief Days of a month (Gregorian)
+static int daysInMonth(const int year, const int month)
+{
+	static const int days[12]{31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+	bool leap = ((year % 4) == 0) && (((year % 100) != 0) || ((year % 400) == 0));
+	return ((month == 2) && leap) ? 29 : days[month - 1];
+}
+
+static bool check(const char* input, const int64_t expected, const int64_t tolerance, int& errors)
+{
+	ParsedInstant instant;
+	if (ADateParser::parse(input, instant) && (llabs(instant.ticks - expected) <= tolerance))
+	{
+		return true;
+	}
+
+	if (errors++ < 5)
+	{
+		printf("  '%s': %lld - expected %lld\n", input, static_cast<long long>(instant.ticks), static_cast<long long>(expected));
+	}
+	return false;
+}
+
+int main()
+{
+	int errors = 0;
+
+	for (auto& test : s_cases)
+	{
+		check(test.input, test.ticks, 0, errors);
+
+		ParsedInstant instant;
+		if (ADateParser::parse(test.input, instant) && (instant.format != test.format))
+		{
+			printf("  '%s': format %d - expected %d\n", test.input, static_cast<int>(instant.format), static_cast<int>(test.format));
+			errors++;
+		}
+	}
+
+	for (const char* input : s_invalid)
+	{
+		ParsedInstant instant;
+		if (ADateParser::parse(input, instant))
+		{
+			printf("  '%s': accepted\n", input);
+			errors++;
+		}
+	}
+	printf("Fixed inputs: %zu valid, %zu invalid\n", sizeof(s_cases) / sizeof(s_cases[0]), sizeof(s_invalid) / sizeof(s_invalid[0]));
+
+	// Random date/times against timegm() - same instant as JD, MJD and Unix seconds
+	std::mt19937_64 random(20201123);
+	char buffer[64];
+	for (int i = 0; i < RandomInputs; i++)
+	{
+		struct tm date{};
+		date.tm_year = static_cast<int>(random() % 800) + 1600 - 1900;
+		date.tm_mon = static_cast<int>(random() % 12);
+		date.tm_mday = static_cast<int>(random() % daysInMonth(date.tm_year + 1900, date.tm_mon + 1)) + 1;
+		date.tm_hour = static_cast<int>(random() % 24);
+		date.tm_min = static_cast<int>(random() % 60);
+		date.tm_sec = static_cast<int>(random() % 60);
+		int micro = static_cast<int>(random() % 1000000);
+		int offset = ((static_cast<int>(random() % 57) - 28) * 30 * 60);
+
+		int64_t seconds = static_cast<int64_t>(timegm(&date));
+		int64_t expected = ((seconds - offset - UnixSecondsOfJ2000) * TicksPerSecond) + micro;
+
+		int hours = abs(offset) / 3600;
+		int minutes = (abs(offset) / 60) % 60;
+		snprintf(buffer, sizeof(buffer), "%04d-%02d-%02d%c%02d:%02d:%02d.%06d%c%02d:%02d", date.tm_year + 1900, date.tm_mon + 1,
+			date.tm_mday, (i % 2 == 0) ? 'T' : ' ', date.tm_hour, date.tm_min, date.tm_sec, micro, (offset < 0) ? '-' : '+', hours, minutes);
+		check(buffer, expected, 0, errors);
+
+		int64_t utc = expected + (UnixSecondsOfJ2000 * TicksPerSecond);
+		snprintf(buffer, sizeof(buffer), "@%lld.%06lld", static_cast<long long>(utc / TicksPerSecond), static_cast<long long>(utc % TicksPerSecond));
+		if (utc >= 0)
+		{
+			check(buffer, expected, 0, errors);
+		}
+
+		// 8 decimals of a day - 0.864 ms
+		double jd = JulianDateOfTickZero + (static_cast<double>(expected) / TicksPerDay);
+		snprintf(buffer, sizeof(buffer), "JD%.8f", jd);
+		check(buffer, expected, 1000, errors);
+		snprintf(buffer, sizeof(buffer), "mjd%.8f", jd - 2400000.5);
+		check(buffer, expected, 1000, errors);
+	}
+	printf("Random inputs: %d date/times as ISO-8601, Unix seconds, JD and MJD\n", RandomInputs);
+
+	printf("%s\n", (errors == 0) ? "ok" : "FAILED");
+	return (errors == 0) ? 0 : 1;
+}
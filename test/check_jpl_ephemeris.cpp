@@ -0,0 +1,358 @@
+/// @file
+///
+/// @brief Checks AJplEphemeris with a synthetic JPL binary file (DE format of asc2eph).
+///
+/// Bodies move on circles (radius, period, phase and inclination below); their
+/// Chebyshev coefficients are fitted at Chebyshev nodes of each sub-interval and
+/// written as a DE binary file in host and swapped byte order. Barycentric
+/// positions (including the Earth from the geocentric Moon and EMRAT) and
+/// astrometric planet positions (light time) are compared with the circles.
+///
+/// @copyright 2019-2020 M.Mashimo and licensors. All Right Reserved.
+///
+/// This file is part of cMoon application.
+///
+/// cMoon is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// any later version.
+///
+/// cMoon is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with cMoon.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include "AInstant.h"
+#include "AJplEphemeris.h"
+
+static constexpr double Au{149597870.7};
+static constexpr double Emrat{81.30056};
+static constexpr double LightKmPerDay{299792.458 * 86400.};
+
+/// @brief Span of the file - 200 records of 32 days from 1999-12-24
+static constexpr double FileStart{2451536.5};
+static constexpr double RecordDays{32.};
+static constexpr int Records{200};
+static constexpr int Coefficients{14};
+
+/// @brief Largest differences - position (km) and angles (arc seconds)
+static constexpr double PositionTolerance{1e-2};
+static constexpr double AngleTolerance{1e-3};
+
+/// @brief Circular motion of an item of the file (relative to its center)
+using SyntheticBody = struct structSyntheticBody
+{
+	int    target;        // NAIF id
+	int    subintervals;  // of a record
+	double radius;        // km
+	double period;        // days
+	double phase;         // radians at J2000.0
+	double inclination;   // radians (to the equator)
+};
+
+/// @brief Items of a DE binary file in order (Mercury to Pluto, geocentric Moon, Sun)
+static const SyntheticBody s_bodies[11]
+{
+	{1,                   4, 0.387 * Au,  87.969,   0.3, 0.12},
+	{2,                   2, 0.723 * Au,  224.701,  1.1, 0.06},
+	{EarthMoonBarycenter, 2, 1.000 * Au,  365.256,  1.7, 0.41},
+	{4,                   1, 1.524 * Au,  686.980,  2.3, 0.43},
+	{5,                   1, 5.203 * Au,  4332.59,  2.9, 0.40},
+	{6,                   1, 9.537 * Au,  10759.2,  3.5, 0.43},
+	{7,                   1, 19.19 * Au,  30688.5,  4.1, 0.40},
+	{8,                   1, 30.07 * Au,  60182.0,  4.7, 0.39},
+	{9,                   1, 39.48 * Au,  90560.0,  5.3, 0.55},
+	{JplMoon,             8, 384400.,     27.3217,  0.7, 0.38},
+	{JplSun,              2, 1.0e6,       4332.59,  5.9, 0.02}
+};
+
+static void circle(const SyntheticBody& body, const double jd, double position[3])
+{
+	double angle = (2. * M_PI * (jd - 2451545.) / body.period) + body.phase;
+	position[0] = body.radius * cos(angle);
+	position[1] = body.radius * sin(angle) * cos(body.inclination);
+	position[2] = body.radius * sin(angle) * sin(body.inclination);
+}
+
+static const SyntheticBody& bodyOf(const int target)
+{
+	return *std::find_if(s_bodies, s_bodies + 11, [target](const SyntheticBody& body) { return body.target == target; });
+}
+
+/// @brief Barycentric position of the circles (Earth from the Moon and EMRAT)
+static void expected(const int target, const double jd, double position[3])
+{
+	if (target == JplEarth || target == JplMoon)
+	{
+		double emb[3];
+		double moon[3];
+		circle(bodyOf(EarthMoonBarycenter), jd, emb);
+		circle(bodyOf(JplMoon), jd, moon);
+		double scale = (target == JplEarth) ? -1. / (1. + Emrat) : Emrat / (1. + Emrat);
+		for (int c = 0; c < 3; c++)
+		{
+			position[c] = emb[c] + (scale * moon[c]);
+		}
+		return;
+	}
+	circle(bodyOf(target), jd, position);
+}
+
+/// @brief Writes doubles and ints in host or swapped byte order
+class Writer
+{
+public:
+	Writer(std::vector<char>& bytes, const bool swapped) : m_bytes(bytes), m_swapped(swapped) {}
+
+	void put(const size_t offset, const void* value, const size_t size)
+	{
+		char bytes[8];
+		memcpy(bytes, value, size);
+		if (m_swapped)
+		{
+			std::reverse(bytes, bytes + size);
+		}
+		memcpy(&m_bytes[offset], bytes, size);
+	}
+
+	void putInt(const size_t offset, const int32_t value) { put(offset, &value, sizeof(value)); }
+	void putDouble(const size_t offset, const double value) { put(offset, &value, sizeof(value)); }
+
+private:
+	std::vector<char>& m_bytes;
+	bool m_swapped;
+};
+
+/// @brief Pointers (IPT) of the items - first coefficient (1 based), coefficients and sub-intervals
+/// @return doubles of a record
+static size_t itemPointers(int pointers[13][3])
+{
+	int offset = 3;
+	for (int item = 0; item < 13; item++)
+	{
+		int subintervals = (item < 11) ? s_bodies[item].subintervals : 0;
+		pointers[item][0] = offset;
+		pointers[item][1] = (item < 11) ? Coefficients : 0;
+		pointers[item][2] = subintervals;
+		offset += 3 * Coefficients * subintervals;
+	}
+	return static_cast<size_t>(offset - 1);
+}
+
+/// @brief Writes the DE binary file (records of 'recordSize' doubles - header, constants, then data)
+static bool writeFile(const std::string& path, const bool swapped)
+{
+	int pointers[13][3];
+	size_t recordSize = itemPointers(pointers);
+
+	std::vector<char> bytes((Records + 2) * recordSize * sizeof(double), 0);
+	Writer writer(bytes, swapped);
+
+	memcpy(&bytes[0], "SYNTHETIC EPHEMERIS - CIRCULAR ORBITS", 37);
+	writer.putDouble(2652, FileStart);
+	writer.putDouble(2660, FileStart + (Records * RecordDays));
+	writer.putDouble(2668, RecordDays);
+	writer.putInt(2676, 0);
+	writer.putDouble(2680, Au);
+	writer.putDouble(2688, Emrat);
+	for (int item = 0; item < 12; item++)
+	{
+		for (int k = 0; k < 3; k++)
+		{
+			writer.putInt(2696 + (((item * 3) + k) * sizeof(int32_t)), pointers[item][k]);
+		}
+	}
+	writer.putInt(2840, 440);
+	for (int k = 0; k < 3; k++)
+	{
+		writer.putInt(2844 + (k * sizeof(int32_t)), pointers[12][k]);
+	}
+
+	// Coefficients of each sub-interval from the circle at Chebyshev nodes
+	std::vector<double> values(3 * Coefficients);
+	for (int record = 0; record < Records; record++)
+	{
+		size_t base = (record + 2) * recordSize * sizeof(double);
+		double start = FileStart + (record * RecordDays);
+		writer.putDouble(base, start);
+		writer.putDouble(base + sizeof(double), start + RecordDays);
+
+		for (int item = 0; item < 11; item++)
+		{
+			const SyntheticBody& body = s_bodies[item];
+			double length = RecordDays / body.subintervals;
+			for (int sub = 0; sub < body.subintervals; sub++)
+			{
+				double middle = start + ((sub + 0.5) * length);
+				for (int j = 0; j < Coefficients; j++)
+				{
+					double position[3];
+					circle(body, middle + (cos(M_PI * (j + 0.5) / Coefficients) * length / 2.), position);
+					for (int c = 0; c < 3; c++)
+					{
+						values[(c * Coefficients) + j] = position[c];
+					}
+				}
+
+				size_t first = base + ((pointers[item][0] - 1 + (sub * 3 * Coefficients)) * sizeof(double));
+				for (int c = 0; c < 3; c++)
+				{
+					for (int k = 0; k < Coefficients; k++)
+					{
+						double sum = 0.;
+						for (int j = 0; j < Coefficients; j++)
+						{
+							sum += values[(c * Coefficients) + j] * cos(M_PI * k * (j + 0.5) / Coefficients);
+						}
+						sum *= ((k == 0) ? 1. : 2.) / Coefficients;
+						writer.putDouble(first + (((c * Coefficients) + k) * sizeof(double)), sum);
+					}
+				}
+			}
+		}
+	}
+
+	FILE* file = fopen(path.c_str(), "wb");
+	if (file == nullptr)
+	{
+		return false;
+	}
+	bool written = (fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size());
+	return (fclose(file) == 0) && written;
+}
+
+/// @brief Angle between two directions (arc seconds) of RA (hours) and DEC (degrees)
+static double separation(const double ra1, const double dec1, const double ra2, const double dec2)
+{
+	double dra = remainder(ra1 - ra2, 24.) * 15. * cos(dec1 * M_PI / 180.);
+	return hypot(dra, dec1 - dec2) * 3600.;
+}
+
+static int checkFile(const std::string& path, const char* name)
+{
+	AJplEphemeris ephemeris;
+	if (!ephemeris.open(path))
+	{
+		printf("%-8s cannot open '%s' - FAILED\n", name, path.c_str());
+		return 1;
+	}
+
+	int errors = 0;
+	if ((ephemeris.number() != 440) || (ephemeris.series().size() != 11) || (ephemeris.jdStart() != FileStart)
+		|| (ephemeris.jdEnd() != FileStart + (Records * RecordDays)))
+	{
+		printf("%-8s header: DE%d, %zu series, JD %.1f to %.1f - FAILED\n", name, ephemeris.number(), ephemeris.series().size(),
+			ephemeris.jdStart(), ephemeris.jdEnd());
+		errors++;
+	}
+
+	static const int targets[]{1, 2, EarthMoonBarycenter, 4, 5, 6, 7, 8, 9, JplSun, JplMoon, JplEarth};
+
+	std::mt19937_64 random(440);
+	std::uniform_real_distribution<double> days(FileStart + 1., FileStart + (Records * RecordDays) - 1.);
+
+	double worstKm = 0.;
+	double worstAngle = 0.;
+	double worstDistance = 0.;
+	for (int sample = 0; sample < 20000; sample++)
+	{
+		double jd = days(random);
+		for (int target : targets)
+		{
+			double position[3];
+			double reference[3];
+			if (!ephemeris.barycentric(target, jd, position))
+			{
+				worstKm = HUGE_VAL;
+				continue;
+			}
+			expected(target, jd, reference);
+			worstKm = std::max(worstKm, sqrt(pow(position[0] - reference[0], 2.) + pow(position[1] - reference[1], 2.)
+				+ pow(position[2] - reference[2], 2.)));
+		}
+
+		// Astrometric position - planet when the light left it (converged)
+		int planet = sample % NumberOfPlanets;
+		double j2000 = jd - 2451545.;
+		PlanetPosition position;
+		if ((planet == PlanetType::Earth) || !ephemeris.covers(j2000))
+		{
+			continue;
+		}
+		if (!ephemeris.planetPosition(planet, j2000, position))
+		{
+			worstAngle = HUGE_VAL;
+			continue;
+		}
+
+		double tt = AInstant::fromJulian(jd).julianTT();
+		double earth[3];
+		double body[3];
+		double geocentric[3];
+		double distance = 0.;
+		expected(JplEarth, tt, earth);
+		for (int iteration = 0; iteration < 6; iteration++)
+		{
+			expected(AJplEphemeris::planetTarget(planet), tt - (distance / LightKmPerDay), body);
+			for (int c = 0; c < 3; c++)
+			{
+				geocentric[c] = body[c] - earth[c];
+			}
+			distance = sqrt((geocentric[0] * geocentric[0]) + (geocentric[1] * geocentric[1]) + (geocentric[2] * geocentric[2]));
+		}
+		double ra = atan2(geocentric[1], geocentric[0]) * (12. / M_PI);
+		double dec = atan2(geocentric[2], hypot(geocentric[0], geocentric[1])) * (180. / M_PI);
+
+		worstAngle = std::max(worstAngle, separation(position.ra, position.dec, ra, dec));
+		worstDistance = std::max(worstDistance, fabs(position.dist - (distance / Au)) * Au);
+	}
+
+	bool ok = (worstKm <= PositionTolerance) && (worstAngle <= AngleTolerance) && (worstDistance <= PositionTolerance);
+	printf("%-8s barycentric %.3g km, astrometric %.3g\" and %.3g km: %s\n", name, worstKm, worstAngle, worstDistance, ok ? "ok" : "FAILED");
+	return errors + (ok ? 0 : 1);
+}
+
+int main()
+{
+	const std::string native{"check_jpl_ephemeris.440"};
+	const std::string swapped{"check_jpl_ephemeris_swapped.440"};
+
+	int errors = 0;
+	if (!writeFile(native, false) || !writeFile(swapped, true))
+	{
+		printf("Cannot write the synthetic ephemeris - FAILED\n");
+		errors++;
+	}
+	else
+	{
+		errors += checkFile(native, "native");
+		errors += checkFile(swapped, "swapped");
+
+		// A file cut short ends with its last record - no header is not an ephemeris
+		int pointers[13][3];
+		size_t recordBytes = itemPointers(pointers) * sizeof(double);
+		AJplEphemeris ephemeris;
+		bool shortened = (truncate(native.c_str(), static_cast<off_t>(3 * recordBytes)) == 0) && ephemeris.open(native)
+			&& (ephemeris.jdEnd() == FileStart + RecordDays);
+		bool rejected = (truncate(native.c_str(), static_cast<off_t>(recordBytes / 4)) == 0) && !ephemeris.open(native);
+		printf("%-8s one record: %s, no header: %s\n", "short", shortened ? "ok" : "FAILED", rejected ? "ok" : "FAILED");
+		errors += (shortened && rejected) ? 0 : 1;
+	}
+
+	remove(native.c_str());
+	remove(swapped.c_str());
+	return (errors == 0) ? 0 : 1;
+}
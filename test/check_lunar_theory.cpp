@@ -0,0 +1,101 @@
+/// @file
+///
+/// @brief Checks ALunarTheory against the examples of Meeus (Astronomical Algorithms).
+///
+/// Example 47.a (1992-04-12 0h TD): apparent longitude, latitude, distance,
+/// parallax, RA and DEC. Example 48.a (same time): geocentric elongation and
+/// illuminated fraction. The apparent values differ by up to 0.12" from Meeus -
+/// nutation is the four term series of Meeus 22 (0.5") - and the elongation by
+/// 0.6" (Sun of Meeus 25). positions() must match position() for a block of times.
+///
+/// @copyright 2019-2020 M.Mashimo and licensors. All Right Reserved.
+///
+/// This file is part of cMoon application.
+///
+/// cMoon is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// any later version.
+///
+/// cMoon is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with cMoon.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "ALunarTheory.h"
+
+/// @brief JDE of the examples
+static constexpr double ExampleJde{2448724.5};
+
+/// @brief Largest difference of the angles (arc seconds)
+static constexpr double AngleTolerance{0.2};
+
+static int s_errors = 0;
+
+static void check(const char* name, const double value, const double expected, const double tolerance, const char* unit)
+{
+	bool ok = (fabs(value - expected) <= tolerance);
+	printf("%-22s %14.6f  Meeus %14.6f  %s\n", name, value, expected, ok ? "ok" : "FAILED");
+	if (!ok)
+	{
+		printf("  difference %g %s (tolerance %g)\n", value - expected, unit, tolerance);
+		s_errors++;
+	}
+}
+
+int main()
+{
+	ALunarTheory theory;
+	LunarPosition position;
+
+	const double t = (ExampleJde - 2451545.) / 36525.;
+	theory.position(t, position);
+
+	// Example 47.a
+	const double degrees = AngleTolerance / 3600.;
+	check("Longitude (apparent)", position.longitude, 133.167265, degrees, "degrees");
+	check("Latitude", position.latitude, -3.229126, degrees, "degrees");
+	check("Distance (km)", position.distance, 368409.7, 0.1, "km");
+	check("Parallax", position.parallax, 0.991990, 1e-6, "degrees");
+	check("RA (degrees)", position.ra * 15., 134.688470, degrees / cos(13.768368 * M_PI / 180.), "degrees");
+	check("DEC", position.dec, 13.768368, degrees, "degrees");
+
+	// Example 48.a - geocentric elongation from the difference of longitudes
+	double psi = acos(cos(position.latitude * M_PI / 180.) * cos(position.elongation * M_PI / 180.)) * 180. / M_PI;
+	check("Elongation", psi, 110.7929, 0.001, "degrees");
+	check("Illuminated fraction", position.illuminated, 0.6786, 0.0001, "");
+
+	// Block of times against single times
+	constexpr size_t count{1000};
+	std::vector<double> times(count), ra(count), dec(count), distance(count), elongation(count);
+	for (size_t i = 0; i < count; i++)
+	{
+		times[i] = t + (i * 0.00137);
+	}
+	theory.positions(times.data(), count, ra.data(), dec.data(), distance.data(), elongation.data());
+
+	double worst = 0.;
+	for (size_t i = 0; i < count; i++)
+	{
+		theory.position(times[i], position);
+		worst = std::max(worst, fabs(position.ra - ra[i]) + fabs(position.dec - dec[i])
+			+ fabs(position.distance - distance[i]) + fabs(position.elongation - elongation[i]));
+	}
+	bool same = (worst == 0.);
+	printf("positions() of %zu times: %s\n", count, same ? "ok" : "FAILED");
+	if (!same)
+	{
+		printf("  largest difference %g\n", worst);
+		s_errors++;
+	}
+
+	return (s_errors == 0) ? 0 : 1;
+}
@@ -0,0 +1,156 @@
+/// @file
+///
+/// @brief Checks ATimeZone lookups against localtime_r.
+///
+/// Samples 1906-2100 every 6 hours (less a second) in ten zones and every
+/// transition seen by localtime_r (the second before and the second of it).
+/// Offset, daylight flag and abbreviation must match. Zones missing from
+/// the zoneinfo directory are skipped.
+///
+/// @copyright 2019-2020 M.Mashimo and licensors. All Right Reserved.
+///
+/// This file is part of cMoon application.
+///
+/// cMoon is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// any later version.
+///
+/// cMoon is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with cMoon.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+
+#include "ATimeZone.h"
+
+/// @brief 1906-01-01 and 2101-01-01 00:00 UTC (Unix seconds)
+static constexpr int64_t FirstSecond{-2019686400LL};
+static constexpr int64_t LastSecond{4133980800LL};
+
+static constexpr int64_t SampleSeconds{(6 * 3600) - 1};
+
+static const char* s_zones[]
+{
+	"America/New_York", "America/Los_Angeles", "America/Sao_Paulo", "Europe/London", "Europe/Berlin",
+	"Asia/Kolkata", "Asia/Tokyo", "Australia/Sydney", "Australia/Lord_Howe", "Pacific/Chatham"
+};
+
+/// @brief Fixed offsets of ATimeZone::fromContext() (hours from UTC - under an hour both ways)
+static const double s_fixedOffsets[]{0., 0.5, -0.5, -3.5, 5.75, -9.5, 12.75, -12.};
+
+/// @brief Compares one second - prints the first few differences
+static bool compare(const ATimeZone& zone, const int64_t utc, int& errors)
+{
+	time_t t = static_cast<time_t>(utc);
+	struct tm local;
+	if (localtime_r(&t, &local) == nullptr)
+	{
+		return true;
+	}
+
+	LocalTimeInfo info = zone.lookup(utc);
+	if ((info.offset == local.tm_gmtoff) && (info.isDst == (local.tm_isdst > 0))
+		&& (strcmp(info.abbreviation, local.tm_zone) == 0))
+	{
+		return true;
+	}
+
+	if (errors++ < 5)
+	{
+		printf("  %lld: %d %d %s - localtime_r %ld %d %s\n", static_cast<long long>(utc), info.offset, info.isDst ? 1 : 0,
+			info.abbreviation, static_cast<long>(local.tm_gmtoff), local.tm_isdst, local.tm_zone);
+	}
+	return false;
+}
+
+/// @brief Offset and abbreviation of localtime_r (to find transitions)
+static bool sameType(const int64_t a, const int64_t b)
+{
+	time_t ta = static_cast<time_t>(a);
+	time_t tb = static_cast<time_t>(b);
+	struct tm la, lb;
+	localtime_r(&ta, &la);
+	localtime_r(&tb, &lb);
+	return (la.tm_gmtoff == lb.tm_gmtoff) && (la.tm_isdst == lb.tm_isdst) && (strcmp(la.tm_zone, lb.tm_zone) == 0);
+}
+
+int main()
+{
+	int failed = 0;
+
+	for (const char* name : s_zones)
+	{
+		std::shared_ptr<const ATimeZone> zone = ATimeZone::find(name);
+		if (zone == nullptr)
+		{
+			printf("%-20s skipped (not in %s)\n", name, DefaultZoneInfoPath);
+			continue;
+		}
+
+		setenv("TZ", name, 1);
+		tzset();
+
+		int errors = 0;
+		size_t samples = 0;
+		size_t transitions = 0;
+		for (int64_t utc = FirstSecond; utc < LastSecond; utc += SampleSeconds)
+		{
+			compare(*zone, utc, errors);
+			samples++;
+
+			// Transition within the step - first second of the new type
+			int64_t next = utc + SampleSeconds;
+			if ((next < LastSecond) && !sameType(utc, next))
+			{
+				int64_t low = utc;
+				int64_t high = next;
+				while ((high - low) > 1)
+				{
+					int64_t middle = low + ((high - low) / 2);
+					if (sameType(low, middle))
+					{
+						low = middle;
+					}
+					else
+					{
+						high = middle;
+					}
+				}
+				compare(*zone, high - 1, errors);
+				compare(*zone, high, errors);
+				transitions++;
+			}
+		}
+
+		printf("%-20s %zu samples, %zu transitions: %s\n", name, samples, transitions, (errors == 0) ? "ok" : "FAILED");
+		if (errors != 0)
+		{
+			failed++;
+		}
+	}
+
+	for (double hours : s_fixedOffsets)
+	{
+		AContext context = DefaultContext;
+		context.timeZone = hours;
+		context.useDST = false;
+		int offset = ATimeZone::fromContext(context)->lookup(0).offset;
+		bool ok = (offset == static_cast<int>(lround(hours * 3600.)));
+		printf("fixed %+6.2f h      %+d s: %s\n", hours, offset, ok ? "ok" : "FAILED");
+		if (!ok)
+		{
+			failed++;
+		}
+	}
+
+	return (failed == 0) ? 0 : 1;
+}